@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON files.
+
+    compare.py baseline.json results.json [--threshold 0.10] [--metric cpu_time]
+
+Prints the per-benchmark change and exits 1 when any benchmark present in
+both files got slower by more than the threshold. With repetitions, the
+median aggregate is compared; otherwise the single run.
+"""
+
+import argparse
+import json
+import sys
+
+UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path, metric):
+    with open(path) as f:
+        data = json.load(f)
+    runs = {}
+    medians = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        value = bench[metric] * UNIT_NS[bench.get("time_unit", "ns")]
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[bench["run_name"]] = value
+        else:
+            runs.setdefault(bench.get("run_name", bench["name"]), value)
+    runs.update(medians)
+    return runs
+
+
+def format_ns(ns):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return "%.2f %s" % (ns / scale, unit)
+    return "%.1f ns" % ns
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("results")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="Relative slowdown that fails (default 0.10)")
+    parser.add_argument("--metric", default="real_time",
+                        choices=["real_time", "cpu_time"])
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    results = load(args.results, args.metric)
+
+    regressions = []
+    width = max([len(name) for name in results] + [9])
+    print("%-*s %12s %12s %9s" % (width, "Benchmark", "Baseline", "Current",
+                                  "Change"))
+    for name, current in results.items():
+        if name not in baseline:
+            print("%-*s %12s %12s %9s" % (width, name, "-",
+                                          format_ns(current), "new"))
+            continue
+        before = baseline[name]
+        change = (current - before) / before if before > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            flag = "  improved"
+        print("%-*s %12s %12s %+8.1f%%%s" % (width, name, format_ns(before),
+                                             format_ns(current), change * 100,
+                                             flag))
+    for name in baseline:
+        if name not in results:
+            print("%-*s %12s %12s %9s" % (width, name,
+                                          format_ns(baseline[name]), "-",
+                                          "missing"))
+
+    if regressions:
+        print("\n%d benchmark(s) slower than baseline by more than %.0f%%"
+              % (len(regressions), args.threshold * 100))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,101 @@
+// bench/counting_allocator.cpp
+//
+// Replacement global operator new / delete that report every allocation
+// to the per-thread counters in memory_profile.hpp. Link it only into
+// programs that profile allocations; the library itself never needs it.
+#include "memory_profile.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define COUNTING_USABLE_SIZE(p) malloc_usable_size(p)
+#else
+#define COUNTING_USABLE_SIZE(p) std::size_t(0)
+#endif
+
+namespace {
+
+void *counted_alloc(std::size_t size) {
+  void *p = std::malloc(size == 0 ? 1 : size);
+  if (p != nullptr) {
+    note_allocation(size, COUNTING_USABLE_SIZE(p));
+  }
+  return p;
+}
+
+void *counted_aligned_alloc(std::size_t size, std::size_t alignment) {
+  // aligned_alloc wants a size that is a multiple of the alignment
+  std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+  void *p = std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+  if (p != nullptr) {
+    note_allocation(size, COUNTING_USABLE_SIZE(p));
+  }
+  return p;
+}
+
+void counted_free(void *p) {
+  if (p != nullptr) {
+    note_free(COUNTING_USABLE_SIZE(p));
+    std::free(p);
+  }
+}
+
+void *alloc_or_throw(std::size_t size) {
+  void *p = counted_alloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *aligned_alloc_or_throw(std::size_t size, std::align_val_t alignment) {
+  void *p = counted_aligned_alloc(size, static_cast<std::size_t>(alignment));
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+struct CountingInstaller {
+  CountingInstaller() { alloc_counting_install(); }
+} installer;
+
+} // namespace
+
+void *operator new(std::size_t size) { return alloc_or_throw(size); }
+void *operator new[](std::size_t size) { return alloc_or_throw(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return counted_alloc(size);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return counted_alloc(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return aligned_alloc_or_throw(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return aligned_alloc_or_throw(size, alignment);
+}
+
+void operator delete(void *p) noexcept { counted_free(p); }
+void operator delete[](void *p) noexcept { counted_free(p); }
+void operator delete(void *p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void *p, std::size_t) noexcept { counted_free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+  counted_free(p);
+}
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+  counted_free(p);
+}
+void operator delete(void *p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  counted_free(p);
+}
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+  counted_free(p);
+}
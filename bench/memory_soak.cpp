@@ -0,0 +1,59 @@
+// bench/memory_soak.cpp
+//
+// Long-session memory soak: replays a generated order tape into one book,
+// counting allocations per operation type and sampling RSS and structure
+// sizes along the way.
+//
+//   memory_soak [operations] [--assert-zero-alloc]
+//
+// With --assert-zero-alloc the run fails if any operation allocated after
+// warmup, for use as a regression gate once the hot path is allocation-free.
+#include "memory_profile.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+int main(int argc, char *argv[]) {
+  MemorySoakConfig config;
+  bool assert_zero_alloc = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--assert-zero-alloc") == 0) {
+      assert_zero_alloc = true;
+    } else if (argv[i][0] >= '0' && argv[i][0] <= '9') {
+      config.operations = std::strtoull(argv[i], nullptr, 10);
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [operations] [--assert-zero-alloc]" << std::endl;
+      return 1;
+    }
+  }
+  config.sample_every =
+      std::max<std::uint64_t>(config.operations / 50, 1);
+
+  MemorySoakReport report;
+  try {
+    std::cout << "Soaking " << config.operations << " operations..."
+              << std::endl;
+    report = run_memory_soak(config);
+    report.print();
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  if (assert_zero_alloc && report.steady_allocations() > 0) {
+    std::cerr << "\nFAILED: " << report.steady_allocations()
+              << " allocations after warmup in";
+    for (std::size_t i = 0; i < kTapeOpCount; ++i) {
+      if (report.steady[i].allocations > 0) {
+        std::cerr << " " << to_string(static_cast<TapeOp>(i));
+      }
+    }
+    std::cerr << std::endl;
+    return 1;
+  }
+  return 0;
+}
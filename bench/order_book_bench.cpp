@@ -0,0 +1,365 @@
+// bench/order_book_bench.cpp
+//
+// Google Benchmark microbenchmarks for OrderBook hot paths, swept over book
+// depths from 10 to 1M resting orders.
+//
+//   bench --benchmark_out=results.json --benchmark_out_format=json
+//   bench/compare.py baseline.json results.json
+#include "muted_output.hpp"
+#include "order_book.hpp"
+#include "timer.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace {
+
+// ============================================================================
+// BOOK LAYOUT
+// ============================================================================
+
+// Resting orders alternate sides over up to kLevels price levels each. The
+// gap between 99.00 and 100.00 is left empty so crossing, iceberg and stop
+// benchmarks can place their own liquidity without disturbing the ladder.
+constexpr double kTick = 0.01;
+constexpr double kBestBid = 99.00;
+constexpr double kBestAsk = 100.00;
+constexpr double kSweepBase = 99.01; // First of up to 99 levels in the gap
+constexpr int kLevels = 500;
+constexpr int kLot = 100;
+
+constexpr int kLadderAccount = 1;
+constexpr int kTakerAccount = 2;
+constexpr int kStopAccount = 3;
+
+const std::vector<int64_t> kDepths = {10, 100, 1000, 10000, 100000, 1000000};
+
+double bid_price(int level) { return kBestBid - level * kTick; }
+double ask_price(int level) { return kBestAsk + level * kTick; }
+double sweep_price(int level) { return kSweepBase + level * kTick; }
+
+class BenchBook {
+public:
+  explicit BenchBook(int depth, bool flight_recorder = true)
+      : depth_(depth), flight_recorder_(flight_recorder) {
+    rebuild();
+  }
+
+  OrderBook &book() { return *book_; }
+  int next_id() { return next_id_++; }
+
+  // Levels per side actually populated by the ladder
+  int bid_levels() const { return std::min(kLevels, (depth_ + 1) / 2); }
+
+  // Orders and stale heap copies accumulate as the benchmark runs; rebuild
+  // once the book has taken as many operations as it was deep, which caps
+  // the drift at 2x while keeping rebuild cost amortized
+  bool maybe_rebuild(benchmark::State &state) {
+    if (++ops_since_build_ < std::max(depth_, 64)) {
+      return false;
+    }
+    state.PauseTiming();
+    rebuild();
+    state.ResumeTiming();
+    return true;
+  }
+
+private:
+  int depth_;
+  bool flight_recorder_;
+  int next_id_ = 1;
+  int ops_since_build_ = 0;
+  std::unique_ptr<OrderBook> book_;
+
+  void rebuild() {
+    book_.reset(); // Free the old book before building its replacement
+    book_ = std::make_unique<OrderBook>("BENCH");
+    if (!flight_recorder_) {
+      book_->disable_flight_recorder();
+    }
+    next_id_ = 1;
+    ops_since_build_ = 0;
+    for (int i = 0; i < depth_; ++i) {
+      int level = (i / 2) % kLevels;
+      if (i % 2 == 0) {
+        book_->add_order(Order(next_id(), kLadderAccount, Side::BUY,
+                               bid_price(level), kLot));
+      } else {
+        book_->add_order(Order(next_id(), kLadderAccount, Side::SELL,
+                               ask_price(level), kLot));
+      }
+    }
+  }
+};
+
+void set_common_counters(benchmark::State &state, int depth) {
+  state.SetItemsProcessed(state.iterations());
+  state.counters["depth"] = depth;
+}
+
+// Manual-time benchmarks time only the operation, not its untimed setup
+void set_iteration_time(benchmark::State &state, const Timer &timer) {
+  state.SetIterationTime(static_cast<double>(timer.elapsed_nanoseconds()) *
+                         1e-9);
+}
+
+// ============================================================================
+// ADD
+// ============================================================================
+
+// Limit buy that rests behind the touch
+void BM_AddPassive(benchmark::State &state) {
+  const int depth = static_cast<int>(state.range(0));
+  BenchBook bench(depth);
+  int level = 0;
+  for (auto _ : state) {
+    bench.book().add_order(Order(bench.next_id(), kLadderAccount, Side::BUY,
+                                 bid_price(level), kLot));
+    level = (level + 1) % bench.bid_levels();
+    bench.maybe_rebuild(state);
+  }
+  set_common_counters(state, depth);
+}
+BENCHMARK(BM_AddPassive)->ArgsProduct({kDepths})->ArgNames({"depth"});
+
+// Limit buy that sweeps range(1) single-order levels and does not rest
+void BM_AddCrossing(benchmark::State &state) {
+  const int depth = static_cast<int>(state.range(0));
+  const int levels = static_cast<int>(state.range(1));
+  BenchBook bench(depth);
+  Timer timer;
+  for (auto _ : state) {
+    for (int level = 0; level < levels; ++level) {
+      bench.book().add_order(Order(bench.next_id(), kLadderAccount, Side::SELL,
+                                   sweep_price(level), kLot));
+    }
+    Order taker(bench.next_id(), kTakerAccount, Side::BUY,
+                sweep_price(levels - 1), levels * kLot);
+
+    timer.start();
+    bench.book().add_order(taker);
+    timer.stop();
+
+    set_iteration_time(state, timer);
+    bench.maybe_rebuild(state);
+  }
+  set_common_counters(state, depth);
+  state.counters["levels"] = levels;
+}
+BENCHMARK(BM_AddCrossing)
+    ->ArgsProduct({kDepths, {1, 5, 50}})
+    ->ArgNames({"depth", "levels"})
+    ->UseManualTime();
+
+// ============================================================================
+// CANCEL / AMEND
+// ============================================================================
+
+// Cancel a bid at the top (0), middle (1) or back (2) of the ladder
+void BM_Cancel(benchmark::State &state) {
+  const int depth = static_cast<int>(state.range(0));
+  const int position = static_cast<int>(state.range(1));
+  BenchBook bench(depth);
+  const int levels = bench.bid_levels();
+  const int level = position == 0 ? 0 : position == 1 ? levels / 2 : levels - 1;
+  Timer timer;
+  for (auto _ : state) {
+    int id = bench.next_id();
+    bench.book().add_order(
+        Order(id, kLadderAccount, Side::BUY, bid_price(level), kLot));
+
+    timer.start();
+    bench.book().cancel_order(id);
+    timer.stop();
+
+    set_iteration_time(state, timer);
+    bench.maybe_rebuild(state);
+  }
+  set_common_counters(state, depth);
+}
+BENCHMARK(BM_Cancel)
+    ->ArgsProduct({kDepths, {0, 1, 2}})
+    ->ArgNames({"depth", "position"})
+    ->UseManualTime();
+
+// Add and cancel a bid at the touch with the flight recorder off (0) or on
+// (1); the difference is what always-on recording costs
+void BM_FlightRecorder(benchmark::State &state) {
+  const int depth = static_cast<int>(state.range(0));
+  const bool recording = state.range(1) != 0;
+  BenchBook bench(depth, recording);
+  for (auto _ : state) {
+    int id = bench.next_id();
+    bench.book().add_order(
+        Order(id, kLadderAccount, Side::BUY, bid_price(0), kLot));
+    bench.book().cancel_order(id);
+    bench.maybe_rebuild(state);
+  }
+  set_common_counters(state, depth);
+}
+BENCHMARK(BM_FlightRecorder)
+    ->ArgsProduct({{100, 10000, 1000000}, {0, 1}})
+    ->ArgNames({"depth", "recording"});
+
+// Move one bid between two mid-ladder prices
+void BM_Amend(benchmark::State &state) {
+  const int depth = static_cast<int>(state.range(0));
+  BenchBook bench(depth);
+  const int level = bench.bid_levels() / 2;
+  int id = bench.next_id();
+  bench.book().add_order(
+      Order(id, kLadderAccount, Side::BUY, bid_price(level), kLot));
+  bool moved = false;
+  for (auto _ : state) {
+    moved = !moved;
+    bench.book().amend_order(id, bid_price(moved ? level + 1 : level),
+                             std::nullopt);
+    if (bench.maybe_rebuild(state)) {
+      state.PauseTiming();
+      id = bench.next_id();
+      bench.book().add_order(
+          Order(id, kLadderAccount, Side::BUY, bid_price(level), kLot));
+      state.ResumeTiming();
+    }
+  }
+  set_common_counters(state, depth);
+}
+BENCHMARK(BM_Amend)->ArgsProduct({kDepths})->ArgNames({"depth"});
+
+// ============================================================================
+// ICEBERG / STOPS / FOK
+// ============================================================================
+
+// Take an iceberg's displayed peak, forcing a refresh from its reserve
+void BM_IcebergRefresh(benchmark::State &state) {
+  const int depth = static_cast<int>(state.range(0));
+  constexpr int kReservePeaks = 10000;
+  BenchBook bench(depth);
+  int iceberg = 0;
+  Timer timer;
+  for (auto _ : state) {
+    auto current = iceberg ? bench.book().get_order(iceberg) : std::nullopt;
+    if (!current || current->remaining_qty <= kLot) {
+      if (current) {
+        bench.book().cancel_order(iceberg);
+      }
+      iceberg = bench.next_id();
+      bench.book().add_order(Order(iceberg, kLadderAccount, Side::SELL,
+                                   sweep_price(0), kLot * kReservePeaks, kLot));
+    }
+    Order taker(bench.next_id(), kTakerAccount, Side::BUY, sweep_price(0),
+                kLot);
+
+    timer.start();
+    bench.book().add_order(taker);
+    timer.stop();
+
+    set_iteration_time(state, timer);
+    if (bench.maybe_rebuild(state)) {
+      iceberg = 0;
+    }
+  }
+  set_common_counters(state, depth);
+}
+BENCHMARK(BM_IcebergRefresh)
+    ->ArgsProduct({kDepths})
+    ->ArgNames({"depth"})
+    ->UseManualTime();
+
+// One trade at the best bid triggers range(1) stop-market sells, each of
+// which trades and re-runs the stop scan
+void BM_StopCascade(benchmark::State &state) {
+  const int depth = static_cast<int>(state.range(0));
+  const int stops = static_cast<int>(state.range(1));
+  BenchBook bench(depth);
+  Timer timer;
+  for (auto _ : state) {
+    // Lift the last trade above the stops so they rest instead of firing
+    bench.book().add_order(
+        Order(bench.next_id(), kLadderAccount, Side::SELL, sweep_price(50), 1));
+    bench.book().add_order(
+        Order(bench.next_id(), kTakerAccount, Side::BUY, sweep_price(50), 1));
+    for (int i = 0; i < stops; ++i) {
+      bench.book().add_order(Order(bench.next_id(), kStopAccount, Side::SELL,
+                                   kBestBid, kLot, true));
+    }
+    // Replace the bids the cascade will take
+    for (int i = 0; i <= stops; ++i) {
+      bench.book().add_order(
+          Order(bench.next_id(), kLadderAccount, Side::BUY, kBestBid, kLot));
+    }
+    Order trigger(bench.next_id(), kTakerAccount, Side::SELL, kBestBid, kLot);
+
+    timer.start();
+    bench.book().add_order(trigger);
+    timer.stop();
+
+    set_iteration_time(state, timer);
+    bench.maybe_rebuild(state);
+  }
+  set_common_counters(state, depth);
+  state.counters["stops"] = stops;
+}
+BENCHMARK(BM_StopCascade)
+    ->ArgsProduct({kDepths, {1, 10}})
+    ->ArgNames({"depth", "stops"})
+    ->UseManualTime();
+
+// FOK buy one lot larger than the best ask level: checked and killed,
+// leaving the book as it was
+void BM_FokCheck(benchmark::State &state) {
+  const int depth = static_cast<int>(state.range(0));
+  BenchBook bench(depth);
+  const int id = bench.next_id();
+  const int top_level_orders = std::max(1, (depth / 2 + kLevels - 1) / kLevels);
+  const int quantity = (top_level_orders + 1) * kLot;
+  for (auto _ : state) {
+    bench.book().add_order(Order(id, kTakerAccount, Side::BUY, kBestAsk,
+                                 quantity, TimeInForce::FOK));
+  }
+  set_common_counters(state, depth);
+}
+BENCHMARK(BM_FokCheck)->ArgsProduct({kDepths})->ArgNames({"depth"});
+
+// ============================================================================
+// DEPTH QUERY
+// ============================================================================
+
+// Aggregate the top 10 levels per side (print_market_depth into the muted
+// console, which skips formatting)
+void BM_DepthQuery(benchmark::State &state) {
+  const int depth = static_cast<int>(state.range(0));
+  BenchBook bench(depth);
+  for (auto _ : state) {
+    bench.book().print_market_depth(10);
+  }
+  set_common_counters(state, depth);
+}
+BENCHMARK(BM_DepthQuery)->ArgsProduct({kDepths})->ArgNames({"depth"});
+
+} // namespace
+
+// The engine logs to std::cout. Reports go to the real console through
+// their own stream, and std::cout is put in a failed state so engine
+// logging is skipped before any formatting happens.
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  std::ostream console(std::cout.rdbuf());
+  benchmark::ConsoleReporter reporter;
+  reporter.SetOutputStream(&console);
+  reporter.SetErrorStream(&std::cerr);
+  {
+    MutedOutput muted;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+  }
+  benchmark::Shutdown();
+  return 0;
+}
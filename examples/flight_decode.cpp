@@ -0,0 +1,50 @@
+// examples/flight_decode.cpp
+//
+// Prints a flight recorder dump (flight_<symbol>_<reason>_<seq>.bin), oldest
+// operation first, with times relative to the first record.
+//
+//   flight_decode <dump.bin> [--last N]
+#include "flight_recorder.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0] << " <dump.bin> [--last N]" << std::endl;
+    return 1;
+  }
+  std::size_t last = 0;
+  if (argc >= 4 && std::strcmp(argv[2], "--last") == 0) {
+    last = static_cast<std::size_t>(std::strtoull(argv[3], nullptr, 10));
+  }
+
+  try {
+    FlightDump dump = read_flight_dump(std::string(argv[1]));
+    const FlightDumpHeader &header = dump.header;
+    std::cout << "Flight recorder dump: " << header.symbol << " ("
+              << header.reason << ")\n"
+              << "  " << header.count << " of " << header.recorded
+              << " operations retained, " << header.ns_per_tick
+              << " ns/tick\n\n";
+
+    std::size_t first = 0;
+    if (last > 0 && last < dump.records.size()) {
+      first = dump.records.size() - last;
+    }
+    std::uint64_t origin =
+        dump.records.empty() ? 0 : dump.records[first].start_ticks;
+    for (std::size_t i = first; i < dump.records.size(); ++i) {
+      std::cout << format_flight_record(dump.records[i], header.ns_per_tick,
+                                        origin)
+                << '\n';
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,46 @@
+// examples/load_harness.cpp
+//
+// Open-loop capacity curve: drives the engine at increasing fixed rates
+// from a pre-generated order tape until it saturates.
+//
+//   load_harness [book|multi|sim] [measured_commands] [start_rate]
+#include "load_harness.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+int main(int argc, char *argv[]) {
+  LoadHarnessConfig config;
+  if (argc >= 2) {
+    if (std::strcmp(argv[1], "multi") == 0) {
+      config.target = LoadTarget::MULTI_SYMBOL;
+    } else if (std::strcmp(argv[1], "sim") == 0) {
+      config.target = LoadTarget::SIMULATOR;
+    } else if (std::strcmp(argv[1], "book") != 0) {
+      std::cerr << "usage: " << argv[0]
+                << " [book|multi|sim] [measured_commands] [start_rate]"
+                << std::endl;
+      return 1;
+    }
+  }
+  if (argc >= 3) {
+    config.measured_commands = std::strtoull(argv[2], nullptr, 10);
+  }
+  if (argc >= 4) {
+    config.start_rate = std::strtod(argv[3], nullptr);
+  }
+
+  try {
+    LoadHarness harness(config);
+    std::cout << "Tape: " << harness.tape().size() << " commands ("
+              << config.warmup_commands << " warmup)" << std::endl;
+    auto results = harness.run();
+    harness.print_report(results);
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
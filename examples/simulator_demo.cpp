@@ -12,7 +12,7 @@ void run_momentum_vs_mean_reversion_demo() {
   std::cout << "╚═══════════════════════════════════════════════════════╝"
             << std::endl;
 
-  TradingSimulator sim;
+  TradingSimulator sim("AAPL");
 
   // Create accounts
   sim.create_account(1001, "Momentum Trader", 1000000.0);
@@ -82,7 +82,7 @@ void run_simple_backtest_demo() {
   std::cout << "╚═══════════════════════════════════════════════════════╝"
             << std::endl;
 
-  TradingSimulator sim;
+  TradingSimulator sim("AAPL");
 
   // Single strategy test
   sim.create_account(2001, "Backtest Strategy", 500000.0);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "strategy.hpp" // for SignalType
+
+#include <cstddef>
+#include <vector>
+
+// ============================================================================
+// BATCH INDICATOR KERNELS (offline research / backtests)
+// ============================================================================
+//
+// Each kernel fills out[i] with the indicator value a streaming strategy
+// would see after prices[0..i], or 0.0 while the window is still filling.
+// Results match the scalar Strategy::calculate_* helpers to 1e-9. Windowed
+// kernels are O(n): sums slide (re-summed every `period` outputs to bound
+// drift), channel extremes use van Herk / Gil-Werman blocks, and the AVX2
+// path handles four consecutive windows per register.
+//
+// batch_ema follows Strategy::calculate_ema, which seeds from the SMA of
+// the latest window rather than the first; it therefore differs from
+// IndicatorSet::ema() once more than `period` prices have been seen.
+//
+// The AVX2 path is selected at runtime when the CPU supports it; there is
+// no need to build with -mavx2.
+
+enum class SimdLevel { SCALAR, AVX2 };
+
+SimdLevel detect_simd_level();
+SimdLevel batch_simd_level();
+void set_batch_simd_level(SimdLevel level); // Clamped to what the CPU has
+const char *simd_level_to_string(SimdLevel level);
+
+void batch_sma(const double *prices, std::size_t n, std::size_t period,
+               double *out);
+void batch_ema(const double *prices, std::size_t n, std::size_t period,
+               double *out);
+void batch_stddev(const double *prices, std::size_t n, std::size_t period,
+                  double *out);
+void batch_zscore(const double *prices, std::size_t n, std::size_t period,
+                  double *out);
+void batch_momentum(const double *prices, std::size_t n, std::size_t period,
+                    double *out);
+void batch_channel(const double *prices, std::size_t n, std::size_t period,
+                   double *out_high, double *out_low);
+
+// ============================================================================
+// BATCH SIGNAL PASSES
+// ============================================================================
+//
+// Replays a strategy's entry/exit rules over a whole price series, assuming
+// every signal fills immediately at the signalled size. Returns one
+// SignalType per price (HOLD when no signal fires).
+
+struct MomentumSignalParams {
+  std::size_t lookback_period = 20;
+  double entry_threshold = 2.0; // %
+  double exit_threshold = -0.5; // %
+  double take_profit = 5.0;     // % gain versus entry price
+  double stop_loss = 2.0;       // % loss versus entry price
+  int quantity = 100;
+};
+
+struct MeanReversionSignalParams {
+  std::size_t lookback_period = 20;
+  double entry_std_devs = 2.0;
+  double exit_std_devs = 0.5;
+  double position_size_pct = 100.0;
+};
+
+std::vector<SignalType>
+batch_momentum_signals(const std::vector<double> &prices,
+                       const MomentumSignalParams &params);
+
+std::vector<SignalType>
+batch_mean_reversion_signals(const std::vector<double> &prices,
+                             const MeanReversionSignalParams &params);
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class WorkerPool;
+
+// ============================================================================
+// P&L SERIES STATISTICS
+// ============================================================================
+
+// Metrics of one P&L path, computed exactly as PerformanceMetrics does
+// (see OnlinePnlMetrics): returns are changes over |previous P&L|, Sharpe
+// counts a return of 0 where the previous P&L is ~0 and Sortino skips
+// those periods, 252 periods a year.
+struct PnlSeriesStats {
+  double sharpe = 0.0;
+  double sortino = 0.0;
+  double max_drawdown = 0.0; // % of peak P&L
+  double total_return = 0.0; // % of |first P&L|
+  double calmar = 0.0;       // total_return / max_drawdown (0 if no drawdown)
+};
+
+PnlSeriesStats compute_pnl_stats(const double *pnl, std::size_t n);
+
+// ============================================================================
+// BLOCK BOOTSTRAP
+// ============================================================================
+
+struct BootstrapConfig {
+  std::size_t resamples = 2000;
+  // Consecutive returns per block, so serial correlation up to this lag
+  // survives resampling. Blocks wrap around the end of the series.
+  std::size_t block_length = 20;
+  double confidence = 0.95;
+  std::uint64_t seed = 1337;
+  std::size_t resamples_per_task = 64; // Unit of work for the pool
+};
+
+struct ConfidenceInterval {
+  double estimate = 0.0;  // On the original series
+  double mean = 0.0;      // Of the resamples
+  double std_error = 0.0; // Stddev of the resamples
+  double lower = 0.0;     // Percentile interval
+  double upper = 0.0;
+};
+
+struct BootstrapReport {
+  std::size_t observations = 0; // P&L changes
+  std::size_t resamples = 0;
+  std::size_t block_length = 0;
+  double confidence = 0.0;
+
+  ConfidenceInterval sharpe;
+  ConfidenceInterval sortino;
+  ConfidenceInterval max_drawdown;
+  ConfidenceInterval total_return;
+  ConfidenceInterval calmar;
+
+  void print() const;
+};
+
+// Circular block bootstrap of a P&L path. The period-over-period changes
+// are resampled in blocks and each resample is summed back into a path
+// from pnl[0], so its metrics follow the same conventions as the original.
+// Resample b draws its block starts from Philox counter range b of the
+// seed, so the report depends on the seed alone, not on the pool or its
+// thread count.
+BootstrapReport block_bootstrap(const std::vector<double> &pnl,
+                                const BootstrapConfig &config =
+                                    BootstrapConfig(),
+                                WorkerPool *pool = nullptr);
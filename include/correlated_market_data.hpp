@@ -0,0 +1,131 @@
+#pragma once
+
+#include "market_data_generator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+class OrderBook;
+
+// ============================================================================
+// CORRELATED SHOCKS
+// ============================================================================
+
+// Unit-variance shocks for n symbols with a target correlation, either
+//   - z = L e, L the Cholesky factor of an n x n correlation matrix, or
+//   - z = B f + s e, B an n x k factor loading matrix and s chosen so every
+//     symbol still has unit variance (O(n k) per draw instead of O(n^2)).
+// Both are applied as saxpy passes over a contiguous row of the transposed
+// matrix, one per independent normal, which the compiler vectorizes.
+class CorrelatedShockGenerator {
+private:
+  std::size_t symbols_;
+  std::size_t sources_;         // Independent normals per draw
+  std::vector<double> columns_; // sources_ x symbols_, row-major
+  std::vector<double> idiosyncratic_; // Factor model only
+  std::vector<double> normals_;       // Scratch, grown on demand
+  std::mt19937_64 rng_;
+  std::uniform_real_distribution<double> uniform01_;
+
+  CorrelatedShockGenerator(std::size_t symbols, std::size_t sources,
+                           std::uint64_t seed);
+  void fill_normals(std::size_t count);
+  void combine(const double *normals, double *out) const;
+
+public:
+  // Row-major n x n correlation matrix; throws if it is not symmetric with
+  // a unit diagonal and positive definite
+  static CorrelatedShockGenerator
+  from_correlation(std::size_t symbols, const std::vector<double> &correlation,
+                   std::uint64_t seed = 1337);
+
+  // Row-major n x k loadings; every row must have a norm of at most 1
+  static CorrelatedShockGenerator
+  from_factors(std::size_t symbols, std::size_t factors,
+               const std::vector<double> &loadings, std::uint64_t seed = 1337);
+
+  // Independent symbols
+  static CorrelatedShockGenerator independent(std::size_t symbols,
+                                              std::uint64_t seed = 1337);
+
+  std::size_t symbols() const { return symbols_; }
+
+  // One draw: out[i] for symbol i
+  void next(double *out);
+
+  // `steps` draws in one batch: out[s * symbols() + i]
+  void generate(std::size_t steps, double *out);
+
+  // Correlation implied by the model, row-major n x n
+  std::vector<double> implied_correlation() const;
+};
+
+// ============================================================================
+// MULTI-ASSET GENERATOR
+// ============================================================================
+
+// A universe of MarketDataGenerators, one per symbol, whose mids move
+// together. Each symbol keeps its own tick size, spread, volatility and
+// liquidity settings from its MarketDataGenerator::Config; only the
+// unit-variance shock driving the mid is shared through the model.
+class MultiAssetMarketDataGenerator {
+public:
+  struct Config {
+    std::vector<MarketDataGenerator::Config> symbols;
+
+    // Correlation model, in order of precedence: factor loadings
+    // (symbols x factors, row-major), a full correlation matrix
+    // (symbols x symbols, row-major), else independent symbols
+    std::size_t factors = 0;
+    std::vector<double> loadings;
+    std::vector<double> correlation;
+
+    std::uint64_t seed = 1337;
+
+    Config() = default;
+  };
+
+  using SnapshotCallback =
+      std::function<void(std::size_t symbol, const MarketDataSnapshot &)>;
+
+  explicit MultiAssetMarketDataGenerator(const Config &config);
+
+  std::size_t size() const { return generators_.size(); }
+  MarketDataGenerator &generator(std::size_t symbol) {
+    return *generators_[symbol];
+  }
+
+  // Per-symbol callbacks go on generator(i); these see every symbol
+  void register_callback(SnapshotCallback callback);
+  void clear_callbacks() { callbacks_.clear(); }
+  void set_clock(const SimClock &clock);
+
+  // One step for every symbol; the returned snapshots are reused
+  const std::vector<MarketDataSnapshot> &next_snapshots();
+
+  // `steps` steps with all shocks drawn up front: result[s * size() + i]
+  std::vector<MarketDataSnapshot> generate_series(std::size_t steps);
+
+  // One step with liquidity into books[i] (nullptr skips a symbol)
+  void step(const std::vector<OrderBook *> &books,
+            double market_order_probability = 0.25);
+
+  const Config &config() const { return config_; }
+  CorrelatedShockGenerator &shocks() { return shocks_; }
+
+private:
+  Config config_;
+  std::vector<std::unique_ptr<MarketDataGenerator>> generators_;
+  CorrelatedShockGenerator shocks_;
+  std::vector<double> shock_buffer_;
+  std::vector<MarketDataSnapshot> snapshots_;
+  std::vector<SnapshotCallback> callbacks_;
+};
+
+// Shock model described by a universe config
+CorrelatedShockGenerator
+make_shock_generator(const MultiAssetMarketDataGenerator::Config &config);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// ============================================================================
+// COUNTER-BASED PRNG (Philox4x32-10)
+// ============================================================================
+
+// Output is a pure function of (key, counter), so any element of any
+// stream can be produced without generating the ones before it. Streams
+// are split by key; each stream walks its own counter.
+struct Philox4x32 {
+  using Block = std::array<std::uint32_t, 4>;
+
+  static Block generate(std::uint64_t counter_lo, std::uint64_t counter_hi,
+                        std::uint64_t key);
+};
+
+// Sequential view of one Philox stream
+class CounterRng {
+private:
+  std::uint64_t key_;
+  std::uint64_t counter_;
+  Philox4x32::Block block_;
+  unsigned used_; // Words of block_ already handed out
+
+public:
+  explicit CounterRng(std::uint64_t key, std::uint64_t counter = 0)
+      : key_(key), counter_(counter), block_{}, used_(4) {}
+
+  std::uint32_t next_u32() {
+    if (used_ == 4) {
+      block_ = Philox4x32::generate(counter_++, 0, key_);
+      used_ = 0;
+    }
+    return block_[used_++];
+  }
+
+  // Uniform in [0, 1)
+  double uniform() { return next_u32() * (1.0 / 4294967296.0); }
+
+  // Uniform in [0, n)
+  std::uint32_t below(std::uint32_t n) {
+    return static_cast<std::uint32_t>(
+        (static_cast<std::uint64_t>(next_u32()) * n) >> 32);
+  }
+};
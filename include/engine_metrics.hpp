@@ -0,0 +1,256 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// SEGMENT LAYOUT
+// ============================================================================
+
+// Everything a monitor reads lives in one flat block that is either
+// process-private memory or a POSIX shared-memory segment:
+//
+//   MetricsSegmentHeader
+//   MetricSlot[slot_capacity]            (64 bytes each)
+//   MetricHistogramBlock[histogram_capacity]
+//
+// Slots are appended and never move. A writer fills a slot, then bumps
+// slot_count with release ordering; readers load slot_count with acquire
+// and may read any slot below it. Values are 64-bit lock-free atomics, so
+// neither side takes a lock or makes a syscall after setup.
+
+enum class MetricKind : std::uint32_t { COUNTER, GAUGE, HISTOGRAM };
+
+constexpr std::size_t kMetricNameSize = 48;
+constexpr std::size_t kMetricHistogramBuckets = 64;
+constexpr std::uint32_t kMetricsLayoutVersion = 1;
+constexpr std::uint64_t kMetricsMagic = 0x315254454D474E45; // "ENGMETR1"
+
+// The writer fills in everything else, then publishes magic with a release
+// store; a reader that loads it with acquire sees a complete header
+struct MetricsSegmentHeader {
+  std::atomic<std::uint64_t> magic;
+  std::uint32_t version;
+  std::uint32_t header_size;
+  std::uint32_t slot_size;
+  std::uint32_t histogram_size;
+  std::uint32_t slot_capacity;
+  std::uint32_t histogram_capacity;
+  std::uint64_t slots_offset;
+  std::uint64_t histograms_offset;
+  std::uint64_t total_size;
+  std::int64_t writer_pid;
+  std::atomic<std::uint32_t> slot_count;
+  std::atomic<std::uint32_t> histogram_count;
+};
+
+struct MetricSlot {
+  char name[kMetricNameSize];
+  MetricKind kind;
+  std::uint32_t histogram; // Block index for histograms
+  // Counter total or gauge level; unused for histograms
+  std::atomic<std::int64_t> value;
+};
+
+// Power-of-two buckets: bucket 0 holds 0, bucket i holds [2^(i-1), 2^i)
+struct MetricHistogramBlock {
+  std::atomic<std::uint64_t> count;
+  std::atomic<std::uint64_t> sum;
+  std::atomic<std::uint64_t> buckets[kMetricHistogramBuckets];
+};
+
+static_assert(sizeof(MetricSlot) == 64, "MetricSlot is part of the layout");
+static_assert(std::atomic<std::int64_t>::is_always_lock_free,
+              "Shared metrics need lock-free 64-bit atomics");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free,
+              "Shared metrics need lock-free 32-bit atomics");
+
+// ============================================================================
+// HANDLES
+// ============================================================================
+
+// Cheap copyable handles into the segment; a default-constructed handle
+// points at a private dummy so unregistered code paths stay branch-free.
+class Counter {
+private:
+  std::atomic<std::int64_t> *value_;
+
+public:
+  Counter();
+  explicit Counter(std::atomic<std::int64_t> *value) : value_(value) {}
+
+  void inc(std::int64_t n = 1) {
+    value_->fetch_add(n, std::memory_order_relaxed);
+  }
+  std::int64_t value() const {
+    return value_->load(std::memory_order_relaxed);
+  }
+};
+
+class Gauge {
+private:
+  std::atomic<std::int64_t> *value_;
+
+public:
+  Gauge();
+  explicit Gauge(std::atomic<std::int64_t> *value) : value_(value) {}
+
+  void set(std::int64_t v) { value_->store(v, std::memory_order_relaxed); }
+  void add(std::int64_t n) { value_->fetch_add(n, std::memory_order_relaxed); }
+  std::int64_t value() const {
+    return value_->load(std::memory_order_relaxed);
+  }
+};
+
+class Histogram {
+private:
+  MetricHistogramBlock *block_;
+
+public:
+  Histogram();
+  explicit Histogram(MetricHistogramBlock *block) : block_(block) {}
+
+  void record(std::uint64_t value) {
+    std::size_t bucket =
+        value == 0 ? 0 : 64 - static_cast<std::size_t>(__builtin_clzll(value));
+    if (bucket >= kMetricHistogramBuckets) {
+      bucket = kMetricHistogramBuckets - 1;
+    }
+    block_->buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    block_->count.fetch_add(1, std::memory_order_relaxed);
+    block_->sum.fetch_add(value, std::memory_order_relaxed);
+  }
+  std::uint64_t count() const {
+    return block_->count.load(std::memory_order_relaxed);
+  }
+};
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
+class MetricsRegistry {
+public:
+  struct Config {
+    // POSIX shared-memory name ("/engine_metrics"); empty keeps the
+    // segment private to the process
+    std::string shm_name;
+    std::size_t slot_capacity = 512;
+    std::size_t histogram_capacity = 32;
+
+    Config() = default;
+  };
+
+  MetricsRegistry();
+  explicit MetricsRegistry(const Config &config);
+  // Unmaps, and unlinks the segment it created unless a newer registry
+  // has taken over the name
+  ~MetricsRegistry();
+  MetricsRegistry(const MetricsRegistry &) = delete;
+  MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+  // Registering an existing name returns the same metric; a name in use
+  // with another kind, or a full segment, throws
+  Counter counter(const std::string &name);
+  Gauge gauge(const std::string &name);
+  Histogram histogram(const std::string &name);
+
+  std::size_t size() const;
+  bool is_shared() const { return !config_.shm_name.empty(); }
+  const MetricsSegmentHeader &header() const { return *header_; }
+
+  void print() const;
+
+private:
+  Config config_;
+  void *base_;
+  std::size_t size_;
+  std::uint64_t segment_inode_; // Identifies our shared segment, 0 = none
+  MetricsSegmentHeader *header_;
+  MetricSlot *slots_;
+  MetricHistogramBlock *histograms_;
+
+  std::mutex mutex_; // Registration only
+  std::unordered_map<std::string, std::uint32_t> index_;
+
+  MetricSlot &register_slot(const std::string &name, MetricKind kind);
+};
+
+// ============================================================================
+// READER
+// ============================================================================
+
+struct MetricSample {
+  std::string name;
+  MetricKind kind;
+  std::int64_t value = 0; // Counter / gauge
+  std::uint64_t count = 0; // Histogram
+  std::uint64_t sum = 0;
+  std::vector<std::uint64_t> buckets;
+
+  // Upper bound of the bucket holding quantile q of a histogram
+  std::uint64_t quantile_bound(double q) const;
+};
+
+// Read-only view of a published segment, for a monitoring process
+class MetricsReader {
+public:
+  explicit MetricsReader(const std::string &shm_name);
+  ~MetricsReader();
+  MetricsReader(const MetricsReader &) = delete;
+  MetricsReader &operator=(const MetricsReader &) = delete;
+
+  std::size_t size() const;
+  std::vector<MetricSample> sample() const;
+  // Counter or gauge value by name
+  std::optional<std::int64_t> value(const std::string &name) const;
+  std::int64_t writer_pid() const { return header_->writer_pid; }
+
+private:
+  const void *base_;
+  std::size_t size_;
+  const MetricsSegmentHeader *header_;
+};
+
+// ============================================================================
+// ORDER BOOK METRICS
+// ============================================================================
+
+// What an OrderBook publishes, registered under `prefix` ("book.AAPL")
+struct OrderBookMetrics {
+  // Orders in, by type
+  Counter limit_orders;
+  Counter market_orders;
+  Counter iceberg_orders;
+  Counter stop_orders;
+  Counter amends;
+
+  // Orders out, by reason
+  Counter filled;
+  Counter cancelled;
+  Counter expired; // IOC / market remainders that could not rest
+  Counter killed;  // FOK without enough liquidity
+
+  Counter rejects; // Cancels / amends of unknown or filled orders
+  Counter fills;
+  Counter fill_volume;
+  Counter self_trades_prevented;
+  Counter stale_skipped; // Cancelled / filled copies popped while matching
+  Counter stop_triggers;
+
+  // Heap sizes include stale copies not yet popped
+  Gauge bid_queue_depth;
+  Gauge ask_queue_depth;
+  Gauge tracked_orders; // active_orders_ entries
+  Gauge pending_stops;
+
+  Histogram add_latency_ns;
+
+  OrderBookMetrics(MetricsRegistry &registry, const std::string &prefix);
+};
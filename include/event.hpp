@@ -2,6 +2,7 @@
 
 #include "types.hpp"
 #include <optional>
+#include <stdexcept>
 #include <string>
 
 enum class EventType {
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "event.hpp"
+
+#include <cstddef>
+#include <fstream>
+#include <optional>
+#include <string>
+
+class OrderBook;
+
+// ============================================================================
+// EVENT LOG STREAMING
+// ============================================================================
+
+// Reads an event log (the CSV written by OrderBook::save_events()) one
+// event at a time, so logs of any length replay in constant memory.
+class EventLogReader {
+private:
+  std::string filename_;
+  std::ifstream file_;
+  std::string line_; // Reused for every line
+  std::size_t events_read_;
+
+public:
+  explicit EventLogReader(const std::string &filename);
+
+  // Next event, or nullopt at end of file
+  std::optional<OrderEvent> next();
+
+  std::size_t events_read() const { return events_read_; }
+  const std::string &filename() const { return filename_; }
+};
+
+// Apply one logged event to `book`. FILL records are the book's own output
+// and are ignored; replaying the orders regenerates them.
+void apply_event(OrderBook &book, const OrderEvent &event);
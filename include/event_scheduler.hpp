@@ -0,0 +1,88 @@
+#pragma once
+
+#include "sim_clock.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// ============================================================================
+// DISCRETE-EVENT SCHEDULER
+// ============================================================================
+
+enum class SimEventType {
+  MARKET_DATA,       // Book snapshot / simulator step / delayed update
+  ORDER_ARRIVAL,     // External or delayed strategy order reaching the book
+  TIMER,             // Periodic strategy timers
+  STRATEGY_WAKEUP,   // One-off wakeup requested for a strategy
+  FILL_NOTIFICATION, // Delayed execution report reaching a strategy
+  CUSTOM,
+};
+
+constexpr std::size_t SIM_EVENT_TYPE_COUNT = 6;
+
+// Timestamp-ordered event queue driving a VirtualClock. Running an event
+// first jumps the clock to its time, so idle gaps cost nothing. Events at
+// the same time run in the order they were scheduled, which keeps runs
+// reproducible.
+class EventScheduler {
+public:
+  using EventId = std::uint64_t;
+  using Action = std::function<void()>;
+
+private:
+  struct Entry {
+    TimePoint time;
+    EventId id; // Also the FIFO tie-breaker
+    SimEventType type;
+    Action action; // Empty once cancelled
+  };
+
+  struct Later {
+    bool operator()(const Entry &a, const Entry &b) const {
+      return a.time != b.time ? a.time > b.time : a.id > b.id;
+    }
+  };
+
+  VirtualClock &clock_;
+  std::vector<Entry> heap_; // Binary min-heap on (time, id)
+  std::size_t pending_;     // Queued and not cancelled
+  EventId next_id_;
+  std::uint64_t events_run_;
+  std::uint64_t events_run_by_type_[SIM_EVENT_TYPE_COUNT];
+
+  void discard_cancelled();
+
+public:
+  explicit EventScheduler(VirtualClock &clock);
+
+  // Events in the past are clamped to "now"
+  EventId schedule_at(TimePoint time, SimEventType type, Action action);
+  EventId schedule_after(Duration delay, SimEventType type, Action action) {
+    return schedule_at(clock_.now() + delay, type, std::move(action));
+  }
+  // O(pending); meant for the occasional timer, not the hot path.
+  // Returns false if the event already ran or was cancelled.
+  bool cancel(EventId id);
+
+  bool empty();
+  std::size_t pending() const { return pending_; }
+  TimePoint next_time(); // Only valid when !empty()
+
+  // Run the earliest event. Returns false when nothing is pending.
+  bool run_next();
+
+  // Run every event up to and including `end`, then leave the clock at
+  // `end`. Returns the number of events run.
+  std::size_t run_until(TimePoint end);
+
+  // Run until the queue drains or `max_events` have run
+  std::size_t run(std::size_t max_events = SIZE_MAX);
+
+  std::uint64_t events_run() const { return events_run_; }
+  std::uint64_t events_run(SimEventType type) const {
+    return events_run_by_type_[static_cast<std::size_t>(type)];
+  }
+  const VirtualClock &clock() const { return clock_; }
+};
@@ -3,6 +3,7 @@
 
 #include "fill.hpp"
 #include "order.hpp"
+#include "order_trace.hpp"
 #include "types.hpp"
 #include <functional>
 #include <unordered_map>
@@ -74,11 +75,13 @@ private:
   uint64_t self_trades_prevented_;
   uint64_t total_fills_routed_;
 
+  OrderPathTracer *tracer_; // Owned by the order book, may be null
+
 public:
   FillRouter(bool prevent_self_trades = true)
       : next_fill_id_(1), prevent_self_trades_(prevent_self_trades),
         enable_fees_(false), maker_fee_rate_(0.0), taker_fee_rate_(0.0),
-        self_trades_prevented_(0), total_fills_routed_(0) {}
+        self_trades_prevented_(0), total_fills_routed_(0), tracer_(nullptr) {}
 
   // Configuration
   void set_self_trade_prevention(bool enable) { prevent_self_trades_ = enable; }
@@ -97,6 +100,8 @@ public:
     self_trade_callbacks_.push_back(callback);
   }
 
+  void set_tracer(OrderPathTracer *tracer) { tracer_ = tracer; }
+
   // Main routing function
   bool route_fill(const Fill &fill, const Order &aggressive_order,
                   const Order &passive_order, const std::string &symbol);
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// ============================================================================
+// RECORD FORMAT
+// ============================================================================
+
+enum class FlightOp : std::uint8_t { ADD, CANCEL, AMEND, FILL };
+
+enum class FlightOutcome : std::uint8_t {
+  PENDING,   // Stop waiting for its trigger
+  RESTED,    // In the book, nothing filled
+  PARTIAL,   // Partly filled, remainder resting
+  FILLED,
+  CANCELLED, // Cancelled, killed or expired
+  REJECTED,  // Unknown / already filled order, self-trade
+  EXECUTED,  // FILL records
+};
+
+// One operation, 64 bytes, dumped as-is (little-endian hosts)
+struct FlightRecord {
+  std::uint64_t sequence;
+  std::uint64_t start_ticks; // TscClock
+  std::uint32_t duration_ticks;
+  std::int32_t order_id;    // Aggressive order for fills
+  std::int32_t other_id;    // Account for commands, passive order for fills
+  std::int32_t quantity;    // Command or fill quantity
+  std::int32_t leaves;      // Remaining quantity after the operation
+  FlightOp op;
+  std::uint8_t side;        // 0 = BUY, 1 = SELL
+  std::uint8_t order_flags; // kFlight* bits
+  FlightOutcome outcome;
+  double price;             // Limit / amend / fill price, 0 if none
+  double best_bid;          // Top of book after, 0 if empty
+  double best_ask;
+};
+
+constexpr std::uint8_t kFlightMarket = 1;
+constexpr std::uint8_t kFlightIceberg = 2;
+constexpr std::uint8_t kFlightStop = 4;
+constexpr std::uint8_t kFlightIoc = 8;
+constexpr std::uint8_t kFlightFok = 16;
+
+static_assert(sizeof(FlightRecord) == 64, "FlightRecord must stay 64 bytes");
+static_assert(std::is_trivially_copyable<FlightRecord>::value,
+              "FlightRecord is written with raw I/O");
+
+struct FlightDumpHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t record_size;
+  std::uint64_t count;    // Records that follow, oldest first
+  std::uint64_t recorded; // Total ever recorded
+  double ns_per_tick;
+  char symbol[16];
+  char reason[32];
+};
+
+const char *to_string(FlightOp op);
+const char *to_string(FlightOutcome outcome);
+
+// ============================================================================
+// FLIGHT RECORDER
+// ============================================================================
+
+// Overwrite-oldest ring of the last N operations on one book. Recording is
+// a 64-byte store into preallocated memory; nothing is formatted until the
+// ring is dumped. Dumps happen on demand, when a signal installed with
+// install_signal_handler() arrives (picked up at the next record), or
+// automatically when an operation exceeds the latency trigger or leaves
+// the book crossed. After an automatic dump, the next one waits until the
+// ring has turned over once, so each dump holds fresh history. Automatic
+// and signal dumps only write files once a dump_directory is configured.
+class FlightRecorder {
+public:
+  struct Config {
+    std::size_t capacity = 1024; // Rounded up to a power of two
+    long long latency_trigger_ns = 0; // 0 = off
+    bool check_invariants = true;     // Dump when the book ends up crossed
+    std::string dump_directory; // Empty = no automatic or signal dumps
+    std::string symbol;
+
+    Config() = default;
+  };
+
+  FlightRecorder();
+  explicit FlightRecorder(const Config &config);
+
+  void record(const FlightRecord &entry);
+
+  std::uint64_t recorded() const { return next_sequence_; }
+  std::size_t capacity() const { return mask_ + 1; }
+  const Config &config() const { return config_; }
+
+  // Retained records, oldest first
+  std::vector<FlightRecord> records() const;
+
+  void dump(std::ostream &out, const std::string &reason = "manual") const;
+  // Writes <dump_directory>/flight_<symbol>_<reason>_<sequence>.bin;
+  // throws if no directory is configured
+  std::string dump_to_file(const std::string &reason = "manual") const;
+
+  // Files written by automatic and signal dumps
+  const std::vector<std::string> &dump_files() const { return dump_files_; }
+
+  // SIGUSR1 (or `signal`) asks every recorder to dump at its next record
+  static void install_signal_handler(int signal);
+  static void request_dump(); // Same, from code
+
+private:
+  Config config_;
+  std::unique_ptr<FlightRecord[]> ring_;
+  std::uint64_t mask_;
+  std::uint64_t next_sequence_;
+  std::uint64_t auto_dump_after_; // No automatic dump before this sequence
+  std::uint64_t seen_requests_;
+  std::vector<std::string> dump_files_;
+
+  void maybe_trigger(const FlightRecord &entry);
+  void dump_now(const char *reason);
+};
+
+// ============================================================================
+// OFFLINE DECODING
+// ============================================================================
+
+struct FlightDump {
+  FlightDumpHeader header;
+  std::vector<FlightRecord> records;
+};
+
+FlightDump read_flight_dump(std::istream &in);
+FlightDump read_flight_dump(const std::string &filename);
+
+// One human-readable line per record, times relative to `origin_ticks`
+std::string format_flight_record(const FlightRecord &record,
+                                 double ns_per_tick,
+                                 std::uint64_t origin_ticks);
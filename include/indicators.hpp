@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// INDICATOR TYPES
+// ============================================================================
+
+enum class IndicatorType {
+  SMA,      // Simple moving average
+  EMA,      // Exponential moving average (seeded with the first SMA)
+  STDDEV,   // Rolling population standard deviation
+  MOMENTUM, // % change versus the price `period` samples ago
+  CHANNEL,  // Rolling high / low
+};
+
+// ============================================================================
+// ROLLING MEAN / VARIANCE
+// ============================================================================
+
+// Mean and population variance over a fixed window, updated in O(1) per
+// sample. Uses the add/replace form of Welford's update rather than raw
+// sum / sum-of-squares so variance stays accurate for prices far from zero.
+class RollingStats {
+private:
+  std::size_t period_;
+  std::size_t count_;
+  double mean_;
+  double m2_;
+
+public:
+  explicit RollingStats(std::size_t period = 1);
+
+  // Window still filling: add a sample
+  void add(double value);
+
+  // Window full: evict `old_value` and admit `new_value`
+  void replace(double old_value, double new_value);
+
+  void reset();
+
+  std::size_t period() const { return period_; }
+  std::size_t count() const { return count_; }
+  bool is_ready() const { return count_ >= period_; }
+
+  double mean() const { return count_ == 0 ? 0.0 : mean_; }
+  double variance() const;
+  double stddev() const;
+};
+
+// ============================================================================
+// INDICATOR SET
+// ============================================================================
+
+// All subscribed indicators for a single instrument. Each call to update()
+// advances every subscription in O(1) (amortized O(1) for channels), so
+// strategies read precomputed values instead of rescanning price history.
+//
+// Indicators return 0.0 until enough samples have been seen, matching the
+// Strategy::calculate_* helpers.
+class IndicatorSet {
+private:
+  struct EmaState {
+    std::size_t period;
+    double alpha;
+    std::size_t count;
+    double seed_sum;
+    double value;
+  };
+
+  struct ChannelState {
+    std::size_t period;
+    std::size_t count;
+    std::deque<std::pair<std::uint64_t, double>> highs; // decreasing values
+    std::deque<std::pair<std::uint64_t, double>> lows;  // increasing values
+  };
+
+  // Subscriptions (a handful per strategy, so linear lookup is fine)
+  std::vector<RollingStats> stats_; // SMA + STDDEV share a window
+  std::vector<EmaState> emas_;
+  std::vector<std::size_t> momentum_periods_;
+  std::vector<ChannelState> channels_;
+
+  // Shared window of recent prices (capacity = longest lookback + 1)
+  std::vector<double> window_;
+  std::size_t head_; // Slot the next price will be written to
+  std::uint64_t samples_seen_;
+  std::size_t valid_; // Prices currently held in window_
+
+  void grow_window(std::size_t capacity);
+  double lag(std::size_t k) const; // k = 0 is the most recent price
+
+  const RollingStats *find_stats(std::size_t period) const;
+  const EmaState *find_ema(std::size_t period) const;
+  const ChannelState *find_channel(std::size_t period) const;
+
+public:
+  IndicatorSet();
+
+  // Subscriptions should be made before the first update(); a subscription
+  // added later only sees prices from that point on.
+  void subscribe(IndicatorType type, std::size_t period);
+  bool is_subscribed(IndicatorType type, std::size_t period) const;
+
+  void update(double price);
+  void reset(); // Drop all samples but keep subscriptions
+
+  // ==================================================================
+  // QUERIES
+  // ==================================================================
+
+  std::uint64_t count() const { return samples_seen_; }
+  bool is_ready(IndicatorType type, std::size_t period) const;
+  double last() const { return samples_seen_ == 0 ? 0.0 : lag(0); }
+
+  double sma(std::size_t period) const;
+  double ema(std::size_t period) const;
+  double variance(std::size_t period) const;
+  double stddev(std::size_t period) const;
+  double momentum(std::size_t period) const;
+  double rolling_high(std::size_t period) const;
+  double rolling_low(std::size_t period) const;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "sim_clock.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+struct StrategyConfig;
+
+// ============================================================================
+// LATENCY PATHS
+// ============================================================================
+
+enum class LatencyPath {
+  MARKET_DATA,       // Book update -> strategy
+  ORDER_ENTRY,       // Strategy order / quote -> book
+  FILL_NOTIFICATION, // Execution -> strategy
+};
+
+constexpr std::size_t LATENCY_PATH_COUNT = 3;
+
+const char *latency_path_to_string(LatencyPath path);
+
+// ============================================================================
+// LATENCY MODELS
+// ============================================================================
+
+// Delay applied to one message. `in_flight` is the number of messages
+// already queued on the same path for the same strategy, so models can
+// charge for load.
+class LatencyModel {
+public:
+  virtual ~LatencyModel() = default;
+  virtual Duration sample(std::size_t in_flight) = 0;
+};
+
+class FixedLatency : public LatencyModel {
+private:
+  Duration latency_;
+
+public:
+  explicit FixedLatency(Duration latency);
+  Duration sample(std::size_t) override { return latency_; }
+};
+
+// Log-normal around a median, the usual shape of measured network and
+// gateway latencies (long right tail, never negative). Seeded, so runs
+// are reproducible.
+class LogNormalLatency : public LatencyModel {
+private:
+  std::mt19937_64 rng_;
+  std::lognormal_distribution<double> dist_; // In nanoseconds
+
+public:
+  LogNormalLatency(Duration median, double sigma, std::uint64_t seed);
+  Duration sample(std::size_t) override;
+};
+
+// Base latency plus a per-message cost for everything already queued
+// ahead, capped at `max_latency` (0 = uncapped)
+class QueueLoadLatency : public LatencyModel {
+private:
+  std::unique_ptr<LatencyModel> base_;
+  Duration per_message_;
+  Duration max_latency_;
+
+public:
+  QueueLoadLatency(std::unique_ptr<LatencyModel> base, Duration per_message,
+                   Duration max_latency = Duration::zero());
+  Duration sample(std::size_t in_flight) override;
+};
+
+// Builds a path's model from strategy parameters, or returns nullptr when
+// the path has no latency configured. With prefix "md", "order" or "fill":
+//   <prefix>_latency_us          fixed latency, or median when sampled
+//   <prefix>_latency_sigma       > 0 samples log-normally around the median
+//   <prefix>_latency_per_msg_us  added per message already in flight
+//   <prefix>_latency_max_us      cap for the load-dependent model
+//   latency_seed                 RNG seed (defaults to the account id)
+std::unique_ptr<LatencyModel> make_latency_model(const StrategyConfig &config,
+                                                 LatencyPath path);
+
+// ============================================================================
+// DELAY QUEUE
+// ============================================================================
+
+// Messages in flight on one path. Delivery is FIFO, like a single TCP
+// session: a message never overtakes the one sent before it, so a sampled
+// due time earlier than the previous message's is pushed back to it.
+// Because the head is always the next due message, the simulator keeps at
+// most one scheduler event per queue, however many messages are in flight.
+template <typename T> class DelayQueue {
+private:
+  std::deque<std::pair<TimePoint, T>> queue_;
+  TimePoint last_due_;
+
+public:
+  // Returns true when the queue was empty, i.e. the caller must schedule a
+  // release at next_due()
+  bool push(TimePoint due, T item) {
+    bool was_empty = queue_.empty();
+    last_due_ = std::max(due, last_due_);
+    queue_.emplace_back(last_due_, std::move(item));
+    return was_empty;
+  }
+
+  bool empty() const { return queue_.empty(); }
+  std::size_t size() const { return queue_.size(); }
+  TimePoint next_due() const { return queue_.front().first; }
+
+  // Hand every message due at or before `now` to `deliver`, in order.
+  // `deliver` may push more messages.
+  template <typename Deliver>
+  std::size_t release(TimePoint now, Deliver &&deliver) {
+    std::size_t count = 0;
+    while (!queue_.empty() && queue_.front().first <= now) {
+      T item = std::move(queue_.front().second);
+      queue_.pop_front();
+      deliver(item);
+      ++count;
+    }
+    return count;
+  }
+};
@@ -1,15 +1,77 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
 #include <vector>
 
+// Fixed-memory log-linear latency histogram. Values below 2^(bits + 1) are
+// counted exactly; above that every power of two is split into 2^bits
+// equal sub-buckets, so any recorded value is known to within a relative
+// error of 2^-bits. Recording is O(1) and allocation-free; percentiles
+// walk the buckets without sorting anything.
+//
+// Trackers with the same Config merge bucket by bucket, so each thread
+// (or each reporting interval) can keep its own and combine them later.
 class LatencyTracker {
-private:
-  std::vector<long long> latencies_;
+public:
+  struct Config {
+    int precision_bits = 7;                    // 2^-7 ~ 0.8% error
+    long long max_value_ns = 60'000'000'000LL; // Larger values saturate
 
-  long long percentile(double p);
-  void print_histogram();
+    Config() = default;
+  };
 
-public:
-  void record(long long latency_ns);
-  void print_statistics();
+  LatencyTracker();
+  explicit LatencyTracker(const Config &config);
+
+  // Negative latencies count as 0, values above max_value_ns as max_value_ns
+  void record(long long latency_ns) { record_n(latency_ns, 1); }
+  void record_n(long long latency_ns, std::uint64_t count);
+
+  // Adds `other`'s samples; throws unless both share a Config
+  void merge(const LatencyTracker &other);
+
+  // Forget all samples, keeping the buckets allocated
+  void reset();
+
+  // Current contents, leaving this tracker empty for the next interval
+  LatencyTracker take_interval();
+
+  // p in [0, 100]: the highest value equivalent to the bucket holding the
+  // sample of that rank, clamped to the exact min / max
+  long long percentile(double p) const;
+
+  std::uint64_t count() const { return total_; }
+  std::uint64_t saturated() const { return saturated_; }
+  long long min() const { return total_ ? min_ : 0; }
+  long long max() const { return total_ ? max_ : 0; }
+  double mean() const;
+
+  const Config &config() const { return config_; }
+  std::size_t bucket_count() const { return counts_.size(); }
+  double relative_error() const;
+
+  // Bucket holding `value`, and the values bucket `index` stands for
+  std::size_t bucket_index(long long value) const;
+  long long bucket_lower(std::size_t index) const;
+  long long bucket_upper(std::size_t index) const; // Inclusive
+
+  // Compact binary form: header plus only the non-empty buckets
+  void serialize(std::ostream &out) const;
+  static LatencyTracker deserialize(std::istream &in);
+
+  void print_statistics() const;
+
+private:
+  Config config_;
+  std::uint64_t sub_buckets_; // 2^precision_bits
+  std::vector<std::uint64_t> counts_;
+  std::uint64_t total_;
+  std::uint64_t saturated_;
+  long long min_;
+  long long max_;
+  double sum_;
+
+  void print_histogram() const;
 };
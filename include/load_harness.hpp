@@ -0,0 +1,107 @@
+#pragma once
+
+#include "latency_tracker.hpp"
+#include "order_tape.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// OPEN-LOOP RUN
+// ============================================================================
+
+// Command i of a run is due at start + i / rate whether or not the engine
+// has finished command i - 1. Response time is measured from that intended
+// send time, so a stall is charged to every command queued behind it
+// instead of silently delaying their sends (coordinated omission). Service
+// time, from the actual send, is what a closed loop would have reported.
+struct LoadRunResult {
+  double offered_rate = 0.0;  // Commands per second
+  double achieved_rate = 0.0; // Measured commands / elapsed
+  std::uint64_t commands = 0; // Measured (after warmup)
+  long long max_lag_ns = 0;   // Worst send delay behind schedule
+  bool sustained = false;
+  LatencyTracker response; // From intended send time
+  LatencyTracker service;  // From actual send time
+};
+
+using CommandSink = std::function<void(const TapeCommand &)>;
+
+// Replays `tape` into `sink` at `rate` commands per second from one
+// thread, spinning until each command is due (or sending at once when
+// behind). The first `warmup` commands run on schedule but are not
+// measured.
+LoadRunResult
+run_open_loop(const std::vector<TapeCommand> &tape, double rate,
+              std::size_t warmup, const CommandSink &sink,
+              const LatencyTracker::Config &histogram = LatencyTracker::Config());
+
+// ============================================================================
+// LOAD HARNESS
+// ============================================================================
+
+enum class LoadTarget {
+  SINGLE_BOOK,  // One OrderBook
+  MULTI_SYMBOL, // `symbols` books, command routed by order ID
+  SIMULATOR,    // TradingSimulator venues via its event scheduler, with
+                // fills reaching positions; virtual time follows the
+                // commands' due times
+};
+
+struct LoadHarnessConfig {
+  LoadTarget target = LoadTarget::SINGLE_BOOK;
+  std::size_t symbols = 4; // MULTI_SYMBOL / SIMULATOR
+
+  OrderTapeConfig tape; // commands is overridden to warmup + measured
+  std::uint64_t warmup_commands = 20000;
+  std::uint64_t measured_commands = 200000;
+
+  // Explicit offered loads; when empty, a geometric sweep from start_rate
+  // multiplying by rate_step for at most max_runs loads
+  std::vector<double> offered_rates;
+  double start_rate = 50000.0;
+  double rate_step = 2.0;
+  std::size_t max_runs = 12;
+
+  // A load is sustained when achieved / offered >= sustain_ratio and, if
+  // max_p99_ns > 0, its response p99 stays under it
+  double sustain_ratio = 0.95;
+  long long max_p99_ns = 0;
+  bool stop_after_saturation = true; // Stop the sweep at the first miss
+
+  // Engine logging goes to std::cout; mute it so it is not what we measure
+  bool mute_engine_output = true;
+
+  LatencyTracker::Config histogram;
+
+  LoadHarnessConfig() = default;
+};
+
+// Capacity curve: each offered load runs the same pre-generated tape
+// against a freshly built engine
+class LoadHarness {
+public:
+  explicit LoadHarness(const LoadHarnessConfig &config);
+
+  // One run per offered load, in order
+  std::vector<LoadRunResult> run();
+  LoadRunResult run_at(double rate);
+
+  // Highest sustained offered load in `results`, 0 if none
+  static double saturation_knee(const std::vector<LoadRunResult> &results);
+  void print_report(const std::vector<LoadRunResult> &results) const;
+
+  const std::vector<TapeCommand> &tape() const { return tape_; }
+  const LoadHarnessConfig &config() const { return config_; }
+
+private:
+  LoadHarnessConfig config_;
+  std::vector<TapeCommand> tape_;
+
+  std::vector<double> offered_rates() const;
+};
+
+std::string to_string(LoadTarget target);
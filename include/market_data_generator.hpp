@@ -1,6 +1,7 @@
 #pragma once
 
 #include "order.hpp"
+#include "sim_clock.hpp"
 #include "strategy.hpp" // for MarketDataSnapshot
 
 #include <deque>
@@ -38,12 +39,21 @@ public:
 
   void reset(double price);
   MarketDataSnapshot next_snapshot();
+  // Mid moves by drift + shock * volatility; `shock` is a unit-variance
+  // draw supplied by the caller (e.g. one leg of a correlated universe)
+  MarketDataSnapshot next_snapshot(double shock);
   std::vector<MarketDataSnapshot> generate_series(std::size_t steps);
 
+  // Timestamps come from `clock` (wall clock by default); it must outlive
+  // the generator
+  void set_clock(const SimClock &clock) { clock_ = &clock; }
+
   void register_callback(SnapshotCallback callback);
   void clear_callbacks();
 
   void step(OrderBook *book = nullptr, double market_order_probability = 0.25);
+  MarketDataSnapshot step_with_shock(double shock, OrderBook *book = nullptr,
+                                     double market_order_probability = 0.25);
   void inject_self_trade(OrderBook &book, int account_id, double price,
                          int quantity);
 
@@ -52,6 +62,7 @@ public:
 
 private:
   Config config_;
+  const SimClock *clock_;
   std::mt19937 rng_;
   std::normal_distribution<double> price_noise_;
   std::uniform_real_distribution<double> size_dist_;
@@ -62,6 +73,9 @@ private:
   std::deque<int> resting_orders_;
 
   int generate_quantity();
+  MarketDataSnapshot make_snapshot(double price_move);
+  void advance(const MarketDataSnapshot &snapshot, OrderBook *book,
+               double market_order_probability);
   void emit_snapshot(const MarketDataSnapshot &snapshot);
   void submit_liquidity(OrderBook &book, const MarketDataSnapshot &snapshot);
   void maybe_submit_market(OrderBook &book, double probability);
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "price_history.hpp" // for InstrumentId
+
+// ============================================================================
+// MASS QUOTE
+// ============================================================================
+
+// Outcome of one side of a mass quote
+enum class QuoteAction {
+  NONE,      // Side not quoted and nothing was resting
+  UNCHANGED, // Live order already matched the request
+  NEW,       // No live order; a new one was placed
+  AMENDED,   // Same price, smaller size: reduced in place, priority kept
+  REPLACED,  // Live order cancelled and a new one placed (priority lost)
+  CANCELLED, // Side pulled (quantity <= 0); live order cancelled
+  REJECTED,  // Crossed quote, foreign order ID, or reused new order ID
+};
+
+inline const char *quote_action_to_string(QuoteAction action) {
+  switch (action) {
+  case QuoteAction::NONE:
+    return "NONE";
+  case QuoteAction::UNCHANGED:
+    return "UNCHANGED";
+  case QuoteAction::NEW:
+    return "NEW";
+  case QuoteAction::AMENDED:
+    return "AMENDED";
+  case QuoteAction::REPLACED:
+    return "REPLACED";
+  case QuoteAction::CANCELLED:
+    return "CANCELLED";
+  case QuoteAction::REJECTED:
+    return "REJECTED";
+  }
+  return "UNKNOWN";
+}
+
+// Replace one account's two-sided quote in a single book. Quantity <= 0
+// pulls that side. live_*_id name the orders currently resting for this
+// quote (0 = none); new_*_id are used only when a new order is needed.
+struct MassQuote {
+  InstrumentId instrument = 0; // Caller's tag; not interpreted by the book
+  int account_id = 0;
+
+  int live_bid_id = 0;
+  int live_ask_id = 0;
+
+  double bid_price = 0.0;
+  int bid_quantity = 0;
+  double ask_price = 0.0;
+  int ask_quantity = 0;
+
+  int new_bid_id = 0;
+  int new_ask_id = 0;
+};
+
+struct QuoteOutcome {
+  QuoteAction action = QuoteAction::NONE;
+  int order_id = 0;         // Order now representing this side (0 = none)
+  int filled_quantity = 0;  // Executed immediately on placement
+  int resting_quantity = 0; // Left in the book after the call
+};
+
+struct MassQuoteResult {
+  QuoteOutcome bid;
+  QuoteOutcome ask;
+};
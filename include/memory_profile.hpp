@@ -0,0 +1,135 @@
+#pragma once
+
+#include "order_tape.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// ALLOCATION COUNTING
+// ============================================================================
+
+// Per-thread allocator activity. The counters only move in programs that
+// link the counting operator new / delete (bench/counting_allocator.cpp);
+// elsewhere they stay at zero and alloc_counting_enabled() is false.
+struct AllocCounts {
+  std::uint64_t allocations = 0;
+  std::uint64_t frees = 0;
+  std::uint64_t bytes_allocated = 0;
+  std::int64_t live_bytes = 0; // Usable size, where the allocator reports it
+
+  AllocCounts operator-(const AllocCounts &before) const {
+    AllocCounts delta;
+    delta.allocations = allocations - before.allocations;
+    delta.frees = frees - before.frees;
+    delta.bytes_allocated = bytes_allocated - before.bytes_allocated;
+    delta.live_bytes = live_bytes - before.live_bytes;
+    return delta;
+  }
+};
+
+AllocCounts thread_alloc_counts();
+bool alloc_counting_enabled();
+
+// Hooks for the interposed operators
+void alloc_counting_install();
+void note_allocation(std::size_t bytes, std::size_t usable);
+void note_free(std::size_t usable);
+
+// Resident set size of this process, 0 where /proc is unavailable
+std::size_t resident_set_bytes();
+
+// ============================================================================
+// STRUCTURE FOOTPRINT
+// ============================================================================
+
+// Estimated heap bytes held by one container: element storage plus
+// per-node and bucket overhead for node-based containers
+struct StructureFootprint {
+  std::string name;
+  std::size_t elements;
+  std::size_t bytes;
+};
+
+// Node-based container estimates (libstdc++ layouts)
+template <typename Map> std::size_t hash_map_bytes(const Map &map) {
+  return map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void *)) +
+         map.bucket_count() * sizeof(void *);
+}
+
+template <typename Map> std::size_t tree_map_bytes(const Map &map) {
+  return map.size() * (sizeof(typename Map::value_type) + 4 * sizeof(void *));
+}
+
+template <typename Vector> std::size_t vector_bytes(const Vector &vector) {
+  return vector.capacity() * sizeof(typename Vector::value_type);
+}
+
+// ============================================================================
+// MEMORY SOAK
+// ============================================================================
+
+constexpr std::size_t kTapeOpCount = 5;
+
+struct MemorySoakConfig {
+  std::uint64_t operations = 50000000;
+  std::uint64_t sample_every = 1000000; // Growth curve resolution
+  std::uint64_t chunk = 1 << 16;        // Tape commands generated at a time
+
+  // Operations before this fraction of the run are warmup; allocations
+  // after it count as steady state
+  double warmup_fraction = 0.1;
+
+  // Resting orders placed on a separate book to measure bytes per order
+  std::uint64_t footprint_orders = 1000000;
+
+  bool event_logging = true;      // Let event_log_ grow as in production
+  bool mute_engine_output = true; // Engine logging goes to std::cout
+
+  OrderTapeConfig tape; // commands is overridden to `operations`
+
+  MemorySoakConfig() = default;
+};
+
+struct OpAllocStats {
+  std::uint64_t operations = 0;
+  std::uint64_t allocations = 0;
+  std::uint64_t bytes = 0;
+  std::uint64_t allocating_operations = 0; // At least one allocation
+  std::uint64_t max_allocations = 0;       // In a single operation
+};
+
+struct MemorySample {
+  std::uint64_t operations;
+  std::size_t rss_bytes;
+  std::int64_t heap_live_bytes;
+  double allocations_per_op; // Since the previous sample
+  std::vector<StructureFootprint> structures;
+};
+
+struct MemorySoakReport {
+  bool counting = false; // Interposed allocator present
+
+  // Resting-order footprint, from placing footprint_orders passive orders
+  double heap_bytes_per_order = 0.0;
+  double rss_bytes_per_order = 0.0;
+  double estimated_bytes_per_order = 0.0; // From structure estimates
+
+  // Indexed by TapeOp
+  std::array<OpAllocStats, kTapeOpCount> all;
+  std::array<OpAllocStats, kTapeOpCount> steady;
+
+  std::vector<MemorySample> growth;
+
+  std::uint64_t steady_allocations() const;
+  void print() const;
+};
+
+// Replays a generated order tape into one OrderBook, attributing every
+// allocation to the operation that made it and sampling memory as it goes
+MemorySoakReport run_memory_soak(const MemorySoakConfig &config);
+
+const char *to_string(TapeOp op);
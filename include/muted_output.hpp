@@ -0,0 +1,27 @@
+#pragma once
+
+#include <iostream>
+
+// Puts std::cout in a failed state for its lifetime, so engine logging is
+// skipped before any formatting happens. The previous stream state comes
+// back on destruction, so mutes nest.
+class MutedOutput {
+public:
+  explicit MutedOutput(bool mute = true)
+      : mute_(mute), saved_(std::cout.rdstate()) {
+    if (mute_) {
+      std::cout.setstate(std::ios::badbit);
+    }
+  }
+  ~MutedOutput() {
+    if (mute_) {
+      std::cout.clear(saved_);
+    }
+  }
+  MutedOutput(const MutedOutput &) = delete;
+  MutedOutput &operator=(const MutedOutput &) = delete;
+
+private:
+  bool mute_;
+  std::ios::iostate saved_;
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// RUNNING MOMENTS
+// ============================================================================
+
+// Unbounded Welford mean / population variance
+struct RunningMoments {
+  std::size_t count = 0;
+  double mean = 0.0;
+  double m2 = 0.0;
+
+  void add(double value) {
+    ++count;
+    double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+  }
+
+  double variance() const {
+    return count == 0 ? 0.0 : m2 / static_cast<double>(count);
+  }
+  double stddev() const;
+};
+
+// ============================================================================
+// ONLINE P&L METRICS
+// ============================================================================
+
+// Everything PerformanceMetrics derives from the P&L series, kept up to
+// date in O(1) per sample and O(1) memory. Returns are period-over-period
+// changes relative to |previous P&L|, as in the batch formulas:
+//   - Sharpe counts a return of 0 when the previous P&L is ~0
+//   - Sortino and return statistics skip those periods
+class OnlinePnlMetrics {
+private:
+  std::size_t samples_;
+  TimePoint first_time_;
+  TimePoint last_time_;
+  double first_pnl_;
+  double last_pnl_;
+
+  RunningMoments sharpe_returns_;  // Zero where previous P&L is ~0
+  RunningMoments defined_returns_; // Skips those periods
+  double downside_sum_sq_;
+  std::size_t downside_count_;
+
+  double peak_;
+  TimePoint peak_time_;
+  double max_drawdown_pct_;
+  double max_drawdown_amount_;
+  Clock::duration longest_drawdown_;
+
+public:
+  OnlinePnlMetrics();
+
+  void add(TimePoint timestamp, double pnl);
+  void reset();
+
+  std::size_t samples() const { return samples_; }
+  std::size_t return_count() const { return defined_returns_.count; }
+  double first_pnl() const { return first_pnl_; }
+  double last_pnl() const { return last_pnl_; }
+  TimePoint first_time() const { return first_time_; }
+  TimePoint last_time() const { return last_time_; }
+
+  double total_return() const;     // Dollars
+  double return_percentage() const;
+  double sharpe_ratio() const;     // Annualized (252 periods)
+  double sortino_ratio() const;    // Annualized (252 periods)
+  std::pair<double, double> return_statistics() const; // Mean, stddev
+
+  double peak() const { return peak_; }
+  double max_drawdown() const { return max_drawdown_pct_; } // % of peak
+  double max_drawdown_amount() const { return max_drawdown_amount_; }
+  double current_drawdown_amount() const { return peak_ - last_pnl_; }
+  bool in_drawdown() const { return samples_ > 0 && last_pnl_ < peak_; }
+  // Longest time spent below a previous peak, ongoing drawdown included
+  Clock::duration longest_drawdown() const { return longest_drawdown_; }
+};
+
+// ============================================================================
+// MIN / MAX DECIMATION
+// ============================================================================
+
+// Fixed-size plot series: samples are grouped into buckets of `stride`
+// consecutive points and each bucket keeps only its lowest and highest
+// point, so spikes and drawdown troughs survive. When the buckets fill
+// `capacity`, neighbouring buckets merge and the stride doubles.
+class MinMaxDecimator {
+public:
+  using Point = std::pair<TimePoint, double>;
+
+private:
+  struct Bucket {
+    Point low;
+    Point high;
+  };
+
+  std::size_t max_buckets_;
+  std::size_t stride_;        // Samples per bucket
+  std::size_t in_last_;       // Samples in buckets_.back()
+  std::size_t samples_;
+  std::vector<Bucket> buckets_;
+
+  void compact();
+
+public:
+  // Keeps at most `capacity` points (rounded down to even, minimum 2)
+  explicit MinMaxDecimator(std::size_t capacity = 4096);
+
+  void add(TimePoint timestamp, double value);
+  void clear();
+
+  // Retained points in time order
+  std::vector<Point> points() const;
+
+  std::size_t samples() const { return samples_; }
+  std::size_t stride() const { return stride_; }
+  std::size_t capacity() const { return max_buckets_ * 2; }
+};
@@ -25,6 +25,10 @@ struct Order {
   bool stop_triggered;    // Has stop been triggered?
   OrderType stop_becomes; // Becomes LIMIT or MARKET when triggered
 
+  // Routing key for multi-instrument hosts: the submitting strategy's
+  // InstrumentId. The book itself ignores it.
+  InstrumentId instrument = 0;
+
   // Constructor for LIMIT orders
   Order(int id_, int account_id_, Side side_, double price_, int qty_,
         TimeInForce tif_ = TimeInForce::GTC);
@@ -1,12 +1,19 @@
 #pragma once
 
+#include "engine_metrics.hpp"
 #include "event.hpp"
 #include "fill.hpp"
 #include "fill_router.hpp"
+#include "flight_recorder.hpp"
+#include "mass_quote.hpp"
+#include "memory_profile.hpp"
 #include "order.hpp"
+#include "order_trace.hpp"
+#include "sim_clock.hpp"
 #include "snapshot.hpp"
 #include "timer.hpp"
 #include <map>
+#include <memory>
 #include <optional>
 #include <queue>
 #include <unordered_map>
@@ -35,6 +42,19 @@ private:
   std::vector<AccountFill> account_fills_; // NEW: Track fills with account info
   std::vector<long long> insertion_latencies_ns_;
   std::unique_ptr<FillRouter> fill_router_;
+  std::unique_ptr<OrderPathTracer> tracer_; // Null unless tracing
+  std::unique_ptr<OrderBookMetrics> metrics_; // Null unless attached
+  std::unique_ptr<FlightRecorder> flight_recorder_; // On unless disabled
+  bool amending_; // amend_order()'s inner cancel and add report as the amend
+  const SimClock *clock_; // Stamps event-log entries
+
+  // `final_order` is the tracked copy when there is one (final state)
+  void record_insertion(const Order &order, const Order &final_order,
+                        const Timer &timer);
+  void publish_book_gauges();
+  void record_flight(FlightRecord &entry);
+  // Cancel or amend of a resting order outside cancel_order()/amend_order()
+  void record_flight(FlightOp op, const Order &order, const Timer &timer);
 
   bool execute_trade(Order &aggressive_order, Order &passive_order);
   void update_order_state(Order &order);
@@ -44,6 +64,10 @@ private:
   void handle_passive_order_after_match(Order &passive_order,
                                         PriorityQueue &book);
 
+  // Pops cancelled / filled copies off the top, as matching would, and
+  // returns the live best price (0 if that side is empty)
+  template <typename PriorityQueue> double live_top_price(PriorityQueue &book);
+
   void handle_unfilled_order(
       Order &order,
       std::priority_queue<Order, std::vector<Order>, BidComparator> *bid_book,
@@ -82,7 +106,16 @@ private:
   double current_trigger_price_for_side(Side side) const;
   bool stop_should_trigger_now(const Order &o) const;
   void trigger_stop_order_immediately(Order &stop_order, double ref_price);
-  void finalize_after_matching(Order &o);
+  // Returns the tracked copy of `o` (nullptr if untracked)
+  const Order *finalize_after_matching(Order &o);
+
+  // Mass-quote helpers
+  void cancel_resting(std::unordered_map<int, Order>::iterator it);
+  bool quote_side_valid(Side side, int live_id, int new_id, int account_id,
+                        int quantity) const;
+  bool settle_quote_side(int live_id, double price, int quantity,
+                         QuoteOutcome &outcome);
+  void place_quote_side(const Order &order, QuoteOutcome &outcome);
 
 public:
   OrderBook(const std::string &symbol = "DEFAULT");
@@ -125,7 +158,11 @@ public:
 
   // NEW: Set/get the symbol this order book handles
   void set_symbol(const std::string &symbol) { current_symbol_ = symbol; }
-  std::string get_symbol() const { return current_symbol_; }
+  const std::string &get_symbol() const { return current_symbol_; }
+
+  // Event-log timestamps come from `clock` (wall clock by default); it
+  // must outlive the book
+  void set_clock(const SimClock &clock) { clock_ = &clock; }
 
   // ==================================================================
   // ORDER LIFECYCLE MANAGEMENT
@@ -134,6 +171,11 @@ public:
   bool cancel_order(int order_id);
   bool amend_order(int order_id, std::optional<double> new_price,
                    std::optional<int> new_quantity);
+
+  // Atomically replace an account's bid and ask: both live orders are
+  // settled before either new order is placed, so a requote never trades
+  // against its own stale side.
+  MassQuoteResult mass_quote(const MassQuote &quote);
   std::optional<Order> get_order(int order_id) const;
   void check_stop_triggers(double trade_price);
 
@@ -188,6 +230,46 @@ public:
   void print_market_depth_compact() const;
   void print_pending_stops() const;
 
+  // ==================================================================
+  // ORDER PATH TRACING
+  // ==================================================================
+
+  // Per-stage latency histograms for add_order, plus the full breakdown
+  // of orders slower than slow_threshold_ns (0 = none). Tracepoints are
+  // only compiled in with ENGINE_TRACEPOINTS; without it nothing records.
+  OrderPathTracer &enable_tracing(long long slow_threshold_ns = 0);
+  void disable_tracing();
+  OrderPathTracer *tracer() { return tracer_.get(); }
+  const OrderPathTracer *tracer() const { return tracer_.get(); }
+
+  // ==================================================================
+  // RUNTIME METRICS
+  // ==================================================================
+
+  // Publish counters and gauges into `registry` under `prefix`
+  // (default "book.<symbol>"). The registry must outlive the book or
+  // the next detach_metrics().
+  void attach_metrics(MetricsRegistry &registry, std::string prefix = "");
+  void detach_metrics() { metrics_.reset(); }
+
+  // ==================================================================
+  // FLIGHT RECORDER
+  // ==================================================================
+
+  // Every book keeps its last 1024 adds, cancels, amends and fills in a
+  // FlightRecorder. Reconfiguring starts a fresh ring; an empty symbol
+  // in `config` takes the book's.
+  FlightRecorder &configure_flight_recorder(FlightRecorder::Config config);
+  void disable_flight_recorder() { flight_recorder_.reset(); }
+  FlightRecorder *flight_recorder() { return flight_recorder_.get(); }
+  const FlightRecorder *flight_recorder() const {
+    return flight_recorder_.get();
+  }
+
+  // Estimated heap held by each internal structure, including the
+  // histories (cancelled orders, fills, events) that are never trimmed
+  std::vector<StructureFootprint> memory_footprint() const;
+
   size_t bids_size() const { return bids_.size(); }
   size_t asks_size() const { return asks_.size(); }
 
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "event.hpp"
+#include "order.hpp"
+#include "types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+class OrderBook;
+
+// ============================================================================
+// FLOW CONFIGURATION
+// ============================================================================
+
+enum class FlowOrderKind : std::uint8_t {
+  LIMIT,   // GTC limit, rests
+  MARKET,  // IOC market
+  ICEBERG, // GTC limit with a displayed peak, rests
+  STOP,    // Stop-market beyond the touch
+  IOC,     // Marketable limit
+  FOK,     // Marketable limit, all-or-nothing
+};
+
+// One order-submitting participant. Resting orders it sends are cancelled
+// with `cancel_probability`, after an exponential delay.
+struct FlowParticipant {
+  int account_id;
+  double weight;              // Relative share of new orders
+  double cancel_probability;  // Chance a resting order is later cancelled
+  double mean_cancel_latency; // Seconds
+};
+
+struct OrderFlowConfig {
+  // Arrivals are a Hawkes process with an exponential kernel:
+  //   intensity(t) = baseline_rate + sum excitation * exp(-decay (t - t_i))
+  // excitation / decay is the branching ratio and must stay below 1.
+  double baseline_rate = 200.0; // Orders per second
+  double excitation = 1500.0;   // Per second, added by every arrival
+  double decay = 2000.0;        // Per second
+
+  // Placement: passive orders land d ticks behind their own touch with
+  // P(d) ~ (d + 1)^-placement_exponent, d < max_distance_ticks.
+  // Marketable orders cross by the same law.
+  double reference_price = 100.0;
+  double tick_size = 0.01;
+  std::int32_t half_spread_ticks = 1;
+  double placement_exponent = 2.2;
+  std::uint32_t max_distance_ticks = 50;
+  double volatility_ticks = 20.0; // Reference move stddev per sqrt(second)
+
+  // Mix of new orders, relative weights indexed by FlowOrderKind
+  std::vector<double> kind_weights = {0.80, 0.04, 0.04, 0.01, 0.08, 0.03};
+
+  int min_quantity = 1;
+  int max_quantity = 500;
+  double iceberg_peak_fraction = 0.2;
+
+  // Cancel-heavy fast makers, slower makers, directional takers
+  std::vector<FlowParticipant> participants = {
+      {9101, 0.60, 0.98, 0.002},
+      {9102, 0.30, 0.85, 0.250},
+      {9103, 0.10, 0.30, 5.000},
+  };
+
+  std::uint64_t seed = 1337;
+  TimePoint start_time = TimePoint();
+  int first_order_id = 1;
+
+  double branching_ratio() const {
+    return decay > 0.0 ? excitation / decay : 0.0;
+  }
+};
+
+// ============================================================================
+// FLOW EVENTS
+// ============================================================================
+
+// A NEW or CANCEL produced by the model. Unlike OrderEvent it can carry a
+// stop order.
+struct FlowEvent {
+  TimePoint timestamp;
+  EventType type; // NEW_ORDER or CANCEL_ORDER
+  FlowOrderKind kind;
+  int order_id;
+  int account_id;
+  Side side;
+  double price;  // Limit price, or stop price for STOP
+  int quantity;
+  int peak_size; // ICEBERG only
+
+  Order to_order() const;
+
+  // Log form; a STOP is written as the market order it becomes
+  OrderEvent to_order_event() const;
+};
+
+void apply_flow_event(OrderBook &book, const FlowEvent &event);
+
+// ============================================================================
+// FLOW MODEL
+// ============================================================================
+
+// Generates bursty order flow in event time. Arrival times are drawn
+// exactly (Dassios-Zhao) in O(1) each; cancels sit in a queue ordered by
+// due time and are merged with the arrivals, so cancels of a burst land
+// during and after it just like live cancel/replace traffic.
+class OrderFlowModel {
+private:
+  struct PendingCancel {
+    double due; // Seconds since start_time
+    int order_id;
+    int account_id;
+
+    bool operator>(const PendingCancel &other) const {
+      return due > other.due;
+    }
+  };
+
+  OrderFlowConfig config_;
+  std::mt19937_64 rng_;
+  std::uniform_real_distribution<double> uniform01_;
+  std::normal_distribution<double> normal_;
+  std::discrete_distribution<int> kind_dist_;
+  std::discrete_distribution<int> participant_dist_;
+  std::uniform_int_distribution<int> quantity_dist_;
+
+  std::priority_queue<PendingCancel, std::vector<PendingCancel>,
+                      std::greater<PendingCancel>>
+      cancels_;
+
+  double now_;          // Seconds since start_time of the last event
+  double next_arrival_; // Seconds since start_time
+  double excess_;       // Intensity above baseline just after next_arrival_
+  double mid_ticks_;
+  std::int32_t bid_ticks_;
+  std::int32_t ask_ticks_;
+  int next_order_id_;
+  std::uint64_t arrivals_;
+  std::uint64_t cancels_emitted_;
+
+  double open_unit(); // Uniform in (0, 1]
+  void schedule_next_arrival();
+  std::int32_t draw_distance();
+  FlowEvent make_arrival();
+  void move_reference(double elapsed);
+  TimePoint to_time_point(double seconds) const;
+
+public:
+  explicit OrderFlowModel(const OrderFlowConfig &config);
+
+  FlowEvent next();
+  std::vector<FlowEvent> generate(std::size_t count);
+
+  // Place the next orders around `book`'s touch
+  void anchor(const OrderBook &book);
+
+  // Send `count` events to `book`, anchoring before each one
+  void drive(OrderBook &book, std::size_t count);
+
+  // Recentre placement when no book is attached
+  void set_reference_price(double price);
+
+  // Intensity just after the next, already scheduled arrival (its own
+  // excitation included), not after the last one returned by next()
+  double intensity() const { return config_.baseline_rate + excess_; }
+
+  TimePoint now() const { return to_time_point(now_); }
+  std::size_t pending_cancels() const { return cancels_.size(); }
+  std::uint64_t arrivals() const { return arrivals_; }
+  std::uint64_t cancels() const { return cancels_emitted_; }
+  const OrderFlowConfig &config() const { return config_; }
+};
+
+// ============================================================================
+// CALIBRATION
+// ============================================================================
+
+// Fits `base` to an event log written by OrderBook::save_events():
+//   - Hawkes rate, branching ratio and decay from the variance-to-mean
+//     ratio of NEW-order counts over several window sizes
+//   - order mix from NEW records (stops are not logged; the STOP weight
+//     of `base` is kept)
+//   - placement exponent from the distance to the touch, found by
+//     replaying the log into a scratch book
+//   - one participant per account with its share of orders, cancel
+//     probability and mean cancel latency
+// Anything the log is too short to estimate keeps its value from `base`.
+OrderFlowConfig calibrate_order_flow(const std::string &filename,
+                                     const OrderFlowConfig &base =
+                                         OrderFlowConfig());
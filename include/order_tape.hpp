@@ -0,0 +1,165 @@
+#pragma once
+
+#include "counter_rng.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class OrderBook;
+class WorkerPool;
+
+// ============================================================================
+// TAPE FORMAT
+// ============================================================================
+
+enum class TapeOp : std::uint8_t {
+  NEW_LIMIT,  // GTC limit
+  NEW_IOC,    // IOC limit
+  NEW_MARKET, // IOC market
+  CANCEL,
+  AMEND, // quantity = new quantity, price_ticks = new price (0 = keep);
+         // generated amends always carry a new price
+};
+
+// One command, 16 bytes, written to disk as-is (little-endian hosts)
+struct TapeCommand {
+  std::uint32_t order_id;
+  std::int32_t price_ticks; // Price / tick_size
+  std::uint32_t quantity;
+  std::uint16_t account;
+  TapeOp op;
+  std::uint8_t side; // 0 = BUY, 1 = SELL
+};
+
+static_assert(sizeof(TapeCommand) == 16, "TapeCommand must stay 16 bytes");
+static_assert(std::is_trivially_copyable<TapeCommand>::value,
+              "TapeCommand is written with raw I/O");
+
+// Streams own runs of this many consecutive commands (1 KiB), so parallel
+// generators only meet at run edges instead of on every cache line
+constexpr std::uint32_t kTapeStreamRun = 64;
+
+struct OrderTapeHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t record_size;
+  std::uint64_t count;
+  std::uint64_t seed;
+  std::uint32_t streams;
+  std::uint32_t reserved;
+  double tick_size;
+  double start_price;
+};
+
+struct OrderTapeConfig {
+  std::uint64_t commands = 1000000;
+  std::uint64_t seed = 1337;
+
+  // Command i belongs to stream (i / kTapeStreamRun) % streams. The tape
+  // depends on this count, never on how many threads generate it.
+  std::uint32_t streams = 64;
+
+  double start_price = 100.0;
+  double tick_size = 0.01;
+  std::uint32_t block_size = 4096;  // Commands per step of the mid path
+  double volatility_ticks = 2.0;    // Mid move stddev per block
+  std::uint32_t max_distance_ticks = 20; // Limit placement from the mid
+
+  // Mix (the remainder is GTC limits)
+  double cancel_ratio = 0.30;
+  double amend_ratio = 0.05;
+  double market_ratio = 0.03;
+  double ioc_ratio = 0.05;
+
+  std::uint32_t min_quantity = 1;
+  std::uint32_t max_quantity = 200;
+  std::uint16_t account_base = 8001; // Stream s trades as account_base + s
+  std::uint32_t live_orders_per_stream = 1024; // Cancel / amend targets
+};
+
+// ============================================================================
+// TAPE GENERATOR
+// ============================================================================
+
+// Generates the tape in consecutive chunks. Within a chunk each stream is
+// produced independently (in parallel when given a WorkerPool) and writes
+// straight into its own slots, so no merge step is needed. The mid-price
+// path is shared by all streams and built serially, one value per block.
+class OrderTapeGenerator {
+private:
+  struct LiveOrder {
+    std::uint32_t order_id;
+    std::uint8_t side;
+  };
+
+  struct StreamState {
+    CounterRng rng;
+    std::vector<LiveOrder> live; // Ring of recent resting orders
+    std::size_t live_head = 0;
+
+    explicit StreamState(std::uint64_t key) : rng(key) {}
+  };
+
+  OrderTapeConfig config_;
+  std::vector<StreamState> streams_;
+  std::vector<std::int32_t> mid_ticks_; // Indexed by block
+  CounterRng path_rng_;
+  std::uint64_t position_; // Next command index
+
+  void extend_mid_path(std::uint64_t last_block);
+  void generate_stream(std::uint32_t stream, std::uint64_t first,
+                       std::uint64_t end, TapeCommand *out);
+
+public:
+  explicit OrderTapeGenerator(const OrderTapeConfig &config);
+
+  // Next `count` commands (fewer at the end of the tape). Returns how many
+  // were written.
+  std::size_t generate(TapeCommand *out, std::size_t count,
+                       WorkerPool *pool = nullptr);
+
+  std::uint64_t position() const { return position_; }
+  bool done() const { return position_ >= config_.commands; }
+  const OrderTapeConfig &config() const { return config_; }
+  OrderTapeHeader header() const;
+};
+
+// Whole tape in memory
+std::vector<TapeCommand> generate_order_tape(const OrderTapeConfig &config,
+                                             WorkerPool *pool = nullptr);
+
+// Stream the tape to disk in chunks of `chunk` commands
+void write_order_tape(const std::string &filename,
+                      const OrderTapeConfig &config,
+                      WorkerPool *pool = nullptr,
+                      std::size_t chunk = 1 << 20);
+
+// ============================================================================
+// TAPE READING / REPLAY
+// ============================================================================
+
+class OrderTapeReader {
+private:
+  std::ifstream file_;
+  OrderTapeHeader header_;
+  std::uint64_t remaining_;
+
+public:
+  explicit OrderTapeReader(const std::string &filename);
+
+  const OrderTapeHeader &header() const { return header_; }
+  std::uint64_t remaining() const { return remaining_; }
+
+  // Up to `max` commands into `out`; 0 at end of tape
+  std::size_t read(TapeCommand *out, std::size_t max);
+};
+
+std::vector<TapeCommand> load_order_tape(const std::string &filename,
+                                         OrderTapeHeader *header = nullptr);
+
+void apply_tape_command(OrderBook &book, const TapeCommand &command,
+                        double tick_size);
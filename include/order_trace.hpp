@@ -0,0 +1,180 @@
+#pragma once
+
+#include "latency_tracker.hpp"
+#include "tsc_clock.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// STAGES
+// ============================================================================
+
+enum class TraceStage : std::uint8_t {
+  VALIDATION,    // FOK liquidity pre-check
+  STOP_HANDLING, // Stop placement, immediate triggers, trigger scans
+  ORDER_INSERT,  // active_orders_ insert
+  MATCHING,      // Matching loop and resting the remainder
+  FILL_ROUTING,  // FillRouter::route_fill and fill bookkeeping
+  FEE_CALC,
+  CALLBACKS, // Fill callbacks
+  EVENT_LOG,
+  FINALIZE, // Post-match state finalization
+};
+
+constexpr std::size_t kTraceStageCount = 9;
+
+const char *to_string(TraceStage stage);
+
+// ============================================================================
+// ORDER PATH TRACER
+// ============================================================================
+
+// Stage breakdown of one order, all times in ns. Stage times are
+// exclusive: a stage nested in another (fee calculation inside fill
+// routing inside matching) is only counted once, in the innermost stage.
+struct StageBreakdown {
+  int order_id = 0;
+  long long total_ns = 0;
+  std::array<long long, kTraceStageCount> stage_ns{};
+  std::array<std::uint32_t, kTraceStageCount> stage_hits{};
+
+  // Time not covered by any tracepoint
+  long long untraced_ns() const;
+};
+
+// Collects tracepoints across the order path. An order opens with
+// begin_order() and closes with end_order(); nested orders (stop triggers,
+// amend's cancel + add) fold into the outermost one. At close, each stage
+// the order touched records its total into that stage's histogram, and an
+// order slower than the slow-path threshold keeps its full breakdown.
+class OrderPathTracer {
+private:
+  std::array<LatencyTracker, kTraceStageCount> stages_;
+  LatencyTracker total_;
+
+  // Current order
+  int depth_;
+  int order_id_;
+  std::uint64_t order_start_;
+  std::uint64_t child_ticks_; // Traced time inside the innermost open scope
+  std::array<std::uint64_t, kTraceStageCount> stage_ticks_;
+  std::array<std::uint32_t, kTraceStageCount> stage_hits_;
+
+  // Slow-path captures, oldest overwritten first
+  long long slow_threshold_ns_;
+  std::vector<StageBreakdown> slow_orders_;
+  std::size_t slow_capacity_;
+  std::size_t slow_next_;
+  std::uint64_t slow_total_;
+
+  static LatencyTracker::Config histogram_config();
+
+public:
+  // threshold_ns = 0 disables slow-path capture
+  explicit OrderPathTracer(long long slow_threshold_ns = 0,
+                           std::size_t slow_capacity = 256);
+
+  void begin_order(int order_id);
+  void end_order();
+
+  // Scope bookkeeping for TraceScope: enter() returns the enclosing
+  // scope's child time, which leave() restores
+  std::uint64_t enter() {
+    std::uint64_t saved = child_ticks_;
+    child_ticks_ = 0;
+    return saved;
+  }
+  void leave(TraceStage stage, std::uint64_t elapsed, std::uint64_t saved) {
+    if (depth_ > 0) {
+      auto index = static_cast<std::size_t>(stage);
+      stage_ticks_[index] += elapsed - child_ticks_;
+      ++stage_hits_[index];
+    }
+    child_ticks_ = saved + elapsed;
+  }
+
+  const LatencyTracker &stage(TraceStage stage) const {
+    return stages_[static_cast<std::size_t>(stage)];
+  }
+  const LatencyTracker &total() const { return total_; }
+
+  void set_slow_threshold(long long threshold_ns) {
+    slow_threshold_ns_ = threshold_ns;
+  }
+  long long slow_threshold() const { return slow_threshold_ns_; }
+
+  // Retained slow orders, oldest first, and how many were ever captured
+  std::vector<StageBreakdown> slow_orders() const;
+  std::uint64_t slow_order_count() const { return slow_total_; }
+
+  void reset();
+  void print_report() const;
+};
+
+// ============================================================================
+// TRACEPOINTS
+// ============================================================================
+
+// Times one stage; a null tracer makes it a no-op
+class TraceScope {
+private:
+  OrderPathTracer *tracer_;
+  TraceStage stage_;
+  std::uint64_t saved_;
+  std::uint64_t start_;
+
+public:
+  TraceScope(OrderPathTracer *tracer, TraceStage stage)
+      : tracer_(tracer), stage_(stage), saved_(0), start_(0) {
+    if (tracer_) {
+      saved_ = tracer_->enter();
+      start_ = TscClock::now();
+    }
+  }
+  ~TraceScope() {
+    if (tracer_) {
+      tracer_->leave(stage_, TscClock::now() - start_, saved_);
+    }
+  }
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+};
+
+// Brackets one order
+class OrderTraceScope {
+private:
+  OrderPathTracer *tracer_;
+
+public:
+  OrderTraceScope(OrderPathTracer *tracer, int order_id) : tracer_(tracer) {
+    if (tracer_) {
+      tracer_->begin_order(order_id);
+    }
+  }
+  ~OrderTraceScope() {
+    if (tracer_) {
+      tracer_->end_order();
+    }
+  }
+  OrderTraceScope(const OrderTraceScope &) = delete;
+  OrderTraceScope &operator=(const OrderTraceScope &) = delete;
+};
+
+// Compiled in with ENGINE_TRACEPOINTS; otherwise they vanish entirely
+#define ENGINE_TRACE_CONCAT_(a, b) a##b
+#define ENGINE_TRACE_CONCAT(a, b) ENGINE_TRACE_CONCAT_(a, b)
+
+#ifdef ENGINE_TRACEPOINTS
+#define ENGINE_TRACE_ORDER(tracer, order_id)                                   \
+  OrderTraceScope ENGINE_TRACE_CONCAT(trace_order_, __LINE__)((tracer),        \
+                                                              (order_id))
+#define ENGINE_TRACE_STAGE(tracer, stage)                                      \
+  TraceScope ENGINE_TRACE_CONCAT(trace_stage_, __LINE__)((tracer),             \
+                                                         TraceStage::stage)
+#else
+#define ENGINE_TRACE_ORDER(tracer, order_id) ((void)0)
+#define ENGINE_TRACE_STAGE(tracer, stage) ((void)0)
+#endif
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// ============================================================================
+// HEDGE RATIO ESTIMATION
+// ============================================================================
+//
+// Pair convention: y is the dependent leg, x the hedge leg, and
+//   y = alpha + beta * x + residual
+// so the traded spread is y - beta * x. beta = cov(x, y) / var(x) in both
+// estimators; they differ only in how the moments are weighted.
+
+enum class HedgeRatioMethod {
+  ROLLING_OLS, // Equal weights over the last `period` samples
+  EXPONENTIAL, // Exponential weights with the given half-life (in samples)
+};
+
+// Windowed means, variances and covariance of (x, y), updated in O(1) per
+// sample with the bivariate add/remove form of Welford's update.
+class RollingCovariance {
+private:
+  std::size_t period_;
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  std::size_t head_; // Slot the next sample will be written to
+  std::size_t count_;
+  double mean_x_;
+  double mean_y_;
+  double m2_x_;
+  double m2_y_;
+  double c_xy_;
+
+  void add(double x, double y);
+  void remove(double x, double y);
+
+public:
+  explicit RollingCovariance(std::size_t period = 1);
+
+  void update(double x, double y); // Evicts the oldest sample once full
+  void reset();
+
+  std::size_t period() const { return period_; }
+  std::size_t count() const { return count_; }
+  bool is_ready() const { return count_ >= period_; }
+
+  double mean_x() const { return mean_x_; }
+  double mean_y() const { return mean_y_; }
+  double variance_x() const;
+  double variance_y() const;
+  double covariance() const;
+  double correlation() const;
+};
+
+// Exponentially weighted means, variances and covariance of (x, y).
+class EwCovariance {
+private:
+  double alpha_;
+  std::uint64_t count_;
+  double mean_x_;
+  double mean_y_;
+  double var_x_;
+  double var_y_;
+  double cov_xy_;
+
+public:
+  explicit EwCovariance(double halflife = 20.0);
+
+  void update(double x, double y);
+  void reset();
+
+  double alpha() const { return alpha_; }
+  std::uint64_t count() const { return count_; }
+
+  double mean_x() const { return mean_x_; }
+  double mean_y() const { return mean_y_; }
+  double variance_x() const { return var_x_; }
+  double variance_y() const { return var_y_; }
+  double covariance() const { return cov_xy_; }
+};
+
+// ============================================================================
+// PAIR STATISTICS
+// ============================================================================
+
+enum class PairLeg { DEPENDENT, HEDGE }; // y, x
+
+// Both estimators for one (y, x) pair plus the latest price of each leg.
+// A sample is taken once both legs have updated since the previous one
+// (when the lagging leg catches up), so each synchronized tick adds exactly
+// one (y, x) pair and never pairs a new price with a stale one twice.
+// Several strategies may share one instance: on_price() ignores an update
+// whose timestamp is not newer than the last one seen for that leg, so the
+// same market data delivered to every sharer is only sampled once.
+class PairStatistics {
+private:
+  RollingCovariance rolling_;
+  EwCovariance exponential_;
+  double last_y_;
+  double last_x_;
+  TimePoint last_update_[2];
+  bool seen_[2];
+  bool fresh_[2]; // Updated since the last sample
+
+public:
+  PairStatistics(std::size_t period, double halflife);
+
+  // Take one (y, x) sample directly
+  void update(double y, double x);
+
+  // Record a leg price; samples the pair once both legs have a new price.
+  // Returns false for duplicate (already seen) updates.
+  bool on_price(PairLeg leg, double price, TimePoint timestamp);
+
+  bool has_prices() const { return seen_[0] && seen_[1]; }
+  bool is_ready() const { return rolling_.is_ready(); }
+  double last_y() const { return last_y_; }
+  double last_x() const { return last_x_; }
+
+  double hedge_ratio(HedgeRatioMethod method) const;
+  double intercept(HedgeRatioMethod method) const;
+
+  // Residual y - (alpha + beta * x) and its standard deviation implied by
+  // the current moments (mean residual is zero by construction)
+  double residual(double y, double x, HedgeRatioMethod method) const;
+  double residual_stddev(HedgeRatioMethod method) const;
+  double zscore(double y, double x, HedgeRatioMethod method) const;
+  double zscore(HedgeRatioMethod method) const {
+    return zscore(last_y_, last_x_, method);
+  }
+
+  const RollingCovariance &rolling() const { return rolling_; }
+  const EwCovariance &exponential() const { return exponential_; }
+};
+
+// Hands out one PairStatistics per (dependent, hedge, period, half-life),
+// so every strategy trading the same legs reads the same estimator.
+class PairStatisticsRegistry {
+private:
+  using Key = std::tuple<std::string, std::string, std::size_t, double>;
+  std::map<Key, std::shared_ptr<PairStatistics>> pairs_;
+
+public:
+  std::shared_ptr<PairStatistics> acquire(const std::string &dependent,
+                                          const std::string &hedge,
+                                          std::size_t period, double halflife);
+
+  std::size_t size() const { return pairs_.size(); }
+};
@@ -9,13 +9,27 @@
 #include <vector>
 
 // project headers
-#include "account.hpp" // for Account
-#include "timer.hpp"   // for TimePoint
+#include "account.hpp"        // for Account
+#include "bootstrap.hpp"      // for BootstrapConfig, BootstrapReport
+#include "online_metrics.hpp"  // for OnlinePnlMetrics, MinMaxDecimator
+#include "timer.hpp"           // for TimePoint
+
+// What add_pnl_snapshot() keeps besides the online metrics
+enum class TimeseriesMode {
+  FULL,      // Every snapshot in pnl_timeseries
+  DECIMATED, // Fixed-size min/max plot series in pnl_decimated
+  NONE,      // Metrics only
+};
 
 struct PerformanceMetrics {
-  // Time series data
+  // Time series data (FULL mode only)
   std::vector<std::pair<TimePoint, double>> pnl_timeseries;
 
+  // Series-derived metrics, updated in O(1) per snapshot in every mode
+  OnlinePnlMetrics online;
+  TimeseriesMode timeseries_mode = TimeseriesMode::FULL;
+  MinMaxDecimator pnl_decimated;
+
   // Core metrics
   double sharpe_ratio;
   double max_drawdown;
@@ -40,10 +54,20 @@ struct PerformanceMetrics {
   // Add a P&L snapshot to the timeseries
   void add_pnl_snapshot(TimePoint timestamp, double pnl);
 
-  // Clear timeseries data
+  // Choose what is kept per snapshot; `capacity` sizes the DECIMATED
+  // series. Clears the timeseries.
+  void set_timeseries_mode(TimeseriesMode mode, std::size_t capacity = 4096);
+
+  // Clear timeseries data (and the online metrics built from it)
   void clear_timeseries();
 
-  // Export timeseries to CSV
+  // Snapshots seen, whatever the mode
+  std::size_t snapshot_count() const { return online.samples(); }
+
+  // Retained series for plotting: full, decimated or empty
+  std::vector<std::pair<TimePoint, double>> plot_series() const;
+
+  // Export timeseries (plot_series()) to CSV
   void export_to_csv(const std::string &filename) const;
 
   // ==================================================================
@@ -68,6 +92,11 @@ struct PerformanceMetrics {
   // Print advanced metrics
   void print_advanced_metrics() const;
 
+  // Confidence intervals for the series metrics by block bootstrap of the
+  // P&L path. Needs the FULL timeseries.
+  BootstrapReport bootstrap(const BootstrapConfig &config = BootstrapConfig(),
+                            WorkerPool *pool = nullptr) const;
+
 private:
   // ==================================================================
   // INTERNAL CALCULATION HELPERS
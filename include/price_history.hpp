@@ -0,0 +1,133 @@
+#pragma once
+
+#include "types.hpp" // for InstrumentId
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// PRICE WINDOW (view of the last N prices as up to two contiguous spans)
+// ============================================================================
+
+struct PriceSpan {
+  const double *data;
+  std::size_t size;
+
+  const double *begin() const { return data; }
+  const double *end() const { return data + size; }
+};
+
+// A ring buffer's tail wraps at most once, so any window is `first`
+// (older prices) followed by `second` (newer prices). Kernels should loop
+// over each span directly; operator[] is for convenience only.
+struct PriceWindow {
+  PriceSpan first{nullptr, 0};
+  PriceSpan second{nullptr, 0};
+
+  std::size_t size() const { return first.size + second.size; }
+  bool empty() const { return size() == 0; }
+
+  double operator[](std::size_t i) const {
+    return i < first.size ? first.data[i] : second.data[i - first.size];
+  }
+  double front() const { return (*this)[0]; }
+  double back() const { return (*this)[size() - 1]; }
+
+  // Most recent min(n, size) prices of this window
+  PriceWindow tail(std::size_t n) const {
+    if (n >= size()) {
+      return *this;
+    }
+    PriceWindow result;
+    if (n <= second.size) {
+      result.first = {second.data + (second.size - n), n};
+    } else {
+      std::size_t k = n - second.size;
+      result.first = {first.data + (first.size - k), k};
+      result.second = second;
+    }
+    return result;
+  }
+
+  class const_iterator {
+  public:
+    const_iterator(const PriceWindow *window, std::size_t index)
+        : window_(window), index_(index) {}
+    double operator*() const { return (*window_)[index_]; }
+    const_iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return index_ != other.index_;
+    }
+
+  private:
+    const PriceWindow *window_;
+    std::size_t index_;
+  };
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size()); }
+};
+
+// ============================================================================
+// PRICE HISTORY STORE
+// ============================================================================
+
+// Fixed-capacity price ring per instrument, each ring one contiguous
+// allocation. Capacity is rounded up to a power of two so slot lookup is a
+// mask. Instruments are interned once to a dense InstrumentId; the hot path
+// (push / last) is then hash-free.
+//
+// Rings never move, so a PriceWindow stays valid while the store lives,
+// including across intern() of new instruments. It is a view, though:
+// later pushes to the same instrument overwrite its oldest prices.
+class PriceHistoryStore {
+private:
+  std::size_t capacity_;
+  std::size_t mask_;
+  std::vector<std::unique_ptr<double[]>> rings_; // [instrument][slot]
+  std::vector<std::uint64_t> counts_;  // Total prices pushed per instrument
+  std::unordered_map<std::string, InstrumentId> ids_;
+  std::vector<std::string> symbols_;
+
+  const double *ring(InstrumentId id) const { return rings_[id].get(); }
+
+public:
+  explicit PriceHistoryStore(std::size_t capacity = 1024);
+
+  // ==================================================================
+  // INSTRUMENTS
+  // ==================================================================
+
+  InstrumentId intern(const std::string &symbol);
+  std::optional<InstrumentId> find(const std::string &symbol) const;
+  const std::string &symbol(InstrumentId id) const { return symbols_[id]; }
+  std::size_t instrument_count() const { return symbols_.size(); }
+
+  // ==================================================================
+  // HISTORY
+  // ==================================================================
+
+  void push(InstrumentId id, double price) {
+    rings_[id][counts_[id] & mask_] = price;
+    ++counts_[id];
+  }
+
+  std::size_t capacity() const { return capacity_; }
+  std::uint64_t total_pushed(InstrumentId id) const { return counts_[id]; }
+  std::size_t size(InstrumentId id) const;
+  double last(InstrumentId id) const;
+
+  // Most recent min(n, size) prices, oldest first
+  PriceWindow last_n(InstrumentId id, std::size_t n) const;
+  PriceWindow window(InstrumentId id) const { return last_n(id, capacity_); }
+
+  void clear(InstrumentId id) { counts_[id] = 0; }
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <stdexcept>
+
+// ============================================================================
+// SIMULATION CLOCKS
+// ============================================================================
+
+using Duration = Clock::duration;
+
+// Source of "now" for anything that stamps simulated activity. Components
+// take a SimClock so the same code can run against wall time or virtual
+// time.
+class SimClock {
+public:
+  virtual ~SimClock() = default;
+  virtual TimePoint now() const = 0;
+};
+
+// Real steady_clock time
+class WallClock : public SimClock {
+public:
+  TimePoint now() const override { return Clock::now(); }
+};
+
+// Time that only moves when told to. Starts at a fixed epoch so two runs
+// produce identical timestamps.
+class VirtualClock : public SimClock {
+private:
+  TimePoint now_;
+
+public:
+  explicit VirtualClock(TimePoint start = TimePoint()) : now_(start) {}
+
+  TimePoint now() const override { return now_; }
+
+  void advance_to(TimePoint t) {
+    if (t < now_) {
+      throw std::runtime_error("VirtualClock cannot move backwards");
+    }
+    now_ = t;
+  }
+
+  void advance_by(Duration d) { advance_to(now_ + d); }
+};
+
+// Shared wall clock for components that were not given one
+inline const SimClock &wall_clock() {
+  static const WallClock clock;
+  return clock;
+}
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "pair_statistics.hpp"
 #include "strategy.hpp"
 
+#include <memory>
+
 // ============================================================================
 // SIMPLE MOMENTUM STRATEGY
 // ============================================================================
@@ -23,10 +26,10 @@ public:
   void on_market_data(const MarketDataSnapshot &snapshot) override;
   void on_fill(const Fill &fill) override;
 
-  std::vector<TradingSignal> generate_signals() override;
+  void generate_signals(std::vector<TradingSignal> &signals) override;
 
 private:
-  TradingSignal evaluate_symbol(const std::string &symbol);
+  TradingSignal evaluate_symbol(InstrumentId id);
   bool should_take_profit(const std::string &symbol, double current_price);
   bool should_stop_loss(const std::string &symbol, double current_price);
 };
@@ -49,10 +52,10 @@ public:
   void on_market_data(const MarketDataSnapshot &snapshot) override;
   void on_fill(const Fill &fill) override;
 
-  std::vector<TradingSignal> generate_signals() override;
+  void generate_signals(std::vector<TradingSignal> &signals) override;
 
 private:
-  TradingSignal evaluate_symbol(const std::string &symbol);
+  TradingSignal evaluate_symbol(InstrumentId id);
   double calculate_z_score(const std::string &symbol) const;
 };
 
@@ -67,14 +70,20 @@ private:
   double quote_size_;      // Size of each quote
   double skew_factor_;     // Adjust quotes based on inventory
 
+  double tick_size_;       // Quotes are rounded outward to this grid
+
+public:
   struct Quote {
     double bid_price;
     double ask_price;
     int bid_size;
     int ask_size;
+    int bid_id; // Live order IDs (0 = side not resting)
+    int ask_id;
     TimePoint timestamp;
   };
 
+private:
   std::unordered_map<std::string, Quote> active_quotes_;
 
 public:
@@ -85,7 +94,13 @@ public:
   void on_fill(const Fill &fill) override;
   void on_timer() override;
 
-  std::vector<TradingSignal> generate_signals() override;
+  // Quotes go through mass quotes; no one-shot order signals
+  void generate_signals(std::vector<TradingSignal> &signals) override;
+  void generate_quotes(std::vector<MassQuote> &quotes) override;
+  void on_quote_result(const MassQuote &quote,
+                       const MassQuoteResult &result) override;
+
+  const Quote *get_active_quote(const std::string &symbol) const;
 
 private:
   std::pair<double, double> calculate_quotes(const std::string &symbol,
@@ -101,31 +116,55 @@ private:
 
 class PairsTradingStrategy : public Strategy {
 private:
-  std::string symbol1_;
-  std::string symbol2_;
-  int formation_period_;   // Period to calculate spread
+  std::string symbol1_;    // Dependent leg (y)
+  std::string symbol2_;    // Hedge leg (x)
+  InstrumentId leg1_;
+  InstrumentId leg2_;
+  int formation_period_;   // Rolling-OLS window (samples)
+  double halflife_;        // EW hedge-ratio half-life (samples)
+  HedgeRatioMethod hedge_method_;
   double entry_threshold_; // Z-score to enter
   double exit_threshold_;  // Z-score to exit
+  int leg_quantity_;       // Dependent-leg size per trade
+
+  // Shared with every other pair on the same legs and parameters
+  std::shared_ptr<PairStatistics> pair_stats_;
+  // Filled legs, from this strategy's executions. spread_position_ is the
+  // sign of the dependent leg: +1 long spread (long y), -1 short, 0 flat.
+  int spread_position_;
+  int dependent_position_;
+  int hedge_position_;
 
-  std::deque<double> spread_history_;
-  double spread_mean_;
-  double spread_std_;
-  bool in_trade_;
+  // Direction last ordered: set by an entry, cleared by an exit. Kept apart
+  // from the filled position so resting or rejected legs don't count.
+  int spread_target_;
 
 public:
-  PairsTradingStrategy(const StrategyConfig &config);
+  // Pairs built from the same registry share their hedge-ratio estimator
+  PairsTradingStrategy(
+      const StrategyConfig &config,
+      std::shared_ptr<PairStatisticsRegistry> registry = nullptr);
 
   void initialize() override;
   void on_market_data(const MarketDataSnapshot &snapshot) override;
   void on_fill(const Fill &fill) override;
+  void on_execution(const Fill &fill, const FillContext &context) override;
 
-  std::vector<TradingSignal> generate_signals() override;
+  void generate_signals(std::vector<TradingSignal> &signals) override;
+
+  const PairStatistics &get_pair_statistics() const { return *pair_stats_; }
+  double get_hedge_ratio() const;
+  double calculate_spread_zscore() const;
+  int get_spread_position() const { return spread_position_; }
+  int get_spread_target() const { return spread_target_; }
+  int get_hedge_position() const { return hedge_position_; }
 
 private:
-  void update_spread_statistics();
-  double calculate_current_spread();
-  double calculate_spread_zscore();
-  TradingSignal generate_pair_signal();
+  void add_leg_signal(std::vector<TradingSignal> &signals, InstrumentId leg,
+                      SignalType type, int quantity, double zscore,
+                      SignalReason reason);
+  void close_leg(std::vector<TradingSignal> &signals, InstrumentId leg,
+                 int position, double zscore);
 };
 
 // ============================================================================
@@ -144,8 +183,12 @@ private:
     double avg_volume;
   };
 
+  // Channel as of the previous tick, so a new price can break through it
   std::unordered_map<std::string, Channel> channels_;
 
+  // Rolling average of displayed top-of-book size (volume proxy)
+  std::unordered_map<std::string, IndicatorSet> volume_stats_;
+
 public:
   BreakoutStrategy(const StrategyConfig &config);
 
@@ -153,9 +196,9 @@ public:
   void on_market_data(const MarketDataSnapshot &snapshot) override;
   void on_fill(const Fill &fill) override;
 
-  std::vector<TradingSignal> generate_signals() override;
+  void generate_signals(std::vector<TradingSignal> &signals) override;
 
 private:
-  void update_channel(const std::string &symbol);
-  TradingSignal evaluate_breakout(const std::string &symbol);
+  void update_channel(const MarketDataSnapshot &snapshot);
+  TradingSignal evaluate_breakout(InstrumentId id);
 };
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "fill.hpp"
+#include "indicators.hpp"
+#include "mass_quote.hpp"
 #include "order.hpp"
+#include "price_history.hpp"
+#include "sim_clock.hpp"
 #include "types.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // Forward declarations
@@ -17,18 +24,91 @@ class OrderBook;
 
 enum class SignalType { BUY, SELL, HOLD, CLOSE_LONG, CLOSE_SHORT };
 
+// Why a signal was generated. Static codes (with a numeric detail in
+// TradingSignal::reason_value) keep signal generation allocation-free.
+enum class SignalReason {
+  NONE,
+  TAKE_PROFIT,
+  STOP_LOSS,
+  MOMENTUM_POSITIVE,      // value = momentum %
+  MOMENTUM_NEGATIVE,      // value = momentum %
+  MOMENTUM_REVERSAL_LONG, // value = momentum %
+  MOMENTUM_REVERSAL_SHORT,
+  PRICE_ABOVE_MEAN,       // value = z-score
+  PRICE_BELOW_MEAN,       // value = z-score
+  MEAN_REVERTED_LONG,     // value = z-score
+  MEAN_REVERTED_SHORT,    // value = z-score
+  MARKET_MAKING_BID,
+  MARKET_MAKING_ASK,
+  BREAKOUT_UP,            // value = channel high
+  BREAKOUT_DOWN,          // value = channel low
+  BREAKOUT_FAILED_LONG,
+  BREAKOUT_FAILED_SHORT,
+  PAIR_SPREAD_HIGH,       // value = residual z-score
+  PAIR_SPREAD_LOW,        // value = residual z-score
+  PAIR_SPREAD_REVERTED,   // value = residual z-score
+};
+
+inline const char *signal_reason_to_string(SignalReason reason) {
+  switch (reason) {
+  case SignalReason::NONE:
+    return "None";
+  case SignalReason::TAKE_PROFIT:
+    return "Take profit triggered";
+  case SignalReason::STOP_LOSS:
+    return "Stop loss triggered";
+  case SignalReason::MOMENTUM_POSITIVE:
+    return "Strong positive momentum";
+  case SignalReason::MOMENTUM_NEGATIVE:
+    return "Strong negative momentum";
+  case SignalReason::MOMENTUM_REVERSAL_LONG:
+    return "Momentum reversal (long exit)";
+  case SignalReason::MOMENTUM_REVERSAL_SHORT:
+    return "Momentum reversal (short exit)";
+  case SignalReason::PRICE_ABOVE_MEAN:
+    return "Price above mean";
+  case SignalReason::PRICE_BELOW_MEAN:
+    return "Price below mean";
+  case SignalReason::MEAN_REVERTED_LONG:
+    return "Mean reversion complete (long exit)";
+  case SignalReason::MEAN_REVERTED_SHORT:
+    return "Mean reversion complete (short exit)";
+  case SignalReason::MARKET_MAKING_BID:
+    return "Market making bid";
+  case SignalReason::MARKET_MAKING_ASK:
+    return "Market making ask";
+  case SignalReason::BREAKOUT_UP:
+    return "Upside breakout";
+  case SignalReason::BREAKOUT_DOWN:
+    return "Downside breakout";
+  case SignalReason::BREAKOUT_FAILED_LONG:
+    return "Breakout failed (long exit)";
+  case SignalReason::BREAKOUT_FAILED_SHORT:
+    return "Breakout failed (short exit)";
+  case SignalReason::PAIR_SPREAD_HIGH:
+    return "Pair spread above mean";
+  case SignalReason::PAIR_SPREAD_LOW:
+    return "Pair spread below mean";
+  case SignalReason::PAIR_SPREAD_REVERTED:
+    return "Pair spread reverted";
+  }
+  return "Unknown";
+}
+
 struct TradingSignal {
   SignalType type;
-  std::string symbol;
-  double confidence;   // 0.0 to 1.0
-  double target_price; // Suggested limit price (0 = market order)
+  InstrumentId instrument; // Interned symbol (see Strategy::symbol_of)
+  double confidence;       // 0.0 to 1.0
+  double target_price;     // Suggested limit price (0 = market order)
   int suggested_quantity;
-  std::string reason; // Why this signal was generated
+  SignalReason reason; // Why this signal was generated
+  double reason_value; // Indicator reading behind the reason
   TimePoint timestamp;
 
-  TradingSignal(SignalType t, const std::string &sym, double conf = 1.0)
-      : type(t), symbol(sym), confidence(conf), target_price(0.0),
-        suggested_quantity(0), timestamp(Clock::now()) {}
+  TradingSignal(SignalType t, InstrumentId inst, double conf = 1.0)
+      : type(t), instrument(inst), confidence(conf), target_price(0.0),
+        suggested_quantity(0), reason(SignalReason::NONE), reason_value(0.0),
+        timestamp(Clock::now()) {}
 
   bool is_buy() const { return type == SignalType::BUY; }
   bool is_sell() const { return type == SignalType::SELL; }
@@ -55,23 +135,70 @@ struct TradingSignal {
   }
 };
 
+// ============================================================================
+// FILL CONTEXT
+// ============================================================================
+
+// Ownership details for a fill routed to a strategy
+struct FillContext {
+  int order_id;       // The strategy's order that traded
+  Side side;          // Side of that order
+  std::string symbol; // Instrument the fill occurred on
+  bool is_maker;      // Order was resting (passive) when it traded
+  double fee;         // Fee charged to the strategy's side
+
+  FillContext(int id, Side s, const std::string &sym, bool maker,
+              double fee_)
+      : order_id(id), side(s), symbol(sym), is_maker(maker), fee(fee_) {}
+};
+
 // ============================================================================
 // MARKET DATA SNAPSHOT
 // ============================================================================
 
+enum class MarketDataType : std::uint8_t {
+  BBO,    // Top of book, every simulator step
+  DEPTH,  // Aggregated price levels (reserved: not published, so
+          // subscribing throws)
+  TRADES, // One update per execution: last_price / last_size
+  BARS,   // OHLCV bar at each bar close: open/high/low/last, last_size=volume
+};
+
+constexpr std::size_t MARKET_DATA_TYPE_COUNT = 4;
+
 struct MarketDataSnapshot {
   std::string symbol;
+  MarketDataType type;
   double last_price;
+  double last_size;
   double bid_price;
   double ask_price;
   double bid_size;
   double ask_size;
   double spread;
+  double open_price; // BARS only
+  double high_price; // BARS only
+  double low_price;  // BARS only
   TimePoint timestamp;
 
   MarketDataSnapshot()
-      : symbol(""), last_price(0.0), bid_price(0.0), ask_price(0.0),
-        bid_size(0.0), ask_size(0.0), spread(0.0), timestamp(Clock::now()) {}
+      : symbol(""), type(MarketDataType::BBO), last_price(0.0),
+        last_size(0.0), bid_price(0.0), ask_price(0.0), bid_size(0.0),
+        ask_size(0.0), spread(0.0), open_price(0.0), high_price(0.0),
+        low_price(0.0), timestamp(Clock::now()) {}
+};
+
+// One (instrument, update type) feed a strategy wants delivered.
+// conflation = N delivers only every Nth update (the latest state; the ones
+// in between are dropped) to keep slow consumers off the hot path.
+struct MarketDataSubscription {
+  std::string symbol;
+  MarketDataType type;
+  std::uint32_t conflation;
+
+  MarketDataSubscription(const std::string &sym, MarketDataType t,
+                         std::uint32_t every = 1)
+      : symbol(sym), type(t), conflation(every == 0 ? 1 : every) {}
 };
 
 // ============================================================================
@@ -129,6 +256,12 @@ struct StrategyStats {
   void print() const;
 };
 
+// A strategy's request to be called back after some simulated time
+struct WakeupRequest {
+  Duration delay;
+  std::uint64_t token;
+};
+
 // ============================================================================
 // BASE STRATEGY CLASS
 // ============================================================================
@@ -140,14 +273,39 @@ protected:
   bool is_initialized_;
   int next_order_id_;
 
-  // Price history for each symbol
-  std::unordered_map<std::string, std::deque<double>> price_history_;
+  // Price history for each symbol (ring per instrument, dense IDs)
+  PriceHistoryStore price_history_;
+
+  // Incremental indicators indexed by InstrumentId, advanced by add_price().
+  // New symbols start from a copy of the subscription template.
+  IndicatorSet indicator_template_;
+  std::vector<IndicatorSet> indicators_;
+
+  // config_.symbols, interned at construction (same order)
+  std::vector<InstrumentId> instruments_;
 
   // Current positions (symbol -> quantity, positive=long, negative=short)
   std::unordered_map<std::string, int> positions_;
 
-  // Pending orders that haven't been filled yet
-  std::unordered_map<int, Order> pending_orders_;
+  // Orders live in a book on the strategy's behalf (flat, reused storage).
+  // The simulator drops an order once it fills, dies on arrival (IOC, FOK,
+  // market remainder, reject) or is found finished at the end of a run, so
+  // the size follows live orders rather than orders ever sent.
+  std::vector<Order> pending_orders_;
+
+  // Reused every tick by emit_orders()
+  std::vector<TradingSignal> signal_arena_;
+
+  // Feeds delivered to on_market_data(). Defaults to BBO for each configured
+  // symbol; read by the simulator in add_strategy(), so declare extra feeds
+  // in the constructor.
+  std::vector<MarketDataSubscription> subscriptions_;
+
+  // Wakeups requested from callbacks, scheduled by the simulator
+  std::vector<WakeupRequest> wakeup_requests_;
+
+  // Stamps signals, stats and quotes (wall clock unless set_clock())
+  const SimClock *clock_;
 
 public:
   Strategy(const StrategyConfig &config);
@@ -166,6 +324,10 @@ public:
   void enable() { config_.enabled = true; }
   void disable() { config_.enabled = false; }
 
+  // Take timestamps from `clock` (the simulator passes its virtual clock);
+  // it must outlive the strategy. Restarts the stats clock.
+  void set_clock(const SimClock &clock);
+
   // ========================================================================
   // CALLBACK METHODS (Override in derived classes)
   // ========================================================================
@@ -176,6 +338,10 @@ public:
   // Called when an order is filled
   virtual void on_fill(const Fill &fill) = 0;
 
+  // Called by the simulator for each fill on one of this strategy's orders.
+  // Defaults to on_fill(); override to use the order/side/symbol context.
+  virtual void on_execution(const Fill &fill, const FillContext &context);
+
   // Called when an order is rejected
   virtual void on_order_rejected(int order_id, const std::string &reason);
 
@@ -185,16 +351,34 @@ public:
   // Called periodically (e.g., every second)
   virtual void on_timer();
 
+  // Called when a wakeup asked for with request_wakeup() comes due
+  virtual void on_wakeup(std::uint64_t /* token */) {}
+
+  // Requests made since the simulator last drained them (it clears this)
+  std::vector<WakeupRequest> &pending_wakeups() { return wakeup_requests_; }
+
   // ========================================================================
   // SIGNAL GENERATION (Override in derived classes)
   // ========================================================================
 
-  // Main method to generate trading signals
-  virtual std::vector<TradingSignal> generate_signals() = 0;
+  // Main method to generate trading signals (append to `signals`)
+  virtual void generate_signals(std::vector<TradingSignal> &signals) = 0;
+
+  // Convert signals to orders (append to `orders`)
+  virtual void signals_to_orders(const std::vector<TradingSignal> &signals,
+                                 std::vector<Order> &orders);
 
-  // Convert signals to orders
-  virtual std::vector<Order>
-  signals_to_orders(const std::vector<TradingSignal> &signals);
+  // Generate into the reusable signal arena, stamp the signals with the
+  // strategy's clock and append the resulting orders to the caller's
+  // submission buffer. Allocation-free once buffers are warm.
+  void emit_orders(std::vector<Order> &orders);
+
+  // Two-sided quoting through OrderBook::mass_quote(). Append one MassQuote
+  // per instrument (prices, sizes, live order IDs); the simulator fills in
+  // the account and new order IDs and reports each outcome back.
+  virtual void generate_quotes(std::vector<MassQuote> & /* quotes */) {}
+  virtual void on_quote_result(const MassQuote & /* quote */,
+                               const MassQuoteResult & /* result */) {}
 
   // ========================================================================
   // HELPER METHODS (Available to derived classes)
@@ -207,15 +391,31 @@ public:
   bool is_flat(const std::string &symbol) const;
 
   // Price history
-  void add_price(const std::string &symbol, double price,
-                 size_t max_history = 1000);
-  const std::deque<double> &get_price_history(const std::string &symbol) const;
+  InstrumentId instrument_id(const std::string &symbol);
+  const std::string &symbol_of(InstrumentId id) const {
+    return price_history_.symbol(id);
+  }
+  void add_price(const std::string &symbol, double price);
+  void add_price(InstrumentId id, double price);
+  PriceWindow get_price_history(const std::string &symbol) const;
   double get_last_price(const std::string &symbol) const;
+  double get_last_price(InstrumentId id) const {
+    return price_history_.last(id);
+  }
+
+  // Indicators (subscribe once, read O(1) per tick)
+  void subscribe_indicator(IndicatorType type, size_t period);
+  const IndicatorSet &get_indicators(const std::string &symbol) const;
+  const IndicatorSet &get_indicators(InstrumentId id) const {
+    return indicators_[id];
+  }
 
   // Order management
   void track_order(const Order &order);
   void remove_order(int order_id);
+  void retag_order(int old_id, int new_id); // Order re-numbered downstream
   bool has_pending_orders(const std::string &symbol) const;
+  const std::vector<Order> &pending_orders() const { return pending_orders_; }
 
   // Risk checks
   bool check_risk_limits(const std::string &symbol, int quantity) const;
@@ -240,16 +440,31 @@ public:
   const std::vector<std::string> &get_symbols() const {
     return config_.symbols;
   }
+  const std::vector<InstrumentId> &get_instruments() const {
+    return instruments_;
+  }
+  const std::vector<MarketDataSubscription> &
+  get_market_data_subscriptions() const {
+    return subscriptions_;
+  }
 
 protected:
   // Utility methods for derived strategies
   int generate_order_id() { return next_order_id_++; }
 
+  // Ask to be woken (on_wakeup(token)) after `delay` of simulated time
+  void request_wakeup(Duration delay, std::uint64_t token = 0) {
+    wakeup_requests_.push_back({delay, token});
+  }
+
+  // Add or update (same symbol + type) a market data feed; DEPTH throws
+  void subscribe_market_data(const std::string &symbol, MarketDataType type,
+                             std::uint32_t conflation = 1);
+  void unsubscribe_market_data(const std::string &symbol, MarketDataType type);
+
   // Technical indicators (helpers for strategies)
-  double calculate_sma(const std::deque<double> &prices, size_t period) const;
-  double calculate_ema(const std::deque<double> &prices, size_t period) const;
-  double calculate_stddev(const std::deque<double> &prices,
-                          size_t period) const;
-  double calculate_momentum(const std::deque<double> &prices,
-                            size_t period) const;
+  double calculate_sma(const PriceWindow &prices, size_t period) const;
+  double calculate_ema(const PriceWindow &prices, size_t period) const;
+  double calculate_stddev(const PriceWindow &prices, size_t period) const;
+  double calculate_momentum(const PriceWindow &prices, size_t period) const;
 };
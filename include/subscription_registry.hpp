@@ -0,0 +1,75 @@
+#pragma once
+
+#include "price_history.hpp" // for InstrumentId
+#include "strategy.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// MARKET DATA SUBSCRIPTION REGISTRY
+// ============================================================================
+
+// Per-instrument, per-update-type subscriber lists, built once when
+// strategies are added. publish() walks only the list for the update's
+// instrument and type, so strategies never see symbols they do not trade.
+class SubscriptionRegistry {
+public:
+  struct Subscriber {
+    Strategy *strategy;
+    std::uint32_t conflation; // Deliver every Nth update
+    std::uint32_t pending;    // Updates skipped since the last delivery
+  };
+
+private:
+  using FeedLists = std::array<std::vector<Subscriber>, MARKET_DATA_TYPE_COUNT>;
+
+  std::unordered_map<std::string, InstrumentId> ids_;
+  std::vector<std::string> symbols_;
+  std::vector<FeedLists> feeds_; // Indexed by InstrumentId
+
+  static std::size_t slot(MarketDataType type) {
+    return static_cast<std::size_t>(type);
+  }
+
+public:
+  InstrumentId intern(const std::string &symbol);
+  std::optional<InstrumentId> find(const std::string &symbol) const;
+  const std::string &symbol(InstrumentId id) const { return symbols_[id]; }
+  std::size_t instrument_count() const { return symbols_.size(); }
+
+  // Registers every subscription the strategy declared
+  void add_strategy(Strategy *strategy);
+  void subscribe(Strategy *strategy, const MarketDataSubscription &sub);
+  void remove_strategy(Strategy *strategy);
+
+  std::size_t subscriber_count(InstrumentId id, MarketDataType type) const {
+    return feeds_[id][slot(type)].size();
+  }
+  bool has_subscribers(InstrumentId id, MarketDataType type) const {
+    return !feeds_[id][slot(type)].empty();
+  }
+
+  // Deliver `snapshot` (of type snapshot.type) to the instrument's
+  // subscribers, honouring each subscriber's conflation
+  void publish(InstrumentId id, const MarketDataSnapshot &snapshot);
+
+  // As above, but hands each due subscriber to `deliver(Strategy *,
+  // snapshot)` instead of calling on_market_data() directly
+  template <typename Deliver>
+  void publish(InstrumentId id, const MarketDataSnapshot &snapshot,
+               Deliver &&deliver) {
+    for (auto &subscriber : feeds_[id][slot(snapshot.type)]) {
+      if (++subscriber.pending < subscriber.conflation) {
+        continue;
+      }
+      subscriber.pending = 0;
+      deliver(subscriber.strategy, snapshot);
+    }
+  }
+};
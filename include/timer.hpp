@@ -1,39 +1,38 @@
 #pragma once
 
-#include <chrono>
+#include <cstdint>
 
+#include "tsc_clock.hpp"
+
+// Stopwatch on TscClock: two counter reads, converted to time on demand
 class Timer {
 private:
-  using Clock = std::chrono::high_resolution_clock;
-  using TimePoint = std::chrono::time_point<Clock>;
-
-  TimePoint start_time_;
-  TimePoint end_time_;
+  std::uint64_t start_ticks_;
+  std::uint64_t end_ticks_;
   bool is_running_;
 
 public:
-  Timer() : is_running_(false) {}
+  Timer() : start_ticks_(0), end_ticks_(0), is_running_(false) {}
 
   void start() {
-    start_time_ = Clock::now();
+    start_ticks_ = TscClock::start();
     is_running_ = true;
   }
 
   void stop() {
-    end_time_ = Clock::now();
+    end_ticks_ = TscClock::stop();
     is_running_ = false;
   }
 
+  std::uint64_t start_ticks() const { return start_ticks_; }
+  std::uint64_t elapsed_ticks() const { return end_ticks_ - start_ticks_; }
+
   long long elapsed_microseconds() const {
-    auto duration = end_time_ - start_time_;
-    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
-        .count();
+    return elapsed_nanoseconds() / 1000;
   }
 
   long long elapsed_nanoseconds() const {
-    auto duration = end_time_ - start_time_;
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
-        .count();
+    return static_cast<long long>(TscClock::to_nanoseconds(elapsed_ticks()));
   }
 
   double elapsed_milliseconds() const {
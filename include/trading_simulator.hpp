@@ -1,45 +1,271 @@
 #pragma once
 
-#include <cstddef>  // for size_t
-#include <fstream>  // for std::ofstream (if exporting results)
-#include <iostream> // for std::cout, std::endl (if printing reports)
-#include <memory>   // for std::unique_ptr
-#include <string>   // for std::string
-#include <vector>   // for std::vector
+#include <algorithm>     // for std::max, std::min
+#include <cstddef>       // for size_t
+#include <cstdint>       // for SIZE_MAX, std::int64_t
+#include <fstream>       // for std::ofstream (if exporting results)
+#include <iostream>      // for std::cout, std::endl (if printing reports)
+#include <memory>        // for std::unique_ptr
+#include <optional>      // for std::optional
+#include <string>        // for std::string
+#include <unordered_map> // for std::unordered_map
+#include <variant>       // for std::variant
+#include <vector>        // for std::vector
 
 // project headers
+#include "correlated_market_data.hpp" // for CorrelatedShockGenerator
+#include "event_log.hpp"        // for EventLogReader
+#include "event_scheduler.hpp"  // for EventScheduler, VirtualClock
+#include "latency_model.hpp"    // for LatencyModel, DelayQueue
+#include "market_data_generator.hpp" // for MarketDataGenerator
 #include "order_book.hpp"       // for OrderBook
 #include "position_manager.hpp" // for PositionManager
 #include "strategy.hpp"         // for Strategy
+#include "subscription_registry.hpp" // for SubscriptionRegistry
+#include "worker_pool.hpp"      // for WorkerPool
 
 // include/trading_simulator.hpp
 class TradingSimulator {
 private:
-  OrderBook order_book_;
+  // Virtual time: every simulated timestamp comes from clock_, and
+  // run_simulation() is driven by scheduler_
+  VirtualClock clock_;
+  EventScheduler scheduler_;
+  Duration step_interval_;  // Virtual time between market data steps
+  Duration timer_interval_; // 0 = strategy timers fire every step
+  EventScheduler::EventId timer_event_; // Next timer, 0 = none pending
+
   PositionManager position_manager_;
   std::vector<std::unique_ptr<Strategy>> strategies_;
 
-  int next_order_id_;
+  // Fill dispatch table: account -> owning strategy (one strategy per
+  // account), built in add_strategy()
+  std::unordered_map<int, Strategy *> strategy_by_account_;
+
+  // Strategies emit straight into this buffer; reused every step
+  std::vector<Order> submission_buffer_;
+  std::vector<MassQuote> quote_buffer_;
+
+  // Latency between the book and a strategy, per path. Only strategies
+  // with at least one model have a link; the rest are served inline.
+  // Each queue is FIFO, so it needs just one scheduler event (for its
+  // head) no matter how many messages are in flight.
+  struct FillNotice {
+    Fill fill;
+    FillContext context;
+  };
+  using OrderEntry = std::variant<Order, MassQuote>;
+
+  struct LatencyLink {
+    Strategy *strategy = nullptr;
+    std::unique_ptr<LatencyModel> models[LATENCY_PATH_COUNT];
+    DelayQueue<MarketDataSnapshot> market_data;
+    DelayQueue<OrderEntry> orders;
+    DelayQueue<FillNotice> fills;
+
+    LatencyModel *model(LatencyPath path) const {
+      return models[static_cast<size_t>(path)].get();
+    }
+  };
+  std::unordered_map<const Strategy *, LatencyLink> latency_links_;
+
+  // Market data fan-out: only subscribers of a venue's symbol (and of the
+  // update type) see each update
+  SubscriptionRegistry subscriptions_;
+
+  struct TradePrint {
+    double price;
+    double quantity;
+    TimePoint timestamp;
+  };
+
+  // Bar under construction (mid price per step, volume from trades)
+  struct BarState {
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    double volume = 0.0;
+    size_t steps = 0;
+
+    void add(double price) {
+      if (open == 0.0) {
+        open = high = low = price;
+      }
+      high = std::max(high, price);
+      low = std::min(low, price);
+      close = price;
+    }
+  };
+
+  // One hosted instrument: its book, optional synthetic flow and feed
+  // state. Venues only share state at synchronization points, so the
+  // first phase of each step runs them in parallel.
+  struct Venue {
+    OrderBook book;
+    InstrumentId feed; // Instrument in subscriptions_
+    std::unique_ptr<MarketDataGenerator> generator;
+    double market_order_probability = 0.25;
+    bool correlated = false; // Mid driven by shocks_, not its own noise
+    double shock = 0.0;      // This step's draw, set before the phase
+
+    // Fills from the parallel phase, dispatched at the next sync point
+    bool defer_fills = false;
+    std::vector<EnhancedFill> deferred_fills;
+
+    // Recorded flow replayed as background liquidity, streamed from disk.
+    // Log time + replay_offset = virtual time.
+    std::unique_ptr<EventLogReader> replay;
+    std::optional<OrderEvent> next_replay;
+    Duration replay_offset{};
+    size_t replayed_events = 0;
+
+    MarketDataSnapshot bbo; // Built in the parallel phase
+    std::vector<TradePrint> trade_prints; // Published as TRADES each step
+    BarState bar;
+
+    explicit Venue(const std::string &symbol) : book(symbol), feed(0) {}
+  };
+  std::vector<std::unique_ptr<Venue>> venues_; // [0] = constructor symbol
+  std::unordered_map<std::string, size_t> venue_by_symbol_;
+
+  // Correlated universe: one joint draw per step, handed out to the
+  // member venues before they advance, so the parallel phase stays
+  // deterministic
+  std::unique_ptr<CorrelatedShockGenerator> shocks_;
+  std::vector<size_t> correlated_venues_;
+  std::vector<double> shock_buffer_;
+
+  // Strategy InstrumentId -> venue index, filled in lazily by route()
+  static constexpr size_t NO_VENUE = SIZE_MAX;
+  std::unordered_map<const Strategy *, std::vector<size_t>> routes_;
+  size_t unrouted_orders_;
+  size_t background_fills_; // Replayed flow trading with itself
+
+  std::unique_ptr<WorkerPool> workers_; // Null = step venues serially
+
+  size_t bar_interval_; // Steps per bar
+  MarketDataSnapshot update_; // Reused for TRADES / BARS updates
+
+  std::int64_t next_order_id_; // Wide, so exhaustion is seen, not wrapped
   bool is_running_;
 
-  void process_fills();
+  Venue &venue(const std::string &symbol);
+  void check_generator(const MarketDataGenerator::Config &generator) const;
+  InstrumentId attach_generator(const MarketDataGenerator::Config &generator,
+                                double market_order_probability);
+  size_t route(const Strategy &strategy, InstrumentId instrument);
+  void advance_venue(Venue &venue);
+  void schedule_replay(Venue &venue);
+  void replay_due(Venue &venue);
+  void ensure_replay_account(int account_id);
+  void dispatch_fill(Venue &venue, const EnhancedFill &fill);
+  void notify_strategy(const EnhancedFill &fill, Side side);
+  void publish(const Venue &venue, const MarketDataSnapshot &update);
+  void publish_trades(Venue &venue);
+  void update_bar(Venue &venue);
+  void schedule_step(size_t step, size_t num_steps);
+  void schedule_timers();
+  void run_timers();
+  void drain_wakeups(Strategy &strategy);
+  int allocate_order_id(); // Next strategy order ID; throws once exhausted
+
+  // Strategy -> book (orders and quotes), inline or via the latency link
+  void submit_orders(Strategy &strategy);
+  void enter_order(Strategy &strategy, OrderEntry &entry);
+  void prune_finished_orders(); // Drop tracking of orders no longer live
+  LatencyLink *find_link(const Strategy *strategy);
+  LatencyLink &link_for_account(int account_id);
+  void release_market_data(LatencyLink &link);
+  void release_orders(LatencyLink &link);
+  void release_fills(LatencyLink &link);
 
 public:
-  TradingSimulator();
+  // Order IDs are partitioned: recorded and generated flow below
+  // STRATEGY_ORDER_ID_BASE, strategy orders from there up to INT_MAX
+  // (about 1.07e9 IDs per simulator; running out throws). Replayed
+  // accounts are moved up by REPLAY_ACCOUNT_BASE, so neither can collide
+  // with recorded flow and every fill is attributable to one or the other
+  static constexpr int STRATEGY_ORDER_ID_BASE = 1 << 30;
+  static constexpr int REPLAY_ACCOUNT_BASE = 1 << 30;
+
+  static bool is_strategy_order(int order_id) {
+    return order_id >= STRATEGY_ORDER_ID_BASE;
+  }
+  static bool is_replay_account(int account_id) {
+    return account_id >= REPLAY_ACCOUNT_BASE;
+  }
+
+  // Hosts `symbol` as the primary instrument
+  explicit TradingSimulator(const std::string &symbol = "SIM");
 
   // Setup
   void setup();
-  void add_strategy(std::unique_ptr<Strategy> strategy);
+  void add_strategy(std::unique_ptr<Strategy> strategy); // Hosts its symbols
+  InstrumentId add_instrument(const std::string &symbol);
+  // Generated flow for the symbol; throws if it already has a generator
+  InstrumentId add_instrument(const MarketDataGenerator::Config &generator,
+                              double market_order_probability = 0.25);
+  // Host every symbol of `universe` with generated flow whose mids move
+  // together under its correlation model. One universe per simulator; a
+  // universe that fails validation adds nothing.
+  std::vector<InstrumentId>
+  add_universe(const MultiAssetMarketDataGenerator::Config &universe,
+               double market_order_probability = 0.25);
+  // Replay a recorded event log (OrderBook::save_events() CSV) into the
+  // symbol's book as background flow. The first event lands at the
+  // current virtual time and later ones keep their recorded spacing.
+  // Throws for a symbol with generated flow (the order IDs would collide);
+  // an event whose order ID or account falls in the strategy / replay
+  // ranges throws when it is replayed (the log is streamed).
+  InstrumentId add_replay(const std::string &symbol,
+                          const std::string &filename);
   void create_account(int account_id, const std::string &name,
                       double initial_cash);
+  void set_bar_interval(size_t steps);
+  void set_step_interval(Duration interval);
+  void set_timer_interval(Duration interval);
+  void set_worker_threads(size_t threads); // Parallel venue stepping
 
   // Execution
-  void run_simulation(size_t num_steps);
-  void process_step(); // One simulation tick
+  void run_simulation(size_t num_steps); // Event-driven, in virtual time
+  void process_step();                   // One simulation tick, run now
+  void stop() { is_running_ = false; }
+
+  // Timed events (virtual time)
+  EventScheduler::EventId schedule_order(const Order &order, TimePoint at);
+  EventScheduler::EventId schedule_order(const std::string &symbol,
+                                         const Order &order, TimePoint at);
+  EventScheduler::EventId schedule_wakeup(Strategy &strategy, Duration delay,
+                                          std::uint64_t token = 0);
+  const VirtualClock &get_clock() const { return clock_; }
+  EventScheduler &get_scheduler() { return scheduler_; }
+
+  // Latency (virtual time). add_strategy() installs any models configured
+  // in the strategy's parameters (see make_latency_model()); this sets or,
+  // with nullptr, clears one path afterwards.
+  void set_latency_model(int account_id, LatencyPath path,
+                         std::unique_ptr<LatencyModel> model);
+  size_t in_flight(int account_id, LatencyPath path);
 
   // Results
   void print_final_report();
   void export_results(const std::string &filename);
 
-  OrderBook &get_order_book() { return order_book_; }
+  const PositionManager &get_position_manager() const {
+    return position_manager_;
+  }
+  OrderBook &get_order_book() { return venues_.front()->book; } // Primary
+  OrderBook &get_order_book(const std::string &symbol) {
+    return venue(symbol).book;
+  }
+  size_t instrument_count() const { return venues_.size(); }
+  size_t unrouted_orders() const { return unrouted_orders_; }
+  size_t replayed_events(const std::string &symbol) {
+    return venue(symbol).replayed_events;
+  }
+  size_t background_fills() const { return background_fills_; }
+  const SubscriptionRegistry &get_subscriptions() const {
+    return subscriptions_;
+  }
 };
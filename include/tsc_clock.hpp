@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define TSC_CLOCK_X86 1
+#include <x86intrin.h>
+#else
+#define TSC_CLOCK_X86 0
+#endif
+
+// Cycle-counter clock for interval timing. On x86 with an invariant TSC
+// (constant rate across P-states, C-states and cores) ticks are read with
+// rdtsc in a few ns; elsewhere ticks are steady_clock nanoseconds.
+//
+// The tick rate is calibrated against steady_clock (a couple of ms of
+// spinning) during static initialization, before main(), so no timed
+// region pays for it. Code running from other static initializers should
+// call init() first. The 2 ms window leaves a relative rate error of
+// roughly 1e-5; recalibrate() measures again over the whole time since
+// calibration, so call it outside timed regions once a process has run
+// for a while (say between benchmark phases or before a periodic report)
+// to keep long intervals and large tick sums accurate.
+class TscClock {
+public:
+  // Calibrate now if that has not happened yet; cheap afterwards
+  static void init() { state(); }
+
+  // Unfenced read: cheapest, may be reordered with nearby instructions
+  static std::uint64_t now() {
+#if TSC_CLOCK_X86
+    if (state().use_tsc) {
+      return __rdtsc();
+    }
+#endif
+    return steady_ns();
+  }
+
+  // Start of a measured region: later instructions wait for the read
+  static std::uint64_t start() {
+#if TSC_CLOCK_X86
+    if (state().use_tsc) {
+      std::uint64_t ticks = __rdtsc();
+      _mm_lfence();
+      return ticks;
+    }
+#endif
+    return steady_ns();
+  }
+
+  // End of a measured region: the read waits for earlier instructions
+  static std::uint64_t stop() {
+#if TSC_CLOCK_X86
+    if (state().use_tsc) {
+      unsigned aux;
+      std::uint64_t ticks = __rdtscp(&aux);
+      _mm_lfence();
+      return ticks;
+    }
+#endif
+    return steady_ns();
+  }
+
+  static double to_nanoseconds(std::uint64_t ticks) {
+    return static_cast<double>(ticks) *
+           state().ns_per_tick.load(std::memory_order_relaxed);
+  }
+
+  // True when ticks come from the TSC rather than steady_clock
+  static bool uses_tsc() { return state().use_tsc; }
+  static double ns_per_tick() {
+    return state().ns_per_tick.load(std::memory_order_relaxed);
+  }
+
+  // Re-measure the tick rate over the time since calibration
+  static void recalibrate();
+
+private:
+  struct State {
+    bool use_tsc;
+    std::atomic<double> ns_per_tick;
+    std::uint64_t base_ticks; // Calibration reference point
+    std::int64_t base_ns;
+
+    State();
+  };
+
+  static State &state() {
+    static State instance;
+    return instance;
+  }
+
+  static std::uint64_t steady_ns() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+
+  static bool tsc_is_invariant();
+  // A (ticks, steady ns) pair read as close together as possible
+  static void sample(std::uint64_t &ticks, std::int64_t &ns);
+};
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 
 // Common type aliases
 using Clock = std::chrono::steady_clock;
 using TimePoint = std::chrono::time_point<Clock>;
 
+// Dense instrument identifier (index into per-instrument tables)
+using InstrumentId = std::uint32_t;
+
 // Order side of book
 enum class Side { BUY, SELL };
 
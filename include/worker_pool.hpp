@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// WORKER POOL (fork-join over an index range)
+// ============================================================================
+
+// Persistent threads for short, repeated parallel sections such as one
+// simulator step across many instruments. parallel_for() hands out indices
+// from a shared counter, the calling thread works too, and the call
+// returns once every index is done, which makes each call a
+// synchronization point. The first exception thrown by a task is
+// rethrown to the caller.
+class WorkerPool {
+public:
+  using Task = std::function<void(std::size_t)>;
+
+private:
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+
+  // Current job (guarded by mutex_, except the index counter)
+  const Task *task_;
+  std::size_t task_count_;
+  std::atomic<std::size_t> next_index_;
+  std::size_t active_workers_;
+  std::uint64_t generation_;
+  std::exception_ptr error_;
+  bool stopping_;
+
+  void worker_loop();
+  void work(const Task &task, std::size_t count);
+
+public:
+  // `threads` includes the caller; 0 or 1 runs everything inline
+  explicit WorkerPool(std::size_t threads);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  std::size_t size() const { return threads_.size() + 1; }
+
+  void parallel_for(std::size_t count, const Task &task);
+};
@@ -0,0 +1,508 @@
+#include "batch_indicators.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define BATCH_HAS_AVX2 1
+#include <immintrin.h>
+#else
+#define BATCH_HAS_AVX2 0
+#endif
+
+namespace {
+
+SimdLevel g_simd_level = detect_simd_level();
+
+// ============================================================================
+// SCALAR KERNELS
+// ============================================================================
+//
+// Windowed sums slide in O(1) per output and are re-summed from scratch
+// every `period` outputs, so rounding drift stays bounded while the whole
+// pass stays O(n).
+
+double window_sum(const double *window, std::size_t period) {
+  double sum = 0.0;
+  for (std::size_t k = 0; k < period; ++k) {
+    sum += window[k];
+  }
+  return sum;
+}
+
+void sma_scalar(const double *p, std::size_t n, std::size_t period,
+                std::size_t from, double *out) {
+  double sum = 0.0;
+  std::size_t resync = from;
+  for (std::size_t i = from; i < n; ++i) {
+    if (i == resync) {
+      sum = window_sum(p + i + 1 - period, period);
+      resync = i + period;
+    } else {
+      sum += p[i] - p[i - period];
+    }
+    out[i] = sum / period;
+  }
+}
+
+// Moments are taken about the window's first price at each resync, which
+// keeps E[x^2] - E[x]^2 from cancelling at price levels far from zero
+void stddev_scalar(const double *p, std::size_t n, std::size_t period,
+                   std::size_t from, double *out) {
+  double shift = 0.0;
+  double sum = 0.0;
+  double sum_squared = 0.0;
+  std::size_t resync = from;
+  for (std::size_t i = from; i < n; ++i) {
+    if (i == resync) {
+      const double *window = p + i + 1 - period;
+      shift = window[0];
+      sum = 0.0;
+      sum_squared = 0.0;
+      for (std::size_t k = 0; k < period; ++k) {
+        double d = window[k] - shift;
+        sum += d;
+        sum_squared += d * d;
+      }
+      resync = i + period;
+    } else {
+      double in = p[i] - shift;
+      double out_d = p[i - period] - shift;
+      sum += in - out_d;
+      sum_squared += in * in - out_d * out_d;
+    }
+    double mean = sum / period;
+    out[i] = std::sqrt(std::max(0.0, sum_squared / period - mean * mean));
+  }
+}
+
+void momentum_scalar(const double *p, std::size_t n, std::size_t period,
+                     std::size_t from, double *out) {
+  for (std::size_t i = from; i < n; ++i) {
+    double past = p[i - period];
+    out[i] = (past == 0.0) ? 0.0 : ((p[i] - past) / past) * 100.0;
+  }
+}
+
+// Channel windows use van Herk / Gil-Werman: with `forward` holding running
+// extremes from each period-aligned block start and `backward` running
+// extremes to each block end, window [i - period + 1, i] is the extreme of
+// backward[i - period + 1] and forward[i].
+template <typename Pick>
+void block_extremes(const double *p, std::size_t n, std::size_t period,
+                    Pick pick, double *forward, double *backward) {
+  for (std::size_t i = 0; i < n; ++i) {
+    forward[i] = (i % period == 0) ? p[i] : pick(forward[i - 1], p[i]);
+  }
+  for (std::size_t i = n; i-- > 0;) {
+    bool block_end = (i + 1) % period == 0 || i + 1 == n;
+    backward[i] = block_end ? p[i] : pick(backward[i + 1], p[i]);
+  }
+}
+
+void channel_scalar(std::size_t n, std::size_t period, std::size_t from,
+                    const double *high_fwd, const double *high_bwd,
+                    const double *low_fwd, const double *low_bwd,
+                    double *out_high, double *out_low) {
+  for (std::size_t i = from; i < n; ++i) {
+    std::size_t start = i + 1 - period;
+    out_high[i] = std::max(high_bwd[start], high_fwd[i]);
+    out_low[i] = std::min(low_bwd[start], low_fwd[i]);
+  }
+}
+
+// ============================================================================
+// AVX2 KERNELS (four consecutive output windows per register)
+// ============================================================================
+
+#if BATCH_HAS_AVX2
+
+// Lane j of the window ending at i + j, minus lane j of the window ending
+// four prices earlier: the four prices that entered minus the four that left
+__attribute__((target("avx2"))) inline __m256d
+slide4(const double *p, std::size_t i, std::size_t period, __m256d shift) {
+  __m256d delta = _mm256_setzero_pd();
+  for (std::size_t k = 0; k < 4; ++k) {
+    __m256d in = _mm256_sub_pd(_mm256_loadu_pd(p + i - 3 + k), shift);
+    __m256d out = _mm256_sub_pd(_mm256_loadu_pd(p + i - 3 + k - period), shift);
+    delta = _mm256_add_pd(delta, _mm256_sub_pd(in, out));
+  }
+  return delta;
+}
+
+__attribute__((target("avx2"))) inline __m256d
+slide4_squared(const double *p, std::size_t i, std::size_t period,
+               __m256d shift) {
+  __m256d delta = _mm256_setzero_pd();
+  for (std::size_t k = 0; k < 4; ++k) {
+    __m256d in = _mm256_sub_pd(_mm256_loadu_pd(p + i - 3 + k), shift);
+    __m256d out = _mm256_sub_pd(_mm256_loadu_pd(p + i - 3 + k - period), shift);
+    delta = _mm256_add_pd(
+        delta, _mm256_sub_pd(_mm256_mul_pd(in, in), _mm256_mul_pd(out, out)));
+  }
+  return delta;
+}
+
+__attribute__((target("avx2"))) std::size_t
+sma_avx2(const double *p, std::size_t n, std::size_t period, std::size_t i,
+         double *out) {
+  const __m256d divisor = _mm256_set1_pd(static_cast<double>(period));
+  const __m256d zero = _mm256_setzero_pd();
+  while (i + 4 <= n) {
+    const double *window = p + i + 1 - period;
+    __m256d sum = _mm256_setzero_pd();
+    for (std::size_t k = 0; k < period; ++k) {
+      sum = _mm256_add_pd(sum, _mm256_loadu_pd(window + k));
+    }
+    _mm256_storeu_pd(out + i, _mm256_div_pd(sum, divisor));
+
+    const std::size_t resync = i + period;
+    for (i += 4; i + 4 <= n && i < resync; i += 4) {
+      sum = _mm256_add_pd(sum, slide4(p, i, period, zero));
+      _mm256_storeu_pd(out + i, _mm256_div_pd(sum, divisor));
+    }
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t
+stddev_avx2(const double *p, std::size_t n, std::size_t period, std::size_t i,
+            double *out) {
+  const __m256d divisor = _mm256_set1_pd(static_cast<double>(period));
+  const __m256d zero = _mm256_setzero_pd();
+  while (i + 4 <= n) {
+    const double *window = p + i + 1 - period;
+    const __m256d shift = _mm256_set1_pd(window[0]);
+    __m256d sum = _mm256_setzero_pd();
+    __m256d sum_squared = _mm256_setzero_pd();
+    for (std::size_t k = 0; k < period; ++k) {
+      __m256d d = _mm256_sub_pd(_mm256_loadu_pd(window + k), shift);
+      sum = _mm256_add_pd(sum, d);
+      sum_squared = _mm256_add_pd(sum_squared, _mm256_mul_pd(d, d));
+    }
+
+    const std::size_t resync = i + period;
+    while (true) {
+      __m256d mean = _mm256_div_pd(sum, divisor);
+      __m256d variance = _mm256_sub_pd(_mm256_div_pd(sum_squared, divisor),
+                                       _mm256_mul_pd(mean, mean));
+      _mm256_storeu_pd(out + i,
+                       _mm256_sqrt_pd(_mm256_max_pd(variance, zero)));
+      i += 4;
+      if (i + 4 > n || i >= resync) {
+        break;
+      }
+      sum = _mm256_add_pd(sum, slide4(p, i, period, shift));
+      sum_squared = _mm256_add_pd(sum_squared,
+                                  slide4_squared(p, i, period, shift));
+    }
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t
+momentum_avx2(const double *p, std::size_t n, std::size_t period,
+              std::size_t i, double *out) {
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d hundred = _mm256_set1_pd(100.0);
+  for (; i + 4 <= n; i += 4) {
+    __m256d current = _mm256_loadu_pd(p + i);
+    __m256d past = _mm256_loadu_pd(p + i - period);
+    __m256d change = _mm256_mul_pd(
+        _mm256_div_pd(_mm256_sub_pd(current, past), past), hundred);
+    // Lanes with a zero reference price report 0.0, like the scalar helper
+    __m256d past_is_zero = _mm256_cmp_pd(past, zero, _CMP_EQ_OQ);
+    _mm256_storeu_pd(out + i, _mm256_blendv_pd(change, zero, past_is_zero));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t
+channel_avx2(std::size_t n, std::size_t period, std::size_t i,
+             const double *high_fwd, const double *high_bwd,
+             const double *low_fwd, const double *low_bwd, double *out_high,
+             double *out_low) {
+  for (; i + 4 <= n; i += 4) {
+    std::size_t start = i + 1 - period;
+    _mm256_storeu_pd(out_high + i,
+                     _mm256_max_pd(_mm256_loadu_pd(high_bwd + start),
+                                   _mm256_loadu_pd(high_fwd + i)));
+    _mm256_storeu_pd(out_low + i,
+                     _mm256_min_pd(_mm256_loadu_pd(low_bwd + start),
+                                   _mm256_loadu_pd(low_fwd + i)));
+  }
+  return i;
+}
+
+#endif // BATCH_HAS_AVX2
+
+// First output index with a full window; everything before it is 0.0
+std::size_t zero_warmup(std::size_t n, std::size_t ready_at, double *out) {
+  std::size_t first = std::min(n, ready_at);
+  std::fill(out, out + first, 0.0);
+  return first;
+}
+
+bool use_avx2() {
+#if BATCH_HAS_AVX2
+  return g_simd_level == SimdLevel::AVX2;
+#else
+  return false;
+#endif
+}
+
+} // namespace
+
+// ============================================================================
+// DISPATCH
+// ============================================================================
+
+SimdLevel detect_simd_level() {
+#if BATCH_HAS_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+#endif
+  return SimdLevel::SCALAR;
+}
+
+SimdLevel batch_simd_level() { return g_simd_level; }
+
+void set_batch_simd_level(SimdLevel level) {
+  g_simd_level =
+      (level == SimdLevel::AVX2) ? detect_simd_level() : SimdLevel::SCALAR;
+}
+
+const char *simd_level_to_string(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::AVX2:
+    return "AVX2";
+  case SimdLevel::SCALAR:
+    return "SCALAR";
+  }
+  return "UNKNOWN";
+}
+
+// ============================================================================
+// KERNELS
+// ============================================================================
+
+void batch_sma(const double *prices, std::size_t n, std::size_t period,
+               double *out) {
+  if (period == 0) {
+    std::fill(out, out + n, 0.0);
+    return;
+  }
+
+  std::size_t i = zero_warmup(n, period - 1, out);
+#if BATCH_HAS_AVX2
+  if (use_avx2()) {
+    i = sma_avx2(prices, n, period, i, out);
+  }
+#endif
+  sma_scalar(prices, n, period, i, out);
+}
+
+void batch_ema(const double *prices, std::size_t n, std::size_t period,
+               double *out) {
+  if (period == 0) {
+    std::fill(out, out + n, 0.0);
+    return;
+  }
+
+  std::size_t first = zero_warmup(n, period - 1, out);
+  if (first >= n) {
+    return;
+  }
+
+  // Strategy::calculate_ema seeds with the SMA of the *latest* window and
+  // then recurses over prices[period..i]. The recurrence is linear, so that
+  // is decay^(i - period + 1) * sma[i] plus an EMA of prices[period..i]
+  // started from zero; both terms update in O(1) per output.
+  sma_scalar(prices, n, period, first, out);
+  const double alpha = 2.0 / (period + 1.0);
+  double decay = 1.0;
+  double recursed = 0.0;
+  for (std::size_t i = first + 1; i < n; ++i) {
+    decay *= 1.0 - alpha;
+    recursed += (prices[i] - recursed) * alpha;
+    out[i] = decay * out[i] + recursed;
+  }
+}
+
+void batch_stddev(const double *prices, std::size_t n, std::size_t period,
+                  double *out) {
+  if (period == 0) {
+    std::fill(out, out + n, 0.0);
+    return;
+  }
+
+  std::size_t i = zero_warmup(n, period - 1, out);
+#if BATCH_HAS_AVX2
+  if (use_avx2()) {
+    i = stddev_avx2(prices, n, period, i, out);
+  }
+#endif
+  stddev_scalar(prices, n, period, i, out);
+}
+
+void batch_zscore(const double *prices, std::size_t n, std::size_t period,
+                  double *out) {
+  std::vector<double> mean(n);
+  std::vector<double> stddev(n);
+  batch_sma(prices, n, period, mean.data());
+  batch_stddev(prices, n, period, stddev.data());
+
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = (stddev[i] == 0.0) ? 0.0 : (prices[i] - mean[i]) / stddev[i];
+  }
+}
+
+void batch_momentum(const double *prices, std::size_t n, std::size_t period,
+                    double *out) {
+  std::size_t i = zero_warmup(n, period, out);
+#if BATCH_HAS_AVX2
+  if (use_avx2()) {
+    i = momentum_avx2(prices, n, period, i, out);
+  }
+#endif
+  momentum_scalar(prices, n, period, i, out);
+}
+
+void batch_channel(const double *prices, std::size_t n, std::size_t period,
+                   double *out_high, double *out_low) {
+  if (period == 0) {
+    std::fill(out_high, out_high + n, 0.0);
+    std::fill(out_low, out_low + n, 0.0);
+    return;
+  }
+
+  zero_warmup(n, period - 1, out_low);
+  std::size_t i = zero_warmup(n, period - 1, out_high);
+  if (i >= n) {
+    return;
+  }
+
+  std::vector<double> high_fwd(n), high_bwd(n), low_fwd(n), low_bwd(n);
+  block_extremes(
+      prices, n, period, [](double a, double b) { return std::max(a, b); },
+      high_fwd.data(), high_bwd.data());
+  block_extremes(
+      prices, n, period, [](double a, double b) { return std::min(a, b); },
+      low_fwd.data(), low_bwd.data());
+#if BATCH_HAS_AVX2
+  if (use_avx2()) {
+    i = channel_avx2(n, period, i, high_fwd.data(), high_bwd.data(),
+                     low_fwd.data(), low_bwd.data(), out_high, out_low);
+  }
+#endif
+  channel_scalar(n, period, i, high_fwd.data(), high_bwd.data(),
+                 low_fwd.data(), low_bwd.data(), out_high, out_low);
+}
+
+// ============================================================================
+// SIGNAL PASSES
+// ============================================================================
+
+std::vector<SignalType>
+batch_momentum_signals(const std::vector<double> &prices,
+                       const MomentumSignalParams &params) {
+  const std::size_t n = prices.size();
+  std::vector<SignalType> signals(n, SignalType::HOLD);
+  std::vector<double> momentum(n);
+  batch_momentum(prices.data(), n, params.lookback_period, momentum.data());
+
+  int position = 0;
+  double entry_price = 0.0;
+
+  for (std::size_t i = params.lookback_period; i < n; ++i) {
+    double price = prices[i];
+    double m = momentum[i];
+    SignalType signal = SignalType::HOLD;
+
+    if (position != 0 && entry_price != 0.0) {
+      double gain_pct = (position > 0)
+                            ? ((price - entry_price) / entry_price) * 100.0
+                            : ((entry_price - price) / entry_price) * 100.0;
+      if (gain_pct >= params.take_profit || -gain_pct >= params.stop_loss) {
+        signal = position > 0 ? SignalType::CLOSE_LONG
+                              : SignalType::CLOSE_SHORT;
+      }
+    }
+
+    if (signal == SignalType::HOLD) {
+      if (position == 0 && m > params.entry_threshold) {
+        signal = SignalType::BUY;
+      } else if (position == 0 && m < -params.entry_threshold) {
+        signal = SignalType::SELL;
+      } else if (position > 0 && m < params.exit_threshold) {
+        signal = SignalType::CLOSE_LONG;
+      } else if (position < 0 && m > -params.exit_threshold) {
+        signal = SignalType::CLOSE_SHORT;
+      }
+    }
+
+    switch (signal) {
+    case SignalType::BUY:
+      position = params.quantity;
+      entry_price = price;
+      break;
+    case SignalType::SELL:
+      position = -params.quantity;
+      entry_price = price;
+      break;
+    case SignalType::CLOSE_LONG:
+    case SignalType::CLOSE_SHORT:
+      position = 0;
+      entry_price = 0.0;
+      break;
+    case SignalType::HOLD:
+      break;
+    }
+    signals[i] = signal;
+  }
+
+  return signals;
+}
+
+std::vector<SignalType>
+batch_mean_reversion_signals(const std::vector<double> &prices,
+                             const MeanReversionSignalParams &params) {
+  const std::size_t n = prices.size();
+  std::vector<SignalType> signals(n, SignalType::HOLD);
+  if (params.lookback_period == 0) {
+    return signals;
+  }
+
+  std::vector<double> z_scores(n);
+  batch_zscore(prices.data(), n, params.lookback_period, z_scores.data());
+
+  const int quantity =
+      static_cast<int>(100 * (params.position_size_pct / 100.0));
+  int position = 0;
+
+  for (std::size_t i = params.lookback_period - 1; i < n; ++i) {
+    double z = z_scores[i];
+    SignalType signal = SignalType::HOLD;
+
+    if (position == 0 && z > params.entry_std_devs) {
+      signal = SignalType::SELL;
+      position = -quantity;
+    } else if (position == 0 && z < -params.entry_std_devs) {
+      signal = SignalType::BUY;
+      position = quantity;
+    } else if (position > 0 && z > -params.exit_std_devs) {
+      signal = SignalType::CLOSE_LONG;
+      position = 0;
+    } else if (position < 0 && z < params.exit_std_devs) {
+      signal = SignalType::CLOSE_SHORT;
+      position = 0;
+    }
+
+    signals[i] = signal;
+  }
+
+  return signals;
+}
@@ -0,0 +1,174 @@
+#include "bootstrap.hpp"
+#include "counter_rng.hpp"
+#include "online_metrics.hpp"
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+// Linear-interpolated quantile of sorted values
+double quantile(const std::vector<double> &sorted, double q) {
+  double position = q * static_cast<double>(sorted.size() - 1);
+  auto below = static_cast<std::size_t>(position);
+  std::size_t above = std::min(below + 1, sorted.size() - 1);
+  double weight = position - static_cast<double>(below);
+  return sorted[below] * (1.0 - weight) + sorted[above] * weight;
+}
+
+ConfidenceInterval summarize(std::vector<double> &values, double estimate,
+                             double confidence) {
+  ConfidenceInterval interval;
+  interval.estimate = estimate;
+
+  double sum = 0.0;
+  for (double v : values) {
+    sum += v;
+  }
+  interval.mean = sum / static_cast<double>(values.size());
+  double sum_sq = 0.0;
+  for (double v : values) {
+    sum_sq += (v - interval.mean) * (v - interval.mean);
+  }
+  interval.std_error =
+      values.size() > 1
+          ? std::sqrt(sum_sq / static_cast<double>(values.size() - 1))
+          : 0.0;
+
+  std::sort(values.begin(), values.end());
+  double tail = (1.0 - confidence) * 0.5;
+  interval.lower = quantile(values, tail);
+  interval.upper = quantile(values, 1.0 - tail);
+  return interval;
+}
+
+void print_interval(const char *name, const ConfidenceInterval &interval) {
+  std::cout << std::left << std::setw(16) << name << std::right << std::fixed
+            << std::setprecision(3) << std::setw(10) << interval.estimate
+            << std::setw(10) << interval.std_error << "   [" << std::setw(9)
+            << interval.lower << ", " << std::setw(9) << interval.upper << "]"
+            << std::endl;
+}
+
+} // namespace
+
+// ============================================================================
+// P&L SERIES STATISTICS
+// ============================================================================
+
+PnlSeriesStats compute_pnl_stats(const double *pnl, std::size_t n) {
+  // The very pass PerformanceMetrics makes, so the two agree exactly
+  OnlinePnlMetrics metrics;
+  for (std::size_t i = 0; i < n; ++i) {
+    metrics.add(TimePoint(), pnl[i]);
+  }
+
+  PnlSeriesStats stats;
+  stats.sharpe = metrics.sharpe_ratio();
+  stats.sortino = metrics.sortino_ratio();
+  stats.max_drawdown = metrics.max_drawdown();
+  stats.total_return = metrics.return_percentage();
+  if (stats.max_drawdown >= 1e-6) {
+    stats.calmar = stats.total_return / stats.max_drawdown;
+  }
+  return stats;
+}
+
+// ============================================================================
+// BLOCK BOOTSTRAP
+// ============================================================================
+
+BootstrapReport block_bootstrap(const std::vector<double> &pnl,
+                                const BootstrapConfig &config,
+                                WorkerPool *pool) {
+  if (pnl.size() < 3) {
+    throw std::runtime_error("Bootstrap needs at least two P&L changes");
+  }
+  if (config.resamples < 2 || config.confidence <= 0.0 ||
+      config.confidence >= 1.0) {
+    throw std::runtime_error(
+        "Bootstrap needs two or more resamples and a confidence in (0, 1)");
+  }
+  const std::size_t n = pnl.size() - 1; // Changes
+  const std::size_t block = std::clamp<std::size_t>(config.block_length, 1, n);
+
+  // Changes followed by their first block - 1 values, so every circular
+  // block is one contiguous run
+  std::vector<double> wrapped(n + block - 1);
+  for (std::size_t i = 0; i < wrapped.size(); ++i) {
+    std::size_t at = i % n;
+    wrapped[i] = pnl[at + 1] - pnl[at];
+  }
+
+  std::vector<PnlSeriesStats> samples(config.resamples);
+  const std::size_t per_task = std::max<std::size_t>(config.resamples_per_task, 1);
+  const std::size_t tasks = (config.resamples + per_task - 1) / per_task;
+
+  auto run_task = [&](std::size_t task) {
+    std::vector<double> path(n + 1);
+    std::size_t first = task * per_task;
+    std::size_t last = std::min(first + per_task, config.resamples);
+    for (std::size_t b = first; b < last; ++b) {
+      CounterRng rng(config.seed, static_cast<std::uint64_t>(b) << 32);
+      path[0] = pnl[0];
+      for (std::size_t filled = 0; filled < n; filled += block) {
+        const double *changes =
+            wrapped.data() + rng.below(static_cast<std::uint32_t>(n));
+        std::size_t length = std::min(block, n - filled);
+        for (std::size_t j = 0; j < length; ++j) {
+          path[filled + j + 1] = path[filled + j] + changes[j];
+        }
+      }
+      samples[b] = compute_pnl_stats(path.data(), path.size());
+    }
+  };
+  if (pool) {
+    pool->parallel_for(tasks, run_task);
+  } else {
+    for (std::size_t task = 0; task < tasks; ++task) {
+      run_task(task);
+    }
+  }
+
+  BootstrapReport report;
+  report.observations = n;
+  report.resamples = config.resamples;
+  report.block_length = block;
+  report.confidence = config.confidence;
+
+  PnlSeriesStats original = compute_pnl_stats(pnl.data(), pnl.size());
+  std::vector<double> values(config.resamples);
+  auto interval = [&](double PnlSeriesStats::*metric) {
+    for (std::size_t b = 0; b < samples.size(); ++b) {
+      values[b] = samples[b].*metric;
+    }
+    return summarize(values, original.*metric, config.confidence);
+  };
+  report.sharpe = interval(&PnlSeriesStats::sharpe);
+  report.sortino = interval(&PnlSeriesStats::sortino);
+  report.max_drawdown = interval(&PnlSeriesStats::max_drawdown);
+  report.total_return = interval(&PnlSeriesStats::total_return);
+  report.calmar = interval(&PnlSeriesStats::calmar);
+  return report;
+}
+
+void BootstrapReport::print() const {
+  std::cout << "\n=== Bootstrap Confidence Intervals ===" << std::endl;
+  std::cout << std::string(60, '-') << std::endl;
+  std::cout << "Returns: " << observations << "  Resamples: " << resamples
+            << "  Block: " << block_length << "  Confidence: " << std::fixed
+            << std::setprecision(1) << confidence * 100.0 << "%" << std::endl;
+  std::cout << std::left << std::setw(16) << "Metric" << std::right
+            << std::setw(10) << "Estimate" << std::setw(10) << "StdErr"
+            << "   Interval" << std::endl;
+  print_interval("Sharpe", sharpe);
+  print_interval("Sortino", sortino);
+  print_interval("Max DD (%)", max_drawdown);
+  print_interval("Return (%)", total_return);
+  print_interval("Calmar", calmar);
+  std::cout << std::string(60, '-') << std::endl;
+}
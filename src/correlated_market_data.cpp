@@ -0,0 +1,263 @@
+#include "correlated_market_data.hpp"
+#include "order_book.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+constexpr double kCorrelationTolerance = 1e-9;
+}
+
+// ============================================================================
+// CORRELATED SHOCKS
+// ============================================================================
+
+CorrelatedShockGenerator::CorrelatedShockGenerator(std::size_t symbols,
+                                                   std::size_t sources,
+                                                   std::uint64_t seed)
+    : symbols_(symbols), sources_(sources),
+      columns_(sources * symbols, 0.0), rng_(seed), uniform01_(0.0, 1.0) {
+  if (symbols == 0) {
+    throw std::runtime_error("Correlated shocks need at least one symbol");
+  }
+}
+
+CorrelatedShockGenerator CorrelatedShockGenerator::from_correlation(
+    std::size_t symbols, const std::vector<double> &correlation,
+    std::uint64_t seed) {
+  if (correlation.size() != symbols * symbols) {
+    throw std::runtime_error("Correlation matrix must be " +
+                             std::to_string(symbols) + " x " +
+                             std::to_string(symbols));
+  }
+  for (std::size_t i = 0; i < symbols; ++i) {
+    if (std::abs(correlation[i * symbols + i] - 1.0) > kCorrelationTolerance) {
+      throw std::runtime_error("Correlation matrix needs a unit diagonal");
+    }
+    for (std::size_t j = 0; j < i; ++j) {
+      if (std::abs(correlation[i * symbols + j] -
+                   correlation[j * symbols + i]) > kCorrelationTolerance) {
+        throw std::runtime_error("Correlation matrix must be symmetric");
+      }
+    }
+  }
+
+  // Cholesky-Banachiewicz, L row-major lower triangular
+  std::vector<double> lower(symbols * symbols, 0.0);
+  for (std::size_t i = 0; i < symbols; ++i) {
+    for (std::size_t j = 0; j <= i; ++j) {
+      double sum = correlation[i * symbols + j];
+      for (std::size_t k = 0; k < j; ++k) {
+        sum -= lower[i * symbols + k] * lower[j * symbols + k];
+      }
+      if (i == j) {
+        if (sum <= 0.0) {
+          throw std::runtime_error(
+              "Correlation matrix is not positive definite");
+        }
+        lower[i * symbols + i] = std::sqrt(sum);
+      } else {
+        lower[i * symbols + j] = sum / lower[j * symbols + j];
+      }
+    }
+  }
+
+  // Normal j feeds symbols i >= j with weight L[i][j]: store L^T so that
+  // row is contiguous
+  CorrelatedShockGenerator shocks(symbols, symbols, seed);
+  for (std::size_t i = 0; i < symbols; ++i) {
+    for (std::size_t j = 0; j <= i; ++j) {
+      shocks.columns_[j * symbols + i] = lower[i * symbols + j];
+    }
+  }
+  return shocks;
+}
+
+CorrelatedShockGenerator CorrelatedShockGenerator::from_factors(
+    std::size_t symbols, std::size_t factors,
+    const std::vector<double> &loadings, std::uint64_t seed) {
+  if (loadings.size() != symbols * factors) {
+    throw std::runtime_error("Factor loadings must be " +
+                             std::to_string(symbols) + " x " +
+                             std::to_string(factors));
+  }
+
+  CorrelatedShockGenerator shocks(symbols, factors, seed);
+  shocks.idiosyncratic_.resize(symbols);
+  for (std::size_t i = 0; i < symbols; ++i) {
+    double explained = 0.0;
+    for (std::size_t f = 0; f < factors; ++f) {
+      double b = loadings[i * factors + f];
+      explained += b * b;
+      shocks.columns_[f * symbols + i] = b;
+    }
+    if (explained > 1.0 + kCorrelationTolerance) {
+      throw std::runtime_error("Factor loadings of symbol " +
+                               std::to_string(i) + " exceed unit variance");
+    }
+    shocks.idiosyncratic_[i] = std::sqrt(std::max(0.0, 1.0 - explained));
+  }
+  return shocks;
+}
+
+CorrelatedShockGenerator
+CorrelatedShockGenerator::independent(std::size_t symbols,
+                                      std::uint64_t seed) {
+  return from_factors(symbols, 0, {}, seed);
+}
+
+void CorrelatedShockGenerator::fill_normals(std::size_t count) {
+  if (normals_.size() < count + 1) {
+    normals_.resize(count + 1);
+  }
+
+  // Box-Muller in pairs
+  for (std::size_t i = 0; i < count; i += 2) {
+    double u1 = 1.0 - uniform01_(rng_); // (0, 1]
+    double u2 = uniform01_(rng_);
+    double r = std::sqrt(-2.0 * std::log(u1));
+    double theta = 6.283185307179586 * u2;
+    normals_[i] = r * std::cos(theta);
+    normals_[i + 1] = r * std::sin(theta);
+  }
+}
+
+void CorrelatedShockGenerator::combine(const double *normals,
+                                       double *out) const {
+  // Factor model: the last symbols_ normals are idiosyncratic
+  const std::size_t n = symbols_;
+  if (!idiosyncratic_.empty()) {
+    const double *own = normals + sources_;
+    const double *scale = idiosyncratic_.data();
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = scale[i] * own[i];
+    }
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = 0.0;
+    }
+  }
+
+  for (std::size_t j = 0; j < sources_; ++j) {
+    const double e = normals[j];
+    const double *column = columns_.data() + j * n;
+    // Cholesky columns are zero above the diagonal
+    std::size_t first = idiosyncratic_.empty() ? j : 0;
+    for (std::size_t i = first; i < n; ++i) {
+      out[i] += e * column[i];
+    }
+  }
+}
+
+void CorrelatedShockGenerator::next(double *out) { generate(1, out); }
+
+void CorrelatedShockGenerator::generate(std::size_t steps, double *out) {
+  std::size_t per_draw =
+      sources_ + (idiosyncratic_.empty() ? 0 : symbols_);
+  fill_normals(steps * per_draw);
+  for (std::size_t s = 0; s < steps; ++s) {
+    combine(normals_.data() + s * per_draw, out + s * symbols_);
+  }
+}
+
+std::vector<double> CorrelatedShockGenerator::implied_correlation() const {
+  const std::size_t n = symbols_;
+  std::vector<double> result(n * n, 0.0);
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t k = 0; k < n; ++k) {
+      double sum = 0.0;
+      for (std::size_t j = 0; j < sources_; ++j) {
+        sum += columns_[j * n + i] * columns_[j * n + k];
+      }
+      if (i == k && !idiosyncratic_.empty()) {
+        sum += idiosyncratic_[i] * idiosyncratic_[i];
+      }
+      result[i * n + k] = sum;
+    }
+  }
+  return result;
+}
+
+// ============================================================================
+// MULTI-ASSET GENERATOR
+// ============================================================================
+
+CorrelatedShockGenerator
+make_shock_generator(const MultiAssetMarketDataGenerator::Config &config) {
+  std::size_t n = config.symbols.size();
+  if (config.factors > 0) {
+    return CorrelatedShockGenerator::from_factors(n, config.factors,
+                                                  config.loadings, config.seed);
+  }
+  if (!config.correlation.empty()) {
+    return CorrelatedShockGenerator::from_correlation(n, config.correlation,
+                                                      config.seed);
+  }
+  return CorrelatedShockGenerator::independent(n, config.seed);
+}
+
+MultiAssetMarketDataGenerator::MultiAssetMarketDataGenerator(
+    const Config &config)
+    : config_(config), shocks_(make_shock_generator(config)),
+      shock_buffer_(config.symbols.size()) {
+  generators_.reserve(config.symbols.size());
+  for (const auto &symbol : config.symbols) {
+    generators_.push_back(std::make_unique<MarketDataGenerator>(symbol));
+  }
+  snapshots_.resize(generators_.size());
+}
+
+void MultiAssetMarketDataGenerator::register_callback(
+    SnapshotCallback callback) {
+  callbacks_.push_back(std::move(callback));
+}
+
+void MultiAssetMarketDataGenerator::set_clock(const SimClock &clock) {
+  for (auto &generator : generators_) {
+    generator->set_clock(clock);
+  }
+}
+
+const std::vector<MarketDataSnapshot> &
+MultiAssetMarketDataGenerator::next_snapshots() {
+  step(std::vector<OrderBook *>());
+  return snapshots_;
+}
+
+std::vector<MarketDataSnapshot>
+MultiAssetMarketDataGenerator::generate_series(std::size_t steps) {
+  const std::size_t n = generators_.size();
+  shock_buffer_.resize(steps * n);
+  shocks_.generate(steps, shock_buffer_.data());
+
+  std::vector<MarketDataSnapshot> result;
+  result.reserve(steps * n);
+  for (std::size_t s = 0; s < steps; ++s) {
+    for (std::size_t i = 0; i < n; ++i) {
+      result.push_back(
+          generators_[i]->step_with_shock(shock_buffer_[s * n + i]));
+      for (const auto &callback : callbacks_) {
+        callback(i, result.back());
+      }
+    }
+  }
+  return result;
+}
+
+void MultiAssetMarketDataGenerator::step(const std::vector<OrderBook *> &books,
+                                         double market_order_probability) {
+  const std::size_t n = generators_.size();
+  shock_buffer_.resize(n);
+  shocks_.next(shock_buffer_.data());
+
+  for (std::size_t i = 0; i < n; ++i) {
+    OrderBook *book = i < books.size() ? books[i] : nullptr;
+    snapshots_[i] = generators_[i]->step_with_shock(shock_buffer_[i], book,
+                                                    market_order_probability);
+    for (const auto &callback : callbacks_) {
+      callback(i, snapshots_[i]);
+    }
+  }
+}
@@ -0,0 +1,38 @@
+#include "counter_rng.hpp"
+
+namespace {
+
+constexpr std::uint32_t kPhiloxM0 = 0xD2511F53;
+constexpr std::uint32_t kPhiloxM1 = 0xCD9E8D57;
+constexpr std::uint32_t kPhiloxW0 = 0x9E3779B9;
+constexpr std::uint32_t kPhiloxW1 = 0xBB67AE85;
+
+inline void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t &hi,
+                    std::uint32_t &lo) {
+  std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+  hi = static_cast<std::uint32_t>(product >> 32);
+  lo = static_cast<std::uint32_t>(product);
+}
+
+} // namespace
+
+Philox4x32::Block Philox4x32::generate(std::uint64_t counter_lo,
+                                       std::uint64_t counter_hi,
+                                       std::uint64_t key) {
+  Block c = {static_cast<std::uint32_t>(counter_lo),
+             static_cast<std::uint32_t>(counter_lo >> 32),
+             static_cast<std::uint32_t>(counter_hi),
+             static_cast<std::uint32_t>(counter_hi >> 32)};
+  std::uint32_t k0 = static_cast<std::uint32_t>(key);
+  std::uint32_t k1 = static_cast<std::uint32_t>(key >> 32);
+
+  for (int round = 0; round < 10; ++round) {
+    std::uint32_t hi0, lo0, hi1, lo1;
+    mulhilo(kPhiloxM0, c[0], hi0, lo0);
+    mulhilo(kPhiloxM1, c[2], hi1, lo1);
+    c = {hi1 ^ c[1] ^ k0, lo1, hi0 ^ c[3] ^ k1, lo0};
+    k0 += kPhiloxW0;
+    k1 += kPhiloxW1;
+  }
+  return c;
+}
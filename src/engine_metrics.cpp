@@ -0,0 +1,350 @@
+#include "engine_metrics.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kCacheLine = 64;
+
+// Targets of default-constructed handles
+std::atomic<std::int64_t> g_unregistered_value{0};
+MetricHistogramBlock g_unregistered_histogram{};
+
+std::size_t align_up(std::size_t value) {
+  return (value + kCacheLine - 1) / kCacheLine * kCacheLine;
+}
+
+const char *kind_name(MetricKind kind) {
+  switch (kind) {
+  case MetricKind::COUNTER:
+    return "counter";
+  case MetricKind::GAUGE:
+    return "gauge";
+  case MetricKind::HISTOGRAM:
+    return "histogram";
+  }
+  return "unknown";
+}
+
+// Identity of a shared-memory object (0 if unknown), so a registry only
+// unlinks the segment it created
+std::uint64_t segment_inode(int fd) {
+  struct stat info;
+  return fstat(fd, &info) == 0 ? static_cast<std::uint64_t>(info.st_ino) : 0;
+}
+
+std::uint64_t segment_inode(const std::string &name) {
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return 0;
+  }
+  std::uint64_t inode = segment_inode(fd);
+  close(fd);
+  return inode;
+}
+
+MetricSample read_slot(const MetricSlot &slot,
+                       const MetricHistogramBlock *histograms) {
+  MetricSample sample;
+  sample.name.assign(slot.name, strnlen(slot.name, kMetricNameSize));
+  sample.kind = slot.kind;
+  if (slot.kind == MetricKind::HISTOGRAM) {
+    const MetricHistogramBlock &block = histograms[slot.histogram];
+    sample.count = block.count.load(std::memory_order_relaxed);
+    sample.sum = block.sum.load(std::memory_order_relaxed);
+    sample.buckets.resize(kMetricHistogramBuckets);
+    for (std::size_t i = 0; i < kMetricHistogramBuckets; ++i) {
+      sample.buckets[i] = block.buckets[i].load(std::memory_order_relaxed);
+    }
+  } else {
+    sample.value = slot.value.load(std::memory_order_relaxed);
+  }
+  return sample;
+}
+
+} // namespace
+
+Counter::Counter() : value_(&g_unregistered_value) {}
+Gauge::Gauge() : value_(&g_unregistered_value) {}
+Histogram::Histogram() : block_(&g_unregistered_histogram) {}
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
+MetricsRegistry::MetricsRegistry() : MetricsRegistry(Config()) {}
+
+MetricsRegistry::MetricsRegistry(const Config &config)
+    : config_(config), base_(nullptr), size_(0), segment_inode_(0),
+      header_(nullptr), slots_(nullptr), histograms_(nullptr) {
+  if (config.slot_capacity == 0) {
+    throw std::runtime_error("Metrics registry needs at least one slot");
+  }
+  std::size_t slots_offset = align_up(sizeof(MetricsSegmentHeader));
+  std::size_t histograms_offset =
+      slots_offset + config.slot_capacity * sizeof(MetricSlot);
+  size_ = align_up(histograms_offset +
+                   config.histogram_capacity * sizeof(MetricHistogramBlock));
+
+  if (config.shm_name.empty()) {
+    base_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  } else {
+    // A segment left by an earlier run is unlinked, not truncated: readers
+    // still mapping it keep the old object instead of faulting, and ours
+    // starts out empty, so sizing it only ever grows it
+    shm_unlink(config.shm_name.c_str());
+    int fd = shm_open(config.shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR,
+                      0600);
+    if (fd < 0) {
+      throw std::runtime_error("Could not create metrics segment " +
+                               config.shm_name);
+    }
+    segment_inode_ = segment_inode(fd);
+    bool sized = ftruncate(fd, static_cast<off_t>(size_)) == 0;
+    base_ = sized ? mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         fd, 0)
+                  : MAP_FAILED;
+    close(fd);
+    if (base_ == MAP_FAILED) {
+      shm_unlink(config.shm_name.c_str());
+    }
+  }
+  if (base_ == MAP_FAILED) {
+    base_ = nullptr;
+    throw std::runtime_error("Could not map metrics segment");
+  }
+
+  auto *bytes = static_cast<char *>(base_);
+  header_ = new (base_) MetricsSegmentHeader;
+  header_->version = kMetricsLayoutVersion;
+  header_->header_size = sizeof(MetricsSegmentHeader);
+  header_->slot_size = sizeof(MetricSlot);
+  header_->histogram_size = sizeof(MetricHistogramBlock);
+  header_->slot_capacity = static_cast<std::uint32_t>(config.slot_capacity);
+  header_->histogram_capacity =
+      static_cast<std::uint32_t>(config.histogram_capacity);
+  header_->slots_offset = slots_offset;
+  header_->histograms_offset = histograms_offset;
+  header_->total_size = size_;
+  header_->writer_pid = static_cast<std::int64_t>(getpid());
+  header_->slot_count.store(0, std::memory_order_relaxed);
+  header_->histogram_count.store(0, std::memory_order_relaxed);
+  // Mapped memory is zeroed, which is a valid state for every slot
+  slots_ = reinterpret_cast<MetricSlot *>(bytes + slots_offset);
+  histograms_ = reinterpret_cast<MetricHistogramBlock *>(bytes +
+                                                         histograms_offset);
+
+  // Magic last: a reader never sees a half-initialized header as valid
+  header_->magic.store(kMetricsMagic, std::memory_order_release);
+}
+
+MetricsRegistry::~MetricsRegistry() {
+  if (base_) {
+    munmap(base_, size_);
+  }
+  if (segment_inode_ != 0 &&
+      segment_inode(config_.shm_name) == segment_inode_) {
+    shm_unlink(config_.shm_name.c_str());
+  }
+}
+
+MetricSlot &MetricsRegistry::register_slot(const std::string &name,
+                                           MetricKind kind) {
+  if (name.empty() || name.size() >= kMetricNameSize) {
+    throw std::runtime_error("Metric name must be 1 to " +
+                             std::to_string(kMetricNameSize - 1) +
+                             " characters: " + name);
+  }
+
+  auto found = index_.find(name);
+  if (found != index_.end()) {
+    MetricSlot &slot = slots_[found->second];
+    if (slot.kind != kind) {
+      throw std::runtime_error("Metric " + name + " is already a " +
+                               kind_name(slot.kind));
+    }
+    return slot;
+  }
+
+  std::uint32_t index = header_->slot_count.load(std::memory_order_relaxed);
+  if (index >= header_->slot_capacity) {
+    throw std::runtime_error("Metrics segment is full");
+  }
+  MetricSlot &slot = slots_[index];
+  if (kind == MetricKind::HISTOGRAM) {
+    std::uint32_t block =
+        header_->histogram_count.load(std::memory_order_relaxed);
+    if (block >= header_->histogram_capacity) {
+      throw std::runtime_error("Metrics segment has no histogram space left");
+    }
+    slot.histogram = block;
+    header_->histogram_count.store(block + 1, std::memory_order_release);
+  }
+  std::memcpy(slot.name, name.c_str(), name.size() + 1);
+  slot.kind = kind;
+
+  index_.emplace(name, index);
+  header_->slot_count.store(index + 1, std::memory_order_release);
+  return slot;
+}
+
+Counter MetricsRegistry::counter(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Counter(&register_slot(name, MetricKind::COUNTER).value);
+}
+
+Gauge MetricsRegistry::gauge(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Gauge(&register_slot(name, MetricKind::GAUGE).value);
+}
+
+Histogram MetricsRegistry::histogram(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  MetricSlot &slot = register_slot(name, MetricKind::HISTOGRAM);
+  return Histogram(&histograms_[slot.histogram]);
+}
+
+std::size_t MetricsRegistry::size() const {
+  return header_->slot_count.load(std::memory_order_acquire);
+}
+
+void MetricsRegistry::print() const {
+  std::cout << "\n=== Engine Metrics ===" << std::endl;
+  std::cout << std::string(60, '-') << std::endl;
+  std::size_t count = size();
+  for (std::size_t i = 0; i < count; ++i) {
+    MetricSample sample = read_slot(slots_[i], histograms_);
+    std::cout << std::left << std::setw(44) << sample.name << std::right;
+    if (sample.kind == MetricKind::HISTOGRAM) {
+      std::cout << " n=" << sample.count << " p50<" << sample.quantile_bound(0.5)
+                << " p99<" << sample.quantile_bound(0.99);
+    } else {
+      std::cout << std::setw(14) << sample.value;
+    }
+    std::cout << std::endl;
+  }
+  std::cout << std::string(60, '-') << std::endl;
+}
+
+// ============================================================================
+// ORDER BOOK METRICS
+// ============================================================================
+
+OrderBookMetrics::OrderBookMetrics(MetricsRegistry &registry,
+                                   const std::string &prefix)
+    : limit_orders(registry.counter(prefix + ".in.limit")),
+      market_orders(registry.counter(prefix + ".in.market")),
+      iceberg_orders(registry.counter(prefix + ".in.iceberg")),
+      stop_orders(registry.counter(prefix + ".in.stop")),
+      amends(registry.counter(prefix + ".in.amend")),
+      filled(registry.counter(prefix + ".out.filled")),
+      cancelled(registry.counter(prefix + ".out.cancelled")),
+      expired(registry.counter(prefix + ".out.expired")),
+      killed(registry.counter(prefix + ".out.killed")),
+      rejects(registry.counter(prefix + ".rejects")),
+      fills(registry.counter(prefix + ".fills")),
+      fill_volume(registry.counter(prefix + ".fill_volume")),
+      self_trades_prevented(registry.counter(prefix + ".self_trades")),
+      stale_skipped(registry.counter(prefix + ".stale_skipped")),
+      stop_triggers(registry.counter(prefix + ".stop_triggers")),
+      bid_queue_depth(registry.gauge(prefix + ".bid_queue_depth")),
+      ask_queue_depth(registry.gauge(prefix + ".ask_queue_depth")),
+      tracked_orders(registry.gauge(prefix + ".tracked_orders")),
+      pending_stops(registry.gauge(prefix + ".pending_stops")),
+      add_latency_ns(registry.histogram(prefix + ".add_latency_ns")) {}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+std::uint64_t MetricSample::quantile_bound(double q) const {
+  if (count == 0 || buckets.empty()) {
+    return 0;
+  }
+  auto rank = static_cast<std::uint64_t>(
+      std::max(1.0, q * static_cast<double>(count)));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return i == 0 ? 0 : (1ULL << i) - 1;
+    }
+  }
+  return UINT64_MAX;
+}
+
+MetricsReader::MetricsReader(const std::string &shm_name)
+    : base_(nullptr), size_(0), header_(nullptr) {
+  int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw std::runtime_error("No metrics segment " + shm_name);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) < sizeof(MetricsSegmentHeader)) {
+    close(fd);
+    throw std::runtime_error("Metrics segment " + shm_name + " is too small");
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  void *mapped = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    throw std::runtime_error("Could not map metrics segment " + shm_name);
+  }
+  base_ = mapped;
+  header_ = static_cast<const MetricsSegmentHeader *>(base_);
+
+  if (header_->magic.load(std::memory_order_acquire) != kMetricsMagic ||
+      header_->version != kMetricsLayoutVersion ||
+      header_->slot_size != sizeof(MetricSlot) ||
+      header_->histogram_size != sizeof(MetricHistogramBlock) ||
+      header_->total_size > size_) {
+    munmap(const_cast<void *>(base_), size_);
+    throw std::runtime_error("Incompatible metrics segment " + shm_name);
+  }
+}
+
+MetricsReader::~MetricsReader() {
+  munmap(const_cast<void *>(base_), size_);
+}
+
+std::size_t MetricsReader::size() const {
+  return header_->slot_count.load(std::memory_order_acquire);
+}
+
+std::vector<MetricSample> MetricsReader::sample() const {
+  const auto *bytes = static_cast<const char *>(base_);
+  const auto *slots =
+      reinterpret_cast<const MetricSlot *>(bytes + header_->slots_offset);
+  const auto *histograms = reinterpret_cast<const MetricHistogramBlock *>(
+      bytes + header_->histograms_offset);
+
+  std::size_t count = size();
+  std::vector<MetricSample> samples;
+  samples.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    samples.push_back(read_slot(slots[i], histograms));
+  }
+  return samples;
+}
+
+std::optional<std::int64_t>
+MetricsReader::value(const std::string &name) const {
+  for (const auto &sample : sample()) {
+    if (sample.name == name && sample.kind != MetricKind::HISTOGRAM) {
+      return sample.value;
+    }
+  }
+  return std::nullopt;
+}
@@ -0,0 +1,59 @@
+#include "event_log.hpp"
+#include "order_book.hpp"
+
+#include <stdexcept>
+
+EventLogReader::EventLogReader(const std::string &filename)
+    : filename_(filename), file_(filename), events_read_(0) {
+  if (!file_.is_open()) {
+    throw std::runtime_error("Could not open file: " + filename);
+  }
+  std::getline(file_, line_); // Skip header
+}
+
+std::optional<OrderEvent> EventLogReader::next() {
+  while (std::getline(file_, line_)) {
+    if (line_.empty()) {
+      continue;
+    }
+    ++events_read_;
+    return OrderEvent::from_csv(line_);
+  }
+  return std::nullopt;
+}
+
+void apply_event(OrderBook &book, const OrderEvent &event) {
+  switch (event.type) {
+  case EventType::NEW_ORDER:
+    if (event.peak_size > 0) {
+      book.add_order(Order(event.order_id, event.account_id, event.side,
+                           event.price, event.quantity, event.peak_size,
+                           event.tif));
+    } else if (event.order_type == OrderType::MARKET) {
+      book.add_order(Order(event.order_id, event.account_id, event.side,
+                           event.order_type, event.quantity, event.tif));
+    } else {
+      book.add_order(Order(event.order_id, event.account_id, event.side,
+                           event.price, event.quantity, event.tif));
+    }
+    break;
+
+  case EventType::CANCEL_ORDER:
+    book.cancel_order(event.order_id);
+    break;
+
+  case EventType::AMEND_ORDER: {
+    std::optional<double> new_price;
+    std::optional<int> new_qty;
+    if (event.has_new_price)
+      new_price = event.new_price;
+    if (event.has_new_quantity)
+      new_qty = event.new_quantity;
+    book.amend_order(event.order_id, new_price, new_qty);
+    break;
+  }
+
+  case EventType::FILL:
+    break;
+  }
+}
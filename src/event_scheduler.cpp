@@ -0,0 +1,88 @@
+#include "event_scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+EventScheduler::EventScheduler(VirtualClock &clock)
+    : clock_(clock), pending_(0), next_id_(1), events_run_(0),
+      events_run_by_type_{} {}
+
+EventScheduler::EventId EventScheduler::schedule_at(TimePoint time,
+                                                    SimEventType type,
+                                                    Action action) {
+  if (time < clock_.now()) {
+    time = clock_.now();
+  }
+
+  EventId id = next_id_++;
+  heap_.push_back({time, id, type, std::move(action)});
+  std::push_heap(heap_.begin(), heap_.end(), Later());
+  ++pending_;
+  return id;
+}
+
+bool EventScheduler::cancel(EventId id) {
+  for (auto &entry : heap_) {
+    if (entry.id == id && entry.action) {
+      entry.action = nullptr;
+      --pending_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void EventScheduler::discard_cancelled() {
+  while (!heap_.empty() && !heap_.front().action) {
+    std::pop_heap(heap_.begin(), heap_.end(), Later());
+    heap_.pop_back();
+  }
+}
+
+bool EventScheduler::empty() {
+  discard_cancelled();
+  return heap_.empty();
+}
+
+TimePoint EventScheduler::next_time() {
+  discard_cancelled();
+  return heap_.front().time;
+}
+
+bool EventScheduler::run_next() {
+  if (empty()) {
+    return false;
+  }
+
+  // Take the entry out before running it; the action may schedule more
+  std::pop_heap(heap_.begin(), heap_.end(), Later());
+  Entry entry = std::move(heap_.back());
+  heap_.pop_back();
+  --pending_;
+
+  clock_.advance_to(entry.time);
+  ++events_run_;
+  ++events_run_by_type_[static_cast<std::size_t>(entry.type)];
+  entry.action();
+  return true;
+}
+
+std::size_t EventScheduler::run_until(TimePoint end) {
+  std::size_t count = 0;
+  while (!empty() && next_time() <= end) {
+    run_next();
+    ++count;
+  }
+  if (clock_.now() < end) {
+    clock_.advance_to(end);
+  }
+  return count;
+}
+
+std::size_t EventScheduler::run(std::size_t max_events) {
+  std::size_t count = 0;
+  while (count < max_events && run_next()) {
+    ++count;
+  }
+  return count;
+}
@@ -7,6 +7,8 @@
 bool FillRouter::route_fill(const Fill &fill, const Order &aggressive_order,
                             const Order &passive_order,
                             const std::string &symbol) {
+  ENGINE_TRACE_STAGE(tracer_, FILL_ROUTING);
+
   // 1. Check for self-trades
   if (prevent_self_trades_ && is_self_trade(aggressive_order, passive_order)) {
     self_trades_prevented_++;
@@ -37,6 +39,7 @@ bool FillRouter::route_fill(const Fill &fill, const Order &aggressive_order,
 
   // 5. Calculate fees
   if (enable_fees_) {
+    ENGINE_TRACE_STAGE(tracer_, FEE_CALC);
     calculate_fees(enhanced_fill, aggressive_is_buyer);
   }
 
@@ -45,7 +48,10 @@ bool FillRouter::route_fill(const Fill &fill, const Order &aggressive_order,
   total_fills_routed_++;
 
   // 7. Notify callbacks
-  notify_callbacks(enhanced_fill);
+  {
+    ENGINE_TRACE_STAGE(tracer_, CALLBACKS);
+    notify_callbacks(enhanced_fill);
+  }
 
   return true;
 }
@@ -0,0 +1,258 @@
+#include "flight_recorder.hpp"
+#include "tsc_clock.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kFlightMagic[8] = {'F', 'L', 'T', 'R', 'E', 'C', '0', '1'};
+constexpr std::uint32_t kFlightVersion = 1;
+
+// Bumped by request_dump() and the signal handler; each recorder compares
+// it against the last value it acted on
+std::atomic<std::uint64_t> g_dump_requests{0};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Dump requests are raised from a signal handler");
+
+extern "C" void flight_signal_handler(int) {
+  g_dump_requests.fetch_add(1, std::memory_order_relaxed);
+}
+
+void copy_field(char *dest, std::size_t size, const std::string &value) {
+  std::memset(dest, 0, size);
+  std::memcpy(dest, value.data(), std::min(value.size(), size - 1));
+}
+
+} // namespace
+
+const char *to_string(FlightOp op) {
+  switch (op) {
+  case FlightOp::ADD:
+    return "ADD";
+  case FlightOp::CANCEL:
+    return "CANCEL";
+  case FlightOp::AMEND:
+    return "AMEND";
+  case FlightOp::FILL:
+    return "FILL";
+  }
+  return "?";
+}
+
+const char *to_string(FlightOutcome outcome) {
+  switch (outcome) {
+  case FlightOutcome::PENDING:
+    return "pending";
+  case FlightOutcome::RESTED:
+    return "rested";
+  case FlightOutcome::PARTIAL:
+    return "partial";
+  case FlightOutcome::FILLED:
+    return "filled";
+  case FlightOutcome::CANCELLED:
+    return "cancelled";
+  case FlightOutcome::REJECTED:
+    return "rejected";
+  case FlightOutcome::EXECUTED:
+    return "executed";
+  }
+  return "?";
+}
+
+// ============================================================================
+// FLIGHT RECORDER
+// ============================================================================
+
+FlightRecorder::FlightRecorder() : FlightRecorder(Config()) {}
+
+FlightRecorder::FlightRecorder(const Config &config)
+    : config_(config), mask_(0), next_sequence_(0), auto_dump_after_(0),
+      seen_requests_(g_dump_requests.load(std::memory_order_relaxed)) {
+  std::size_t capacity = 1;
+  while (capacity < std::max<std::size_t>(config.capacity, 2)) {
+    capacity <<= 1;
+  }
+  // Default-initialized: pages are only touched as the ring fills
+  ring_.reset(new FlightRecord[capacity]);
+  mask_ = capacity - 1;
+}
+
+void FlightRecorder::record(const FlightRecord &entry) {
+  FlightRecord &slot = ring_[next_sequence_ & mask_];
+  slot = entry;
+  slot.sequence = next_sequence_++;
+  maybe_trigger(slot);
+}
+
+void FlightRecorder::maybe_trigger(const FlightRecord &entry) {
+  if (config_.dump_directory.empty()) {
+    return; // Nowhere to dump to
+  }
+  std::uint64_t requests = g_dump_requests.load(std::memory_order_relaxed);
+  if (requests != seen_requests_) {
+    seen_requests_ = requests;
+    dump_now("signal");
+    return;
+  }
+  if (entry.sequence < auto_dump_after_) {
+    return;
+  }
+
+  const char *reason = nullptr;
+  if (config_.latency_trigger_ns > 0 &&
+      TscClock::to_nanoseconds(entry.duration_ticks) >=
+          static_cast<double>(config_.latency_trigger_ns)) {
+    reason = "latency";
+  } else if (config_.check_invariants &&
+             ((entry.best_bid > 0.0 && entry.best_ask > 0.0 &&
+               entry.best_bid >= entry.best_ask) ||
+              entry.leaves < 0)) {
+    reason = "invariant";
+  }
+  if (reason) {
+    auto_dump_after_ = entry.sequence + capacity();
+    dump_now(reason);
+  }
+}
+
+void FlightRecorder::dump_now(const char *reason) {
+  try {
+    dump_files_.push_back(dump_to_file(reason));
+  } catch (const std::exception &) {
+    // Never let diagnostics take down the engine
+  }
+}
+
+std::vector<FlightRecord> FlightRecorder::records() const {
+  std::uint64_t count = std::min<std::uint64_t>(next_sequence_, capacity());
+  std::vector<FlightRecord> result;
+  result.reserve(static_cast<std::size_t>(count));
+  for (std::uint64_t s = next_sequence_ - count; s < next_sequence_; ++s) {
+    result.push_back(ring_[s & mask_]);
+  }
+  return result;
+}
+
+void FlightRecorder::dump(std::ostream &out, const std::string &reason) const {
+  std::vector<FlightRecord> retained = records();
+
+  FlightDumpHeader header{};
+  std::memcpy(header.magic, kFlightMagic, sizeof(header.magic));
+  header.version = kFlightVersion;
+  header.record_size = sizeof(FlightRecord);
+  header.count = retained.size();
+  header.recorded = next_sequence_;
+  header.ns_per_tick = TscClock::ns_per_tick();
+  copy_field(header.symbol, sizeof(header.symbol), config_.symbol);
+  copy_field(header.reason, sizeof(header.reason), reason);
+
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(retained.data()),
+            static_cast<std::streamsize>(retained.size() *
+                                         sizeof(FlightRecord)));
+  if (!out) {
+    throw std::runtime_error("Failed to write flight recorder dump");
+  }
+}
+
+std::string FlightRecorder::dump_to_file(const std::string &reason) const {
+  if (config_.dump_directory.empty()) {
+    throw std::runtime_error("Flight recorder has no dump directory");
+  }
+  std::string filename = config_.dump_directory + "/flight_" +
+                         (config_.symbol.empty() ? "book" : config_.symbol) +
+                         "_" + reason + "_" + std::to_string(next_sequence_) +
+                         ".bin";
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open file for writing: " + filename);
+  }
+  dump(file, reason);
+  return filename;
+}
+
+void FlightRecorder::install_signal_handler(int signal) {
+  std::signal(signal, flight_signal_handler);
+}
+
+void FlightRecorder::request_dump() {
+  g_dump_requests.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// OFFLINE DECODING
+// ============================================================================
+
+FlightDump read_flight_dump(std::istream &in) {
+  FlightDump dump{};
+  in.read(reinterpret_cast<char *>(&dump.header), sizeof(dump.header));
+  if (!in || std::memcmp(dump.header.magic, kFlightMagic, 8) != 0 ||
+      dump.header.version != kFlightVersion ||
+      dump.header.record_size != sizeof(FlightRecord)) {
+    throw std::runtime_error("Not a flight recorder dump");
+  }
+  dump.records.resize(static_cast<std::size_t>(dump.header.count));
+  in.read(reinterpret_cast<char *>(dump.records.data()),
+          static_cast<std::streamsize>(dump.records.size() *
+                                       sizeof(FlightRecord)));
+  if (!in) {
+    throw std::runtime_error("Truncated flight recorder dump");
+  }
+  return dump;
+}
+
+FlightDump read_flight_dump(const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open file for reading: " + filename);
+  }
+  return read_flight_dump(file);
+}
+
+std::string format_flight_record(const FlightRecord &record,
+                                 double ns_per_tick,
+                                 std::uint64_t origin_ticks) {
+  std::ostringstream line;
+  // Signed: an add starts before the fills it causes but is recorded after
+  double at_us = static_cast<double>(static_cast<std::int64_t>(
+                     record.start_ticks - origin_ticks)) *
+                 ns_per_tick / 1000.0;
+  line << "#" << record.sequence << " " << std::fixed << std::setprecision(3)
+       << at_us << "us " << to_string(record.op) << " ";
+  if (record.op == FlightOp::FILL) {
+    line << record.order_id << " x " << record.other_id;
+  } else {
+    line << "order " << record.order_id << " acct " << record.other_id << " "
+         << (record.side == 0 ? "BUY" : "SELL");
+    if (record.order_flags & kFlightMarket) {
+      line << " MKT";
+    }
+    if (record.order_flags & kFlightIceberg) {
+      line << " ICE";
+    }
+    if (record.order_flags & kFlightStop) {
+      line << " STOP";
+    }
+    if (record.order_flags & kFlightIoc) {
+      line << " IOC";
+    }
+    if (record.order_flags & kFlightFok) {
+      line << " FOK";
+    }
+  }
+  line << " " << record.quantity << " @ " << std::setprecision(2)
+       << record.price << " -> " << to_string(record.outcome) << " leaves "
+       << record.leaves << " (" << std::setprecision(0)
+       << static_cast<double>(record.duration_ticks) * ns_per_tick
+       << " ns) bbo " << std::setprecision(2) << record.best_bid << "/"
+       << record.best_ask;
+  return line.str();
+}
@@ -0,0 +1,289 @@
+#include "indicators.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// ============================================================================
+// ROLLING STATS
+// ============================================================================
+
+RollingStats::RollingStats(std::size_t period)
+    : period_(period), count_(0), mean_(0.0), m2_(0.0) {
+  if (period_ == 0) {
+    throw std::runtime_error("RollingStats period must be positive");
+  }
+}
+
+void RollingStats::add(double value) {
+  ++count_;
+  double delta = value - mean_;
+  mean_ += delta / static_cast<double>(count_);
+  m2_ += delta * (value - mean_);
+}
+
+void RollingStats::replace(double old_value, double new_value) {
+  double old_mean = mean_;
+  double delta = new_value - old_value;
+  mean_ += delta / static_cast<double>(count_);
+  m2_ += delta * (new_value - mean_ + old_value - old_mean);
+}
+
+void RollingStats::reset() {
+  count_ = 0;
+  mean_ = 0.0;
+  m2_ = 0.0;
+}
+
+double RollingStats::variance() const {
+  if (count_ == 0) {
+    return 0.0;
+  }
+  // Clamp tiny negative values left over from rounding
+  return std::max(0.0, m2_ / static_cast<double>(count_));
+}
+
+double RollingStats::stddev() const { return std::sqrt(variance()); }
+
+// ============================================================================
+// INDICATOR SET - SUBSCRIPTIONS
+// ============================================================================
+
+IndicatorSet::IndicatorSet()
+    : window_(1, 0.0), head_(0), samples_seen_(0), valid_(0) {}
+
+void IndicatorSet::subscribe(IndicatorType type, std::size_t period) {
+  if (period == 0) {
+    throw std::runtime_error("Indicator period must be positive");
+  }
+
+  if (is_subscribed(type, period)) {
+    return;
+  }
+
+  switch (type) {
+  case IndicatorType::SMA:
+  case IndicatorType::STDDEV:
+    stats_.emplace_back(period);
+    grow_window(period);
+    break;
+  case IndicatorType::EMA:
+    emas_.push_back({period, 2.0 / (period + 1.0), 0, 0.0, 0.0});
+    break;
+  case IndicatorType::MOMENTUM:
+    momentum_periods_.push_back(period);
+    grow_window(period + 1);
+    break;
+  case IndicatorType::CHANNEL:
+    channels_.push_back({period, 0, {}, {}});
+    break;
+  }
+}
+
+bool IndicatorSet::is_subscribed(IndicatorType type, std::size_t period) const {
+  switch (type) {
+  case IndicatorType::SMA:
+  case IndicatorType::STDDEV:
+    return find_stats(period) != nullptr;
+  case IndicatorType::EMA:
+    return find_ema(period) != nullptr;
+  case IndicatorType::MOMENTUM:
+    return std::find(momentum_periods_.begin(), momentum_periods_.end(),
+                     period) != momentum_periods_.end();
+  case IndicatorType::CHANNEL:
+    return find_channel(period) != nullptr;
+  }
+  return false;
+}
+
+void IndicatorSet::grow_window(std::size_t capacity) {
+  if (capacity <= window_.size()) {
+    return;
+  }
+
+  // Re-linearize the retained prices, oldest first
+  std::vector<double> grown(capacity, 0.0);
+  for (std::size_t i = 0; i < valid_; ++i) {
+    grown[i] = lag(valid_ - 1 - i);
+  }
+
+  window_ = std::move(grown);
+  head_ = valid_ % window_.size();
+}
+
+double IndicatorSet::lag(std::size_t k) const {
+  std::size_t cap = window_.size();
+  return window_[(head_ + cap - 1 - k) % cap];
+}
+
+const RollingStats *IndicatorSet::find_stats(std::size_t period) const {
+  for (const auto &s : stats_) {
+    if (s.period() == period)
+      return &s;
+  }
+  return nullptr;
+}
+
+const IndicatorSet::EmaState *
+IndicatorSet::find_ema(std::size_t period) const {
+  for (const auto &e : emas_) {
+    if (e.period == period)
+      return &e;
+  }
+  return nullptr;
+}
+
+const IndicatorSet::ChannelState *
+IndicatorSet::find_channel(std::size_t period) const {
+  for (const auto &c : channels_) {
+    if (c.period == period)
+      return &c;
+  }
+  return nullptr;
+}
+
+// ============================================================================
+// INDICATOR SET - UPDATE
+// ============================================================================
+
+void IndicatorSet::update(double price) {
+  // Rolling mean/variance: evict the price leaving each window before the
+  // new one overwrites the shared buffer
+  for (auto &s : stats_) {
+    if (s.is_ready()) {
+      s.replace(lag(s.period() - 1), price);
+    } else {
+      s.add(price);
+    }
+  }
+
+  // EMA: seed with the SMA of the first `period` prices, then recurse
+  for (auto &e : emas_) {
+    if (e.count < e.period) {
+      e.seed_sum += price;
+      if (++e.count == e.period) {
+        e.value = e.seed_sum / static_cast<double>(e.period);
+      }
+    } else {
+      e.value += (price - e.value) * e.alpha;
+    }
+  }
+
+  // Channels: monotonic deques keyed by sample sequence number
+  for (auto &c : channels_) {
+    while (!c.highs.empty() && c.highs.back().second <= price) {
+      c.highs.pop_back();
+    }
+    c.highs.emplace_back(samples_seen_, price);
+
+    while (!c.lows.empty() && c.lows.back().second >= price) {
+      c.lows.pop_back();
+    }
+    c.lows.emplace_back(samples_seen_, price);
+
+    while (c.highs.front().first + c.period <= samples_seen_) {
+      c.highs.pop_front();
+    }
+    while (c.lows.front().first + c.period <= samples_seen_) {
+      c.lows.pop_front();
+    }
+
+    if (c.count < c.period) {
+      ++c.count;
+    }
+  }
+
+  window_[head_] = price;
+  head_ = (head_ + 1) % window_.size();
+  valid_ = std::min(valid_ + 1, window_.size());
+  ++samples_seen_;
+}
+
+void IndicatorSet::reset() {
+  for (auto &s : stats_) {
+    s.reset();
+  }
+  for (auto &e : emas_) {
+    e.count = 0;
+    e.seed_sum = 0.0;
+    e.value = 0.0;
+  }
+  for (auto &c : channels_) {
+    c.count = 0;
+    c.highs.clear();
+    c.lows.clear();
+  }
+
+  std::fill(window_.begin(), window_.end(), 0.0);
+  head_ = 0;
+  valid_ = 0;
+  samples_seen_ = 0;
+}
+
+// ============================================================================
+// INDICATOR SET - QUERIES
+// ============================================================================
+
+bool IndicatorSet::is_ready(IndicatorType type, std::size_t period) const {
+  switch (type) {
+  case IndicatorType::SMA:
+  case IndicatorType::STDDEV: {
+    const RollingStats *s = find_stats(period);
+    return s && s->is_ready();
+  }
+  case IndicatorType::EMA: {
+    const EmaState *e = find_ema(period);
+    return e && e->count >= e->period;
+  }
+  case IndicatorType::MOMENTUM:
+    return is_subscribed(type, period) && valid_ >= period + 1;
+  case IndicatorType::CHANNEL: {
+    const ChannelState *c = find_channel(period);
+    return c && c->count >= c->period;
+  }
+  }
+  return false;
+}
+
+double IndicatorSet::sma(std::size_t period) const {
+  const RollingStats *s = find_stats(period);
+  return (s && s->is_ready()) ? s->mean() : 0.0;
+}
+
+double IndicatorSet::ema(std::size_t period) const {
+  const EmaState *e = find_ema(period);
+  return (e && e->count >= e->period) ? e->value : 0.0;
+}
+
+double IndicatorSet::variance(std::size_t period) const {
+  const RollingStats *s = find_stats(period);
+  return (s && s->is_ready()) ? s->variance() : 0.0;
+}
+
+double IndicatorSet::stddev(std::size_t period) const {
+  return std::sqrt(variance(period));
+}
+
+double IndicatorSet::momentum(std::size_t period) const {
+  if (!is_ready(IndicatorType::MOMENTUM, period)) {
+    return 0.0;
+  }
+
+  double current = lag(0);
+  double past = lag(period);
+
+  if (past == 0.0)
+    return 0.0;
+
+  return ((current - past) / past) * 100.0; // Percentage change
+}
+
+double IndicatorSet::rolling_high(std::size_t period) const {
+  const ChannelState *c = find_channel(period);
+  return (c && c->count >= c->period) ? c->highs.front().second : 0.0;
+}
+
+double IndicatorSet::rolling_low(std::size_t period) const {
+  const ChannelState *c = find_channel(period);
+  return (c && c->count >= c->period) ? c->lows.front().second : 0.0;
+}
@@ -0,0 +1,113 @@
+#include "latency_model.hpp"
+#include "strategy.hpp" // for StrategyConfig
+
+#include <cmath>
+#include <stdexcept>
+
+const char *latency_path_to_string(LatencyPath path) {
+  switch (path) {
+  case LatencyPath::MARKET_DATA:
+    return "MARKET_DATA";
+  case LatencyPath::ORDER_ENTRY:
+    return "ORDER_ENTRY";
+  case LatencyPath::FILL_NOTIFICATION:
+    return "FILL_NOTIFICATION";
+  }
+  return "UNKNOWN";
+}
+
+FixedLatency::FixedLatency(Duration latency) : latency_(latency) {
+  if (latency < Duration::zero()) {
+    throw std::runtime_error("Latency cannot be negative");
+  }
+}
+
+LogNormalLatency::LogNormalLatency(Duration median, double sigma,
+                                   std::uint64_t seed)
+    : rng_(seed) {
+  if (median <= Duration::zero() || sigma <= 0.0) {
+    throw std::runtime_error(
+        "Log-normal latency needs a positive median and sigma");
+  }
+  double median_ns = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(median).count());
+  dist_ = std::lognormal_distribution<double>(std::log(median_ns), sigma);
+}
+
+Duration LogNormalLatency::sample(std::size_t) {
+  return std::chrono::duration_cast<Duration>(
+      std::chrono::nanoseconds(std::llround(dist_(rng_))));
+}
+
+QueueLoadLatency::QueueLoadLatency(std::unique_ptr<LatencyModel> base,
+                                   Duration per_message, Duration max_latency)
+    : base_(std::move(base)), per_message_(per_message),
+      max_latency_(max_latency) {
+  if (!base_) {
+    throw std::runtime_error("Queue-load latency needs a base model");
+  }
+  if (per_message < Duration::zero() || max_latency < Duration::zero()) {
+    throw std::runtime_error("Latency cannot be negative");
+  }
+}
+
+Duration QueueLoadLatency::sample(std::size_t in_flight) {
+  Duration latency = base_->sample(in_flight) +
+                     per_message_ * static_cast<Duration::rep>(in_flight);
+  if (max_latency_ > Duration::zero() && latency > max_latency_) {
+    latency = max_latency_;
+  }
+  return latency;
+}
+
+namespace {
+
+const char *parameter_prefix(LatencyPath path) {
+  switch (path) {
+  case LatencyPath::MARKET_DATA:
+    return "md";
+  case LatencyPath::ORDER_ENTRY:
+    return "order";
+  case LatencyPath::FILL_NOTIFICATION:
+    return "fill";
+  }
+  return "";
+}
+
+Duration microseconds(double us) {
+  return std::chrono::duration_cast<Duration>(
+      std::chrono::duration<double, std::micro>(us));
+}
+
+} // namespace
+
+std::unique_ptr<LatencyModel> make_latency_model(const StrategyConfig &config,
+                                                 LatencyPath path) {
+  std::string prefix = parameter_prefix(path);
+  double latency_us = config.get_parameter(prefix + "_latency_us", 0.0);
+  double sigma = config.get_parameter(prefix + "_latency_sigma", 0.0);
+  double per_msg_us = config.get_parameter(prefix + "_latency_per_msg_us", 0.0);
+  double max_us = config.get_parameter(prefix + "_latency_max_us", 0.0);
+
+  if (latency_us <= 0.0 && per_msg_us <= 0.0) {
+    return nullptr;
+  }
+
+  std::unique_ptr<LatencyModel> model;
+  if (sigma > 0.0 && latency_us > 0.0) {
+    // Each path gets its own stream so adding one does not shift another
+    auto seed = static_cast<std::uint64_t>(
+        config.get_parameter("latency_seed", config.account_id));
+    model = std::make_unique<LogNormalLatency>(
+        microseconds(latency_us), sigma,
+        seed * LATENCY_PATH_COUNT + static_cast<std::uint64_t>(path));
+  } else {
+    model = std::make_unique<FixedLatency>(microseconds(latency_us));
+  }
+
+  if (per_msg_us > 0.0) {
+    model = std::make_unique<QueueLoadLatency>(
+        std::move(model), microseconds(per_msg_us), microseconds(max_us));
+  }
+  return model;
+}
@@ -1,73 +1,280 @@
 #include "latency_tracker.hpp"
 #include <algorithm>
-#include <climits>
+#include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
-#include <map>
+#include <limits>
+#include <stdexcept>
 #include <string>
 
-void LatencyTracker::record(long long latency_ns) {
-  latencies_.push_back(latency_ns);
+namespace {
+
+constexpr char kHistogramMagic[8] = {'L', 'A', 'T', 'H', 'I', 'S', 'T', '1'};
+constexpr std::uint32_t kHistogramVersion = 1;
+
+struct HistogramHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t precision_bits;
+  std::int64_t max_value_ns;
+  std::uint64_t total;
+  std::uint64_t saturated;
+  std::int64_t min;
+  std::int64_t max;
+  double sum;
+  std::uint64_t buckets; // Non-empty buckets that follow
+};
+
+struct HistogramBucket {
+  std::uint64_t index;
+  std::uint64_t count;
+};
+
+int floor_log2(std::uint64_t value) { return 63 - __builtin_clzll(value); }
+
+} // namespace
+
+LatencyTracker::LatencyTracker() : LatencyTracker(Config()) {}
+
+LatencyTracker::LatencyTracker(const Config &config)
+    : config_(config), sub_buckets_(0), total_(0), saturated_(0),
+      min_(std::numeric_limits<long long>::max()), max_(0), sum_(0.0) {
+  if (config.precision_bits < 1 || config.precision_bits > 16) {
+    throw std::runtime_error("Latency precision must be 1 to 16 bits");
+  }
+  if (config.max_value_ns < 1) {
+    throw std::runtime_error("Latency range must be positive");
+  }
+  sub_buckets_ = std::uint64_t{1} << config.precision_bits;
+  counts_.assign(bucket_index(config.max_value_ns) + 1, 0);
 }
 
-void LatencyTracker::print_statistics() {
-  if (latencies_.empty()) {
-    std::cout << "No latencies recorded!" << std::endl;
+// ============================================================================
+// BUCKET LAYOUT
+// ============================================================================
+
+std::size_t LatencyTracker::bucket_index(long long value) const {
+  auto v = static_cast<std::uint64_t>(std::max(value, 0LL));
+  if (v < 2 * sub_buckets_) {
+    return static_cast<std::size_t>(v);
+  }
+  // v >> shift lands in [S, 2S): one row of S sub-buckets per octave
+  int shift = floor_log2(v) - config_.precision_bits;
+  return static_cast<std::size_t>(static_cast<std::uint64_t>(shift) *
+                                      sub_buckets_ +
+                                  (v >> shift));
+}
+
+long long LatencyTracker::bucket_lower(std::size_t index) const {
+  std::uint64_t i = index;
+  if (i < 2 * sub_buckets_) {
+    return static_cast<long long>(i);
+  }
+  std::uint64_t shift = i / sub_buckets_ - 1;
+  return static_cast<long long>((i - shift * sub_buckets_) << shift);
+}
+
+long long LatencyTracker::bucket_upper(std::size_t index) const {
+  std::uint64_t i = index;
+  if (i < 2 * sub_buckets_) {
+    return static_cast<long long>(i);
+  }
+  std::uint64_t shift = i / sub_buckets_ - 1;
+  return bucket_lower(index) + static_cast<long long>((1ULL << shift) - 1);
+}
+
+double LatencyTracker::relative_error() const {
+  return 1.0 / static_cast<double>(sub_buckets_);
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+void LatencyTracker::record_n(long long latency_ns, std::uint64_t count) {
+  if (count == 0) {
     return;
   }
+  if (latency_ns < 0) {
+    latency_ns = 0;
+  } else if (latency_ns > config_.max_value_ns) {
+    latency_ns = config_.max_value_ns;
+    saturated_ += count;
+  }
+  counts_[bucket_index(latency_ns)] += count;
+  total_ += count;
+  min_ = std::min(min_, latency_ns);
+  max_ = std::max(max_, latency_ns);
+  sum_ += static_cast<double>(latency_ns) * static_cast<double>(count);
+}
 
-  std::sort(latencies_.begin(), latencies_.end());
+void LatencyTracker::merge(const LatencyTracker &other) {
+  if (other.config_.precision_bits != config_.precision_bits ||
+      other.config_.max_value_ns != config_.max_value_ns) {
+    throw std::runtime_error(
+        "Cannot merge latency trackers with different precision or range");
+  }
+  for (std::size_t i = 0; i < counts_.size(); ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  total_ += other.total_;
+  saturated_ += other.saturated_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  sum_ += other.sum_;
+}
 
-  std::cout << "\n=== Latency Distribution ===" << std::endl;
-  std::cout << "p50 (median): " << percentile(50) << " ns" << std::endl;
-  std::cout << "p95: " << percentile(95) << " ns" << std::endl;
-  std::cout << "p99: " << percentile(99) << " ns" << std::endl;
-  std::cout << "p99.9: " << percentile(99.9) << " ns" << std::endl;
+void LatencyTracker::reset() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  total_ = 0;
+  saturated_ = 0;
+  min_ = std::numeric_limits<long long>::max();
+  max_ = 0;
+  sum_ = 0.0;
+}
 
-  print_histogram();
+LatencyTracker LatencyTracker::take_interval() {
+  LatencyTracker interval(*this);
+  reset();
+  return interval;
 }
 
-long long LatencyTracker::percentile(double p) {
-  size_t n = latencies_.size();
-  size_t index = static_cast<size_t>((p / 100.0) * n);
-  if (index >= n)
-    index = n - 1;
-  return latencies_[index];
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+long long LatencyTracker::percentile(double p) const {
+  if (total_ == 0) {
+    return 0;
+  }
+  p = std::clamp(p, 0.0, 100.0);
+  auto rank = static_cast<std::uint64_t>(
+      std::ceil(p / 100.0 * static_cast<double>(total_)));
+  rank = std::max<std::uint64_t>(rank, 1);
+
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < counts_.size(); ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return std::clamp(bucket_upper(i), min_, max_);
+    }
+  }
+  return max_;
 }
 
-void LatencyTracker::print_histogram() {
-  std::cout << "\n=== Histogram ===" << std::endl;
+double LatencyTracker::mean() const {
+  return total_ ? sum_ / static_cast<double>(total_) : 0.0;
+}
 
-  std::map<std::string, std::pair<long long, long long>> buckets = {
-      {"<500ns", {0, 500}},
-      {"500-750ns", {500, 750}},
-      {"750-1000ns", {750, 1000}},
-      {"1000-1500ns", {1000, 1500}},
-      {">1500ns", {1500, LLONG_MAX}}};
+// ============================================================================
+// SERIALIZATION
+// ============================================================================
 
-  std::map<std::string, int> counts;
-  for (const auto &[label, range] : buckets) {
-    counts[label] = 0;
+void LatencyTracker::serialize(std::ostream &out) const {
+  HistogramHeader header{};
+  std::memcpy(header.magic, kHistogramMagic, sizeof(header.magic));
+  header.version = kHistogramVersion;
+  header.precision_bits = static_cast<std::uint32_t>(config_.precision_bits);
+  header.max_value_ns = config_.max_value_ns;
+  header.total = total_;
+  header.saturated = saturated_;
+  header.min = min_;
+  header.max = max_;
+  header.sum = sum_;
+  for (std::uint64_t c : counts_) {
+    header.buckets += c != 0;
   }
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
 
-  for (long long lat : latencies_) {
-    for (const auto &[label, range] : buckets) {
-      if (lat >= range.first && lat < range.second) {
-        counts[label]++;
-        break;
-      }
+  for (std::size_t i = 0; i < counts_.size(); ++i) {
+    if (counts_[i] != 0) {
+      HistogramBucket bucket{i, counts_[i]};
+      out.write(reinterpret_cast<const char *>(&bucket), sizeof(bucket));
     }
   }
+  if (!out) {
+    throw std::runtime_error("Failed to write latency histogram");
+  }
+}
+
+LatencyTracker LatencyTracker::deserialize(std::istream &in) {
+  HistogramHeader header{};
+  in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!in || std::memcmp(header.magic, kHistogramMagic, 8) != 0 ||
+      header.version != kHistogramVersion) {
+    throw std::runtime_error("Not a latency histogram");
+  }
+
+  Config config;
+  config.precision_bits = static_cast<int>(header.precision_bits);
+  config.max_value_ns = header.max_value_ns;
+  LatencyTracker tracker(config);
+  for (std::uint64_t b = 0; b < header.buckets; ++b) {
+    HistogramBucket bucket{};
+    in.read(reinterpret_cast<char *>(&bucket), sizeof(bucket));
+    if (!in || bucket.index >= tracker.counts_.size()) {
+      throw std::runtime_error("Corrupt latency histogram");
+    }
+    tracker.counts_[bucket.index] = bucket.count;
+  }
+  tracker.total_ = header.total;
+  tracker.saturated_ = header.saturated;
+  tracker.min_ = header.min;
+  tracker.max_ = header.max;
+  tracker.sum_ = header.sum;
+  return tracker;
+}
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+void LatencyTracker::print_statistics() const {
+  if (total_ == 0) {
+    std::cout << "No latencies recorded!" << std::endl;
+    return;
+  }
 
-  size_t total = latencies_.size();
-  for (const auto &[label, range] : buckets) {
-    int count = counts[label];
-    double percentage = (count * 100.0) / total;
+  std::cout << "\n=== Latency Distribution ===" << std::endl;
+  std::cout << "samples: " << total_ << "  min: " << min() << " ns  max: "
+            << max() << " ns  mean: " << std::fixed << std::setprecision(1)
+            << mean() << " ns" << std::endl;
+  std::cout << "p50 (median): " << percentile(50) << " ns" << std::endl;
+  std::cout << "p95: " << percentile(95) << " ns" << std::endl;
+  std::cout << "p99: " << percentile(99) << " ns" << std::endl;
+  std::cout << "p99.9: " << percentile(99.9) << " ns" << std::endl;
+  std::cout << "p99.99: " << percentile(99.99) << " ns" << std::endl;
+  if (saturated_ > 0) {
+    std::cout << saturated_ << " samples above " << config_.max_value_ns
+              << " ns were clamped" << std::endl;
+  }
 
-    std::cout << label << ": " << count << " (" << std::fixed
-              << std::setprecision(1) << percentage << "%) ";
+  print_histogram();
+}
+
+void LatencyTracker::print_histogram() const {
+  std::cout << "\n=== Histogram ===" << std::endl;
+
+  // One row per power of two between min and max
+  int low = min_ > 0 ? floor_log2(static_cast<std::uint64_t>(min_)) : 0;
+  int high = max_ > 0 ? floor_log2(static_cast<std::uint64_t>(max_)) : 0;
+  for (int octave = low; octave <= high; ++octave) {
+    long long from = octave == 0 ? 0 : 1LL << octave;
+    long long to = (1LL << (octave + 1)) - 1;
+    std::uint64_t count = 0;
+    for (std::size_t i = bucket_index(from);
+         i < counts_.size() && bucket_lower(i) <= to; ++i) {
+      count += counts_[i];
+    }
+    double percentage = (count * 100.0) / static_cast<double>(total_);
+
+    std::cout << std::setw(12) << from << "-" << std::left << std::setw(12)
+              << (std::to_string(to) + "ns") << std::right << std::setw(10)
+              << count << " (" << std::fixed << std::setprecision(1)
+              << std::setw(5) << percentage << "%) ";
 
     int bar_length = static_cast<int>(percentage / 2);
     std::cout << std::string(bar_length, '#') << std::endl;
   }
-}
\ No newline at end of file
+}
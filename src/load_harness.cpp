@@ -0,0 +1,286 @@
+#include "load_harness.hpp"
+#include "muted_output.hpp"
+#include "order_book.hpp"
+#include "trading_simulator.hpp"
+#include "tsc_clock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+long long ticks_to_ns(std::uint64_t ticks) {
+  return static_cast<long long>(TscClock::to_nanoseconds(ticks));
+}
+
+std::string format_ns(long long ns) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(1);
+  if (ns >= 1000000000LL) {
+    out << ns / 1e9 << "s";
+  } else if (ns >= 1000000LL) {
+    out << ns / 1e6 << "ms";
+  } else if (ns >= 1000LL) {
+    out << ns / 1e3 << "us";
+  } else {
+    out << std::setprecision(0) << static_cast<double>(ns) << "ns";
+  }
+  return out.str();
+}
+
+std::string format_rate(double rate) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(rate >= 1e6 ? 2 : 1);
+  if (rate >= 1e6) {
+    out << rate / 1e6 << "M";
+  } else {
+    out << rate / 1e3 << "k";
+  }
+  return out.str();
+}
+
+} // namespace
+
+std::string to_string(LoadTarget target) {
+  switch (target) {
+  case LoadTarget::SINGLE_BOOK:
+    return "single book";
+  case LoadTarget::MULTI_SYMBOL:
+    return "multi-symbol";
+  case LoadTarget::SIMULATOR:
+    return "simulator";
+  }
+  return "?";
+}
+
+// ============================================================================
+// OPEN-LOOP RUN
+// ============================================================================
+
+LoadRunResult run_open_loop(const std::vector<TapeCommand> &tape, double rate,
+                            std::size_t warmup, const CommandSink &sink,
+                            const LatencyTracker::Config &histogram) {
+  if (rate <= 0.0) {
+    throw std::runtime_error("Offered rate must be positive");
+  }
+  if (warmup >= tape.size()) {
+    throw std::runtime_error("Tape has no commands left after warmup");
+  }
+
+  LoadRunResult result;
+  result.offered_rate = rate;
+  result.response = LatencyTracker(histogram);
+  result.service = LatencyTracker(histogram);
+
+  // Due times come from the command index, never from the previous
+  // completion, so a slow command cannot push the schedule back
+  const double ticks_per_command = 1e9 / rate / TscClock::ns_per_tick();
+  const std::uint64_t start = TscClock::now();
+  std::uint64_t measure_start = 0;
+  std::uint64_t done = start;
+  std::uint64_t max_lag = 0;
+
+  for (std::size_t i = 0; i < tape.size(); ++i) {
+    const std::uint64_t due =
+        start + static_cast<std::uint64_t>(static_cast<double>(i) *
+                                           ticks_per_command);
+    std::uint64_t sent = TscClock::now();
+    while (sent < due) {
+      sent = TscClock::now();
+    }
+
+    sink(tape[i]);
+    done = TscClock::now();
+
+    if (i < warmup) {
+      continue;
+    }
+    if (i == warmup) {
+      measure_start = due;
+    }
+    result.response.record(ticks_to_ns(done - due));
+    result.service.record(ticks_to_ns(done - sent));
+    max_lag = std::max(max_lag, sent - due);
+  }
+
+  result.commands = tape.size() - warmup;
+  result.max_lag_ns = ticks_to_ns(max_lag);
+  double elapsed_s = TscClock::to_nanoseconds(done - measure_start) * 1e-9;
+  result.achieved_rate =
+      elapsed_s > 0.0 ? static_cast<double>(result.commands) / elapsed_s
+                      : rate;
+  return result;
+}
+
+// ============================================================================
+// LOAD HARNESS
+// ============================================================================
+
+LoadHarness::LoadHarness(const LoadHarnessConfig &config) : config_(config) {
+  if (config_.measured_commands == 0) {
+    throw std::runtime_error("Load harness needs measured commands");
+  }
+  if (config_.target != LoadTarget::SINGLE_BOOK && config_.symbols == 0) {
+    throw std::runtime_error("Load harness needs at least one symbol");
+  }
+  OrderTapeConfig tape = config_.tape;
+  tape.commands = config_.warmup_commands + config_.measured_commands;
+  tape_ = generate_order_tape(tape);
+}
+
+std::vector<double> LoadHarness::offered_rates() const {
+  if (!config_.offered_rates.empty()) {
+    return config_.offered_rates;
+  }
+  std::vector<double> rates;
+  double rate = config_.start_rate;
+  for (std::size_t i = 0; i < config_.max_runs; ++i) {
+    rates.push_back(rate);
+    rate *= config_.rate_step;
+  }
+  return rates;
+}
+
+LoadRunResult LoadHarness::run_at(double rate) {
+  MutedOutput muted(config_.mute_engine_output);
+  const double tick = config_.tape.tick_size;
+  const std::size_t warmup = static_cast<std::size_t>(config_.warmup_commands);
+  LoadRunResult result;
+
+  switch (config_.target) {
+  case LoadTarget::SINGLE_BOOK: {
+    OrderBook book("LOAD");
+    result = run_open_loop(
+        tape_, rate, warmup,
+        [&book, tick](const TapeCommand &command) {
+          apply_tape_command(book, command, tick);
+        },
+        config_.histogram);
+    break;
+  }
+  case LoadTarget::MULTI_SYMBOL: {
+    std::vector<std::unique_ptr<OrderBook>> books;
+    for (std::size_t i = 0; i < config_.symbols; ++i) {
+      books.push_back(
+          std::make_unique<OrderBook>("LOAD" + std::to_string(i)));
+    }
+    // Routing by order ID keeps cancels and amends with their order
+    result = run_open_loop(
+        tape_, rate, warmup,
+        [&books, tick](const TapeCommand &command) {
+          apply_tape_command(*books[command.order_id % books.size()], command,
+                             tick);
+        },
+        config_.histogram);
+    break;
+  }
+  case LoadTarget::SIMULATOR: {
+    TradingSimulator sim("LOAD0");
+    std::vector<OrderBook *> books;
+    for (std::size_t i = 0; i < config_.symbols; ++i) {
+      std::string symbol = "LOAD" + std::to_string(i);
+      sim.add_instrument(symbol);
+      books.push_back(&sim.get_order_book(symbol));
+    }
+    sim.setup();
+    for (std::uint32_t s = 0; s < config_.tape.streams; ++s) {
+      sim.create_account(config_.tape.account_base + static_cast<int>(s),
+                         "Load Stream", 1e12);
+    }
+
+    // Each command is an ORDER_ARRIVAL event at its due time in virtual
+    // time (command i at start + i / rate), so it takes the scheduler hop,
+    // the virtual clock advances with the offered load, and fills reach
+    // positions with matching timestamps
+    EventScheduler &scheduler = sim.get_scheduler();
+    const TimePoint start = sim.get_clock().now();
+    const std::chrono::duration<double, std::nano> spacing(1e9 / rate);
+    std::uint64_t index = 0;
+    result = run_open_loop(
+        tape_, rate, warmup,
+        [&books, &scheduler, &index, start, spacing,
+         tick](const TapeCommand &command) {
+          OrderBook *book = books[command.order_id % books.size()];
+          TimePoint due = start + std::chrono::duration_cast<Duration>(
+                                      spacing * static_cast<double>(index++));
+          scheduler.schedule_at(
+              due, SimEventType::ORDER_ARRIVAL,
+              [book, command, tick] { apply_tape_command(*book, command, tick); });
+          scheduler.run_until(due);
+        },
+        config_.histogram);
+    break;
+  }
+  }
+
+  result.sustained =
+      result.achieved_rate >= config_.sustain_ratio * rate &&
+      (config_.max_p99_ns <= 0 ||
+       result.response.percentile(99) <= config_.max_p99_ns);
+  return result;
+}
+
+std::vector<LoadRunResult> LoadHarness::run() {
+  std::vector<LoadRunResult> results;
+  for (double rate : offered_rates()) {
+    results.push_back(run_at(rate));
+    if (config_.stop_after_saturation && !results.back().sustained) {
+      break;
+    }
+  }
+  return results;
+}
+
+double LoadHarness::saturation_knee(const std::vector<LoadRunResult> &results) {
+  double knee = 0.0;
+  for (const auto &result : results) {
+    if (result.sustained) {
+      knee = std::max(knee, result.offered_rate);
+    }
+  }
+  return knee;
+}
+
+void LoadHarness::print_report(const std::vector<LoadRunResult> &results) const {
+  std::cout << "\n=== Open-Loop Capacity Curve (" << to_string(config_.target)
+            << ", " << config_.measured_commands
+            << " commands per load) ===" << std::endl;
+  std::cout << "Response time is measured from the intended send time; "
+               "service time from the actual send."
+            << std::endl;
+  std::cout << std::right << std::setw(10) << "offered/s" << std::setw(11)
+            << "achieved/s" << std::setw(9) << "p50" << std::setw(9) << "p90"
+            << std::setw(9) << "p99" << std::setw(9) << "p99.9"
+            << std::setw(9) << "p99.99" << std::setw(9) << "max"
+            << std::setw(10) << "svc p50" << std::setw(10) << "svc p99"
+            << "  status" << std::endl;
+  std::cout << std::string(107, '-') << std::endl;
+
+  for (const auto &result : results) {
+    const LatencyTracker &r = result.response;
+    std::cout << std::setw(10) << format_rate(result.offered_rate)
+              << std::setw(11) << format_rate(result.achieved_rate)
+              << std::setw(9) << format_ns(r.percentile(50)) << std::setw(9)
+              << format_ns(r.percentile(90)) << std::setw(9)
+              << format_ns(r.percentile(99)) << std::setw(9)
+              << format_ns(r.percentile(99.9)) << std::setw(9)
+              << format_ns(r.percentile(99.99)) << std::setw(9)
+              << format_ns(r.max()) << std::setw(10)
+              << format_ns(result.service.percentile(50)) << std::setw(10)
+              << format_ns(result.service.percentile(99)) << "  "
+              << (result.sustained ? "ok" : "SATURATED") << std::endl;
+  }
+
+  double knee = saturation_knee(results);
+  if (knee > 0.0) {
+    std::cout << "Saturation knee: " << format_rate(knee)
+              << " commands/s (highest sustained load)" << std::endl;
+  } else {
+    std::cout << "No offered load was sustained" << std::endl;
+  }
+}
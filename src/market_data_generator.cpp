@@ -14,7 +14,8 @@ MarketDataGenerator::MarketDataGenerator()
     : MarketDataGenerator(Config()) {}
 
 MarketDataGenerator::MarketDataGenerator(const Config &config)
-    : config_(config), rng_(config.seed), price_noise_(0.0, config.volatility),
+    : config_(config), clock_(&wall_clock()), rng_(config.seed),
+      price_noise_(0.0, config.volatility),
       size_dist_(config.min_size, config.max_size), uniform01_(0.0, 1.0),
       last_mid_(config.start_price), next_order_id_(100000) {}
 
@@ -30,8 +31,15 @@ int MarketDataGenerator::generate_quantity() {
 }
 
 MarketDataSnapshot MarketDataGenerator::next_snapshot() {
-  double shock = price_noise_(rng_);
-  last_mid_ = std::max(kMinPrice, last_mid_ + config_.drift + shock);
+  return make_snapshot(price_noise_(rng_));
+}
+
+MarketDataSnapshot MarketDataGenerator::next_snapshot(double shock) {
+  return make_snapshot(shock * config_.volatility);
+}
+
+MarketDataSnapshot MarketDataGenerator::make_snapshot(double price_move) {
+  last_mid_ = std::max(kMinPrice, last_mid_ + config_.drift + price_move);
   double half_spread = config_.spread * 0.5;
 
   MarketDataSnapshot snapshot;
@@ -43,7 +51,7 @@ MarketDataSnapshot MarketDataGenerator::next_snapshot() {
   snapshot.bid_size = static_cast<double>(generate_quantity());
   snapshot.ask_size = static_cast<double>(generate_quantity());
   snapshot.spread = snapshot.ask_price - snapshot.bid_price;
-  snapshot.timestamp = Clock::now();
+  snapshot.timestamp = clock_->now();
 
   return snapshot;
 }
@@ -139,7 +147,20 @@ void MarketDataGenerator::maybe_submit_market(OrderBook &book,
 
 void MarketDataGenerator::step(OrderBook *book,
                                double market_order_probability) {
-  MarketDataSnapshot snapshot = next_snapshot();
+  advance(next_snapshot(), book, market_order_probability);
+}
+
+MarketDataSnapshot
+MarketDataGenerator::step_with_shock(double shock, OrderBook *book,
+                                     double market_order_probability) {
+  MarketDataSnapshot snapshot = next_snapshot(shock);
+  advance(snapshot, book, market_order_probability);
+  return snapshot;
+}
+
+void MarketDataGenerator::advance(const MarketDataSnapshot &snapshot,
+                                  OrderBook *book,
+                                  double market_order_probability) {
   emit_snapshot(snapshot);
 
   if (!book) {
@@ -0,0 +1,277 @@
+#include "memory_profile.hpp"
+#include "muted_output.hpp"
+#include "order_book.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <unistd.h>
+
+namespace {
+
+// Constant-initialized, so touching it from operator new never allocates
+thread_local AllocCounts t_alloc_counts;
+std::atomic<bool> g_alloc_counting{false};
+
+constexpr int kFootprintAccount = 1;
+constexpr int kFootprintIdBase = 2000000000; // Clear of tape order IDs
+
+void record_op(OpAllocStats &stats, const AllocCounts &delta) {
+  ++stats.operations;
+  stats.allocations += delta.allocations;
+  stats.bytes += delta.bytes_allocated;
+  if (delta.allocations > 0) {
+    ++stats.allocating_operations;
+    stats.max_allocations = std::max(stats.max_allocations, delta.allocations);
+  }
+}
+
+std::size_t total_bytes(const std::vector<StructureFootprint> &structures) {
+  std::size_t bytes = 0;
+  for (const auto &structure : structures) {
+    bytes += structure.bytes;
+  }
+  return bytes;
+}
+
+std::size_t elements_of(const MemorySample &sample, const char *name) {
+  for (const auto &structure : sample.structures) {
+    if (structure.name == name) {
+      return structure.elements;
+    }
+  }
+  return 0;
+}
+
+double megabytes(double bytes) { return bytes / (1024.0 * 1024.0); }
+
+void print_op_table(const char *title,
+                    const std::array<OpAllocStats, kTapeOpCount> &stats) {
+  std::cout << "\n" << title << std::endl;
+  std::cout << std::left << std::setw(12) << "op" << std::right
+            << std::setw(12) << "ops" << std::setw(11) << "allocs/op"
+            << std::setw(11) << "bytes/op" << std::setw(12) << "allocating"
+            << std::setw(6) << "max" << std::endl;
+  for (std::size_t i = 0; i < kTapeOpCount; ++i) {
+    const OpAllocStats &op = stats[i];
+    if (op.operations == 0) {
+      continue;
+    }
+    double n = static_cast<double>(op.operations);
+    std::cout << std::left << std::setw(12)
+              << to_string(static_cast<TapeOp>(i)) << std::right
+              << std::setw(12) << op.operations << std::fixed
+              << std::setprecision(3) << std::setw(11) << op.allocations / n
+              << std::setprecision(1) << std::setw(11) << op.bytes / n
+              << std::setw(11) << 100.0 * op.allocating_operations / n << "%"
+              << std::setw(6) << op.max_allocations << std::endl;
+  }
+}
+
+} // namespace
+
+const char *to_string(TapeOp op) {
+  switch (op) {
+  case TapeOp::NEW_LIMIT:
+    return "NEW_LIMIT";
+  case TapeOp::NEW_IOC:
+    return "NEW_IOC";
+  case TapeOp::NEW_MARKET:
+    return "NEW_MARKET";
+  case TapeOp::CANCEL:
+    return "CANCEL";
+  case TapeOp::AMEND:
+    return "AMEND";
+  }
+  return "?";
+}
+
+// ============================================================================
+// ALLOCATION COUNTING
+// ============================================================================
+
+AllocCounts thread_alloc_counts() { return t_alloc_counts; }
+
+bool alloc_counting_enabled() {
+  return g_alloc_counting.load(std::memory_order_relaxed);
+}
+
+void alloc_counting_install() {
+  g_alloc_counting.store(true, std::memory_order_relaxed);
+}
+
+void note_allocation(std::size_t bytes, std::size_t usable) {
+  ++t_alloc_counts.allocations;
+  t_alloc_counts.bytes_allocated += bytes;
+  t_alloc_counts.live_bytes += static_cast<std::int64_t>(usable);
+}
+
+void note_free(std::size_t usable) {
+  ++t_alloc_counts.frees;
+  t_alloc_counts.live_bytes -= static_cast<std::int64_t>(usable);
+}
+
+std::size_t resident_set_bytes() {
+  std::ifstream statm("/proc/self/statm");
+  std::size_t pages = 0;
+  std::size_t resident = 0;
+  if (!(statm >> pages >> resident)) {
+    return 0;
+  }
+  return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// ============================================================================
+// MEMORY SOAK
+// ============================================================================
+
+std::uint64_t MemorySoakReport::steady_allocations() const {
+  std::uint64_t total = 0;
+  for (const auto &op : steady) {
+    total += op.allocations;
+  }
+  return total;
+}
+
+MemorySoakReport run_memory_soak(const MemorySoakConfig &config) {
+  MutedOutput muted(config.mute_engine_output);
+  MemorySoakReport report;
+  report.counting = alloc_counting_enabled();
+  const double tick = config.tape.tick_size;
+
+  // Bytes per resting order, on a book of its own so the passive orders
+  // do not linger in the soak
+  if (config.footprint_orders > 0) {
+    OrderBook book("FOOTPRINT");
+    const std::uint64_t n = config.footprint_orders;
+    AllocCounts before = thread_alloc_counts();
+    std::size_t rss_before = resident_set_bytes();
+    std::size_t estimated_before = total_bytes(book.memory_footprint());
+    for (std::uint64_t i = 0; i < n; ++i) {
+      double price = config.tape.start_price - (1 + i % 1000) * tick;
+      book.add_order(Order(kFootprintIdBase + static_cast<int>(i),
+                           kFootprintAccount, Side::BUY, price, 100));
+    }
+    AllocCounts delta = thread_alloc_counts() - before;
+    double orders = static_cast<double>(n);
+    report.heap_bytes_per_order = delta.live_bytes / orders;
+    report.rss_bytes_per_order =
+        (static_cast<double>(resident_set_bytes()) -
+         static_cast<double>(rss_before)) /
+        orders;
+    report.estimated_bytes_per_order =
+        (static_cast<double>(total_bytes(book.memory_footprint())) -
+         static_cast<double>(estimated_before)) /
+        orders;
+  }
+
+  OrderBook book("SOAK");
+  if (config.event_logging) {
+    book.enable_logging();
+  }
+
+  OrderTapeConfig tape = config.tape;
+  tape.commands = config.operations;
+  OrderTapeGenerator generator(tape);
+  std::vector<TapeCommand> chunk(
+      static_cast<std::size_t>(std::max<std::uint64_t>(config.chunk, 1)));
+
+  const std::uint64_t steady_from = static_cast<std::uint64_t>(
+      static_cast<double>(config.operations) * config.warmup_fraction);
+  const std::uint64_t sample_every =
+      std::max<std::uint64_t>(config.sample_every, 1);
+  std::uint64_t operations = 0;
+  std::uint64_t sampled_at = 0;
+  std::uint64_t op_allocations = 0; // Inside operations since the sample
+
+  while (!generator.done()) {
+    std::size_t n = generator.generate(chunk.data(), chunk.size());
+    for (std::size_t i = 0; i < n; ++i) {
+      const TapeCommand &command = chunk[i];
+      AllocCounts before = thread_alloc_counts();
+      apply_tape_command(book, command, tick);
+      AllocCounts delta = thread_alloc_counts() - before;
+
+      std::size_t type = static_cast<std::size_t>(command.op);
+      record_op(report.all[type], delta);
+      if (operations >= steady_from) {
+        record_op(report.steady[type], delta);
+      }
+      op_allocations += delta.allocations;
+      ++operations;
+
+      if (operations % sample_every == 0 || operations == config.operations) {
+        MemorySample sample;
+        sample.operations = operations;
+        sample.rss_bytes = resident_set_bytes();
+        sample.heap_live_bytes = thread_alloc_counts().live_bytes;
+        sample.allocations_per_op =
+            static_cast<double>(op_allocations) /
+            static_cast<double>(operations - sampled_at);
+        sample.structures = book.memory_footprint();
+        report.growth.push_back(std::move(sample));
+        sampled_at = operations;
+        op_allocations = 0;
+      }
+    }
+  }
+  return report;
+}
+
+void MemorySoakReport::print() const {
+  std::cout << "\n=== Memory Soak ===" << std::endl;
+  if (!counting) {
+    std::cout << "Allocation counting unavailable: link "
+                 "bench/counting_allocator.cpp to enable it"
+              << std::endl;
+  }
+
+  std::cout << "\nResting order footprint:" << std::endl;
+  std::cout << std::fixed << std::setprecision(1)
+            << "  heap:      " << heap_bytes_per_order << " bytes/order"
+            << std::endl
+            << "  RSS:       " << rss_bytes_per_order << " bytes/order"
+            << std::endl
+            << "  estimated: " << estimated_bytes_per_order
+            << " bytes/order (structure sizes)" << std::endl;
+
+  if (counting) {
+    print_op_table("Allocations per operation (whole run):", all);
+    print_op_table("Allocations per operation (steady state):", steady);
+  }
+
+  std::cout << "\nGrowth curve:" << std::endl;
+  std::cout << std::right << std::setw(12) << "ops" << std::setw(10) << "RSS MB"
+            << std::setw(10) << "heap MB" << std::setw(10) << "allocs/op"
+            << std::setw(10) << "active" << std::setw(11) << "cancelled"
+            << std::setw(10) << "fills" << std::setw(10) << "routed"
+            << std::setw(11) << "events" << std::setw(11) << "latencies"
+            << std::endl;
+  for (const auto &sample : growth) {
+    std::cout << std::setw(12) << sample.operations << std::setprecision(1)
+              << std::setw(10) << megabytes(sample.rss_bytes) << std::setw(10)
+              << megabytes(static_cast<double>(sample.heap_live_bytes))
+              << std::setprecision(3) << std::setw(10)
+              << sample.allocations_per_op << std::setw(10)
+              << elements_of(sample, "active_orders_") << std::setw(11)
+              << elements_of(sample, "cancelled_orders_") << std::setw(10)
+              << elements_of(sample, "fills_") << std::setw(10)
+              << elements_of(sample, "routed_fills_") << std::setw(11)
+              << elements_of(sample, "event_log_") << std::setw(11)
+              << elements_of(sample, "insertion_latencies_ns_") << std::endl;
+  }
+
+  if (!growth.empty()) {
+    std::cout << "\nStructures at the end of the run (estimated):"
+              << std::endl;
+    for (const auto &structure : growth.back().structures) {
+      std::cout << "  " << std::left << std::setw(26) << structure.name
+                << std::right << std::setw(12) << structure.elements
+                << std::setprecision(1) << std::setw(10)
+                << megabytes(static_cast<double>(structure.bytes)) << " MB"
+                << std::endl;
+    }
+  }
+}
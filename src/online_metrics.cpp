@@ -0,0 +1,187 @@
+#include "online_metrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double kZeroPnl = 1e-6;
+constexpr double kTradingPeriods = 252.0;
+} // namespace
+
+double RunningMoments::stddev() const { return std::sqrt(variance()); }
+
+// ============================================================================
+// ONLINE P&L METRICS
+// ============================================================================
+
+OnlinePnlMetrics::OnlinePnlMetrics() { reset(); }
+
+void OnlinePnlMetrics::reset() {
+  samples_ = 0;
+  first_time_ = last_time_ = peak_time_ = TimePoint();
+  first_pnl_ = last_pnl_ = peak_ = 0.0;
+  sharpe_returns_ = RunningMoments();
+  defined_returns_ = RunningMoments();
+  downside_sum_sq_ = 0.0;
+  downside_count_ = 0;
+  max_drawdown_pct_ = 0.0;
+  max_drawdown_amount_ = 0.0;
+  longest_drawdown_ = Clock::duration::zero();
+}
+
+void OnlinePnlMetrics::add(TimePoint timestamp, double pnl) {
+  if (samples_ == 0) {
+    samples_ = 1;
+    first_time_ = last_time_ = peak_time_ = timestamp;
+    first_pnl_ = last_pnl_ = peak_ = pnl;
+    return;
+  }
+
+  if (std::abs(last_pnl_) < kZeroPnl) {
+    sharpe_returns_.add(0.0);
+  } else {
+    double r = (pnl - last_pnl_) / std::abs(last_pnl_);
+    sharpe_returns_.add(r);
+    defined_returns_.add(r);
+    if (r < 0.0) {
+      downside_sum_sq_ += r * r;
+      ++downside_count_;
+    }
+  }
+
+  if (pnl > peak_) {
+    peak_ = pnl;
+    peak_time_ = timestamp;
+  } else if (pnl < peak_) {
+    max_drawdown_amount_ = std::max(max_drawdown_amount_, peak_ - pnl);
+    if (peak_ > 0.0) {
+      max_drawdown_pct_ =
+          std::max(max_drawdown_pct_, (peak_ - pnl) / peak_ * 100.0);
+    }
+    longest_drawdown_ = std::max(longest_drawdown_, timestamp - peak_time_);
+  } else {
+    peak_time_ = timestamp; // Back at the peak: the drawdown is over
+  }
+
+  ++samples_;
+  last_time_ = timestamp;
+  last_pnl_ = pnl;
+}
+
+double OnlinePnlMetrics::total_return() const {
+  return samples_ < 2 ? 0.0 : last_pnl_ - first_pnl_;
+}
+
+double OnlinePnlMetrics::return_percentage() const {
+  if (samples_ < 2 || std::abs(first_pnl_) < kZeroPnl) {
+    return 0.0;
+  }
+  return (last_pnl_ - first_pnl_) / std::abs(first_pnl_) * 100.0;
+}
+
+double OnlinePnlMetrics::sharpe_ratio() const {
+  double stddev = sharpe_returns_.stddev();
+  if (sharpe_returns_.count == 0 || stddev < 1e-10) {
+    return 0.0;
+  }
+  return sharpe_returns_.mean / stddev * std::sqrt(kTradingPeriods);
+}
+
+double OnlinePnlMetrics::sortino_ratio() const {
+  if (defined_returns_.count == 0 || downside_count_ == 0) {
+    return 0.0;
+  }
+  double downside_dev =
+      std::sqrt(downside_sum_sq_ / static_cast<double>(downside_count_));
+  if (downside_dev < 1e-10) {
+    return 0.0;
+  }
+  return defined_returns_.mean / downside_dev * std::sqrt(kTradingPeriods);
+}
+
+std::pair<double, double> OnlinePnlMetrics::return_statistics() const {
+  if (defined_returns_.count == 0) {
+    return {0.0, 0.0};
+  }
+  return {defined_returns_.mean, defined_returns_.stddev()};
+}
+
+// ============================================================================
+// MIN / MAX DECIMATION
+// ============================================================================
+
+MinMaxDecimator::MinMaxDecimator(std::size_t capacity)
+    : max_buckets_(std::max<std::size_t>(capacity / 2, 1)), stride_(1),
+      in_last_(0), samples_(0) {
+  buckets_.reserve(max_buckets_);
+}
+
+void MinMaxDecimator::add(TimePoint timestamp, double value) {
+  ++samples_;
+  Point point{timestamp, value};
+
+  if (in_last_ == stride_ && buckets_.size() == max_buckets_) {
+    compact();
+  }
+  if (buckets_.empty() || in_last_ == stride_) {
+    buckets_.push_back({point, point});
+    in_last_ = 1;
+    return;
+  }
+
+  Bucket &bucket = buckets_.back();
+  if (value < bucket.low.second) {
+    bucket.low = point;
+  }
+  if (value > bucket.high.second) {
+    bucket.high = point;
+  }
+  ++in_last_;
+}
+
+void MinMaxDecimator::compact() {
+  // Merge pairs (0,1), (2,3), ...; an odd last bucket carries over alone
+  std::size_t merged = 0;
+  std::size_t last_count = in_last_;
+  for (std::size_t i = 0; i < buckets_.size(); i += 2) {
+    Bucket bucket = buckets_[i];
+    if (i + 1 < buckets_.size()) {
+      const Bucket &next = buckets_[i + 1];
+      if (next.low.second < bucket.low.second) {
+        bucket.low = next.low;
+      }
+      if (next.high.second > bucket.high.second) {
+        bucket.high = next.high;
+      }
+      last_count = stride_ + in_last_;
+    } else {
+      last_count = in_last_;
+    }
+    buckets_[merged++] = bucket;
+  }
+  buckets_.resize(merged);
+  stride_ *= 2;
+  in_last_ = last_count;
+}
+
+void MinMaxDecimator::clear() {
+  buckets_.clear();
+  stride_ = 1;
+  in_last_ = 0;
+  samples_ = 0;
+}
+
+std::vector<MinMaxDecimator::Point> MinMaxDecimator::points() const {
+  std::vector<Point> result;
+  result.reserve(buckets_.size() * 2);
+  for (const auto &bucket : buckets_) {
+    const Point &first =
+        bucket.low.first <= bucket.high.first ? bucket.low : bucket.high;
+    const Point &second = &first == &bucket.low ? bucket.high : bucket.low;
+    result.push_back(first);
+    if (second.first != first.first || second.second != first.second) {
+      result.push_back(second);
+    }
+  }
+  return result;
+}
@@ -1,17 +1,200 @@
 #include "order_book.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
+namespace {
+
+std::uint8_t flight_flags(const Order &order) {
+  std::uint8_t flags = 0;
+  if (order.is_market_order()) {
+    flags |= kFlightMarket;
+  }
+  if (order.is_iceberg()) {
+    flags |= kFlightIceberg;
+  }
+  if (order.is_stop) {
+    flags |= kFlightStop;
+  }
+  if (order.tif == TimeInForce::IOC) {
+    flags |= kFlightIoc;
+  } else if (order.tif == TimeInForce::FOK) {
+    flags |= kFlightFok;
+  }
+  return flags;
+}
+
+FlightOutcome flight_outcome(OrderState state) {
+  switch (state) {
+  case OrderState::PENDING:
+    return FlightOutcome::PENDING;
+  case OrderState::ACTIVE:
+    return FlightOutcome::RESTED;
+  case OrderState::PARTIALLY_FILLED:
+    return FlightOutcome::PARTIAL;
+  case OrderState::FILLED:
+    return FlightOutcome::FILLED;
+  case OrderState::CANCELLED:
+    return FlightOutcome::CANCELLED;
+  case OrderState::REJECTED:
+    break;
+  }
+  return FlightOutcome::REJECTED;
+}
+
+void stamp_flight(FlightRecord &entry, const Timer &timer) {
+  entry.start_ticks = timer.start_ticks();
+  entry.duration_ticks = static_cast<std::uint32_t>(
+      std::min<std::uint64_t>(timer.elapsed_ticks(), UINT32_MAX));
+}
+
+// Command on an order the book may not know, e.g. a rejected cancel
+FlightRecord flight_command(FlightOp op, int order_id, const Timer &timer) {
+  FlightRecord entry{};
+  entry.op = op;
+  stamp_flight(entry, timer);
+  entry.order_id = order_id;
+  entry.outcome = FlightOutcome::REJECTED;
+  return entry;
+}
+
+FlightRecord flight_command(FlightOp op, const Order &order,
+                            const Timer &timer) {
+  FlightRecord entry = flight_command(op, order.id, timer);
+  entry.other_id = order.account_id;
+  entry.side = order.side == Side::BUY ? 0 : 1;
+  entry.order_flags = flight_flags(order);
+  entry.price = order.is_market_order() ? 0.0 : order.price;
+  return entry;
+}
+
+} // namespace
+
 // ============================================================================
 // CONSTRUCTOR
 // ============================================================================
 
 OrderBook::OrderBook(const std::string &symbol)
-    : fill_router_(std::make_unique<FillRouter>(true)),
-      logging_enabled_(false), last_trade_price_(0), snapshot_counter_(0),
-      current_symbol_(symbol) {
+    : fill_router_(std::make_unique<FillRouter>(true)), amending_(false),
+      clock_(&wall_clock()), logging_enabled_(false), last_trade_price_(0),
+      snapshot_counter_(0), current_symbol_(symbol) {
   fill_router_->set_self_trade_prevention(true);
+  configure_flight_recorder(FlightRecorder::Config());
+}
+
+// ============================================================================
+// ORDER PATH TRACING
+// ============================================================================
+
+OrderPathTracer &OrderBook::enable_tracing(long long slow_threshold_ns) {
+  if (!tracer_) {
+    tracer_ = std::make_unique<OrderPathTracer>(slow_threshold_ns);
+    fill_router_->set_tracer(tracer_.get());
+  } else {
+    tracer_->set_slow_threshold(slow_threshold_ns);
+  }
+  return *tracer_;
+}
+
+void OrderBook::disable_tracing() {
+  fill_router_->set_tracer(nullptr);
+  tracer_.reset();
+}
+
+// ============================================================================
+// RUNTIME METRICS
+// ============================================================================
+
+void OrderBook::attach_metrics(MetricsRegistry &registry, std::string prefix) {
+  if (prefix.empty()) {
+    prefix = "book." + current_symbol_;
+  }
+  metrics_ = std::make_unique<OrderBookMetrics>(registry, prefix);
+  publish_book_gauges();
+}
+
+void OrderBook::record_insertion(const Order &order, const Order &final_order,
+                                 const Timer &timer) {
+  long long latency_ns = timer.elapsed_nanoseconds();
+  insertion_latencies_ns_.push_back(latency_ns);
+  if (flight_recorder_ && !amending_) {
+    FlightRecord entry = flight_command(FlightOp::ADD, order, timer);
+    entry.quantity = order.quantity;
+    entry.leaves = final_order.remaining_qty;
+    entry.outcome = flight_outcome(final_order.state);
+    record_flight(entry);
+  }
+  if (!metrics_ || amending_) {
+    return;
+  }
+  if (order.is_stop) {
+    metrics_->stop_orders.inc();
+  } else if (order.is_iceberg()) {
+    metrics_->iceberg_orders.inc();
+  } else if (order.is_market_order()) {
+    metrics_->market_orders.inc();
+  } else {
+    metrics_->limit_orders.inc();
+  }
+  metrics_->add_latency_ns.record(
+      static_cast<std::uint64_t>(std::max(latency_ns, 0LL)));
+  publish_book_gauges();
+}
+
+void OrderBook::publish_book_gauges() {
+  metrics_->bid_queue_depth.set(static_cast<std::int64_t>(bids_.size()));
+  metrics_->ask_queue_depth.set(static_cast<std::int64_t>(asks_.size()));
+  metrics_->tracked_orders.set(
+      static_cast<std::int64_t>(active_orders_.size()));
+  metrics_->pending_stops.set(static_cast<std::int64_t>(pending_stop_count()));
+}
+
+// ============================================================================
+// FLIGHT RECORDER
+// ============================================================================
+
+FlightRecorder &
+OrderBook::configure_flight_recorder(FlightRecorder::Config config) {
+  if (config.symbol.empty()) {
+    config.symbol = current_symbol_;
+  }
+  flight_recorder_ = std::make_unique<FlightRecorder>(config);
+  return *flight_recorder_;
+}
+
+template <typename PriorityQueue>
+double OrderBook::live_top_price(PriorityQueue &book) {
+  while (!book.empty()) {
+    const Order &top = book.top();
+    auto it = active_orders_.find(top.id);
+    if (it != active_orders_.end() &&
+        it->second.state != OrderState::CANCELLED &&
+        it->second.state != OrderState::FILLED &&
+        !(it->second.display_qty == 0 && it->second.remaining_qty > 0)) {
+      return top.price;
+    }
+    if (metrics_) {
+      metrics_->stale_skipped.inc();
+    }
+    book.pop();
+  }
+  return 0.0;
+}
+
+void OrderBook::record_flight(FlightRecord &entry) {
+  entry.best_bid = live_top_price(bids_);
+  entry.best_ask = live_top_price(asks_);
+  flight_recorder_->record(entry);
+}
+
+void OrderBook::record_flight(FlightOp op, const Order &order,
+                              const Timer &timer) {
+  FlightRecord entry = flight_command(op, order, timer);
+  entry.quantity = order.remaining_qty;
+  entry.leaves = order.state == OrderState::CANCELLED ? 0 : order.remaining_qty;
+  entry.outcome = flight_outcome(order.state);
+  record_flight(entry);
 }
 
 // ============================================================================
@@ -25,11 +208,14 @@ OrderBook::OrderBook(const std::string &symbol)
 void OrderBook::add_order(Order o) {
   Timer timer;
   timer.start();
+  ENGINE_TRACE_ORDER(tracer_.get(), o.id);
 
   Order order = o;
 
   // Handle stop orders (now with trigger-on-placement)
   if (order.is_stop && !order.stop_triggered) {
+    ENGINE_TRACE_STAGE(tracer_.get(), STOP_HANDLING);
+
     // If conditions already meet the stop, trigger immediately (do NOT enqueue)
     if (stop_should_trigger_now(order)) {
       const double ref = current_trigger_price_for_side(order.side);
@@ -41,7 +227,9 @@ void OrderBook::add_order(Order o) {
       trigger_stop_order_immediately(order, ref);
 
       timer.stop();
-      insertion_latencies_ns_.push_back(timer.elapsed_nanoseconds());
+      auto tracked = active_orders_.find(order.id);
+      record_insertion(
+          o, tracked != active_orders_.end() ? tracked->second : order, timer);
       return;
     }
 
@@ -62,24 +250,29 @@ void OrderBook::add_order(Order o) {
     }
 
     timer.stop();
-    insertion_latencies_ns_.push_back(timer.elapsed_nanoseconds());
+    record_insertion(o, order, timer);
     return; // Don't match yet
   }
 
   // Regular orders (or triggered stops) proceed normally
   order.state = OrderState::ACTIVE;
-  active_orders_.insert_or_assign(order.id, order);
+  {
+    ENGINE_TRACE_STAGE(tracer_.get(), ORDER_INSERT);
+    active_orders_.insert_or_assign(order.id, order);
+  }
 
   if (logging_enabled_) {
+    ENGINE_TRACE_STAGE(tracer_.get(), EVENT_LOG);
+
     // Handle market orders with infinite price properly
     double log_price = order.is_market_order() ? 0.0 : order.price;
 
     if (order.is_iceberg()) {
-      event_log_.emplace_back(order.timestamp, order.id, order.side, order.type,
+      event_log_.emplace_back(clock_->now(), order.id, order.side, order.type,
                               order.tif, log_price, order.quantity,
                               order.peak_size, order.account_id);
     } else {
-      event_log_.emplace_back(order.timestamp, order.id, order.side, order.type,
+      event_log_.emplace_back(clock_->now(), order.id, order.side, order.type,
                               order.tif, log_price, order.quantity, 0,
                               order.account_id);
     }
@@ -95,10 +288,10 @@ void OrderBook::add_order(Order o) {
 
   // IMPORTANT: finalize states (prevents overwriting IOC remainder =>
   // CANCELLED)
-  finalize_after_matching(order);
+  const Order *tracked = finalize_after_matching(order);
 
   timer.stop();
-  insertion_latencies_ns_.push_back(timer.elapsed_nanoseconds());
+  record_insertion(o, tracked ? *tracked : order, timer);
 }
 
 // ============================================================================
@@ -112,26 +305,49 @@ bool OrderBook::cancel_order(int order_id) {
   auto it = active_orders_.find(order_id);
   if (it == active_orders_.end()) {
     if (logging_enabled_) {
-      event_log_.emplace_back(Clock::now(), EventType::CANCEL_ORDER, order_id);
+      event_log_.emplace_back(clock_->now(), EventType::CANCEL_ORDER, order_id);
     }
     std::cout << "Order " << order_id << " not found or already processed."
               << '\n';
+    if (metrics_) {
+      metrics_->rejects.inc();
+    }
+    if (flight_recorder_) {
+      timer.stop();
+      FlightRecord entry = flight_command(FlightOp::CANCEL, order_id, timer);
+      record_flight(entry);
+    }
     return false;
   }
   Order &order = it->second;
 
   if (logging_enabled_) {
-    event_log_.emplace_back(Clock::now(), EventType::CANCEL_ORDER, order_id,
+    event_log_.emplace_back(clock_->now(), EventType::CANCEL_ORDER, order_id,
                             order.account_id);
   }
 
   if (order.is_filled()) {
     std::cout << "Order " << order_id << " is already filled." << '\n';
+    if (metrics_) {
+      metrics_->rejects.inc();
+    }
+    if (flight_recorder_) {
+      timer.stop();
+      FlightRecord entry = flight_command(FlightOp::CANCEL, order, timer);
+      entry.quantity = order.remaining_qty;
+      record_flight(entry);
+    }
     return false;
   }
 
   // Mark as canceled
   order.state = OrderState::CANCELLED;
+  FlightRecord entry{};
+  if (flight_recorder_) {
+    entry = flight_command(FlightOp::CANCEL, order, timer);
+    entry.quantity = order.remaining_qty;
+    entry.outcome = FlightOutcome::CANCELLED;
+  }
 
   // Move to cancelled Orders
   cancelled_orders_.insert({order_id, order});
@@ -142,6 +358,14 @@ bool OrderBook::cancel_order(int order_id) {
   // The matching logic should check if order is still active
 
   timer.stop();
+  if (metrics_ && !amending_) {
+    metrics_->cancelled.inc();
+    publish_book_gauges();
+  }
+  if (flight_recorder_ && !amending_) {
+    stamp_flight(entry, timer);
+    record_flight(entry);
+  }
 
   std::cout << "Cancelled order " << order_id
             << " (latency: " << timer.elapsed_nanoseconds() << " ns)" << '\n';
@@ -158,23 +382,46 @@ bool OrderBook::amend_order(int order_id, std::optional<double> new_price,
   auto it = active_orders_.find(order_id);
   if (it == active_orders_.end()) {
     if (logging_enabled_) {
-      event_log_.emplace_back(Clock::now(), order_id, new_price, new_quantity);
+      event_log_.emplace_back(clock_->now(), order_id, new_price, new_quantity);
     }
     std::cout << "Order " << order_id << " not found." << '\n';
+    if (metrics_) {
+      metrics_->rejects.inc();
+    }
+    if (flight_recorder_) {
+      timer.stop();
+      FlightRecord entry = flight_command(FlightOp::AMEND, order_id, timer);
+      entry.price = new_price.value_or(0.0);
+      entry.quantity = new_quantity.value_or(0);
+      record_flight(entry);
+    }
     return false;
   }
   Order &order = it->second;
 
   if (logging_enabled_) {
-    event_log_.emplace_back(Clock::now(), order_id, new_price, new_quantity,
+    event_log_.emplace_back(clock_->now(), order_id, new_price, new_quantity,
                             order.account_id);
   }
 
   // Can't amend filled orders
   if (order.is_filled()) {
     std::cout << "Order " << order_id << " is already filled." << '\n';
+    if (metrics_) {
+      metrics_->rejects.inc();
+    }
+    if (flight_recorder_) {
+      timer.stop();
+      FlightRecord entry = flight_command(FlightOp::AMEND, order, timer);
+      entry.price = new_price.value_or(0.0);
+      entry.quantity = new_quantity.value_or(0);
+      record_flight(entry);
+    }
     return false;
   }
+  if (metrics_) {
+    metrics_->amends.inc();
+  }
 
   // Extract order details
   Side side = order.side;
@@ -182,6 +429,7 @@ bool OrderBook::amend_order(int order_id, std::optional<double> new_price,
   int quantity = new_quantity.value_or(order.remaining_qty);
 
   // Cancel old order
+  amending_ = true;
   cancel_order(order_id);
 
   // Create new order with same ID
@@ -190,8 +438,24 @@ bool OrderBook::amend_order(int order_id, std::optional<double> new_price,
 
   // CRITICAL: Use add_order() to trigger matching logic
   add_order(amended_order);
+  amending_ = false;
 
   timer.stop();
+  if (metrics_) {
+    publish_book_gauges();
+  }
+  if (flight_recorder_) {
+    FlightRecord entry = flight_command(FlightOp::AMEND, amended_order, timer);
+    entry.quantity = quantity;
+    auto live = active_orders_.find(order_id);
+    if (live != active_orders_.end()) {
+      entry.leaves = live->second.remaining_qty;
+      entry.outcome = flight_outcome(live->second.state);
+    } else {
+      entry.outcome = FlightOutcome::CANCELLED;
+    }
+    record_flight(entry);
+  }
 
   std::cout << "✓ Amended order " << order_id
             << " (latency: " << timer.elapsed_nanoseconds() << " ns)" << '\n';
@@ -2,15 +2,17 @@
 
 #include <algorithm>
 #include <iostream>
+#include <unordered_set>
+
+const Order *OrderBook::finalize_after_matching(Order &o) {
+  ENGINE_TRACE_STAGE(tracer_.get(), FINALIZE);
 
-void OrderBook::finalize_after_matching(Order &o) {
   // If already terminal, do not overwrite
   auto it = active_orders_.find(o.id);
-  if (it != active_orders_.end()) {
-    if (it->second.state == OrderState::CANCELLED ||
-        it->second.state == OrderState::FILLED) {
-      return;
-    }
+  const Order *tracked = it != active_orders_.end() ? &it->second : nullptr;
+  if (tracked && (tracked->state == OrderState::CANCELLED ||
+                  tracked->state == OrderState::FILLED)) {
+    return tracked;
   }
 
   if (o.tif == TimeInForce::IOC) {
@@ -26,7 +28,7 @@ void OrderBook::finalize_after_matching(Order &o) {
       if (it != active_orders_.end())
         it->second.state = OrderState::FILLED;
     }
-    return;
+    return tracked;
   }
 
   // FOK handled in check_fok_condition()
@@ -41,10 +43,23 @@ void OrderBook::finalize_after_matching(Order &o) {
     if (it != active_orders_.end())
       it->second.state = OrderState::PARTIALLY_FILLED;
   }
+  return tracked;
 }
 
 bool OrderBook::can_fill_order(const Order &order) const {
   int available_qty = 0;
+  std::unordered_set<int> counted; // Heaps can hold several copies of one id
+
+  // Queue copies keep their size from insertion; quotes amended in place
+  // and partial fills only update active_orders_, so read the size there
+  auto add_live = [&](const Order &copy) {
+    auto it = active_orders_.find(copy.id);
+    if (it == active_orders_.end() || !it->second.is_active() ||
+        !counted.insert(copy.id).second) {
+      return;
+    }
+    available_qty += it->second.remaining_qty;
+  };
 
   if (order.side == Side::BUY) {
     auto asks_copy = asks_;
@@ -56,7 +71,7 @@ bool OrderBook::can_fill_order(const Order &order) const {
         break;
       }
 
-      available_qty += best_ask.remaining_qty;
+      add_live(best_ask);
     }
   } else {
     auto bids_copy = bids_;
@@ -68,7 +83,7 @@ bool OrderBook::can_fill_order(const Order &order) const {
         break;
       }
 
-      available_qty += best_bid.remaining_qty;
+      add_live(best_bid);
     }
   }
   return available_qty >= order.quantity;
@@ -123,8 +138,12 @@ bool OrderBook::execute_trade(Order &aggressive_order, Order &passive_order) {
 
   bool fill_accepted = fill_router_->route_fill(fill, aggressive_order,
                                                 passive_order, current_symbol_);
+  ENGINE_TRACE_STAGE(tracer_.get(), FILL_ROUTING);
 
   if (!fill_accepted) {
+    if (metrics_) {
+      metrics_->self_trades_prevented.inc();
+    }
     // Fill was rejected (likely self-trade prevention)
     std::cout << "⚠ Fill rejected: Order " << aggressive_order.id << " x Order "
               << passive_order.id << " (Account " << aggressive_order.account_id
@@ -148,6 +167,10 @@ bool OrderBook::execute_trade(Order &aggressive_order, Order &passive_order) {
 
   // Keep the old fills_ vector for backward compatibility
   fills_.emplace_back(buy_id, sell_id, trade_price, trade_qty);
+  if (metrics_) {
+    metrics_->fills.inc();
+    metrics_->fill_volume.inc(trade_qty);
+  }
 
   // Keep the old account_fills_ vector for backward compatibility
   account_fills_.emplace_back(fills_.back(), buy_account, sell_account,
@@ -158,7 +181,8 @@ bool OrderBook::execute_trade(Order &aggressive_order, Order &passive_order) {
   // ========================================================================
 
   if (logging_enabled_) {
-    event_log_.emplace_back(Clock::now(), buy_id, sell_id, trade_price,
+    ENGINE_TRACE_STAGE(tracer_.get(), EVENT_LOG);
+    event_log_.emplace_back(clock_->now(), buy_id, sell_id, trade_price,
                             trade_qty, buy_account);
   }
 
@@ -175,6 +199,20 @@ bool OrderBook::execute_trade(Order &aggressive_order, Order &passive_order) {
     passive_order.display_qty -= trade_qty;
   }
 
+  if (flight_recorder_) {
+    FlightRecord entry{};
+    entry.op = FlightOp::FILL;
+    entry.outcome = FlightOutcome::EXECUTED;
+    entry.start_ticks = TscClock::now();
+    entry.order_id = aggressive_order.id;
+    entry.other_id = passive_order.id;
+    entry.quantity = trade_qty;
+    entry.leaves = aggressive_order.remaining_qty;
+    entry.side = aggressive_order.side == Side::BUY ? 0 : 1;
+    entry.price = trade_price;
+    record_flight(entry);
+  }
+
   // ========================================================================
   //  TRIGGER STOP ORDERS
   // ========================================================================
@@ -211,6 +249,9 @@ void OrderBook::update_order_state(Order &order) {
 
   // Update state
   if (order.is_filled()) {
+    if (metrics_ && it->second.state != OrderState::FILLED) {
+      metrics_->filled.inc();
+    }
     it->second.state = OrderState::FILLED;
   } else if (order.remaining_qty < order.quantity) {
     it->second.state = OrderState::PARTIALLY_FILLED;
@@ -248,6 +289,9 @@ void OrderBook::handle_unfilled_order(
   }
 
   // Order cannot rest - cancel it
+  if (metrics_) {
+    metrics_->expired.inc();
+  }
   auto it = active_orders_.find(order.id);
   if (it != active_orders_.end()) {
     it->second.state = OrderState::CANCELLED;
@@ -274,12 +318,16 @@ bool OrderBook::check_fok_condition(const Order &order) {
   if (order.tif != TimeInForce::FOK) {
     return true; // Not FOK, proceed
   }
+  ENGINE_TRACE_STAGE(tracer_.get(), VALIDATION);
 
   if (can_fill_order(order)) {
     return true; // FOK can be filled, proceed
   }
 
   // FOK cannot be filled - cancel it
+  if (metrics_) {
+    metrics_->killed.inc();
+  }
   auto it = active_orders_.find(order.id);
   if (it != active_orders_.end()) {
     it->second.state = OrderState::CANCELLED;
@@ -293,6 +341,8 @@ bool OrderBook::check_fok_condition(const Order &order) {
 }
 
 void OrderBook::match_buy_order(Order &buy_order) {
+  ENGINE_TRACE_STAGE(tracer_.get(), MATCHING);
+
   if (!check_fok_condition(buy_order)) {
     return;
   }
@@ -306,6 +356,9 @@ void OrderBook::match_buy_order(Order &buy_order) {
     if (it == active_orders_.end() ||
         it->second.state == OrderState::CANCELLED ||
         it->second.state == OrderState::FILLED) {
+      if (metrics_) {
+        metrics_->stale_skipped.inc();
+      }
       continue; // Skip cancelled/filled orders
     }
 
@@ -364,6 +417,8 @@ void OrderBook::match_buy_order(Order &buy_order) {
 }
 
 void OrderBook::match_sell_order(Order &sell_order) {
+  ENGINE_TRACE_STAGE(tracer_.get(), MATCHING);
+
   if (!check_fok_condition(sell_order)) {
     return;
   }
@@ -377,6 +432,9 @@ void OrderBook::match_sell_order(Order &sell_order) {
     if (it == active_orders_.end() ||
         it->second.state == OrderState::CANCELLED ||
         it->second.state == OrderState::FILLED) {
+      if (metrics_) {
+        metrics_->stale_skipped.inc();
+      }
       continue;
     }
 
@@ -0,0 +1,173 @@
+#include "order_book.hpp"
+
+// ============================================================================
+// MASS QUOTE
+// ============================================================================
+
+void OrderBook::cancel_resting(std::unordered_map<int, Order>::iterator it) {
+  Timer timer;
+  timer.start();
+  Order &order = it->second;
+
+  if (logging_enabled_) {
+    event_log_.emplace_back(clock_->now(), EventType::CANCEL_ORDER, order.id,
+                            order.account_id);
+  }
+
+  // Stale queue copies are skipped during matching (see cancel_order)
+  order.state = OrderState::CANCELLED;
+  auto cancelled = cancelled_orders_.insert_or_assign(order.id, order).first;
+  active_orders_.erase(it);
+
+  timer.stop();
+  if (metrics_) {
+    metrics_->cancelled.inc();
+    publish_book_gauges();
+  }
+  if (flight_recorder_) {
+    record_flight(FlightOp::CANCEL, cancelled->second, timer);
+  }
+}
+
+// Resolves the live order for one side. Returns true when a new order must
+// still be placed for this side.
+bool OrderBook::settle_quote_side(int live_id, double price, int quantity,
+                                  QuoteOutcome &outcome) {
+  auto it = live_id != 0 ? active_orders_.find(live_id) : active_orders_.end();
+
+  // Filled, cancelled or unknown orders are simply no longer live
+  if (it != active_orders_.end() &&
+      (it->second.state == OrderState::CANCELLED ||
+       it->second.state == OrderState::FILLED || it->second.is_stop ||
+       it->second.remaining_qty <= 0)) {
+    it = active_orders_.end();
+  }
+
+  if (quantity <= 0) {
+    if (it != active_orders_.end()) {
+      outcome.order_id = it->first;
+      cancel_resting(it);
+      outcome.action = QuoteAction::CANCELLED;
+    }
+    return false;
+  }
+
+  if (it == active_orders_.end()) {
+    outcome.action = QuoteAction::NEW;
+    return true;
+  }
+
+  Order &live = it->second;
+
+  // Same price and no size increase: amend in place. The queue copy keeps
+  // its time priority; matching always reads the size from active_orders_.
+  if (live.price == price && quantity <= live.remaining_qty &&
+      !live.is_iceberg()) {
+    outcome.order_id = live.id;
+    outcome.resting_quantity = quantity;
+
+    if (quantity == live.remaining_qty) {
+      outcome.action = QuoteAction::UNCHANGED;
+      return false;
+    }
+
+    Timer timer;
+    timer.start();
+    if (logging_enabled_) {
+      event_log_.emplace_back(clock_->now(), live.id, std::optional<double>(),
+                              std::optional<int>(quantity), live.account_id);
+    }
+
+    live.quantity -= live.remaining_qty - quantity;
+    live.remaining_qty = quantity;
+    live.display_qty = quantity;
+    timer.stop();
+    if (metrics_) {
+      metrics_->amends.inc();
+    }
+    if (flight_recorder_) {
+      record_flight(FlightOp::AMEND, live, timer);
+    }
+    outcome.action = QuoteAction::AMENDED;
+    return false;
+  }
+
+  cancel_resting(it);
+  outcome.action = QuoteAction::REPLACED;
+  return true;
+}
+
+bool OrderBook::quote_side_valid(Side side, int live_id, int new_id,
+                                 int account_id, int quantity) const {
+  auto it = active_orders_.find(live_id);
+  if (live_id != 0 && it != active_orders_.end() &&
+      (it->second.account_id != account_id || it->second.side != side)) {
+    return false; // Someone else's order
+  }
+
+  if (quantity > 0 && (new_id == 0 || active_orders_.count(new_id) > 0 ||
+                       cancelled_orders_.count(new_id) > 0)) {
+    return false; // A new order might be needed but its ID is taken
+  }
+
+  return true;
+}
+
+void OrderBook::place_quote_side(const Order &order, QuoteOutcome &outcome) {
+  add_order(order);
+
+  outcome.order_id = order.id;
+  auto it = active_orders_.find(order.id);
+  if (it == active_orders_.end()) {
+    return;
+  }
+
+  const Order &placed = it->second;
+  outcome.filled_quantity = placed.quantity - placed.remaining_qty;
+  bool resting = placed.state == OrderState::ACTIVE ||
+                 placed.state == OrderState::PARTIALLY_FILLED;
+  outcome.resting_quantity = resting ? placed.remaining_qty : 0;
+}
+
+MassQuoteResult OrderBook::mass_quote(const MassQuote &quote) {
+  MassQuoteResult result;
+
+  bool quoting_bid = quote.bid_quantity > 0;
+  bool quoting_ask = quote.ask_quantity > 0;
+
+  if (quoting_bid && quoting_ask && quote.bid_price >= quote.ask_price) {
+    result.bid.action = QuoteAction::REJECTED;
+    result.ask.action = QuoteAction::REJECTED;
+    return result;
+  }
+
+  // 1. Validate both sides before touching either
+  if (!quote_side_valid(Side::BUY, quote.live_bid_id, quote.new_bid_id,
+                        quote.account_id, quote.bid_quantity) ||
+      !quote_side_valid(Side::SELL, quote.live_ask_id, quote.new_ask_id,
+                        quote.account_id, quote.ask_quantity)) {
+    result.bid.action = QuoteAction::REJECTED;
+    result.ask.action = QuoteAction::REJECTED;
+    return result;
+  }
+
+  // 2. Settle both live orders (amend in place, cancel, or mark for placing)
+  bool place_bid = settle_quote_side(quote.live_bid_id, quote.bid_price,
+                                     quote.bid_quantity, result.bid);
+  bool place_ask = settle_quote_side(quote.live_ask_id, quote.ask_price,
+                                     quote.ask_quantity, result.ask);
+
+  // 3. Place what is left, with no stale quote of ours resting
+  if (place_bid) {
+    place_quote_side(Order(quote.new_bid_id, quote.account_id, Side::BUY,
+                           quote.bid_price, quote.bid_quantity),
+                     result.bid);
+  }
+  if (place_ask) {
+    place_quote_side(Order(quote.new_ask_id, quote.account_id, Side::SELL,
+                           quote.ask_price, quote.ask_quantity),
+                     result.ask);
+  }
+
+  return result;
+}
@@ -467,3 +467,28 @@ void OrderBook::print_fill_rate_analysis() const {
   std::cout << "Orders added to book (no fill): "
             << (total_orders - orders_with_fills) << std::endl;
 }
+
+std::vector<StructureFootprint> OrderBook::memory_footprint() const {
+  // Heaps hide their vectors' capacity; count live elements only
+  std::vector<StructureFootprint> structures = {
+      {"bids_", bids_.size(), bids_.size() * sizeof(Order)},
+      {"asks_", asks_.size(), asks_.size() * sizeof(Order)},
+      {"active_orders_", active_orders_.size(), hash_map_bytes(active_orders_)},
+      {"cancelled_orders_", cancelled_orders_.size(),
+       hash_map_bytes(cancelled_orders_)},
+      {"stop_orders", pending_stop_count(),
+       tree_map_bytes(stop_buys_) + tree_map_bytes(stop_sells_)},
+      {"fills_", fills_.size(), vector_bytes(fills_)},
+      {"account_fills_", account_fills_.size(), vector_bytes(account_fills_)},
+      {"routed_fills_", fill_router_->get_all_fills().size(),
+       vector_bytes(fill_router_->get_all_fills())},
+      {"event_log_", event_log_.size(), vector_bytes(event_log_)},
+      {"insertion_latencies_ns_", insertion_latencies_ns_.size(),
+       vector_bytes(insertion_latencies_ns_)},
+  };
+  if (flight_recorder_) {
+    structures.push_back({"flight_recorder", flight_recorder_->capacity(),
+                          flight_recorder_->capacity() * sizeof(FlightRecord)});
+  }
+  return structures;
+}
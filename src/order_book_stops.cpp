@@ -63,6 +63,10 @@ void OrderBook::trigger_stop_order_immediately(Order &stop_order,
             << " order " << stop_order.id << " triggered at $" << std::fixed
             << std::setprecision(2) << ref_price << std::endl;
 
+  if (metrics_) {
+    metrics_->stop_triggers.inc();
+  }
+
   // Mark as triggered & convert type explicitly
   stop_order.stop_triggered = true;
   stop_order.is_stop = false;
@@ -88,6 +92,7 @@ void OrderBook::trigger_stop_order_immediately(Order &stop_order,
 }
 
 void OrderBook::check_stop_triggers(double trade_price) {
+  ENGINE_TRACE_STAGE(tracer_.get(), STOP_HANDLING);
   last_trade_price_ = trade_price;
 
   std::vector<Order> triggered_orders;
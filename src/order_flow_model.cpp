@@ -0,0 +1,550 @@
+#include "order_flow_model.hpp"
+#include "event_log.hpp"
+#include "order_book.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+constexpr std::size_t kMinCalibrationArrivals = 200;
+constexpr std::size_t kMinPlacementSamples = 50;
+constexpr double kMaxBranchingRatio = 0.95;
+
+std::int32_t to_ticks(double price, double tick_size) {
+  return static_cast<std::int32_t>(std::lround(price / tick_size));
+}
+
+bool rests(FlowOrderKind kind) {
+  return kind == FlowOrderKind::LIMIT || kind == FlowOrderKind::ICEBERG;
+}
+
+FlowOrderKind kind_of(const OrderEvent &event) {
+  if (event.order_type == OrderType::MARKET) {
+    return FlowOrderKind::MARKET;
+  }
+  if (event.peak_size > 0) {
+    return FlowOrderKind::ICEBERG;
+  }
+  if (event.tif == TimeInForce::IOC) {
+    return FlowOrderKind::IOC;
+  }
+  if (event.tif == TimeInForce::FOK) {
+    return FlowOrderKind::FOK;
+  }
+  return FlowOrderKind::LIMIT;
+}
+
+// (1 - e^-x) / x, the shape of the Hawkes Fano factor in window length
+double fano_shape(double x) {
+  return x < 1e-9 ? 1.0 : -std::expm1(-x) / x;
+}
+
+} // namespace
+
+// ============================================================================
+// FLOW EVENTS
+// ============================================================================
+
+Order FlowEvent::to_order() const {
+  switch (kind) {
+  case FlowOrderKind::MARKET:
+    return Order(order_id, account_id, side, OrderType::MARKET, quantity,
+                 TimeInForce::IOC);
+  case FlowOrderKind::ICEBERG:
+    return Order(order_id, account_id, side, price, quantity, peak_size);
+  case FlowOrderKind::STOP:
+    return Order(order_id, account_id, side, price, quantity, true);
+  case FlowOrderKind::IOC:
+    return Order(order_id, account_id, side, price, quantity,
+                 TimeInForce::IOC);
+  case FlowOrderKind::FOK:
+    return Order(order_id, account_id, side, price, quantity,
+                 TimeInForce::FOK);
+  case FlowOrderKind::LIMIT:
+  default:
+    return Order(order_id, account_id, side, price, quantity);
+  }
+}
+
+OrderEvent FlowEvent::to_order_event() const {
+  if (type == EventType::CANCEL_ORDER) {
+    return OrderEvent(timestamp, EventType::CANCEL_ORDER, order_id,
+                      account_id);
+  }
+
+  switch (kind) {
+  case FlowOrderKind::MARKET:
+  case FlowOrderKind::STOP:
+    return OrderEvent(timestamp, order_id, side, OrderType::MARKET,
+                      TimeInForce::IOC, 0.0, quantity, 0, account_id);
+  case FlowOrderKind::IOC:
+    return OrderEvent(timestamp, order_id, side, OrderType::LIMIT,
+                      TimeInForce::IOC, price, quantity, 0, account_id);
+  case FlowOrderKind::FOK:
+    return OrderEvent(timestamp, order_id, side, OrderType::LIMIT,
+                      TimeInForce::FOK, price, quantity, 0, account_id);
+  case FlowOrderKind::ICEBERG:
+  case FlowOrderKind::LIMIT:
+  default:
+    return OrderEvent(timestamp, order_id, side, OrderType::LIMIT,
+                      TimeInForce::GTC, price, quantity, peak_size,
+                      account_id);
+  }
+}
+
+void apply_flow_event(OrderBook &book, const FlowEvent &event) {
+  if (event.type == EventType::CANCEL_ORDER) {
+    book.cancel_order(event.order_id);
+  } else {
+    book.add_order(event.to_order());
+  }
+}
+
+// ============================================================================
+// FLOW MODEL
+// ============================================================================
+
+OrderFlowModel::OrderFlowModel(const OrderFlowConfig &config)
+    : config_(config), rng_(config.seed), uniform01_(0.0, 1.0),
+      normal_(0.0, 1.0), now_(0.0), next_arrival_(0.0), excess_(0.0),
+      mid_ticks_(0.0), bid_ticks_(0), ask_ticks_(0),
+      next_order_id_(config.first_order_id), arrivals_(0),
+      cancels_emitted_(0) {
+  if (config.baseline_rate <= 0.0 || config.excitation < 0.0 ||
+      config.decay <= 0.0) {
+    throw std::runtime_error("Order flow needs positive Hawkes rates");
+  }
+  if (config.branching_ratio() >= 1.0) {
+    throw std::runtime_error(
+        "Order flow is explosive: excitation / decay must be below 1");
+  }
+  if (config.tick_size <= 0.0 || config.reference_price <= 0.0) {
+    throw std::runtime_error("Order flow needs positive prices");
+  }
+  if (config.min_quantity < 1 || config.max_quantity < config.min_quantity) {
+    throw std::runtime_error("Order flow quantity range is invalid");
+  }
+  if (config.kind_weights.size() != 6 || config.participants.empty()) {
+    throw std::runtime_error(
+        "Order flow needs six kind weights and at least one participant");
+  }
+
+  kind_dist_ = std::discrete_distribution<int>(config.kind_weights.begin(),
+                                               config.kind_weights.end());
+  std::vector<double> weights;
+  weights.reserve(config.participants.size());
+  for (const auto &participant : config.participants) {
+    weights.push_back(participant.weight);
+  }
+  participant_dist_ =
+      std::discrete_distribution<int>(weights.begin(), weights.end());
+  quantity_dist_ = std::uniform_int_distribution<int>(config.min_quantity,
+                                                      config.max_quantity);
+
+  set_reference_price(config.reference_price);
+  schedule_next_arrival();
+}
+
+double OrderFlowModel::open_unit() { return 1.0 - uniform01_(rng_); }
+
+void OrderFlowModel::schedule_next_arrival() {
+  // Dassios-Zhao: the earlier of the next baseline arrival and the next
+  // arrival from the decaying excitation (which may never come)
+  double from_baseline = -std::log(open_unit()) / config_.baseline_rate;
+  double from_excitation = std::numeric_limits<double>::infinity();
+  if (excess_ > 0.0) {
+    double d = 1.0 + config_.decay * std::log(open_unit()) / excess_;
+    if (d > 0.0) {
+      from_excitation = -std::log(d) / config_.decay;
+    }
+  }
+
+  double wait = std::min(from_baseline, from_excitation);
+  next_arrival_ += wait;
+  excess_ = excess_ * std::exp(-config_.decay * wait) + config_.excitation;
+}
+
+std::int32_t OrderFlowModel::draw_distance() {
+  // Continuous Pareto on [0.5, max + 0.5) rounded to x = d + 1, so each
+  // integer x collects the mass of [x - 0.5, x + 0.5)
+  double a = config_.placement_exponent - 1.0;
+  double upper = (static_cast<double>(config_.max_distance_ticks) + 0.5) / 0.5;
+  double u = uniform01_(rng_);
+  double x;
+  if (std::abs(a) < 1e-9) {
+    x = 0.5 * std::exp(u * std::log(upper));
+  } else {
+    double tail = 1.0 - std::pow(upper, -a);
+    x = 0.5 * std::pow(1.0 - u * tail, -1.0 / a);
+  }
+  auto distance = static_cast<std::int32_t>(std::lround(x)) - 1;
+  return std::clamp<std::int32_t>(
+      distance, 0,
+      static_cast<std::int32_t>(config_.max_distance_ticks) - 1);
+}
+
+void OrderFlowModel::move_reference(double elapsed) {
+  if (config_.volatility_ticks <= 0.0 || elapsed <= 0.0) {
+    return;
+  }
+  double moved =
+      mid_ticks_ + normal_(rng_) * config_.volatility_ticks * std::sqrt(elapsed);
+  double floor_ticks = static_cast<double>(config_.max_distance_ticks) +
+                       config_.half_spread_ticks + 2.0;
+  moved = std::max(moved, floor_ticks);
+
+  // Shift the touch as a whole so an anchored spread survives the move
+  auto shift = static_cast<std::int32_t>(std::lround(moved) -
+                                         std::lround(mid_ticks_));
+  mid_ticks_ = moved;
+  bid_ticks_ += shift;
+  ask_ticks_ += shift;
+}
+
+TimePoint OrderFlowModel::to_time_point(double seconds) const {
+  return config_.start_time +
+         std::chrono::duration_cast<Clock::duration>(
+             std::chrono::duration<double>(seconds));
+}
+
+void OrderFlowModel::set_reference_price(double price) {
+  mid_ticks_ = std::max(price, config_.tick_size) / config_.tick_size;
+  std::int32_t mid = static_cast<std::int32_t>(std::lround(mid_ticks_));
+  std::int32_t half = std::max<std::int32_t>(config_.half_spread_ticks, 1);
+  bid_ticks_ = std::max<std::int32_t>(mid - half, 1);
+  ask_ticks_ = mid + half;
+}
+
+FlowEvent OrderFlowModel::make_arrival() {
+  const FlowParticipant &participant =
+      config_.participants[participant_dist_(rng_)];
+  auto kind = static_cast<FlowOrderKind>(kind_dist_(rng_));
+
+  FlowEvent event;
+  event.timestamp = to_time_point(now_);
+  event.type = EventType::NEW_ORDER;
+  event.kind = kind;
+  event.order_id = next_order_id_++;
+  event.account_id = participant.account_id;
+  event.side = uniform01_(rng_) < 0.5 ? Side::BUY : Side::SELL;
+  event.quantity = quantity_dist_(rng_);
+  event.peak_size = 0;
+
+  bool buy = event.side == Side::BUY;
+  std::int32_t distance = draw_distance();
+  std::int32_t ticks = 0;
+  switch (kind) {
+  case FlowOrderKind::LIMIT:
+  case FlowOrderKind::ICEBERG:
+    ticks = buy ? bid_ticks_ - distance : ask_ticks_ + distance;
+    break;
+  case FlowOrderKind::IOC:
+  case FlowOrderKind::FOK:
+    ticks = buy ? ask_ticks_ + distance : bid_ticks_ - distance;
+    break;
+  case FlowOrderKind::STOP:
+    ticks = buy ? ask_ticks_ + 1 + distance : bid_ticks_ - 1 - distance;
+    break;
+  case FlowOrderKind::MARKET:
+    break;
+  }
+  event.price = std::max<std::int32_t>(ticks, 1) * config_.tick_size;
+  if (kind == FlowOrderKind::MARKET) {
+    event.price = 0.0;
+  }
+  if (kind == FlowOrderKind::ICEBERG) {
+    event.peak_size = std::clamp(
+        static_cast<int>(event.quantity * config_.iceberg_peak_fraction), 1,
+        event.quantity);
+  }
+
+  if (rests(kind) && uniform01_(rng_) < participant.cancel_probability) {
+    double latency = participant.mean_cancel_latency > 0.0
+                         ? -std::log(open_unit()) *
+                               participant.mean_cancel_latency
+                         : 0.0;
+    cancels_.push({now_ + latency, event.order_id, event.account_id});
+  }
+  return event;
+}
+
+FlowEvent OrderFlowModel::next() {
+  if (!cancels_.empty() && cancels_.top().due <= next_arrival_) {
+    PendingCancel cancel = cancels_.top();
+    cancels_.pop();
+    now_ = std::max(now_, cancel.due);
+    ++cancels_emitted_;
+
+    FlowEvent event{};
+    event.timestamp = to_time_point(now_);
+    event.type = EventType::CANCEL_ORDER;
+    event.order_id = cancel.order_id;
+    event.account_id = cancel.account_id;
+    return event;
+  }
+
+  move_reference(next_arrival_ - now_);
+  now_ = next_arrival_;
+  ++arrivals_;
+  FlowEvent event = make_arrival();
+  schedule_next_arrival();
+  return event;
+}
+
+std::vector<FlowEvent> OrderFlowModel::generate(std::size_t count) {
+  std::vector<FlowEvent> events;
+  events.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    events.push_back(next());
+  }
+  return events;
+}
+
+void OrderFlowModel::anchor(const OrderBook &book) {
+  auto best_bid = book.get_best_bid();
+  auto best_ask = book.get_best_ask();
+  if (best_bid && best_ask) {
+    bid_ticks_ = to_ticks(best_bid->price, config_.tick_size);
+    ask_ticks_ = to_ticks(best_ask->price, config_.tick_size);
+    mid_ticks_ = 0.5 * (bid_ticks_ + ask_ticks_);
+  } else if (best_bid) {
+    set_reference_price(best_bid->price +
+                        config_.half_spread_ticks * config_.tick_size);
+  } else if (best_ask) {
+    set_reference_price(best_ask->price -
+                        config_.half_spread_ticks * config_.tick_size);
+  }
+}
+
+void OrderFlowModel::drive(OrderBook &book, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    anchor(book);
+    apply_flow_event(book, next());
+  }
+}
+
+// ============================================================================
+// CALIBRATION
+// ============================================================================
+
+namespace {
+
+struct AccountStats {
+  std::size_t orders = 0;
+  std::size_t resting = 0;
+  std::size_t cancels = 0;
+  double cancel_latency = 0.0; // Sum, seconds
+};
+
+// Fit (rate, branching ratio, decay) to Fano factors of arrival counts.
+// For an exponential-kernel Hawkes process with branching ratio n,
+//   Fano(T) = A + (1 - A) (1 - e^-kT) / kT,  A = 1/(1-n)^2, k = decay (1-n)
+// so k is found by a log-spaced scan and A by least squares for each k.
+void fit_hawkes(const std::vector<double> &arrivals, OrderFlowConfig &config) {
+  if (arrivals.size() < kMinCalibrationArrivals) {
+    return;
+  }
+  double start = arrivals.front();
+  double span = arrivals.back() - start;
+  if (span <= 0.0) {
+    return;
+  }
+  double rate = static_cast<double>(arrivals.size()) / span;
+
+  std::vector<double> windows;
+  std::vector<double> fanos;
+  for (double gaps : {2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 200.0, 500.0}) {
+    double window = gaps / rate;
+    auto buckets = static_cast<std::size_t>(span / window);
+    if (buckets < 10) {
+      break;
+    }
+    std::vector<double> counts(buckets, 0.0);
+    for (double t : arrivals) {
+      auto b = static_cast<std::size_t>((t - start) / window);
+      if (b < buckets) {
+        counts[b] += 1.0;
+      }
+    }
+    double mean = 0.0;
+    for (double c : counts) {
+      mean += c;
+    }
+    mean /= static_cast<double>(buckets);
+    double var = 0.0;
+    for (double c : counts) {
+      var += (c - mean) * (c - mean);
+    }
+    var /= static_cast<double>(buckets - 1);
+    if (mean > 0.0) {
+      windows.push_back(window);
+      fanos.push_back(var / mean);
+    }
+  }
+  if (windows.size() < 2) {
+    return;
+  }
+
+  double best_error = std::numeric_limits<double>::infinity();
+  double best_k = rate;
+  double best_a = 1.0;
+  for (int step = 0; step <= 240; ++step) {
+    double k = rate * std::pow(10.0, -3.0 + step * 0.025);
+    double num = 0.0;
+    double den = 0.0;
+    for (std::size_t i = 0; i < windows.size(); ++i) {
+      double g = fano_shape(k * windows[i]);
+      num += (1.0 - g) * (fanos[i] - g);
+      den += (1.0 - g) * (1.0 - g);
+    }
+    double a = den > 0.0 ? std::max(num / den, 1.0) : 1.0;
+    double error = 0.0;
+    for (std::size_t i = 0; i < windows.size(); ++i) {
+      double g = fano_shape(k * windows[i]);
+      double r = fanos[i] - a - (1.0 - a) * g;
+      error += r * r;
+    }
+    if (error < best_error) {
+      best_error = error;
+      best_k = k;
+      best_a = a;
+    }
+  }
+
+  double n = std::min(1.0 - 1.0 / std::sqrt(best_a), kMaxBranchingRatio);
+  config.baseline_rate = rate * (1.0 - n);
+  if (n > 0.0) {
+    config.decay = best_k / (1.0 - n);
+    config.excitation = n * config.decay;
+  } else {
+    config.excitation = 0.0;
+  }
+}
+
+} // namespace
+
+OrderFlowConfig calibrate_order_flow(const std::string &filename,
+                                     const OrderFlowConfig &base) {
+  OrderFlowConfig config = base;
+  EventLogReader reader(filename);
+  OrderBook book("CALIBRATION");
+
+  std::vector<double> arrivals;
+  std::vector<double> kind_counts(6, 0.0);
+  double log_distance_sum = 0.0;
+  std::size_t placement_samples = 0;
+  std::vector<int> account_order; // First-seen order of accounts
+  std::unordered_map<int, AccountStats> accounts;
+  std::unordered_map<int, std::pair<int, double>> live; // id -> (acct, t)
+
+  bool have_origin = false;
+  TimePoint origin;
+  while (auto event = reader.next()) {
+    if (!have_origin) {
+      origin = event->timestamp;
+      have_origin = true;
+    }
+    double t = std::chrono::duration<double>(event->timestamp - origin).count();
+
+    if (event->type == EventType::NEW_ORDER) {
+      FlowOrderKind kind = kind_of(*event);
+      arrivals.push_back(t);
+      kind_counts[static_cast<std::size_t>(kind)] += 1.0;
+
+      auto inserted = accounts.try_emplace(event->account_id);
+      if (inserted.second) {
+        account_order.push_back(event->account_id);
+      }
+      AccountStats &stats = inserted.first->second;
+      ++stats.orders;
+
+      if (rests(kind)) {
+        ++stats.resting;
+        live[event->order_id] = {event->account_id, t};
+
+        // Distance behind the own-side touch, before this order joins
+        bool buy = event->side == Side::BUY;
+        auto touch = buy ? book.get_best_bid() : book.get_best_ask();
+        if (touch) {
+          std::int32_t d = buy ? to_ticks(touch->price - event->price,
+                                          config.tick_size)
+                               : to_ticks(event->price - touch->price,
+                                          config.tick_size);
+          if (d >= 0) {
+            log_distance_sum += std::log((d + 1.0) / 0.5);
+            ++placement_samples;
+          }
+        }
+      }
+    } else if (event->type == EventType::CANCEL_ORDER) {
+      auto it = live.find(event->order_id);
+      if (it != live.end()) {
+        AccountStats &stats = accounts[it->second.first];
+        ++stats.cancels;
+        stats.cancel_latency += t - it->second.second;
+        live.erase(it);
+      }
+    }
+    apply_event(book, *event);
+  }
+
+  fit_hawkes(arrivals, config);
+
+  // Order mix: logged kinds share what the base leaves to non-stops
+  if (!arrivals.empty() && config.kind_weights.size() == 6) {
+    double base_total = 0.0;
+    for (double w : base.kind_weights) {
+      base_total += w;
+    }
+    std::size_t stop = static_cast<std::size_t>(FlowOrderKind::STOP);
+    double stop_share =
+        base_total > 0.0 ? base.kind_weights[stop] / base_total : 0.0;
+    double logged = static_cast<double>(arrivals.size());
+    for (std::size_t k = 0; k < kind_counts.size(); ++k) {
+      config.kind_weights[k] =
+          k == stop ? stop_share : (1.0 - stop_share) * kind_counts[k] / logged;
+    }
+  }
+
+  // Discrete power law MLE (continuity-corrected) over x = d + 1 >= 1
+  if (placement_samples >= kMinPlacementSamples && log_distance_sum > 0.0) {
+    config.placement_exponent =
+        1.0 + static_cast<double>(placement_samples) / log_distance_sum;
+  }
+
+  if (!accounts.empty()) {
+    double fallback_latency = base.participants.empty()
+                                  ? 1.0
+                                  : base.participants.front()
+                                        .mean_cancel_latency;
+    config.participants.clear();
+    for (int account : account_order) {
+      const AccountStats &stats = accounts[account];
+      FlowParticipant participant;
+      participant.account_id = account;
+      participant.weight = static_cast<double>(stats.orders) /
+                           static_cast<double>(arrivals.size());
+      participant.cancel_probability =
+          stats.resting > 0 ? std::min(1.0, static_cast<double>(stats.cancels) /
+                                                static_cast<double>(
+                                                    stats.resting))
+                            : 0.0;
+      participant.mean_cancel_latency =
+          stats.cancels > 0
+              ? stats.cancel_latency / static_cast<double>(stats.cancels)
+              : fallback_latency;
+      config.participants.push_back(participant);
+    }
+  }
+
+  auto best_bid = book.get_best_bid();
+  auto best_ask = book.get_best_ask();
+  if (best_bid && best_ask) {
+    config.reference_price = 0.5 * (best_bid->price + best_ask->price);
+  }
+  return config;
+}
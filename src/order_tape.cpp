@@ -0,0 +1,308 @@
+#include "order_tape.hpp"
+#include "order_book.hpp"
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kTapeMagic[8] = {'O', 'R', 'D', 'T', 'A', 'P', 'E', '1'};
+constexpr std::uint32_t kTapeVersion = 1;
+
+// SplitMix64 finalizer: spreads (seed, stream) into well-separated keys
+std::uint64_t mix64(std::uint64_t x) {
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+std::uint64_t stream_key(std::uint64_t seed, std::uint64_t stream) {
+  return mix64(seed ^ mix64(stream + 1));
+}
+
+} // namespace
+
+// ============================================================================
+// GENERATOR
+// ============================================================================
+
+OrderTapeGenerator::OrderTapeGenerator(const OrderTapeConfig &config)
+    : config_(config), path_rng_(stream_key(config.seed, UINT64_MAX)),
+      position_(0) {
+  if (config.streams == 0 || config.block_size == 0) {
+    throw std::runtime_error("Order tape needs at least one stream and block");
+  }
+  if (config.commands >= static_cast<std::uint64_t>(INT_MAX)) {
+    throw std::runtime_error("Order tape too long for int order IDs");
+  }
+  if (config.tick_size <= 0.0 || config.start_price <= 0.0) {
+    throw std::runtime_error("Order tape needs positive prices");
+  }
+  if (config.min_quantity == 0 || config.max_quantity < config.min_quantity) {
+    throw std::runtime_error("Order tape quantity range is invalid");
+  }
+
+  streams_.reserve(config.streams);
+  for (std::uint32_t s = 0; s < config.streams; ++s) {
+    streams_.emplace_back(stream_key(config.seed, s));
+    streams_.back().live.reserve(config.live_orders_per_stream);
+  }
+  mid_ticks_.push_back(
+      static_cast<std::int32_t>(std::lround(config.start_price /
+                                            config.tick_size)));
+}
+
+void OrderTapeGenerator::extend_mid_path(std::uint64_t last_block) {
+  while (mid_ticks_.size() <= last_block) {
+    // Box-Muller step, floored a few ticks above zero
+    double u1 = std::max(path_rng_.uniform(), 1e-12);
+    double u2 = path_rng_.uniform();
+    double z = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    auto step = static_cast<std::int32_t>(std::lround(z * config_.volatility_ticks));
+    std::int32_t floor_ticks =
+        static_cast<std::int32_t>(config_.max_distance_ticks) + 2;
+    mid_ticks_.push_back(std::max(mid_ticks_.back() + step, floor_ticks));
+  }
+}
+
+void OrderTapeGenerator::generate_stream(std::uint32_t stream,
+                                         std::uint64_t first,
+                                         std::uint64_t end, TapeCommand *out) {
+  StreamState &state = streams_[stream];
+  CounterRng &rng = state.rng;
+  const OrderTapeConfig &cfg = config_;
+  const std::uint32_t quantity_span = cfg.max_quantity - cfg.min_quantity + 1;
+  const double cancel_cut = cfg.cancel_ratio;
+  const double amend_cut = cancel_cut + cfg.amend_ratio;
+  const double market_cut = amend_cut + cfg.market_ratio;
+  const double ioc_cut = market_cut + cfg.ioc_ratio;
+
+  // This stream's runs that overlap [first, end)
+  const std::uint64_t period =
+      static_cast<std::uint64_t>(kTapeStreamRun) * cfg.streams;
+  std::uint64_t run = first / period * period +
+                      static_cast<std::uint64_t>(stream) * kTapeStreamRun;
+  if (run + kTapeStreamRun <= first) {
+    run += period;
+  }
+
+  // Limit price around the mid of the command's block; distance skews to
+  // the touch and -1 crosses the spread
+  auto limit_price = [&](std::uint64_t i, std::uint8_t side) {
+    std::int32_t mid = mid_ticks_[i / cfg.block_size];
+    double u = rng.uniform();
+    std::int32_t distance =
+        static_cast<std::int32_t>(u * u * (cfg.max_distance_ticks + 1)) - 1;
+    return side == 0 ? mid - 1 - distance : mid + 1 + distance;
+  };
+
+  for (; run < end; run += period) {
+    const std::uint64_t run_end = std::min(run + kTapeStreamRun, end);
+    for (std::uint64_t i = std::max(run, first); i < run_end; ++i) {
+      TapeCommand &command = out[i - first];
+      command.account = static_cast<std::uint16_t>(cfg.account_base + stream);
+      command.side = static_cast<std::uint8_t>(rng.next_u32() & 1);
+      command.quantity = cfg.min_quantity + rng.below(quantity_span);
+
+      double pick = rng.uniform();
+      if (pick < amend_cut && state.live.empty()) {
+        pick = 1.0; // Nothing to cancel or amend yet: rest a limit instead
+      }
+      if (pick < amend_cut) {
+        std::uint32_t slot = rng.below(static_cast<std::uint32_t>(
+            state.live.size()));
+        const LiveOrder target = state.live[slot];
+        command.order_id = target.order_id;
+        command.side = target.side;
+        if (pick < cancel_cut) {
+          command.op = TapeOp::CANCEL;
+          command.price_ticks = 0;
+          command.quantity = 0;
+          state.live[slot] = state.live.back(); // Cancelled orders leave
+          state.live.pop_back();
+        } else {
+          command.op = TapeOp::AMEND;
+          command.price_ticks = limit_price(i, target.side);
+        }
+        continue;
+      }
+
+      // New order
+      command.order_id = static_cast<std::uint32_t>(i + 1);
+      command.price_ticks = limit_price(i, command.side);
+
+      if (pick < market_cut) {
+        command.op = TapeOp::NEW_MARKET;
+        command.price_ticks = 0;
+        continue;
+      }
+      command.op = pick < ioc_cut ? TapeOp::NEW_IOC : TapeOp::NEW_LIMIT;
+      if (command.op == TapeOp::NEW_IOC) {
+        continue;
+      }
+
+      // Remember resting candidates for later cancels / amends
+      const LiveOrder resting{command.order_id, command.side};
+      if (state.live.size() < cfg.live_orders_per_stream) {
+        state.live.push_back(resting);
+      } else if (cfg.live_orders_per_stream > 0) {
+        state.live[state.live_head] = resting;
+        state.live_head = (state.live_head + 1) % cfg.live_orders_per_stream;
+      }
+    }
+  }
+}
+
+std::size_t OrderTapeGenerator::generate(TapeCommand *out, std::size_t count,
+                                         WorkerPool *pool) {
+  std::uint64_t end =
+      std::min<std::uint64_t>(position_ + count, config_.commands);
+  if (end <= position_) {
+    return 0;
+  }
+
+  std::uint64_t first = position_;
+  extend_mid_path((end - 1) / config_.block_size);
+
+  auto run_stream = [&](std::size_t stream) {
+    generate_stream(static_cast<std::uint32_t>(stream), first, end, out);
+  };
+  if (pool) {
+    pool->parallel_for(streams_.size(), run_stream);
+  } else {
+    for (std::size_t s = 0; s < streams_.size(); ++s) {
+      run_stream(s);
+    }
+  }
+
+  position_ = end;
+  return static_cast<std::size_t>(end - first);
+}
+
+OrderTapeHeader OrderTapeGenerator::header() const {
+  OrderTapeHeader header{};
+  std::memcpy(header.magic, kTapeMagic, sizeof(header.magic));
+  header.version = kTapeVersion;
+  header.record_size = sizeof(TapeCommand);
+  header.count = config_.commands;
+  header.seed = config_.seed;
+  header.streams = config_.streams;
+  header.tick_size = config_.tick_size;
+  header.start_price = config_.start_price;
+  return header;
+}
+
+std::vector<TapeCommand> generate_order_tape(const OrderTapeConfig &config,
+                                             WorkerPool *pool) {
+  OrderTapeGenerator generator(config);
+  std::vector<TapeCommand> tape(config.commands);
+  generator.generate(tape.data(), tape.size(), pool);
+  return tape;
+}
+
+void write_order_tape(const std::string &filename,
+                      const OrderTapeConfig &config, WorkerPool *pool,
+                      std::size_t chunk) {
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open file: " + filename);
+  }
+
+  OrderTapeGenerator generator(config);
+  OrderTapeHeader header = generator.header();
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  std::vector<TapeCommand> buffer(std::max<std::size_t>(chunk, 1));
+  while (std::size_t n = generator.generate(buffer.data(), buffer.size(),
+                                            pool)) {
+    file.write(reinterpret_cast<const char *>(buffer.data()),
+               static_cast<std::streamsize>(n * sizeof(TapeCommand)));
+  }
+
+  if (!file) {
+    throw std::runtime_error("Failed writing order tape: " + filename);
+  }
+}
+
+// ============================================================================
+// READING / REPLAY
+// ============================================================================
+
+OrderTapeReader::OrderTapeReader(const std::string &filename)
+    : file_(filename, std::ios::binary), header_{}, remaining_(0) {
+  if (!file_.is_open()) {
+    throw std::runtime_error("Could not open file: " + filename);
+  }
+
+  file_.read(reinterpret_cast<char *>(&header_), sizeof(header_));
+  if (!file_ || std::memcmp(header_.magic, kTapeMagic, 8) != 0 ||
+      header_.version != kTapeVersion ||
+      header_.record_size != sizeof(TapeCommand)) {
+    throw std::runtime_error("Not an order tape: " + filename);
+  }
+  remaining_ = header_.count;
+}
+
+std::size_t OrderTapeReader::read(TapeCommand *out, std::size_t max) {
+  std::size_t n = static_cast<std::size_t>(
+      std::min<std::uint64_t>(max, remaining_));
+  if (n == 0) {
+    return 0;
+  }
+
+  file_.read(reinterpret_cast<char *>(out),
+             static_cast<std::streamsize>(n * sizeof(TapeCommand)));
+  if (!file_) {
+    throw std::runtime_error("Order tape is truncated");
+  }
+  remaining_ -= n;
+  return n;
+}
+
+std::vector<TapeCommand> load_order_tape(const std::string &filename,
+                                         OrderTapeHeader *header) {
+  OrderTapeReader reader(filename);
+  std::vector<TapeCommand> tape(static_cast<std::size_t>(reader.remaining()));
+  reader.read(tape.data(), tape.size());
+  if (header) {
+    *header = reader.header();
+  }
+  return tape;
+}
+
+void apply_tape_command(OrderBook &book, const TapeCommand &command,
+                        double tick_size) {
+  int id = static_cast<int>(command.order_id);
+  Side side = command.side == 0 ? Side::BUY : Side::SELL;
+  double price = command.price_ticks * tick_size;
+  int quantity = static_cast<int>(command.quantity);
+
+  switch (command.op) {
+  case TapeOp::NEW_LIMIT:
+    book.add_order(Order(id, command.account, side, price, quantity));
+    break;
+  case TapeOp::NEW_IOC:
+    book.add_order(
+        Order(id, command.account, side, price, quantity, TimeInForce::IOC));
+    break;
+  case TapeOp::NEW_MARKET:
+    book.add_order(Order(id, command.account, side, OrderType::MARKET,
+                         quantity, TimeInForce::IOC));
+    break;
+  case TapeOp::CANCEL:
+    book.cancel_order(id);
+    break;
+  case TapeOp::AMEND:
+    book.amend_order(id,
+                     command.price_ticks != 0
+                         ? std::optional<double>(price)
+                         : std::nullopt,
+                     quantity);
+    break;
+  }
+}
@@ -0,0 +1,177 @@
+#include "order_trace.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+constexpr std::array<TraceStage, kTraceStageCount> kAllStages = {
+    TraceStage::VALIDATION,   TraceStage::STOP_HANDLING,
+    TraceStage::ORDER_INSERT, TraceStage::MATCHING,
+    TraceStage::FILL_ROUTING, TraceStage::FEE_CALC,
+    TraceStage::CALLBACKS,    TraceStage::EVENT_LOG,
+    TraceStage::FINALIZE};
+
+} // namespace
+
+const char *to_string(TraceStage stage) {
+  switch (stage) {
+  case TraceStage::VALIDATION:
+    return "validation";
+  case TraceStage::STOP_HANDLING:
+    return "stop handling";
+  case TraceStage::ORDER_INSERT:
+    return "order insert";
+  case TraceStage::MATCHING:
+    return "matching";
+  case TraceStage::FILL_ROUTING:
+    return "fill routing";
+  case TraceStage::FEE_CALC:
+    return "fee calc";
+  case TraceStage::CALLBACKS:
+    return "callbacks";
+  case TraceStage::EVENT_LOG:
+    return "event log";
+  case TraceStage::FINALIZE:
+    return "finalize";
+  }
+  return "unknown";
+}
+
+long long StageBreakdown::untraced_ns() const {
+  long long traced = 0;
+  for (long long ns : stage_ns) {
+    traced += ns;
+  }
+  return std::max(0LL, total_ns - traced);
+}
+
+// ============================================================================
+// ORDER PATH TRACER
+// ============================================================================
+
+LatencyTracker::Config OrderPathTracer::histogram_config() {
+  // 3% buckets up to 1 s keep each histogram around 7 KB
+  LatencyTracker::Config config;
+  config.precision_bits = 5;
+  config.max_value_ns = 1'000'000'000LL;
+  return config;
+}
+
+OrderPathTracer::OrderPathTracer(long long slow_threshold_ns,
+                                 std::size_t slow_capacity)
+    : total_(histogram_config()), depth_(0), order_id_(0), order_start_(0),
+      child_ticks_(0), stage_ticks_{}, stage_hits_{},
+      slow_threshold_ns_(slow_threshold_ns),
+      slow_capacity_(std::max<std::size_t>(slow_capacity, 1)), slow_next_(0),
+      slow_total_(0) {
+  stages_.fill(LatencyTracker(histogram_config()));
+  slow_orders_.reserve(slow_capacity_);
+}
+
+void OrderPathTracer::begin_order(int order_id) {
+  if (depth_++ > 0) {
+    return; // Nested: part of the outer order
+  }
+  order_id_ = order_id;
+  child_ticks_ = 0;
+  stage_ticks_.fill(0);
+  stage_hits_.fill(0);
+  order_start_ = TscClock::now();
+}
+
+void OrderPathTracer::end_order() {
+  if (depth_ == 0 || --depth_ > 0) {
+    return;
+  }
+  auto total_ns = static_cast<long long>(
+      TscClock::to_nanoseconds(TscClock::now() - order_start_));
+  total_.record(total_ns);
+
+  StageBreakdown breakdown;
+  breakdown.order_id = order_id_;
+  breakdown.total_ns = total_ns;
+  for (std::size_t i = 0; i < kTraceStageCount; ++i) {
+    if (stage_hits_[i] == 0) {
+      continue;
+    }
+    breakdown.stage_ns[i] =
+        static_cast<long long>(TscClock::to_nanoseconds(stage_ticks_[i]));
+    breakdown.stage_hits[i] = stage_hits_[i];
+    stages_[i].record(breakdown.stage_ns[i]);
+  }
+  child_ticks_ = 0;
+
+  if (slow_threshold_ns_ > 0 && total_ns >= slow_threshold_ns_) {
+    if (slow_orders_.size() < slow_capacity_) {
+      slow_orders_.push_back(breakdown);
+    } else {
+      slow_orders_[slow_next_] = breakdown;
+    }
+    slow_next_ = (slow_next_ + 1) % slow_capacity_;
+    ++slow_total_;
+  }
+}
+
+std::vector<StageBreakdown> OrderPathTracer::slow_orders() const {
+  if (slow_orders_.size() < slow_capacity_) {
+    return slow_orders_;
+  }
+  std::vector<StageBreakdown> ordered;
+  ordered.reserve(slow_orders_.size());
+  for (std::size_t i = 0; i < slow_orders_.size(); ++i) {
+    ordered.push_back(slow_orders_[(slow_next_ + i) % slow_capacity_]);
+  }
+  return ordered;
+}
+
+void OrderPathTracer::reset() {
+  for (auto &stage : stages_) {
+    stage.reset();
+  }
+  total_.reset();
+  slow_orders_.clear();
+  slow_next_ = 0;
+  slow_total_ = 0;
+}
+
+void OrderPathTracer::print_report() const {
+  std::cout << "\n=== Order Path Breakdown ===" << std::endl;
+  std::cout << "Orders traced: " << total_.count() << "  (p50 "
+            << total_.percentile(50) << " ns, p99 " << total_.percentile(99)
+            << " ns, p99.9 " << total_.percentile(99.9) << " ns)" << std::endl;
+  std::cout << std::string(60, '-') << std::endl;
+  std::cout << std::left << std::setw(16) << "Stage" << std::right
+            << std::setw(10) << "Orders" << std::setw(10) << "p50"
+            << std::setw(10) << "p99" << std::setw(12) << "p99.9"
+            << std::endl;
+  for (TraceStage s : kAllStages) {
+    const LatencyTracker &h = stage(s);
+    if (h.count() == 0) {
+      continue;
+    }
+    std::cout << std::left << std::setw(16) << to_string(s) << std::right
+              << std::setw(10) << h.count() << std::setw(10)
+              << h.percentile(50) << std::setw(10) << h.percentile(99)
+              << std::setw(12) << h.percentile(99.9) << std::endl;
+  }
+
+  if (slow_total_ > 0) {
+    std::cout << "\nSlow orders (>= " << slow_threshold_ns_
+              << " ns): " << slow_total_ << std::endl;
+    for (const auto &order : slow_orders()) {
+      std::cout << "  order " << order.order_id << ": " << order.total_ns
+                << " ns =";
+      for (TraceStage s : kAllStages) {
+        auto i = static_cast<std::size_t>(s);
+        if (order.stage_hits[i] > 0) {
+          std::cout << " " << to_string(s) << " " << order.stage_ns[i];
+        }
+      }
+      std::cout << " untraced " << order.untraced_ns() << std::endl;
+    }
+  }
+  std::cout << std::string(60, '-') << std::endl;
+}
@@ -0,0 +1,211 @@
+#include "pair_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// ============================================================================
+// ROLLING COVARIANCE
+// ============================================================================
+
+RollingCovariance::RollingCovariance(std::size_t period)
+    : period_(period), xs_(period, 0.0), ys_(period, 0.0), head_(0),
+      count_(0), mean_x_(0.0), mean_y_(0.0), m2_x_(0.0), m2_y_(0.0),
+      c_xy_(0.0) {
+  if (period_ == 0) {
+    throw std::runtime_error("RollingCovariance period must be positive");
+  }
+}
+
+void RollingCovariance::add(double x, double y) {
+  ++count_;
+  double n = static_cast<double>(count_);
+  double dx = x - mean_x_;
+  double dy = y - mean_y_;
+  mean_x_ += dx / n;
+  mean_y_ += dy / n;
+  m2_x_ += dx * (x - mean_x_);
+  m2_y_ += dy * (y - mean_y_);
+  c_xy_ += dx * (y - mean_y_);
+}
+
+void RollingCovariance::remove(double x, double y) {
+  if (count_ == 1) {
+    count_ = 0;
+    mean_x_ = mean_y_ = m2_x_ = m2_y_ = c_xy_ = 0.0;
+    return;
+  }
+
+  --count_;
+  double n = static_cast<double>(count_);
+  double dx = x - mean_x_; // Against the mean including the sample
+  double dy = y - mean_y_;
+  mean_x_ -= dx / n;
+  mean_y_ -= dy / n;
+  m2_x_ -= dx * (x - mean_x_);
+  m2_y_ -= dy * (y - mean_y_);
+  c_xy_ -= dx * (y - mean_y_);
+}
+
+void RollingCovariance::update(double x, double y) {
+  if (count_ == period_) {
+    remove(xs_[head_], ys_[head_]);
+  }
+  xs_[head_] = x;
+  ys_[head_] = y;
+  head_ = (head_ + 1 == period_) ? 0 : head_ + 1;
+  add(x, y);
+}
+
+void RollingCovariance::reset() {
+  head_ = 0;
+  count_ = 0;
+  mean_x_ = mean_y_ = m2_x_ = m2_y_ = c_xy_ = 0.0;
+}
+
+double RollingCovariance::variance_x() const {
+  return count_ == 0 ? 0.0 : std::max(0.0, m2_x_ / count_);
+}
+
+double RollingCovariance::variance_y() const {
+  return count_ == 0 ? 0.0 : std::max(0.0, m2_y_ / count_);
+}
+
+double RollingCovariance::covariance() const {
+  return count_ == 0 ? 0.0 : c_xy_ / count_;
+}
+
+double RollingCovariance::correlation() const {
+  double denom = std::sqrt(variance_x() * variance_y());
+  return denom > 0.0 ? covariance() / denom : 0.0;
+}
+
+// ============================================================================
+// EXPONENTIALLY WEIGHTED COVARIANCE
+// ============================================================================
+
+EwCovariance::EwCovariance(double halflife)
+    : count_(0), mean_x_(0.0), mean_y_(0.0), var_x_(0.0), var_y_(0.0),
+      cov_xy_(0.0) {
+  if (halflife <= 0.0) {
+    throw std::runtime_error("EwCovariance half-life must be positive");
+  }
+  alpha_ = 1.0 - std::pow(0.5, 1.0 / halflife);
+}
+
+void EwCovariance::update(double x, double y) {
+  if (count_++ == 0) {
+    mean_x_ = x;
+    mean_y_ = y;
+    return;
+  }
+
+  double dx = x - mean_x_;
+  double dy = y - mean_y_;
+  mean_x_ += alpha_ * dx;
+  mean_y_ += alpha_ * dy;
+  var_x_ = (1.0 - alpha_) * (var_x_ + alpha_ * dx * dx);
+  var_y_ = (1.0 - alpha_) * (var_y_ + alpha_ * dy * dy);
+  cov_xy_ = (1.0 - alpha_) * (cov_xy_ + alpha_ * dx * dy);
+}
+
+void EwCovariance::reset() {
+  count_ = 0;
+  mean_x_ = mean_y_ = var_x_ = var_y_ = cov_xy_ = 0.0;
+}
+
+// ============================================================================
+// PAIR STATISTICS
+// ============================================================================
+
+PairStatistics::PairStatistics(std::size_t period, double halflife)
+    : rolling_(period), exponential_(halflife), last_y_(0.0), last_x_(0.0),
+      last_update_{}, seen_{false, false}, fresh_{false, false} {}
+
+void PairStatistics::update(double y, double x) {
+  rolling_.update(x, y);
+  exponential_.update(x, y);
+}
+
+bool PairStatistics::on_price(PairLeg leg, double price, TimePoint timestamp) {
+  std::size_t slot = static_cast<std::size_t>(leg);
+  if (seen_[slot] && timestamp <= last_update_[slot]) {
+    return false;
+  }
+
+  seen_[slot] = true;
+  fresh_[slot] = true;
+  last_update_[slot] = timestamp;
+  (leg == PairLeg::DEPENDENT ? last_y_ : last_x_) = price;
+
+  if (fresh_[0] && fresh_[1]) {
+    update(last_y_, last_x_);
+    fresh_[0] = fresh_[1] = false;
+  }
+  return true;
+}
+
+double PairStatistics::hedge_ratio(HedgeRatioMethod method) const {
+  double var_x, cov;
+  if (method == HedgeRatioMethod::ROLLING_OLS) {
+    var_x = rolling_.variance_x();
+    cov = rolling_.covariance();
+  } else {
+    var_x = exponential_.variance_x();
+    cov = exponential_.covariance();
+  }
+  return var_x > 0.0 ? cov / var_x : 0.0;
+}
+
+double PairStatistics::intercept(HedgeRatioMethod method) const {
+  double beta = hedge_ratio(method);
+  if (method == HedgeRatioMethod::ROLLING_OLS) {
+    return rolling_.mean_y() - beta * rolling_.mean_x();
+  }
+  return exponential_.mean_y() - beta * exponential_.mean_x();
+}
+
+double PairStatistics::residual(double y, double x,
+                                HedgeRatioMethod method) const {
+  return y - (intercept(method) + hedge_ratio(method) * x);
+}
+
+double PairStatistics::residual_stddev(HedgeRatioMethod method) const {
+  // var(y - beta x) = var_y - 2 beta cov + beta^2 var_x
+  double beta = hedge_ratio(method);
+  double var_x, var_y, cov;
+  if (method == HedgeRatioMethod::ROLLING_OLS) {
+    var_x = rolling_.variance_x();
+    var_y = rolling_.variance_y();
+    cov = rolling_.covariance();
+  } else {
+    var_x = exponential_.variance_x();
+    var_y = exponential_.variance_y();
+    cov = exponential_.covariance();
+  }
+  return std::sqrt(std::max(0.0, var_y - 2.0 * beta * cov + beta * beta * var_x));
+}
+
+double PairStatistics::zscore(double y, double x,
+                              HedgeRatioMethod method) const {
+  double sd = residual_stddev(method);
+  if (sd < 1e-12) {
+    return 0.0;
+  }
+  return residual(y, x, method) / sd;
+}
+
+// ============================================================================
+// PAIR STATISTICS REGISTRY
+// ============================================================================
+
+std::shared_ptr<PairStatistics>
+PairStatisticsRegistry::acquire(const std::string &dependent,
+                                const std::string &hedge, std::size_t period,
+                                double halflife) {
+  auto &slot = pairs_[Key(dependent, hedge, period, halflife)];
+  if (!slot) {
+    slot = std::make_shared<PairStatistics>(period, halflife);
+  }
+  return slot;
+}
@@ -2,7 +2,6 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
-#include <numeric>
 
 void PerformanceMetrics::calculate(const std::vector<Account> &accounts) {
   // Reset all metrics
@@ -29,93 +28,19 @@ void PerformanceMetrics::calculate(const std::vector<Account> &accounts) {
     win_rate = (static_cast<double>(total_wins) / total_trades) * 100.0;
   }
 
-  // Calculate metrics from P&L timeseries if available
-  if (!pnl_timeseries.empty()) {
+  // Series metrics are maintained online as snapshots arrive
+  if (online.samples() > 0) {
     sharpe_ratio = calculate_sharpe_ratio();
     max_drawdown = calculate_max_drawdown();
   }
 }
 
 double PerformanceMetrics::calculate_sharpe_ratio() const {
-  if (pnl_timeseries.size() < 2) {
-    return 0.0;
-  }
-
-  // Calculate daily returns
-  std::vector<double> returns;
-  returns.reserve(pnl_timeseries.size() - 1);
-
-  for (size_t i = 1; i < pnl_timeseries.size(); ++i) {
-    double prev_pnl = pnl_timeseries[i - 1].second;
-    double curr_pnl = pnl_timeseries[i].second;
-
-    // Avoid division by zero
-    if (std::abs(prev_pnl) < 1e-6) {
-      returns.push_back(0.0);
-    } else {
-      double daily_return = (curr_pnl - prev_pnl) / std::abs(prev_pnl);
-      returns.push_back(daily_return);
-    }
-  }
-
-  if (returns.empty()) {
-    return 0.0;
-  }
-
-  // Calculate mean return
-  double mean_return =
-      std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-
-  // Calculate standard deviation of returns
-  double sum_squared_diff = 0.0;
-  for (double ret : returns) {
-    double diff = ret - mean_return;
-    sum_squared_diff += diff * diff;
-  }
-
-  double stddev = std::sqrt(sum_squared_diff / returns.size());
-
-  // Avoid division by zero
-  if (stddev < 1e-10) {
-    return 0.0;
-  }
-
-  // Annualized Sharpe ratio (assuming 252 trading days)
-  // Sharpe = (mean_return / stddev) * sqrt(252)
-  double sharpe = (mean_return / stddev) * std::sqrt(252.0);
-
-  return sharpe;
+  return online.sharpe_ratio();
 }
 
 double PerformanceMetrics::calculate_max_drawdown() const {
-  if (pnl_timeseries.size() < 2) {
-    return 0.0;
-  }
-
-  double max_drawdown = 0.0;
-  double running_peak = pnl_timeseries[0].second;
-
-  for (size_t i = 1; i < pnl_timeseries.size(); ++i) {
-    double current_pnl = pnl_timeseries[i].second;
-
-    // Update running peak if we have a new high
-    if (current_pnl > running_peak) {
-      running_peak = current_pnl;
-    }
-
-    // Calculate drawdown from peak
-    double drawdown = 0.0;
-    if (running_peak > 0) {
-      drawdown = ((running_peak - current_pnl) / running_peak) * 100.0;
-    }
-
-    // Track maximum drawdown
-    if (drawdown > max_drawdown) {
-      max_drawdown = drawdown;
-    }
-  }
-
-  return max_drawdown;
+  return online.max_drawdown();
 }
 
 void PerformanceMetrics::print_report() const {
@@ -159,12 +84,12 @@ void PerformanceMetrics::print_report() const {
   std::cout << "Maximum Drawdown:    " << std::fixed << std::setprecision(2)
             << max_drawdown << "%" << std::endl;
 
-  if (!pnl_timeseries.empty()) {
+  if (online.samples() > 0) {
     std::cout << "\n=== P&L Timeline ===" << std::endl;
     std::cout << std::string(60, '-') << std::endl;
 
-    double initial_pnl = pnl_timeseries.front().second;
-    double final_pnl = pnl_timeseries.back().second;
+    double initial_pnl = online.first_pnl();
+    double final_pnl = online.last_pnl();
     double total_return = final_pnl - initial_pnl;
     double return_pct =
         (initial_pnl != 0.0)
@@ -177,7 +102,7 @@ void PerformanceMetrics::print_report() const {
               << final_pnl << std::endl;
     std::cout << "Total Return:        $" << std::fixed << std::setprecision(2)
               << total_return << " (" << return_pct << "%)" << std::endl;
-    std::cout << "Data Points:         " << pnl_timeseries.size() << std::endl;
+    std::cout << "Data Points:         " << online.samples() << std::endl;
   }
 
   std::cout << "\n" << std::string(60, '=') << std::endl;
@@ -200,35 +125,53 @@ void PerformanceMetrics::print_report() const {
 }
 
 void PerformanceMetrics::add_pnl_snapshot(TimePoint timestamp, double pnl) {
-  pnl_timeseries.push_back({timestamp, pnl});
-}
-
-void PerformanceMetrics::clear_timeseries() { pnl_timeseries.clear(); }
-
-double PerformanceMetrics::get_total_return() const {
-  if (pnl_timeseries.size() < 2) {
-    return 0.0;
+  online.add(timestamp, pnl);
+
+  switch (timeseries_mode) {
+  case TimeseriesMode::FULL:
+    pnl_timeseries.push_back({timestamp, pnl});
+    break;
+  case TimeseriesMode::DECIMATED:
+    pnl_decimated.add(timestamp, pnl);
+    break;
+  case TimeseriesMode::NONE:
+    break;
   }
+}
 
-  double initial = pnl_timeseries.front().second;
-  double final = pnl_timeseries.back().second;
+void PerformanceMetrics::set_timeseries_mode(TimeseriesMode mode,
+                                             std::size_t capacity) {
+  timeseries_mode = mode;
+  pnl_decimated = MinMaxDecimator(capacity);
+  clear_timeseries();
+}
 
-  return final - initial;
+void PerformanceMetrics::clear_timeseries() {
+  pnl_timeseries.clear();
+  pnl_timeseries.shrink_to_fit();
+  pnl_decimated.clear();
+  online.reset();
 }
 
-double PerformanceMetrics::get_return_percentage() const {
-  if (pnl_timeseries.size() < 2) {
-    return 0.0;
+std::vector<std::pair<TimePoint, double>>
+PerformanceMetrics::plot_series() const {
+  switch (timeseries_mode) {
+  case TimeseriesMode::FULL:
+    return pnl_timeseries;
+  case TimeseriesMode::DECIMATED:
+    return pnl_decimated.points();
+  case TimeseriesMode::NONE:
+  default:
+    return {};
   }
+}
 
-  double initial = pnl_timeseries.front().second;
-  double final = pnl_timeseries.back().second;
-
-  if (std::abs(initial) < 1e-6) {
-    return 0.0;
-  }
+double PerformanceMetrics::get_total_return() const {
+  return online.total_return();
+}
 
-  return ((final - initial) / std::abs(initial)) * 100.0;
+double PerformanceMetrics::get_return_percentage() const {
+  return online.return_percentage();
 }
 
 double PerformanceMetrics::get_calmar_ratio() const {
@@ -244,54 +187,7 @@ double PerformanceMetrics::get_calmar_ratio() const {
 }
 
 double PerformanceMetrics::get_sortino_ratio() const {
-  if (pnl_timeseries.size() < 2) {
-    return 0.0;
-  }
-
-  // Calculate daily returns
-  std::vector<double> returns;
-  returns.reserve(pnl_timeseries.size() - 1);
-
-  for (size_t i = 1; i < pnl_timeseries.size(); ++i) {
-    double prev = pnl_timeseries[i - 1].second;
-    double curr = pnl_timeseries[i].second;
-
-    if (std::abs(prev) > 1e-6) {
-      returns.push_back((curr - prev) / std::abs(prev));
-    }
-  }
-
-  if (returns.empty()) {
-    return 0.0;
-  }
-
-  // Mean return
-  double mean_return =
-      std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-
-  // Downside deviation (only negative returns)
-  double sum_squared_negative = 0.0;
-  int negative_count = 0;
-
-  for (double ret : returns) {
-    if (ret < 0) {
-      sum_squared_negative += ret * ret;
-      negative_count++;
-    }
-  }
-
-  if (negative_count == 0) {
-    return 0.0; // No negative returns
-  }
-
-  double downside_dev = std::sqrt(sum_squared_negative / negative_count);
-
-  if (downside_dev < 1e-10) {
-    return 0.0;
-  }
-
-  // Annualized Sortino ratio
-  return (mean_return / downside_dev) * std::sqrt(252.0);
+  return online.sortino_ratio();
 }
 
 void PerformanceMetrics::print_advanced_metrics() const {
@@ -307,7 +203,7 @@ void PerformanceMetrics::print_advanced_metrics() const {
   std::cout << "  (Like Sharpe, but only penalizes downside volatility)"
             << std::endl;
 
-  if (pnl_timeseries.size() >= 2) {
+  if (online.samples() >= 2) {
     std::cout << "\nTotal Return:        " << std::fixed << std::setprecision(2)
               << get_return_percentage() << "%" << std::endl;
   }
@@ -316,37 +212,20 @@ void PerformanceMetrics::print_advanced_metrics() const {
 }
 
 std::pair<double, double> PerformanceMetrics::get_return_statistics() const {
-  if (pnl_timeseries.size() < 2) {
-    return {0.0, 0.0};
-  }
-
-  std::vector<double> returns;
-  for (size_t i = 1; i < pnl_timeseries.size(); ++i) {
-    double prev = pnl_timeseries[i - 1].second;
-    double curr = pnl_timeseries[i].second;
-
-    if (std::abs(prev) > 1e-6) {
-      returns.push_back((curr - prev) / std::abs(prev));
-    }
-  }
+  return online.return_statistics();
+}
 
-  if (returns.empty()) {
-    return {0.0, 0.0};
+BootstrapReport PerformanceMetrics::bootstrap(const BootstrapConfig &config,
+                                              WorkerPool *pool) const {
+  if (timeseries_mode != TimeseriesMode::FULL) {
+    throw std::runtime_error("Bootstrap needs the FULL P&L timeseries");
   }
-
-  // Mean
-  double mean =
-      std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-
-  // Standard deviation
-  double sum_sq = 0.0;
-  for (double r : returns) {
-    double diff = r - mean;
-    sum_sq += diff * diff;
+  std::vector<double> pnl;
+  pnl.reserve(pnl_timeseries.size());
+  for (const auto &snapshot : pnl_timeseries) {
+    pnl.push_back(snapshot.second);
   }
-  double stddev = std::sqrt(sum_sq / returns.size());
-
-  return {mean, stddev};
+  return block_bootstrap(pnl, config, pool);
 }
 
 void PerformanceMetrics::export_to_csv(const std::string &filename) const {
@@ -358,14 +237,15 @@ void PerformanceMetrics::export_to_csv(const std::string &filename) const {
   // Write header
   file << "timestamp,pnl,cumulative_return\n";
 
-  if (pnl_timeseries.empty()) {
+  auto series = plot_series();
+  if (series.empty()) {
     file.close();
     return;
   }
 
-  double initial_pnl = pnl_timeseries[0].second;
+  double initial_pnl = online.first_pnl();
 
-  for (const auto &[timestamp, pnl] : pnl_timeseries) {
+  for (const auto &[timestamp, pnl] : series) {
     double cumulative_return = 0.0;
     if (std::abs(initial_pnl) > 1e-6) {
       cumulative_return = ((pnl - initial_pnl) / std::abs(initial_pnl)) * 100.0;
@@ -0,0 +1,72 @@
+#include "price_history.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+PriceHistoryStore::PriceHistoryStore(std::size_t capacity) : capacity_(1) {
+  if (capacity == 0) {
+    throw std::runtime_error("Price history capacity must be positive");
+  }
+
+  while (capacity_ < capacity) {
+    capacity_ <<= 1;
+  }
+  mask_ = capacity_ - 1;
+}
+
+InstrumentId PriceHistoryStore::intern(const std::string &symbol) {
+  auto it = ids_.find(symbol);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+
+  InstrumentId id = static_cast<InstrumentId>(symbols_.size());
+  ids_.emplace(symbol, id);
+  symbols_.push_back(symbol);
+  counts_.push_back(0);
+  rings_.push_back(std::make_unique<double[]>(capacity_));
+
+  return id;
+}
+
+std::optional<InstrumentId>
+PriceHistoryStore::find(const std::string &symbol) const {
+  auto it = ids_.find(symbol);
+  if (it == ids_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::size_t PriceHistoryStore::size(InstrumentId id) const {
+  return static_cast<std::size_t>(
+      std::min<std::uint64_t>(counts_[id], capacity_));
+}
+
+double PriceHistoryStore::last(InstrumentId id) const {
+  if (counts_[id] == 0) {
+    return 0.0;
+  }
+  return ring(id)[(counts_[id] - 1) & mask_];
+}
+
+PriceWindow PriceHistoryStore::last_n(InstrumentId id, std::size_t n) const {
+  PriceWindow window;
+  n = std::min(n, size(id));
+  if (n == 0) {
+    return window;
+  }
+
+  const double *base = ring(id);
+  std::size_t start = static_cast<std::size_t>((counts_[id] - n) & mask_);
+
+  if (start + n <= capacity_) {
+    window.first = {base + start, n};
+  } else {
+    std::size_t head = capacity_ - start;
+    window.first = {base + start, head};
+    window.second = {base, n - head};
+  }
+
+  return window;
+}
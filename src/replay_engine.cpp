@@ -1,5 +1,5 @@
 #include "replay_engine.hpp"
-#include <fstream>
+#include "event_log.hpp"
 #include <iomanip>
 #include <iostream>
 
@@ -7,24 +7,15 @@ ReplayEngine::ReplayEngine()
     : current_idx_(0), events_processed_(0), fills_generated_(0) {}
 
 void ReplayEngine::load_from_file(const std::string &filename) {
-  std::ifstream file(filename);
-  if (!file.is_open()) {
-    throw std::runtime_error("Could not open file: " + filename);
-  }
-
-  std::string line;
-  std::getline(file, line); // Skip header
+  EventLogReader reader(filename);
 
   events_.clear();
   current_idx_ = 0; // Reset position
 
-  while (std::getline(file, line)) {
-    if (line.empty())
-      continue;
-    events_.push_back(OrderEvent::from_csv(line));
+  while (auto event = reader.next()) {
+    events_.push_back(std::move(*event));
   }
 
-  file.close();
   std::cout << "Loaded " << events_.size() << " events from " << filename
             << std::endl;
 }
@@ -209,41 +200,10 @@ const OrderEvent &ReplayEngine::peek_next_event() const {
 
 // Rest of the implementation remains the same...
 void ReplayEngine::replay_event(const OrderEvent &event) {
-  switch (event.type) {
-  case EventType::NEW_ORDER:
-    if (event.peak_size > 0) {
-      book_.add_order(Order(event.order_id, event.account_id, event.side,
-                            event.price, event.quantity, event.peak_size,
-                            event.tif));
-    } else if (event.order_type == OrderType::MARKET) {
-      book_.add_order(Order(event.order_id, event.account_id, event.side,
-                            event.order_type, event.quantity, event.tif));
-    } else {
-      book_.add_order(Order(event.order_id, event.account_id, event.side,
-                            event.price, event.quantity, event.tif));
-    }
-    break;
-
-  case EventType::CANCEL_ORDER:
-    book_.cancel_order(event.order_id);
-    break;
-
-  case EventType::AMEND_ORDER: {
-    std::optional<double> new_price;
-    std::optional<int> new_qty;
-    if (event.has_new_price)
-      new_price = event.new_price;
-    if (event.has_new_quantity)
-      new_qty = event.new_quantity;
-    book_.amend_order(event.order_id, new_price, new_qty);
-    break;
-  }
-
-  case EventType::FILL:
+  if (event.type == EventType::FILL) {
     fills_generated_++;
-    break;
   }
-
+  apply_event(book_, event);
   events_processed_++;
 }
 
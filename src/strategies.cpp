@@ -1,7 +1,9 @@
 #include "strategies.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <stdexcept>
 
 // ============================================================================
 // MOMENTUM STRATEGY
@@ -17,6 +19,8 @@ MomentumStrategy::MomentumStrategy(const StrategyConfig &config)
   exit_threshold_ = config_.get_parameter("exit_threshold", -0.5);  // -0.5%
   take_profit_pct_ = config_.get_parameter("take_profit", 5.0);     // 5%
   stop_loss_pct_ = config_.get_parameter("stop_loss", 2.0);         // 2%
+
+  subscribe_indicator(IndicatorType::MOMENTUM, lookback_period_);
 }
 
 void MomentumStrategy::initialize() {
@@ -54,33 +58,30 @@ void MomentumStrategy::on_fill(const Fill &fill) {
             << " @ $" << fill.price << std::endl;
 }
 
-std::vector<TradingSignal> MomentumStrategy::generate_signals() {
-  std::vector<TradingSignal> signals;
-
+void MomentumStrategy::generate_signals(std::vector<TradingSignal> &signals) {
   if (!is_initialized_ || !config_.enabled) {
-    return signals;
+    return;
   }
 
-  for (const auto &symbol : config_.symbols) {
-    TradingSignal signal = evaluate_symbol(symbol);
+  for (InstrumentId id : instruments_) {
+    TradingSignal signal = evaluate_symbol(id);
     if (!signal.is_hold()) {
       signals.push_back(signal);
       stats_.signals_generated++;
     }
   }
-
-  return signals;
 }
 
-TradingSignal MomentumStrategy::evaluate_symbol(const std::string &symbol) {
-  const auto &prices = get_price_history(symbol);
+TradingSignal MomentumStrategy::evaluate_symbol(InstrumentId id) {
+  const auto &indicators = get_indicators(id);
 
-  if (prices.size() < static_cast<size_t>(lookback_period_ + 1)) {
-    return TradingSignal(SignalType::HOLD, symbol);
+  if (!indicators.is_ready(IndicatorType::MOMENTUM, lookback_period_)) {
+    return TradingSignal(SignalType::HOLD, id);
   }
 
-  double current_price = prices.back();
-  double momentum = calculate_momentum(prices, lookback_period_);
+  const std::string &symbol = symbol_of(id);
+  double current_price = indicators.last();
+  double momentum = indicators.momentum(lookback_period_);
   int position = get_position(symbol);
 
   // Check for take profit or stop loss first
@@ -88,18 +89,20 @@ TradingSignal MomentumStrategy::evaluate_symbol(const std::string &symbol) {
     if (should_take_profit(symbol, current_price)) {
       TradingSignal signal(position > 0 ? SignalType::CLOSE_LONG
                                         : SignalType::CLOSE_SHORT,
-                           symbol, 1.0);
+                           id, 1.0);
       signal.suggested_quantity = std::abs(position);
-      signal.reason = "Take profit triggered";
+      signal.reason = SignalReason::TAKE_PROFIT;
+      signal.reason_value = current_price;
       return signal;
     }
 
     if (should_stop_loss(symbol, current_price)) {
       TradingSignal signal(position > 0 ? SignalType::CLOSE_LONG
                                         : SignalType::CLOSE_SHORT,
-                           symbol, 1.0);
+                           id, 1.0);
       signal.suggested_quantity = std::abs(position);
-      signal.reason = "Stop loss triggered";
+      signal.reason = SignalReason::STOP_LOSS;
+      signal.reason_value = current_price;
       return signal;
     }
   }
@@ -107,41 +110,43 @@ TradingSignal MomentumStrategy::evaluate_symbol(const std::string &symbol) {
   // Entry signals
   if (position == 0) {
     if (momentum > entry_threshold_) {
-      TradingSignal signal(SignalType::BUY, symbol);
+      TradingSignal signal(SignalType::BUY, id);
       signal.confidence = std::min(momentum / (entry_threshold_ * 2), 1.0);
       signal.suggested_quantity = 100;
-      signal.reason =
-          "Strong positive momentum: " + std::to_string(momentum) + "%";
+      signal.reason = SignalReason::MOMENTUM_POSITIVE;
+      signal.reason_value = momentum;
       return signal;
     }
 
     if (momentum < -entry_threshold_) {
-      TradingSignal signal(SignalType::SELL, symbol);
+      TradingSignal signal(SignalType::SELL, id);
       signal.confidence =
           std::min(std::abs(momentum) / (entry_threshold_ * 2), 1.0);
       signal.suggested_quantity = 100;
-      signal.reason =
-          "Strong negative momentum: " + std::to_string(momentum) + "%";
+      signal.reason = SignalReason::MOMENTUM_NEGATIVE;
+      signal.reason_value = momentum;
       return signal;
     }
   }
 
   // Exit signals
   if (position > 0 && momentum < exit_threshold_) {
-    TradingSignal signal(SignalType::CLOSE_LONG, symbol);
+    TradingSignal signal(SignalType::CLOSE_LONG, id);
     signal.suggested_quantity = position;
-    signal.reason = "Momentum reversal (long exit)";
+    signal.reason = SignalReason::MOMENTUM_REVERSAL_LONG;
+    signal.reason_value = momentum;
     return signal;
   }
 
   if (position < 0 && momentum > -exit_threshold_) {
-    TradingSignal signal(SignalType::CLOSE_SHORT, symbol);
+    TradingSignal signal(SignalType::CLOSE_SHORT, id);
     signal.suggested_quantity = std::abs(position);
-    signal.reason = "Momentum reversal (short exit)";
+    signal.reason = SignalReason::MOMENTUM_REVERSAL_SHORT;
+    signal.reason_value = momentum;
     return signal;
   }
 
-  return TradingSignal(SignalType::HOLD, symbol);
+  return TradingSignal(SignalType::HOLD, id);
 }
 
 bool MomentumStrategy::should_take_profit(const std::string &symbol,
@@ -196,6 +201,8 @@ MeanReversionStrategy::MeanReversionStrategy(const StrategyConfig &config)
   entry_std_devs_ = config_.get_parameter("entry_std_devs", 2.0);
   exit_std_devs_ = config_.get_parameter("exit_std_devs", 0.5);
   position_size_pct_ = config_.get_parameter("position_size_pct", 100.0);
+
+  subscribe_indicator(IndicatorType::SMA, lookback_period_);
 }
 
 void MeanReversionStrategy::initialize() {
@@ -224,57 +231,50 @@ void MeanReversionStrategy::on_fill(const Fill &fill) {
             << " @ $" << fill.price << std::endl;
 }
 
-std::vector<TradingSignal> MeanReversionStrategy::generate_signals() {
-  std::vector<TradingSignal> signals;
-
+void MeanReversionStrategy::generate_signals(std::vector<TradingSignal> &signals) {
   if (!is_initialized_ || !config_.enabled) {
-    return signals;
+    return;
   }
 
-  for (const auto &symbol : config_.symbols) {
-    TradingSignal signal = evaluate_symbol(symbol);
+  for (InstrumentId id : instruments_) {
+    TradingSignal signal = evaluate_symbol(id);
     if (!signal.is_hold()) {
       signals.push_back(signal);
       stats_.signals_generated++;
     }
   }
-
-  return signals;
 }
 
-TradingSignal
-MeanReversionStrategy::evaluate_symbol(const std::string &symbol) {
-  const auto &prices = get_price_history(symbol);
-
-  if (prices.size() < static_cast<size_t>(lookback_period_)) {
-    return TradingSignal(SignalType::HOLD, symbol);
+TradingSignal MeanReversionStrategy::evaluate_symbol(InstrumentId id) {
+  if (!get_indicators(id).is_ready(IndicatorType::SMA, lookback_period_)) {
+    return TradingSignal(SignalType::HOLD, id);
   }
 
-  double z_score = calculate_z_score(symbol);
-  int position = get_position(symbol);
+  double z_score = calculate_z_score(symbol_of(id));
+  int position = get_position(symbol_of(id));
 
   // Entry signals - price has deviated significantly from mean
   if (position == 0) {
     if (z_score > entry_std_devs_) {
       // Price is high - sell (expect reversion down)
-      TradingSignal signal(SignalType::SELL, symbol);
+      TradingSignal signal(SignalType::SELL, id);
       signal.confidence = std::min(z_score / (entry_std_devs_ * 2), 1.0);
       signal.suggested_quantity =
           static_cast<int>(100 * (position_size_pct_ / 100.0));
-      signal.reason = "Price above " + std::to_string(entry_std_devs_) +
-                      " std devs (z=" + std::to_string(z_score) + ")";
+      signal.reason = SignalReason::PRICE_ABOVE_MEAN;
+      signal.reason_value = z_score;
       return signal;
     }
 
     if (z_score < -entry_std_devs_) {
       // Price is low - buy (expect reversion up)
-      TradingSignal signal(SignalType::BUY, symbol);
+      TradingSignal signal(SignalType::BUY, id);
       signal.confidence =
           std::min(std::abs(z_score) / (entry_std_devs_ * 2), 1.0);
       signal.suggested_quantity =
           static_cast<int>(100 * (position_size_pct_ / 100.0));
-      signal.reason = "Price below " + std::to_string(entry_std_devs_) +
-                      " std devs (z=" + std::to_string(z_score) + ")";
+      signal.reason = SignalReason::PRICE_BELOW_MEAN;
+      signal.reason_value = z_score;
       return signal;
     }
   }
@@ -282,42 +282,40 @@ MeanReversionStrategy::evaluate_symbol(const std::string &symbol) {
   // Exit signals - price has reverted toward mean
   if (position > 0 && z_score > -exit_std_devs_) {
     // Long position, price reverted to near mean
-    TradingSignal signal(SignalType::CLOSE_LONG, symbol);
+    TradingSignal signal(SignalType::CLOSE_LONG, id);
     signal.suggested_quantity = position;
-    signal.reason =
-        "Mean reversion complete (long exit, z=" + std::to_string(z_score) +
-        ")";
+    signal.reason = SignalReason::MEAN_REVERTED_LONG;
+    signal.reason_value = z_score;
     return signal;
   }
 
   if (position < 0 && z_score < exit_std_devs_) {
     // Short position, price reverted to near mean
-    TradingSignal signal(SignalType::CLOSE_SHORT, symbol);
+    TradingSignal signal(SignalType::CLOSE_SHORT, id);
     signal.suggested_quantity = std::abs(position);
-    signal.reason =
-        "Mean reversion complete (short exit, z=" + std::to_string(z_score) +
-        ")";
+    signal.reason = SignalReason::MEAN_REVERTED_SHORT;
+    signal.reason_value = z_score;
     return signal;
   }
 
-  return TradingSignal(SignalType::HOLD, symbol);
+  return TradingSignal(SignalType::HOLD, id);
 }
 
 double
 MeanReversionStrategy::calculate_z_score(const std::string &symbol) const {
-  const auto &prices = get_price_history(symbol);
+  const auto &indicators = get_indicators(symbol);
 
-  if (prices.size() < static_cast<size_t>(lookback_period_)) {
+  if (!indicators.is_ready(IndicatorType::SMA, lookback_period_)) {
     return 0.0;
   }
 
-  double mean = calculate_sma(prices, lookback_period_);
-  double stddev = calculate_stddev(prices, lookback_period_);
+  double mean = indicators.sma(lookback_period_);
+  double stddev = indicators.stddev(lookback_period_);
 
   if (stddev == 0.0)
     return 0.0;
 
-  double current_price = prices.back();
+  double current_price = indicators.last();
   return (current_price - mean) / stddev;
 }
 
@@ -332,6 +330,7 @@ MarketMakerStrategy::MarketMakerStrategy(const StrategyConfig &config)
   inventory_limit_ = config_.get_parameter("inventory_limit", 500.0);
   quote_size_ = config_.get_parameter("quote_size", 100.0);
   skew_factor_ = config_.get_parameter("skew_factor", 0.1); // 10% skew
+  tick_size_ = config_.get_parameter("tick_size", 0.01);
 }
 
 void MarketMakerStrategy::initialize() {
@@ -343,6 +342,7 @@ void MarketMakerStrategy::initialize() {
   std::cout << "  Inventory Limit:    " << inventory_limit_ << std::endl;
   std::cout << "  Quote Size:         " << quote_size_ << std::endl;
   std::cout << "  Skew Factor:        " << skew_factor_ << std::endl;
+  std::cout << "  Tick Size:          " << tick_size_ << std::endl;
 }
 
 void MarketMakerStrategy::on_market_data(const MarketDataSnapshot &snapshot) {
@@ -364,45 +364,73 @@ void MarketMakerStrategy::on_timer() {
   // This would be called by the trading simulator
 }
 
-std::vector<TradingSignal> MarketMakerStrategy::generate_signals() {
-  std::vector<TradingSignal> signals;
+void MarketMakerStrategy::generate_signals(
+    std::vector<TradingSignal> & /* signals */) {}
 
+void MarketMakerStrategy::generate_quotes(std::vector<MassQuote> &quotes) {
   if (!is_initialized_ || !config_.enabled) {
-    return signals;
+    return;
   }
 
-  for (const auto &symbol : config_.symbols) {
-    int position = get_position(symbol);
-
-    // Don't add to position if we're at inventory limit
-    if (std::abs(position) >= inventory_limit_) {
-      continue;
-    }
-
-    double last_price = get_last_price(symbol);
+  for (InstrumentId id : instruments_) {
+    const std::string &symbol = symbol_of(id);
+    double last_price = get_last_price(id);
     if (last_price <= 0.0)
       continue;
 
     auto [bid_price, ask_price] = calculate_quotes(symbol, last_price);
+    int position = get_position(symbol);
+    int size = static_cast<int>(quote_size_);
+
+    MassQuote quote;
+    quote.instrument = id;
+    // Round outward so a steady mid maps to the same prices and the book
+    // can keep our queue position
+    quote.bid_price = std::floor(bid_price / tick_size_ + 1e-9) * tick_size_;
+    quote.ask_price = std::ceil(ask_price / tick_size_ - 1e-9) * tick_size_;
+    // At the inventory limit, only quote the side that reduces it
+    quote.bid_quantity = position >= inventory_limit_ ? 0 : size;
+    quote.ask_quantity = position <= -inventory_limit_ ? 0 : size;
+
+    auto it = active_quotes_.find(symbol);
+    if (it != active_quotes_.end()) {
+      quote.live_bid_id = it->second.bid_id;
+      quote.live_ask_id = it->second.ask_id;
+    }
 
-    // Create buy signal (bid)
-    TradingSignal buy_signal(SignalType::BUY, symbol);
-    buy_signal.target_price = bid_price;
-    buy_signal.suggested_quantity = static_cast<int>(quote_size_);
-    buy_signal.reason = "Market making bid";
-    signals.push_back(buy_signal);
+    quotes.push_back(quote);
+  }
+}
 
-    // Create sell signal (ask)
-    TradingSignal sell_signal(SignalType::SELL, symbol);
-    sell_signal.target_price = ask_price;
-    sell_signal.suggested_quantity = static_cast<int>(quote_size_);
-    sell_signal.reason = "Market making ask";
-    signals.push_back(sell_signal);
+void MarketMakerStrategy::on_quote_result(const MassQuote &quote,
+                                          const MassQuoteResult &result) {
+  if (result.bid.action == QuoteAction::REJECTED) {
+    stats_.orders_rejected++;
+    return;
+  }
 
-    stats_.signals_generated += 2;
+  for (const QuoteOutcome *side : {&result.bid, &result.ask}) {
+    if (side->action == QuoteAction::NEW ||
+        side->action == QuoteAction::REPLACED) {
+      stats_.orders_submitted++;
+      stats_.signals_generated++;
+    }
   }
 
-  return signals;
+  Quote &active = active_quotes_[symbol_of(quote.instrument)];
+  active.bid_price = quote.bid_price;
+  active.ask_price = quote.ask_price;
+  active.bid_size = result.bid.resting_quantity;
+  active.ask_size = result.ask.resting_quantity;
+  active.bid_id = result.bid.resting_quantity > 0 ? result.bid.order_id : 0;
+  active.ask_id = result.ask.resting_quantity > 0 ? result.ask.order_id : 0;
+  active.timestamp = clock_->now();
+}
+
+const MarketMakerStrategy::Quote *
+MarketMakerStrategy::get_active_quote(const std::string &symbol) const {
+  auto it = active_quotes_.find(symbol);
+  return it != active_quotes_.end() ? &it->second : nullptr;
 }
 
 std::pair<double, double>
@@ -450,4 +478,329 @@ bool MarketMakerStrategy::should_update_quotes(
   double price_change_pct = std::abs((new_mid - old_mid) / old_mid) * 100.0;
 
   return price_change_pct > 0.1; // Update if >0.1% price change
-}
\ No newline at end of file
+}
+// ============================================================================
+// PAIRS TRADING STRATEGY
+// ============================================================================
+
+PairsTradingStrategy::PairsTradingStrategy(
+    const StrategyConfig &config,
+    std::shared_ptr<PairStatisticsRegistry> registry)
+    : Strategy(config), spread_position_(0), dependent_position_(0),
+      hedge_position_(0), spread_target_(0) {
+
+  if (config_.symbols.size() < 2) {
+    throw std::runtime_error("PairsTradingStrategy needs two symbols");
+  }
+
+  symbol1_ = config_.symbols[0];
+  symbol2_ = config_.symbols[1];
+  leg1_ = instruments_[0];
+  leg2_ = instruments_[1];
+
+  formation_period_ =
+      static_cast<int>(config_.get_parameter("formation_period", 60.0));
+  halflife_ = config_.get_parameter("hedge_halflife", formation_period_ / 2.0);
+  hedge_method_ = config_.get_parameter("hedge_method", 0.0) == 0.0
+                      ? HedgeRatioMethod::ROLLING_OLS
+                      : HedgeRatioMethod::EXPONENTIAL;
+  entry_threshold_ = config_.get_parameter("entry_threshold", 2.0);
+  exit_threshold_ = config_.get_parameter("exit_threshold", 0.5);
+  leg_quantity_ = static_cast<int>(config_.get_parameter("quantity", 100.0));
+
+  if (!registry) {
+    registry = std::make_shared<PairStatisticsRegistry>();
+  }
+  pair_stats_ = registry->acquire(symbol1_, symbol2_, formation_period_,
+                                  halflife_);
+}
+
+void PairsTradingStrategy::initialize() {
+  Strategy::initialize();
+
+  std::cout << "[" << config_.name
+            << "] Initialized with parameters:" << std::endl;
+  std::cout << "  Pair:               " << symbol1_ << " / " << symbol2_
+            << std::endl;
+  std::cout << "  Formation Period:   " << formation_period_ << std::endl;
+  std::cout << "  Hedge Ratio:        "
+            << (hedge_method_ == HedgeRatioMethod::ROLLING_OLS
+                    ? "rolling OLS"
+                    : "EW, half-life " + std::to_string(halflife_))
+            << std::endl;
+  std::cout << "  Entry Z-Score:      " << entry_threshold_ << std::endl;
+  std::cout << "  Exit Z-Score:       " << exit_threshold_ << std::endl;
+}
+
+void PairsTradingStrategy::on_market_data(const MarketDataSnapshot &snapshot) {
+  if (!is_initialized_ || !config_.enabled || snapshot.last_price <= 0.0)
+    return;
+
+  add_price(snapshot.symbol, snapshot.last_price);
+
+  if (snapshot.symbol == symbol1_) {
+    pair_stats_->on_price(PairLeg::DEPENDENT, snapshot.last_price,
+                          snapshot.timestamp);
+  } else if (snapshot.symbol == symbol2_) {
+    pair_stats_->on_price(PairLeg::HEDGE, snapshot.last_price,
+                          snapshot.timestamp);
+  }
+}
+
+void PairsTradingStrategy::on_fill(const Fill &fill) {
+  update_stats(fill);
+
+  std::cout << "[" << config_.name << "] Fill received: " << fill.quantity
+            << " @ $" << fill.price << std::endl;
+}
+
+void PairsTradingStrategy::on_execution(const Fill &fill,
+                                        const FillContext &context) {
+  int signed_quantity =
+      context.side == Side::BUY ? fill.quantity : -fill.quantity;
+  if (context.symbol == symbol1_) {
+    dependent_position_ += signed_quantity;
+  } else if (context.symbol == symbol2_) {
+    hedge_position_ += signed_quantity;
+  }
+  spread_position_ = (dependent_position_ > 0) - (dependent_position_ < 0);
+
+  Strategy::on_execution(fill, context);
+}
+
+double PairsTradingStrategy::get_hedge_ratio() const {
+  return pair_stats_->hedge_ratio(hedge_method_);
+}
+
+double PairsTradingStrategy::calculate_spread_zscore() const {
+  return pair_stats_->zscore(hedge_method_);
+}
+
+void PairsTradingStrategy::generate_signals(
+    std::vector<TradingSignal> &signals) {
+  if (!is_initialized_ || !config_.enabled || !pair_stats_->is_ready()) {
+    return;
+  }
+
+  double z_score = calculate_spread_zscore();
+  bool flat = dependent_position_ == 0 && hedge_position_ == 0;
+
+  // Entry: spread stretched away from its fitted mean. Selling the spread
+  // means selling y and buying beta units of x (selling them if beta < 0).
+  if (spread_target_ == 0) {
+    if (!flat) {
+      // A leg filled after its trade was exited; flatten it once nothing
+      // else is still working
+      if (pending_orders().empty()) {
+        close_leg(signals, leg1_, dependent_position_, z_score);
+        close_leg(signals, leg2_, hedge_position_, z_score);
+      }
+      return;
+    }
+
+    int direction = 0;
+    if (z_score > entry_threshold_) {
+      direction = -1;
+    } else if (z_score < -entry_threshold_) {
+      direction = 1;
+    }
+    if (direction == 0) {
+      return;
+    }
+
+    double beta = get_hedge_ratio();
+    int hedge_quantity =
+        static_cast<int>(std::lround(std::abs(beta) * leg_quantity_));
+    int hedge_direction = beta >= 0.0 ? -direction : direction;
+    SignalReason reason = direction < 0 ? SignalReason::PAIR_SPREAD_HIGH
+                                        : SignalReason::PAIR_SPREAD_LOW;
+
+    add_leg_signal(signals, leg1_,
+                   direction > 0 ? SignalType::BUY : SignalType::SELL,
+                   leg_quantity_, z_score, reason);
+    if (hedge_quantity > 0) {
+      add_leg_signal(signals, leg2_,
+                     hedge_direction > 0 ? SignalType::BUY : SignalType::SELL,
+                     hedge_quantity, z_score, reason);
+    }
+
+    spread_target_ = direction;
+    return;
+  }
+
+  // Exit: spread back inside the exit band. Only filled quantity is closed;
+  // a leg that fills later is flattened by the branch above.
+  bool reverted = spread_target_ > 0 ? z_score > -exit_threshold_
+                                     : z_score < exit_threshold_;
+  if (!reverted) {
+    return;
+  }
+
+  close_leg(signals, leg1_, dependent_position_, z_score);
+  close_leg(signals, leg2_, hedge_position_, z_score);
+  spread_target_ = 0;
+}
+
+void PairsTradingStrategy::close_leg(std::vector<TradingSignal> &signals,
+                                     InstrumentId leg, int position,
+                                     double zscore) {
+  if (position == 0) {
+    return;
+  }
+  add_leg_signal(signals, leg,
+                 position > 0 ? SignalType::CLOSE_LONG
+                              : SignalType::CLOSE_SHORT,
+                 std::abs(position), zscore,
+                 SignalReason::PAIR_SPREAD_REVERTED);
+}
+
+void PairsTradingStrategy::add_leg_signal(std::vector<TradingSignal> &signals,
+                                          InstrumentId leg, SignalType type,
+                                          int quantity, double zscore,
+                                          SignalReason reason) {
+  TradingSignal signal(type, leg);
+  signal.confidence = std::min(std::abs(zscore) / (entry_threshold_ * 2), 1.0);
+  signal.suggested_quantity = quantity;
+  signal.reason = reason;
+  signal.reason_value = zscore;
+  signals.push_back(signal);
+  stats_.signals_generated++;
+}
+
+// ============================================================================
+// BREAKOUT STRATEGY
+// ============================================================================
+
+BreakoutStrategy::BreakoutStrategy(const StrategyConfig &config)
+    : Strategy(config) {
+
+  channel_period_ =
+      static_cast<int>(config_.get_parameter("channel_period", 20.0));
+  breakout_threshold_ =
+      config_.get_parameter("breakout_threshold", 0.5);                // 0.5%
+  volume_multiplier_ = config_.get_parameter("volume_multiplier", 1.0); // 1x
+
+  subscribe_indicator(IndicatorType::CHANNEL, channel_period_);
+}
+
+void BreakoutStrategy::initialize() {
+  Strategy::initialize();
+
+  std::cout << "[" << config_.name
+            << "] Initialized with parameters:" << std::endl;
+  std::cout << "  Channel Period:     " << channel_period_ << std::endl;
+  std::cout << "  Breakout Threshold: " << breakout_threshold_ << "%"
+            << std::endl;
+  std::cout << "  Volume Multiplier:  " << volume_multiplier_ << "x"
+            << std::endl;
+}
+
+void BreakoutStrategy::on_market_data(const MarketDataSnapshot &snapshot) {
+  if (!is_initialized_ || !config_.enabled)
+    return;
+
+  // Capture the channel formed by prior prices before this one joins it
+  update_channel(snapshot);
+  add_price(snapshot.symbol, snapshot.last_price);
+}
+
+void BreakoutStrategy::on_fill(const Fill &fill) {
+  update_stats(fill);
+
+  std::cout << "[" << config_.name << "] Fill received: " << fill.quantity
+            << " @ $" << fill.price << std::endl;
+}
+
+void BreakoutStrategy::generate_signals(std::vector<TradingSignal> &signals) {
+  if (!is_initialized_ || !config_.enabled) {
+    return;
+  }
+
+  for (InstrumentId id : instruments_) {
+    TradingSignal signal = evaluate_breakout(id);
+    if (!signal.is_hold()) {
+      signals.push_back(signal);
+      stats_.signals_generated++;
+    }
+  }
+}
+
+void BreakoutStrategy::update_channel(const MarketDataSnapshot &snapshot) {
+  const auto &indicators = get_indicators(snapshot.symbol);
+
+  auto vol_it = volume_stats_.find(snapshot.symbol);
+  if (vol_it == volume_stats_.end()) {
+    IndicatorSet volume;
+    volume.subscribe(IndicatorType::SMA, channel_period_);
+    vol_it = volume_stats_.emplace(snapshot.symbol, std::move(volume)).first;
+  }
+
+  if (indicators.is_ready(IndicatorType::CHANNEL, channel_period_)) {
+    channels_[snapshot.symbol] = {indicators.rolling_high(channel_period_),
+                                  indicators.rolling_low(channel_period_),
+                                  vol_it->second.sma(channel_period_)};
+  }
+
+  vol_it->second.update(snapshot.bid_size + snapshot.ask_size);
+}
+
+TradingSignal BreakoutStrategy::evaluate_breakout(InstrumentId id) {
+  const std::string &symbol = symbol_of(id);
+  auto it = channels_.find(symbol);
+  if (it == channels_.end()) {
+    return TradingSignal(SignalType::HOLD, id);
+  }
+
+  const Channel &channel = it->second;
+  double current_price = get_last_price(id);
+  int position = get_position(symbol);
+
+  // Volume confirmation (skipped until an average is available)
+  double current_volume = volume_stats_.at(symbol).last();
+  bool volume_confirmed =
+      channel.avg_volume <= 0.0 ||
+      current_volume >= volume_multiplier_ * channel.avg_volume;
+
+  double upper = channel.high * (1.0 + breakout_threshold_ / 100.0);
+  double lower = channel.low * (1.0 - breakout_threshold_ / 100.0);
+
+  // Entry signals - price has broken out of the channel
+  if (position == 0 && volume_confirmed) {
+    if (current_price > upper) {
+      TradingSignal signal(SignalType::BUY, id);
+      signal.suggested_quantity = 100;
+      signal.reason = SignalReason::BREAKOUT_UP;
+      signal.reason_value = channel.high;
+      return signal;
+    }
+
+    if (current_price < lower) {
+      TradingSignal signal(SignalType::SELL, id);
+      signal.suggested_quantity = 100;
+      signal.reason = SignalReason::BREAKOUT_DOWN;
+      signal.reason_value = channel.low;
+      return signal;
+    }
+  }
+
+  // Exit signals - price has fallen back to the middle of the channel
+  double midpoint = (channel.high + channel.low) / 2.0;
+
+  if (position > 0 && current_price < midpoint) {
+    TradingSignal signal(SignalType::CLOSE_LONG, id);
+    signal.suggested_quantity = position;
+    signal.reason = SignalReason::BREAKOUT_FAILED_LONG;
+    signal.reason_value = midpoint;
+    return signal;
+  }
+
+  if (position < 0 && current_price > midpoint) {
+    TradingSignal signal(SignalType::CLOSE_SHORT, id);
+    signal.suggested_quantity = std::abs(position);
+    signal.reason = SignalReason::BREAKOUT_FAILED_SHORT;
+    signal.reason_value = midpoint;
+    return signal;
+  }
+
+  return TradingSignal(SignalType::HOLD, id);
+}
@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <iostream>
 #include <numeric>
+#include <stdexcept>
 
 // ============================================================================
 // STRATEGY STATISTICS
@@ -35,7 +36,54 @@ void StrategyStats::print() const {
 // ============================================================================
 
 Strategy::Strategy(const StrategyConfig &config)
-    : config_(config), is_initialized_(false), next_order_id_(1) {}
+    : config_(config), is_initialized_(false), next_order_id_(1),
+      price_history_(static_cast<size_t>(
+          config.get_parameter("max_history", 1000.0))),
+      clock_(&wall_clock()) {
+  for (const auto &symbol : config_.symbols) {
+    instruments_.push_back(instrument_id(symbol));
+  }
+
+  // Sized once so the per-tick path never grows these buffers
+  size_t reserve = static_cast<size_t>(
+      config_.get_parameter("order_buffer_size", 64.0));
+  pending_orders_.reserve(reserve);
+  signal_arena_.reserve(std::max(reserve, instruments_.size()));
+
+  // Top of book for every traded symbol unless the strategy says otherwise
+  auto conflation = static_cast<std::uint32_t>(
+      config_.get_parameter("md_conflation", 1.0));
+  for (const auto &symbol : config_.symbols) {
+    subscribe_market_data(symbol, MarketDataType::BBO, conflation);
+  }
+}
+
+void Strategy::subscribe_market_data(const std::string &symbol,
+                                     MarketDataType type,
+                                     std::uint32_t conflation) {
+  if (type == MarketDataType::DEPTH) {
+    throw std::runtime_error("DEPTH market data is not published yet; "
+                             "subscribe to BBO, TRADES or BARS");
+  }
+  for (auto &subscription : subscriptions_) {
+    if (subscription.symbol == symbol && subscription.type == type) {
+      subscription.conflation = conflation == 0 ? 1 : conflation;
+      return;
+    }
+  }
+  subscriptions_.emplace_back(symbol, type, conflation);
+}
+
+void Strategy::unsubscribe_market_data(const std::string &symbol,
+                                       MarketDataType type) {
+  subscriptions_.erase(
+      std::remove_if(subscriptions_.begin(), subscriptions_.end(),
+                     [&](const MarketDataSubscription &subscription) {
+                       return subscription.symbol == symbol &&
+                              subscription.type == type;
+                     }),
+      subscriptions_.end());
+}
 
 void Strategy::on_order_rejected(int order_id, const std::string &reason) {
   stats_.orders_rejected++;
@@ -52,16 +100,34 @@ void Strategy::on_order_cancelled(int order_id) {
             << std::endl;
 }
 
+void Strategy::on_execution(const Fill &fill,
+                            const FillContext & /* context */) {
+  on_fill(fill);
+}
+
 void Strategy::on_timer() {
   // Default implementation: do nothing
   // Override in derived classes for periodic actions
 }
 
-std::vector<Order>
-Strategy::signals_to_orders(const std::vector<TradingSignal> &signals) {
+void Strategy::set_clock(const SimClock &clock) {
+  clock_ = &clock;
+  stats_.start_time = clock_->now();
+  stats_.last_update = stats_.start_time;
+}
 
-  std::vector<Order> orders;
+void Strategy::emit_orders(std::vector<Order> &orders) {
+  signal_arena_.clear();
+  generate_signals(signal_arena_);
+  TimePoint now = clock_->now();
+  for (auto &signal : signal_arena_) {
+    signal.timestamp = now;
+  }
+  signals_to_orders(signal_arena_, orders);
+}
 
+void Strategy::signals_to_orders(const std::vector<TradingSignal> &signals,
+                                 std::vector<Order> &orders) {
   for (const auto &signal : signals) {
     if (signal.is_hold()) {
       continue; // No order for HOLD signals
@@ -79,21 +145,23 @@ Strategy::signals_to_orders(const std::vector<TradingSignal> &signals) {
       continue;
     }
 
+    const std::string &symbol = symbol_of(signal.instrument);
+
     // Determine quantity
     int quantity = signal.suggested_quantity;
     if (quantity <= 0) {
       // Default quantity logic
       if (signal.is_close()) {
-        quantity = std::abs(get_position(signal.symbol));
+        quantity = std::abs(get_position(symbol));
       } else {
         quantity = 100; // Default
       }
     }
 
     // Check risk limits
-    if (!check_risk_limits(signal.symbol, quantity)) {
+    if (!check_risk_limits(symbol, quantity)) {
       std::cout << "[" << config_.name << "] Risk limit exceeded for "
-                << signal.symbol << ", skipping signal" << std::endl;
+                << symbol << ", skipping signal" << std::endl;
       continue;
     }
 
@@ -107,14 +175,13 @@ Strategy::signals_to_orders(const std::vector<TradingSignal> &signals) {
                     quantity)
             : Order(order_id, config_.account_id, side, signal.target_price,
                     quantity);
+    order.instrument = signal.instrument;
 
     orders.push_back(order);
     track_order(order);
 
     stats_.orders_submitted++;
   }
-
-  return orders;
 }
 
 // ============================================================================
@@ -143,27 +210,58 @@ bool Strategy::is_flat(const std::string &symbol) const {
 // PRICE HISTORY
 // ============================================================================
 
-void Strategy::add_price(const std::string &symbol, double price,
-                         size_t max_history) {
-  auto &history = price_history_[symbol];
-  history.push_back(price);
-
-  if (history.size() > max_history) {
-    history.pop_front();
+InstrumentId Strategy::instrument_id(const std::string &symbol) {
+  InstrumentId id = price_history_.intern(symbol);
+  if (id >= indicators_.size()) {
+    indicators_.resize(id + 1, indicator_template_);
   }
+  return id;
 }
 
-const std::deque<double> &
-Strategy::get_price_history(const std::string &symbol) const {
+void Strategy::add_price(const std::string &symbol, double price) {
+  add_price(instrument_id(symbol), price);
+}
 
-  static std::deque<double> empty;
-  auto it = price_history_.find(symbol);
-  return (it != price_history_.end()) ? it->second : empty;
+void Strategy::add_price(InstrumentId id, double price) {
+  price_history_.push(id, price);
+  indicators_[id].update(price);
+}
+
+PriceWindow Strategy::get_price_history(const std::string &symbol) const {
+  auto id = price_history_.find(symbol);
+  return id ? price_history_.window(*id) : PriceWindow();
 }
 
 double Strategy::get_last_price(const std::string &symbol) const {
-  const auto &history = get_price_history(symbol);
-  return history.empty() ? 0.0 : history.back();
+  auto id = price_history_.find(symbol);
+  return id ? price_history_.last(*id) : 0.0;
+}
+
+// ============================================================================
+// INDICATORS
+// ============================================================================
+
+void Strategy::subscribe_indicator(IndicatorType type, size_t period) {
+  if (indicator_template_.is_subscribed(type, period)) {
+    return;
+  }
+
+  indicator_template_.subscribe(type, period);
+
+  // Rebuild symbols already in flight from their retained history
+  for (InstrumentId id = 0; id < indicators_.size(); ++id) {
+    IndicatorSet rebuilt = indicator_template_;
+    for (double price : price_history_.window(id)) {
+      rebuilt.update(price);
+    }
+    indicators_[id] = std::move(rebuilt);
+  }
+}
+
+const IndicatorSet &
+Strategy::get_indicators(const std::string &symbol) const {
+  auto id = price_history_.find(symbol);
+  return id ? indicators_[*id] : indicator_template_;
 }
 
 // ============================================================================
@@ -171,10 +269,27 @@ double Strategy::get_last_price(const std::string &symbol) const {
 // ============================================================================
 
 void Strategy::track_order(const Order &order) {
-  pending_orders_.insert({order.id, order});
+  pending_orders_.push_back(order);
 }
 
-void Strategy::remove_order(int order_id) { pending_orders_.erase(order_id); }
+void Strategy::remove_order(int order_id) {
+  for (size_t i = 0; i < pending_orders_.size(); ++i) {
+    if (pending_orders_[i].id == order_id) {
+      pending_orders_[i] = pending_orders_.back();
+      pending_orders_.pop_back();
+      return;
+    }
+  }
+}
+
+void Strategy::retag_order(int old_id, int new_id) {
+  for (auto &order : pending_orders_) {
+    if (order.id == old_id) {
+      order.id = new_id;
+      return;
+    }
+  }
+}
 
 bool Strategy::has_pending_orders(const std::string & /* symbol */) const {
   // Note: We'd need to track symbol per order for this to work perfectly
@@ -205,7 +320,7 @@ bool Strategy::check_risk_limits(const std::string &symbol,
 
 void Strategy::update_stats(const Fill &fill) {
   stats_.orders_filled++;
-  stats_.last_update = Clock::now();
+  stats_.last_update = clock_->now();
 
   // Remove from pending orders
   remove_order(fill.buy_order_id);
@@ -258,21 +373,26 @@ void Strategy::print_positions() const {
 // TECHNICAL INDICATORS
 // ============================================================================
 
-double Strategy::calculate_sma(const std::deque<double> &prices,
+double Strategy::calculate_sma(const PriceWindow &prices,
                                size_t period) const {
   if (prices.size() < period) {
     return 0.0;
   }
 
+  // Sum each contiguous span of the tail directly
+  PriceWindow tail = prices.tail(period);
   double sum = 0.0;
-  for (size_t i = prices.size() - period; i < prices.size(); ++i) {
-    sum += prices[i];
+  for (double p : tail.first) {
+    sum += p;
+  }
+  for (double p : tail.second) {
+    sum += p;
   }
 
   return sum / period;
 }
 
-double Strategy::calculate_ema(const std::deque<double> &prices,
+double Strategy::calculate_ema(const PriceWindow &prices,
                                size_t period) const {
   if (prices.size() < period) {
     return 0.0;
@@ -290,7 +410,7 @@ double Strategy::calculate_ema(const std::deque<double> &prices,
   return ema;
 }
 
-double Strategy::calculate_stddev(const std::deque<double> &prices,
+double Strategy::calculate_stddev(const PriceWindow &prices,
                                   size_t period) const {
   if (prices.size() < period) {
     return 0.0;
@@ -298,16 +418,21 @@ double Strategy::calculate_stddev(const std::deque<double> &prices,
 
   double mean = calculate_sma(prices, period);
 
+  PriceWindow tail = prices.tail(period);
   double sum_squared_diff = 0.0;
-  for (size_t i = prices.size() - period; i < prices.size(); ++i) {
-    double diff = prices[i] - mean;
+  for (double p : tail.first) {
+    double diff = p - mean;
+    sum_squared_diff += diff * diff;
+  }
+  for (double p : tail.second) {
+    double diff = p - mean;
     sum_squared_diff += diff * diff;
   }
 
   return std::sqrt(sum_squared_diff / period);
 }
 
-double Strategy::calculate_momentum(const std::deque<double> &prices,
+double Strategy::calculate_momentum(const PriceWindow &prices,
                                     size_t period) const {
   if (prices.size() < period + 1) {
     return 0.0;
@@ -0,0 +1,64 @@
+#include "subscription_registry.hpp"
+
+#include <algorithm>
+
+InstrumentId SubscriptionRegistry::intern(const std::string &symbol) {
+  auto it = ids_.find(symbol);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+
+  InstrumentId id = static_cast<InstrumentId>(symbols_.size());
+  ids_.emplace(symbol, id);
+  symbols_.push_back(symbol);
+  feeds_.emplace_back();
+
+  return id;
+}
+
+std::optional<InstrumentId>
+SubscriptionRegistry::find(const std::string &symbol) const {
+  auto it = ids_.find(symbol);
+  if (it == ids_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void SubscriptionRegistry::add_strategy(Strategy *strategy) {
+  for (const auto &sub : strategy->get_market_data_subscriptions()) {
+    subscribe(strategy, sub);
+  }
+}
+
+void SubscriptionRegistry::subscribe(Strategy *strategy,
+                                     const MarketDataSubscription &sub) {
+  auto &list = feeds_[intern(sub.symbol)][slot(sub.type)];
+
+  for (auto &subscriber : list) {
+    if (subscriber.strategy == strategy) {
+      subscriber.conflation = sub.conflation;
+      return;
+    }
+  }
+  list.push_back({strategy, sub.conflation, 0});
+}
+
+void SubscriptionRegistry::remove_strategy(Strategy *strategy) {
+  for (auto &lists : feeds_) {
+    for (auto &list : lists) {
+      list.erase(std::remove_if(list.begin(), list.end(),
+                                [strategy](const Subscriber &subscriber) {
+                                  return subscriber.strategy == strategy;
+                                }),
+                 list.end());
+    }
+  }
+}
+
+void SubscriptionRegistry::publish(InstrumentId id,
+                                   const MarketDataSnapshot &snapshot) {
+  publish(id, snapshot, [](Strategy *strategy, const MarketDataSnapshot &s) {
+    strategy->on_market_data(s);
+  });
+}
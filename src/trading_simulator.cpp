@@ -1,35 +1,265 @@
 // src/trading_simulator.cpp
 #include "trading_simulator.hpp"
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <unordered_set>
 
-TradingSimulator::TradingSimulator()
-    : order_book_("SIM"), next_order_id_(1), is_running_(false) {}
+namespace {
+
+// Resting in the book (possibly partially filled); anything else is final
+bool order_is_live(const OrderBook &book, int order_id) {
+  auto order = book.get_order(order_id);
+  return order && order->is_active();
+}
+
+} // namespace
+
+TradingSimulator::TradingSimulator(const std::string &symbol)
+    : scheduler_(clock_), step_interval_(std::chrono::milliseconds(1)),
+      timer_interval_(Duration::zero()), timer_event_(0), unrouted_orders_(0),
+      background_fills_(0), bar_interval_(60),
+      next_order_id_(STRATEGY_ORDER_ID_BASE), is_running_(false) {
+  submission_buffer_.reserve(256);
+  quote_buffer_.reserve(16);
+  add_instrument(symbol);
+}
 
 // In trading_simulator.cpp or wherever you initialize
 void TradingSimulator::setup() {
-  // Register callback for automatic fill processing
-  order_book_.get_fill_router().register_fill_callback(
-      [this](const EnhancedFill &fill) {
-        position_manager_.process_fill(fill.base_fill, fill.buy_account_id,
-                                       fill.sell_account_id, fill.symbol);
-
-        // Notify strategies
-        for (auto &strategy : strategies_) {
-          if (strategy->get_account_id() == fill.buy_account_id ||
-              strategy->get_account_id() == fill.sell_account_id) {
-            strategy->on_fill(fill.base_fill);
-          }
+  // Register self-trade notification
+  for (auto &venue : venues_) {
+    venue->book.get_fill_router().register_self_trade_callback(
+        [](int account_id, const Order &order1, const Order &order2) {
+          std::cout << "⚠ Self-trade detected for account " << account_id
+                    << " between orders " << order1.id << " and "
+                    << order2.id << std::endl;
+        });
+  }
+}
+
+InstrumentId TradingSimulator::add_instrument(const std::string &symbol) {
+  auto it = venue_by_symbol_.find(symbol);
+  if (it != venue_by_symbol_.end()) {
+    return static_cast<InstrumentId>(it->second);
+  }
+
+  size_t index = venues_.size();
+  auto venue = std::make_unique<Venue>(symbol);
+  venue->book.set_clock(clock_);
+  venue->feed = subscriptions_.intern(symbol);
+  venue->bbo.symbol = symbol;
+  venue->trade_prints.reserve(64);
+
+  // Single fill path: every routed fill reaches positions and the owning
+  // strategies exactly once, in order. Fills from the parallel phase wait
+  // for the next synchronization point.
+  Venue *target = venue.get();
+  venue->book.get_fill_router().register_fill_callback(
+      [this, target](const EnhancedFill &fill) {
+        if (target->defer_fills) {
+          target->deferred_fills.push_back(fill);
+        } else {
+          dispatch_fill(*target, fill);
         }
       });
 
-  // Register self-trade notification
-  order_book_.get_fill_router().register_self_trade_callback(
-      [](int account_id, const Order &order1, const Order &order2) {
-        std::cout << "⚠ Self-trade detected for account " << account_id
-                  << " between orders " << order1.id << " and " << order2.id
-                  << std::endl;
-      });
+  venues_.push_back(std::move(venue));
+  venue_by_symbol_.emplace(symbol, index);
+  return static_cast<InstrumentId>(index);
+}
+
+void TradingSimulator::check_generator(
+    const MarketDataGenerator::Config &generator) const {
+  if (generator.symbol.empty()) {
+    throw std::runtime_error("Generated instrument needs a symbol");
+  }
+  if (generator.start_price <= 0.0 || generator.tick_size <= 0.0 ||
+      generator.spread < 0.0 || generator.volatility <= 0.0 ||
+      generator.min_size <= 0.0 || generator.max_size < generator.min_size) {
+    throw std::runtime_error("Generator for " + generator.symbol +
+                             " has invalid prices or sizes");
+  }
+  auto it = venue_by_symbol_.find(generator.symbol);
+  if (it != venue_by_symbol_.end() && venues_[it->second]->generator) {
+    throw std::runtime_error("Symbol " + generator.symbol +
+                             " already has generated flow");
+  }
+  if (it != venue_by_symbol_.end() && venues_[it->second]->replay) {
+    throw std::runtime_error("Symbol " + generator.symbol +
+                             " replays a log; its order IDs would collide "
+                             "with generated flow");
+  }
+}
+
+InstrumentId
+TradingSimulator::add_instrument(const MarketDataGenerator::Config &generator,
+                                 double market_order_probability) {
+  check_generator(generator);
+  return attach_generator(generator, market_order_probability);
+}
+
+InstrumentId TradingSimulator::attach_generator(
+    const MarketDataGenerator::Config &generator,
+    double market_order_probability) {
+  InstrumentId id = add_instrument(generator.symbol);
+  Venue &target = *venues_[id];
+
+  target.generator = std::make_unique<MarketDataGenerator>(generator);
+  target.generator->set_clock(clock_);
+  target.market_order_probability = market_order_probability;
+
+  // The generator trades from its own accounts; book them like any other
+  auto ensure_account = [this](int account_id, const char *role) {
+    if (!position_manager_.has_account(account_id)) {
+      position_manager_.create_account(account_id, role, 1e12);
+    }
+  };
+  for (size_t level = 0; level < generator.depth_levels; ++level) {
+    ensure_account(generator.maker_buy_account + static_cast<int>(level),
+                   "Generator Maker");
+    ensure_account(generator.maker_sell_account + static_cast<int>(level),
+                   "Generator Maker");
+  }
+  ensure_account(generator.taker_buy_account, "Generator Taker");
+  ensure_account(generator.taker_sell_account, "Generator Taker");
+
+  return id;
+}
+
+std::vector<InstrumentId> TradingSimulator::add_universe(
+    const MultiAssetMarketDataGenerator::Config &universe,
+    double market_order_probability) {
+  if (shocks_) {
+    throw std::runtime_error("Simulator already has a correlated universe");
+  }
+
+  // Validate everything before the first venue changes, so a bad universe
+  // leaves the simulator as it was
+  auto shocks = std::make_unique<CorrelatedShockGenerator>(
+      make_shock_generator(universe));
+  std::unordered_set<std::string> symbols;
+  for (const auto &symbol : universe.symbols) {
+    check_generator(symbol);
+    if (!symbols.insert(symbol.symbol).second) {
+      throw std::runtime_error("Symbol " + symbol.symbol +
+                               " appears twice in the universe");
+    }
+  }
+
+  std::vector<InstrumentId> ids;
+  ids.reserve(universe.symbols.size());
+  correlated_venues_.reserve(universe.symbols.size());
+  for (const auto &symbol : universe.symbols) {
+    InstrumentId id = attach_generator(symbol, market_order_probability);
+    venues_[id]->correlated = true;
+    correlated_venues_.push_back(id);
+    ids.push_back(id);
+  }
+
+  shocks_ = std::move(shocks);
+  shock_buffer_.resize(correlated_venues_.size());
+  return ids;
+}
+
+InstrumentId TradingSimulator::add_replay(const std::string &symbol,
+                                          const std::string &filename) {
+  auto existing = venue_by_symbol_.find(symbol);
+  if (existing != venue_by_symbol_.end()) {
+    const Venue &venue = *venues_[existing->second];
+    if (venue.replay) {
+      throw std::runtime_error("Symbol " + symbol + " already has a replay");
+    }
+    if (venue.generator) {
+      throw std::runtime_error("Symbol " + symbol +
+                               " has generated flow; its order IDs would "
+                               "collide with the replay's");
+    }
+  }
+
+  InstrumentId id = add_instrument(symbol);
+  Venue &target = *venues_[id];
+
+  target.replay = std::make_unique<EventLogReader>(filename);
+  target.next_replay = target.replay->next();
+  if (target.next_replay) {
+    target.replay_offset = clock_.now() - target.next_replay->timestamp;
+    schedule_replay(target);
+  }
+  return id;
+}
+
+void TradingSimulator::schedule_replay(Venue &venue) {
+  if (!venue.next_replay) {
+    return; // Log exhausted
+  }
+
+  // One pending event per log: it applies everything then due and re-arms
+  Venue *target = &venue;
+  scheduler_.schedule_at(venue.next_replay->timestamp + venue.replay_offset,
+                         SimEventType::ORDER_ARRIVAL,
+                         [this, target] { replay_due(*target); });
+}
+
+void TradingSimulator::replay_due(Venue &venue) {
+  TimePoint now = clock_.now();
+  while (venue.next_replay &&
+         venue.next_replay->timestamp + venue.replay_offset <= now) {
+    OrderEvent &event = *venue.next_replay;
+    if (event.type == EventType::NEW_ORDER) {
+      if (is_strategy_order(event.order_id)) {
+        throw std::runtime_error("Replayed order " +
+                                 std::to_string(event.order_id) +
+                                 " is in the strategy order ID range");
+      }
+      if (event.account_id >= REPLAY_ACCOUNT_BASE) {
+        throw std::runtime_error("Replayed account " +
+                                 std::to_string(event.account_id) +
+                                 " is in the replay account range");
+      }
+      event.account_id = REPLAY_ACCOUNT_BASE + std::max(event.account_id, 0);
+    }
+
+    apply_event(venue.book, event);
+    ++venue.replayed_events;
+    venue.next_replay = venue.replay->next();
+  }
+
+  schedule_replay(venue);
+}
+
+void TradingSimulator::ensure_replay_account(int account_id) {
+  if (!position_manager_.has_account(account_id)) {
+    position_manager_.create_account(
+        account_id,
+        "Replay " + std::to_string(account_id - REPLAY_ACCOUNT_BASE), 1e12);
+  }
+}
+
+TradingSimulator::Venue &TradingSimulator::venue(const std::string &symbol) {
+  auto it = venue_by_symbol_.find(symbol);
+  if (it == venue_by_symbol_.end()) {
+    throw std::runtime_error("Symbol " + symbol + " is not hosted");
+  }
+  return *venues_[it->second];
+}
+
+size_t TradingSimulator::route(const Strategy &strategy,
+                               InstrumentId instrument) {
+  auto &routes = routes_[&strategy];
+  if (instrument < routes.size() && routes[instrument] != NO_VENUE) {
+    return routes[instrument];
+  }
+
+  if (instrument >= routes.size()) {
+    routes.resize(instrument + 1, NO_VENUE);
+  }
+  auto it = venue_by_symbol_.find(strategy.symbol_of(instrument));
+  if (it != venue_by_symbol_.end()) {
+    routes[instrument] = it->second;
+  }
+  return routes[instrument];
 }
 
 void TradingSimulator::add_strategy(std::unique_ptr<Strategy> strategy) {
@@ -39,6 +269,28 @@ void TradingSimulator::add_strategy(std::unique_ptr<Strategy> strategy) {
                              " must be created before adding strategy");
   }
 
+  int account_id = strategy->get_account_id();
+  if (!strategy_by_account_.emplace(account_id, strategy.get()).second) {
+    throw std::runtime_error("Account " + std::to_string(account_id) +
+                             " already has a strategy attached");
+  }
+
+  // Every traded symbol gets a book (without generated flow)
+  for (const auto &symbol : strategy->get_config().symbols) {
+    add_instrument(symbol);
+  }
+  subscriptions_.add_strategy(strategy.get());
+  strategy->set_clock(clock_);
+
+  for (size_t i = 0; i < LATENCY_PATH_COUNT; ++i) {
+    auto path = static_cast<LatencyPath>(i);
+    if (auto model = make_latency_model(strategy->get_config(), path)) {
+      LatencyLink &link = latency_links_[strategy.get()];
+      link.strategy = strategy.get();
+      link.models[i] = std::move(model);
+    }
+  }
+
   strategies_.push_back(std::move(strategy));
 }
 
@@ -47,6 +299,35 @@ void TradingSimulator::create_account(int account_id, const std::string &name,
   position_manager_.create_account(account_id, name, initial_cash);
 }
 
+void TradingSimulator::set_step_interval(Duration interval) {
+  if (interval <= Duration::zero()) {
+    throw std::runtime_error("Step interval must be positive");
+  }
+  step_interval_ = interval;
+}
+
+void TradingSimulator::set_timer_interval(Duration interval) {
+  if (interval < Duration::zero()) {
+    throw std::runtime_error("Timer interval cannot be negative");
+  }
+  timer_interval_ = interval;
+}
+
+void TradingSimulator::set_worker_threads(size_t threads) {
+  if (threads <= 1) {
+    workers_.reset();
+  } else {
+    workers_ = std::make_unique<WorkerPool>(threads);
+  }
+}
+
+void TradingSimulator::set_bar_interval(size_t steps) {
+  if (steps == 0) {
+    throw std::runtime_error("Bar interval must be at least one step");
+  }
+  bar_interval_ = steps;
+}
+
 void TradingSimulator::run_simulation(size_t num_steps) {
   std::cout << "\n╔═══════════════════════════════════════════════════════╗"
             << std::endl;
@@ -62,35 +343,181 @@ void TradingSimulator::run_simulation(size_t num_steps) {
 
   is_running_ = true;
 
-  // Main simulation loop
-  for (size_t step = 0; step < num_steps && is_running_; ++step) {
-    process_step();
-
-    // Progress reporting
-    if ((step + 1) % 100 == 0 || step == num_steps - 1) {
-      std::cout << "\rProgress: " << (step + 1) << "/" << num_steps << " ("
-                << std::fixed << std::setprecision(1)
-                << ((step + 1) * 100.0 / num_steps) << "%)" << std::flush;
-    }
+  // Steps, timers and any externally scheduled events all run off the one
+  // queue; the clock jumps straight from each event to the next
+  TimePoint end = clock_.now() + step_interval_ * num_steps;
+  if (num_steps > 0) {
+    schedule_step(0, num_steps);
+  }
+  schedule_timers();
+  scheduler_.run_until(end);
+  is_running_ = false;
+  // The timer chain re-arms itself past `end`; drop it so the next run
+  // starts a single fresh chain
+  if (timer_event_ != 0) {
+    scheduler_.cancel(timer_event_);
+    timer_event_ = 0;
   }
+  prune_finished_orders();
 
   std::cout << "\n\n✓ Simulation complete!" << std::endl;
 
-  // Process any final fills
-  process_fills();
-
   print_final_report();
 }
 
+void TradingSimulator::schedule_step(size_t step, size_t num_steps) {
+  scheduler_.schedule_after(
+      step_interval_, SimEventType::MARKET_DATA, [this, step, num_steps] {
+        if (!is_running_) {
+          return;
+        }
+
+        process_step();
+
+        // Progress reporting
+        if ((step + 1) % 100 == 0 || step == num_steps - 1) {
+          std::cout << "\rProgress: " << (step + 1) << "/" << num_steps
+                    << " (" << std::fixed << std::setprecision(1)
+                    << ((step + 1) * 100.0 / num_steps) << "%)" << std::flush;
+        }
+
+        if (step + 1 < num_steps) {
+          schedule_step(step + 1, num_steps);
+        }
+      });
+}
+
+void TradingSimulator::schedule_timers() {
+  if (timer_interval_ == Duration::zero()) {
+    return; // Timers run inside process_step()
+  }
+
+  timer_event_ = scheduler_.schedule_after(
+      timer_interval_, SimEventType::TIMER, [this] {
+        if (!is_running_) {
+          return;
+        }
+        run_timers();
+        schedule_timers();
+      });
+}
+
+void TradingSimulator::run_timers() {
+  for (auto &strategy : strategies_) {
+    strategy->on_timer();
+    drain_wakeups(*strategy);
+  }
+}
+
+EventScheduler::EventId TradingSimulator::schedule_order(const Order &order,
+                                                         TimePoint at) {
+  return schedule_order(venues_.front()->book.get_symbol(), order, at);
+}
+
+EventScheduler::EventId
+TradingSimulator::schedule_order(const std::string &symbol, const Order &order,
+                                 TimePoint at) {
+  OrderBook *book = &venue(symbol).book;
+  return scheduler_.schedule_at(at, SimEventType::ORDER_ARRIVAL,
+                                [book, order] { book->add_order(order); });
+}
+
+EventScheduler::EventId TradingSimulator::schedule_wakeup(Strategy &strategy,
+                                                          Duration delay,
+                                                          std::uint64_t token) {
+  Strategy *target = &strategy;
+  return scheduler_.schedule_after(delay, SimEventType::STRATEGY_WAKEUP,
+                                   [this, target, token] {
+                                     target->on_wakeup(token);
+                                     drain_wakeups(*target);
+                                   });
+}
+
+void TradingSimulator::drain_wakeups(Strategy &strategy) {
+  auto &requests = strategy.pending_wakeups();
+  for (size_t i = 0; i < requests.size(); ++i) {
+    schedule_wakeup(strategy, requests[i].delay, requests[i].token);
+  }
+  requests.clear();
+}
+
 void TradingSimulator::process_step() {
-  // 1. Update market data for all strategies
-  MarketDataSnapshot snapshot;
-  snapshot.symbol = order_book_.get_symbol();
-  snapshot.timestamp = Clock::now();
+  if (shocks_) {
+    shocks_->next(shock_buffer_.data());
+    for (size_t i = 0; i < correlated_venues_.size(); ++i) {
+      venues_[correlated_venues_[i]]->shock = shock_buffer_[i];
+    }
+  }
+
+  // 1. Advance every venue on its own (generated flow, top of book). Venues
+  // share nothing here, so with workers they run in parallel.
+  if (workers_ && venues_.size() > 1) {
+    workers_->parallel_for(venues_.size(),
+                           [this](size_t i) { advance_venue(*venues_[i]); });
+  } else {
+    for (auto &venue : venues_) {
+      advance_venue(*venue);
+    }
+  }
+
+  // 2. Synchronization point. Everything above happened at the same
+  // virtual time, so merge in venue order: results do not depend on the
+  // number of threads.
+  for (auto &venue : venues_) {
+    for (const auto &fill : venue->deferred_fills) {
+      dispatch_fill(*venue, fill);
+    }
+    venue->deferred_fills.clear();
+    publish(*venue, venue->bbo);
+  }
+
+  // 3. Collect orders from each strategy. Strategies whose market data is
+  // delayed react when it reaches them instead (release_market_data()).
+  for (auto &strategy : strategies_) {
+    LatencyLink *link = find_link(strategy.get());
+    if (link && link->model(LatencyPath::MARKET_DATA)) {
+      continue;
+    }
+    submit_orders(*strategy);
+  }
+
+  // 4. Publish this step's executions, then close bars that are due
+  for (auto &venue : venues_) {
+    publish_trades(*venue);
+    update_bar(*venue);
+  }
+
+  // 5. Call timer callbacks (unless they run on their own interval)
+  if (timer_interval_ == Duration::zero()) {
+    run_timers();
+  } else {
+    for (auto &strategy : strategies_) {
+      drain_wakeups(*strategy);
+    }
+  }
+}
 
-  // Get current market state
-  auto best_bid = order_book_.get_best_bid();
-  auto best_ask = order_book_.get_best_ask();
+void TradingSimulator::advance_venue(Venue &venue) {
+  if (venue.generator) {
+    venue.defer_fills = true;
+    if (venue.correlated) {
+      venue.generator->step_with_shock(venue.shock, &venue.book,
+                                       venue.market_order_probability);
+    } else {
+      venue.generator->step(&venue.book, venue.market_order_probability);
+    }
+    venue.defer_fills = false;
+  }
+
+  MarketDataSnapshot &snapshot = venue.bbo;
+  snapshot.type = MarketDataType::BBO;
+  snapshot.timestamp = clock_.now();
+  snapshot.bid_price = snapshot.bid_size = 0.0;
+  snapshot.ask_price = snapshot.ask_size = 0.0;
+  snapshot.last_price = 0.0;
+
+  auto best_bid = venue.book.get_best_bid();
+  auto best_ask = venue.book.get_best_ask();
 
   if (best_bid) {
     snapshot.bid_price = best_bid->price;
@@ -106,60 +533,328 @@ void TradingSimulator::process_step() {
     snapshot.last_price = (best_bid->price + best_ask->price) / 2.0;
   }
 
-  auto spread = order_book_.get_spread();
-  snapshot.spread = spread.value_or(0.0);
+  snapshot.spread = venue.book.get_spread().value_or(0.0);
+}
 
-  // 2. Notify all strategies of market data
-  for (auto &strategy : strategies_) {
-    strategy->on_market_data(snapshot);
+int TradingSimulator::allocate_order_id() {
+  if (next_order_id_ > std::numeric_limits<int>::max()) {
+    throw std::runtime_error("Strategy order IDs exhausted after " +
+                             std::to_string(next_order_id_ -
+                                            STRATEGY_ORDER_ID_BASE) +
+                             " orders");
+  }
+  return static_cast<int>(next_order_id_++);
+}
+
+void TradingSimulator::submit_orders(Strategy &strategy) {
+  if (!strategy.is_enabled()) {
+    return;
   }
 
-  // 3. Generate signals from each strategy
-  for (auto &strategy : strategies_) {
-    if (!strategy->is_enabled())
-      continue;
+  LatencyLink *link = find_link(&strategy);
+  LatencyModel *model = link ? link->model(LatencyPath::ORDER_ENTRY) : nullptr;
+
+  submission_buffer_.clear();
+  strategy.emit_orders(submission_buffer_);
+
+  // Orders go out under simulator-wide IDs, keeping the strategy's
+  // pending-order tracking in sync
+  for (auto &order : submission_buffer_) {
+    int strategy_order_id = order.id;
+    order.id = allocate_order_id();
+    strategy.retag_order(strategy_order_id, order.id);
+
+    OrderEntry entry(order);
+    if (model) {
+      TimePoint due = clock_.now() + model->sample(link->orders.size());
+      if (link->orders.push(due, std::move(entry))) {
+        release_orders(*link);
+      }
+    } else {
+      enter_order(strategy, entry); // Fills dispatch via the router callback
+    }
+  }
+
+  // Two-sided quotes replace the strategy's previous ones in one call
+  quote_buffer_.clear();
+  strategy.generate_quotes(quote_buffer_);
 
-    auto signals = strategy->generate_signals();
-    auto orders = strategy->signals_to_orders(signals);
+  for (auto &quote : quote_buffer_) {
+    quote.account_id = strategy.get_account_id();
+    quote.new_bid_id = allocate_order_id();
+    quote.new_ask_id = allocate_order_id();
 
-    // Submit orders to order book
-    for (auto &order : orders) {
-      order.id = next_order_id_++;
-      order_book_.add_order(order);
+    OrderEntry entry(quote);
+    if (model) {
+      TimePoint due = clock_.now() + model->sample(link->orders.size());
+      if (link->orders.push(due, std::move(entry))) {
+        release_orders(*link);
+      }
+    } else {
+      enter_order(strategy, entry);
     }
   }
+}
 
-  // 4. Process any fills that occurred
-  process_fills();
+void TradingSimulator::enter_order(Strategy &strategy, OrderEntry &entry) {
+  if (auto *order = std::get_if<Order>(&entry)) {
+    size_t index = route(strategy, order->instrument);
+    if (index == NO_VENUE) {
+      ++unrouted_orders_; // Symbol not hosted by this simulator
+      strategy.remove_order(order->id);
+      return;
+    }
+    OrderBook &book = venues_[index]->book;
+    book.add_order(*order);
+    // Filled, killed (IOC / FOK / market remainder) or rejected on arrival:
+    // nothing rests, so the strategy stops tracking it
+    if (!order_is_live(book, order->id)) {
+      strategy.remove_order(order->id);
+    }
+  } else {
+    auto &quote = std::get<MassQuote>(entry);
+    size_t index = route(strategy, quote.instrument);
+    if (index == NO_VENUE) {
+      ++unrouted_orders_;
+      return;
+    }
+    OrderBook &book = venues_[index]->book;
+    strategy.on_quote_result(quote, book.mass_quote(quote));
+  }
+}
 
-  // 5. Call timer callbacks
+void TradingSimulator::prune_finished_orders() {
   for (auto &strategy : strategies_) {
-    strategy->on_timer();
+    const auto &pending = strategy->pending_orders();
+    // remove_order() swaps in the last entry, so walk backwards
+    for (size_t i = pending.size(); i-- > 0;) {
+      const Order &order = pending[i];
+      size_t index = route(*strategy, order.instrument);
+      if (index == NO_VENUE || !order_is_live(venues_[index]->book, order.id)) {
+        strategy->remove_order(order.id);
+      }
+    }
   }
 }
 
-void TradingSimulator::process_fills() {
-  const auto &account_fills = order_book_.get_account_fills();
-  static size_t last_processed = 0;
+TradingSimulator::LatencyLink *
+TradingSimulator::find_link(const Strategy *strategy) {
+  if (latency_links_.empty()) {
+    return nullptr;
+  }
+  auto it = latency_links_.find(strategy);
+  return it == latency_links_.end() ? nullptr : &it->second;
+}
 
-  // Process only new fills
-  for (size_t i = last_processed; i < account_fills.size(); ++i) {
-    const auto &af = account_fills[i];
+TradingSimulator::LatencyLink &
+TradingSimulator::link_for_account(int account_id) {
+  auto it = strategy_by_account_.find(account_id);
+  if (it == strategy_by_account_.end()) {
+    throw std::runtime_error("Account " + std::to_string(account_id) +
+                             " has no strategy attached");
+  }
+  LatencyLink &link = latency_links_[it->second];
+  link.strategy = it->second;
+  return link;
+}
 
-    // Route fill to position manager
-    position_manager_.process_fill(af.fill, af.buy_account_id,
-                                   af.sell_account_id, af.symbol);
+void TradingSimulator::set_latency_model(int account_id, LatencyPath path,
+                                         std::unique_ptr<LatencyModel> model) {
+  link_for_account(account_id).models[static_cast<size_t>(path)] =
+      std::move(model);
+}
 
-    // Notify strategies
-    for (auto &strategy : strategies_) {
-      if (strategy->get_account_id() == af.buy_account_id ||
-          strategy->get_account_id() == af.sell_account_id) {
-        strategy->on_fill(af.fill);
-      }
+size_t TradingSimulator::in_flight(int account_id, LatencyPath path) {
+  LatencyLink &link = link_for_account(account_id);
+  switch (path) {
+  case LatencyPath::MARKET_DATA:
+    return link.market_data.size();
+  case LatencyPath::ORDER_ENTRY:
+    return link.orders.size();
+  case LatencyPath::FILL_NOTIFICATION:
+    return link.fills.size();
+  }
+  return 0;
+}
+
+// Each release_* is called once when its queue goes from empty to
+// non-empty: it schedules a single event for the head message, which
+// delivers everything then due and re-arms for the next head. The
+// captures (two pointers) fit std::function's inline buffer, so a release
+// event costs no allocation.
+void TradingSimulator::release_market_data(LatencyLink &link) {
+  LatencyLink *target = &link;
+  scheduler_.schedule_at(
+      link.market_data.next_due(), SimEventType::MARKET_DATA,
+      [this, target] {
+        Strategy &strategy = *target->strategy;
+        target->market_data.release(
+            clock_.now(), [&strategy](const MarketDataSnapshot &update) {
+              strategy.on_market_data(update);
+            });
+        submit_orders(strategy); // React on arrival
+        if (!target->market_data.empty()) {
+          release_market_data(*target);
+        }
+      });
+}
+
+void TradingSimulator::release_orders(LatencyLink &link) {
+  LatencyLink *target = &link;
+  scheduler_.schedule_at(link.orders.next_due(), SimEventType::ORDER_ARRIVAL,
+                         [this, target] {
+                           Strategy &strategy = *target->strategy;
+                           target->orders.release(
+                               clock_.now(), [&](OrderEntry &entry) {
+                                 enter_order(strategy, entry);
+                               });
+                           if (!target->orders.empty()) {
+                             release_orders(*target);
+                           }
+                         });
+}
+
+void TradingSimulator::release_fills(LatencyLink &link) {
+  LatencyLink *target = &link;
+  scheduler_.schedule_at(
+      link.fills.next_due(), SimEventType::FILL_NOTIFICATION, [this, target] {
+        Strategy &strategy = *target->strategy;
+        target->fills.release(clock_.now(), [&strategy](FillNotice &notice) {
+          strategy.on_execution(notice.fill, notice.context);
+        });
+        if (!target->fills.empty()) {
+          release_fills(*target);
+        }
+      });
+}
+
+void TradingSimulator::publish(const Venue &venue,
+                               const MarketDataSnapshot &update) {
+  if (latency_links_.empty()) {
+    subscriptions_.publish(venue.feed, update);
+    return;
+  }
+
+  subscriptions_.publish(
+      venue.feed, update,
+      [this](Strategy *strategy, const MarketDataSnapshot &snapshot) {
+        LatencyLink *link = find_link(strategy);
+        LatencyModel *model =
+            link ? link->model(LatencyPath::MARKET_DATA) : nullptr;
+        if (!model) {
+          strategy->on_market_data(snapshot);
+          return;
+        }
+        TimePoint due = clock_.now() + model->sample(link->market_data.size());
+        if (link->market_data.push(due, snapshot)) {
+          release_market_data(*link);
+        }
+      });
+}
+
+void TradingSimulator::publish_trades(Venue &venue) {
+  for (const auto &print : venue.trade_prints) {
+    venue.bar.add(print.price);
+    venue.bar.volume += print.quantity;
+  }
+
+  if (subscriptions_.has_subscribers(venue.feed, MarketDataType::TRADES)) {
+    update_.symbol = venue.book.get_symbol();
+    update_.type = MarketDataType::TRADES;
+    for (const auto &print : venue.trade_prints) {
+      update_.last_price = print.price;
+      update_.last_size = print.quantity;
+      update_.timestamp = print.timestamp;
+      publish(venue, update_);
     }
   }
 
-  last_processed = account_fills.size();
+  venue.trade_prints.clear();
+}
+
+void TradingSimulator::update_bar(Venue &venue) {
+  BarState &bar = venue.bar;
+  if (venue.bbo.last_price > 0.0) {
+    bar.add(venue.bbo.last_price);
+  }
+
+  if (++bar.steps < bar_interval_) {
+    return;
+  }
+
+  if (bar.open != 0.0 &&
+      subscriptions_.has_subscribers(venue.feed, MarketDataType::BARS)) {
+    update_.symbol = venue.book.get_symbol();
+    update_.type = MarketDataType::BARS;
+    update_.open_price = bar.open;
+    update_.high_price = bar.high;
+    update_.low_price = bar.low;
+    update_.last_price = bar.close;
+    update_.last_size = bar.volume;
+    update_.timestamp = venue.bbo.timestamp;
+    publish(venue, update_);
+  }
+
+  bar = BarState();
+}
+
+void TradingSimulator::dispatch_fill(Venue &venue, const EnhancedFill &fill) {
+  venue.trade_prints.push_back({fill.base_fill.price,
+                                static_cast<double>(fill.base_fill.quantity),
+                                clock_.now()});
+
+  // Replayed flow trading with itself only moves the mark; anything else
+  // is booked, with a replayed counterparty getting an account on demand
+  bool buy_replay = is_replay_account(fill.buy_account_id);
+  bool sell_replay = is_replay_account(fill.sell_account_id);
+  if (buy_replay && sell_replay) {
+    ++background_fills_;
+    position_manager_.update_price(fill.symbol, fill.base_fill.price);
+    return;
+  }
+  if (buy_replay) {
+    ensure_replay_account(fill.buy_account_id);
+  }
+  if (sell_replay) {
+    ensure_replay_account(fill.sell_account_id);
+  }
+
+  position_manager_.process_fill(fill.base_fill, fill.buy_account_id,
+                                 fill.sell_account_id, fill.symbol);
+
+  notify_strategy(fill, Side::BUY);
+  if (fill.sell_account_id != fill.buy_account_id) {
+    notify_strategy(fill, Side::SELL);
+  }
+}
+
+void TradingSimulator::notify_strategy(const EnhancedFill &fill, Side side) {
+  bool is_buy = (side == Side::BUY);
+  int account_id = is_buy ? fill.buy_account_id : fill.sell_account_id;
+
+  auto it = strategy_by_account_.find(account_id);
+  if (it == strategy_by_account_.end()) {
+    return; // Not a strategy account (e.g. generated liquidity)
+  }
+
+  FillContext context(
+      is_buy ? fill.base_fill.buy_order_id : fill.base_fill.sell_order_id,
+      side, fill.symbol, is_buy != fill.is_aggressive_buy,
+      is_buy ? fill.buyer_fee : fill.seller_fee);
+
+  LatencyLink *link = find_link(it->second);
+  LatencyModel *model =
+      link ? link->model(LatencyPath::FILL_NOTIFICATION) : nullptr;
+  if (!model) {
+    it->second->on_execution(fill.base_fill, context);
+    return;
+  }
+
+  // Positions are already booked; only the strategy hears about it late
+  TimePoint due = clock_.now() + model->sample(link->fills.size());
+  if (link->fills.push(due, FillNotice{fill.base_fill, std::move(context)})) {
+    release_fills(*link);
+  }
 }
 
 void TradingSimulator::print_final_report() {
@@ -172,7 +867,11 @@ void TradingSimulator::print_final_report() {
 
   // Order book statistics
   std::cout << "\n=== Order Book Statistics ===" << std::endl;
-  order_book_.print_match_stats();
+  size_t total_fills = 0;
+  for (const auto &venue : venues_) {
+    venue->book.print_match_stats();
+    total_fills += venue->book.get_fills().size();
+  }
 
   // Strategy performance
   std::cout << "\n=== Strategy Performance ===" << std::endl;
@@ -186,7 +885,15 @@ void TradingSimulator::print_final_report() {
 
   // Overall metrics
   std::cout << "\n=== Aggregate Metrics ===" << std::endl;
-  std::cout << "Total Fills: " << order_book_.get_fills().size() << std::endl;
+  std::cout << "Total Fills: " << total_fills << std::endl;
+  if (background_fills_ > 0) {
+    std::cout << "Replayed Background Fills: " << background_fills_
+              << std::endl;
+  }
+  if (unrouted_orders_ > 0) {
+    std::cout << "Unrouted Orders: " << unrouted_orders_
+              << " (symbols not hosted)" << std::endl;
+  }
   std::cout << "Total Account Value: $" << std::fixed << std::setprecision(2)
             << position_manager_.get_total_account_value() << std::endl;
   std::cout << "Total P&L: $" << position_manager_.get_total_pnl() << std::endl;
@@ -0,0 +1,93 @@
+#include "tsc_clock.hpp"
+
+#include <cmath>
+
+#if TSC_CLOCK_X86
+#include <cpuid.h>
+#endif
+
+namespace {
+
+constexpr std::chrono::milliseconds kCalibrationWindow{2};
+constexpr int kSampleAttempts = 5;
+
+// Calibrate before main(), not inside the first timed region
+[[maybe_unused]] const bool kCalibratedAtStartup = (TscClock::init(), true);
+
+} // namespace
+
+TscClock::State::State()
+    : use_tsc(false), ns_per_tick(1.0), base_ticks(0), base_ns(0) {
+  if (!tsc_is_invariant()) {
+    return;
+  }
+  use_tsc = true;
+  sample(base_ticks, base_ns);
+
+  // Spin rather than sleep: the scheduler only has to keep us on one core
+  // for the window, and the pair is read at its end either way
+  auto until = std::chrono::steady_clock::now() + kCalibrationWindow;
+  while (std::chrono::steady_clock::now() < until) {
+  }
+
+  std::uint64_t ticks = 0;
+  std::int64_t ns = 0;
+  sample(ticks, ns);
+  double rate = static_cast<double>(ns - base_ns) /
+                static_cast<double>(ticks - base_ticks);
+  if (ticks <= base_ticks || !std::isfinite(rate) || rate <= 0.0) {
+    use_tsc = false; // Counter not usable after all
+    return;
+  }
+  ns_per_tick.store(rate, std::memory_order_relaxed);
+}
+
+void TscClock::recalibrate() {
+  State &s = state();
+  if (!s.use_tsc) {
+    return;
+  }
+  std::uint64_t ticks = 0;
+  std::int64_t ns = 0;
+  sample(ticks, ns);
+  if (ticks <= s.base_ticks || ns <= s.base_ns) {
+    return;
+  }
+  s.ns_per_tick.store(static_cast<double>(ns - s.base_ns) /
+                          static_cast<double>(ticks - s.base_ticks),
+                      std::memory_order_relaxed);
+}
+
+bool TscClock::tsc_is_invariant() {
+#if TSC_CLOCK_X86
+  // CPUID 0x80000007: EDX bit 8 = invariant TSC
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  return (edx & (1u << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+void TscClock::sample(std::uint64_t &ticks, std::int64_t &ns) {
+  // Keep the tightest steady_clock bracket around a counter read and
+  // credit the counter with its midpoint
+  std::int64_t best_gap = INT64_MAX;
+  for (int attempt = 0; attempt < kSampleAttempts; ++attempt) {
+    auto before = static_cast<std::int64_t>(steady_ns());
+#if TSC_CLOCK_X86
+    unsigned aux;
+    std::uint64_t t = __rdtscp(&aux);
+#else
+    std::uint64_t t = steady_ns();
+#endif
+    auto after = static_cast<std::int64_t>(steady_ns());
+    if (after - before < best_gap) {
+      best_gap = after - before;
+      ticks = t;
+      ns = before + (after - before) / 2;
+    }
+  }
+}
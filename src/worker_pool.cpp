@@ -0,0 +1,99 @@
+#include "worker_pool.hpp"
+
+WorkerPool::WorkerPool(std::size_t threads)
+    : task_(nullptr), task_count_(0), next_index_(0), active_workers_(0),
+      generation_(0), stopping_(false) {
+  for (std::size_t i = 1; i < threads; ++i) {
+    threads_.emplace_back([this] { worker_loop(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::work(const Task &task, std::size_t count) {
+  for (;;) {
+    std::size_t i = next_index_.fetch_add(1, std::memory_order_relaxed);
+    if (i >= count) {
+      return;
+    }
+    try {
+      task(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+      next_index_.store(count, std::memory_order_relaxed); // Stop early
+    }
+  }
+}
+
+void WorkerPool::worker_loop() {
+  std::uint64_t seen = 0;
+  for (;;) {
+    const Task *task;
+    std::size_t count;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+      if (stopping_) {
+        return;
+      }
+      seen = generation_;
+      task = task_;
+      count = task_count_;
+    }
+
+    work(*task, count);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--active_workers_ == 0) {
+      done_cv_.notify_one();
+    }
+  }
+}
+
+void WorkerPool::parallel_for(std::size_t count, const Task &task) {
+  if (count == 0) {
+    return;
+  }
+  if (threads_.empty() || count == 1) {
+    for (std::size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    task_count_ = count;
+    next_index_.store(0, std::memory_order_relaxed);
+    active_workers_ = threads_.size();
+    error_ = nullptr;
+    ++generation_;
+  }
+  start_cv_.notify_all();
+
+  work(task, count);
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [&] { return active_workers_ == 0; });
+    task_ = nullptr;
+    error = error_;
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
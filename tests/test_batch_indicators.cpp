@@ -0,0 +1,233 @@
+#include "batch_indicators.hpp"
+#include "price_history.hpp"
+#include "strategies.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+class IndicatorProbe : public Strategy {
+public:
+  IndicatorProbe() : Strategy(StrategyConfig()) {}
+
+  void on_market_data(const MarketDataSnapshot &) override {}
+  void on_fill(const Fill &) override {}
+  void generate_signals(std::vector<TradingSignal> &) override {}
+
+  using Strategy::calculate_ema;
+  using Strategy::calculate_momentum;
+  using Strategy::calculate_sma;
+  using Strategy::calculate_stddev;
+};
+
+std::vector<double> random_walk(std::size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> noise(0.0, 0.5);
+  std::vector<double> prices;
+  double price = 100.0;
+  for (std::size_t i = 0; i < n; ++i) {
+    price = std::max(0.01, price + noise(rng));
+    prices.push_back(price);
+  }
+  return prices;
+}
+
+// Feeds prices through a streaming strategy one tick at a time, assuming
+// each signal fills immediately, and records the decision per tick.
+std::vector<SignalType> stream_signals(Strategy &strategy,
+                                       const std::vector<double> &prices) {
+  std::vector<SignalType> decisions;
+  std::vector<TradingSignal> signals;
+  strategy.initialize();
+
+  for (double price : prices) {
+    MarketDataSnapshot snapshot;
+    snapshot.symbol = "SYM";
+    snapshot.last_price = price;
+    strategy.on_market_data(snapshot);
+
+    SignalType decision = SignalType::HOLD;
+    signals.clear();
+    strategy.generate_signals(signals);
+    for (const auto &signal : signals) {
+      decision = signal.type;
+      int position = strategy.get_position("SYM");
+      if (signal.is_buy()) {
+        strategy.update_position("SYM", position + signal.suggested_quantity);
+      } else if (signal.is_sell()) {
+        strategy.update_position("SYM", position - signal.suggested_quantity);
+      } else if (signal.is_close()) {
+        strategy.update_position("SYM", 0);
+      }
+    }
+    decisions.push_back(decision);
+  }
+
+  return decisions;
+}
+
+class BatchIndicatorsTest : public ::testing::TestWithParam<SimdLevel> {
+protected:
+  void SetUp() override {
+    previous_ = batch_simd_level();
+    set_batch_simd_level(GetParam());
+  }
+  void TearDown() override { set_batch_simd_level(previous_); }
+
+  SimdLevel previous_ = SimdLevel::SCALAR;
+};
+
+} // namespace
+
+TEST_P(BatchIndicatorsTest, MatchesScalarHelpers) {
+  const std::size_t n = 3003; // Not a multiple of the vector width
+  const std::size_t period = 20;
+  auto prices = random_walk(n, 3);
+
+  std::vector<double> sma(n), stddev(n), momentum(n), high(n), low(n);
+  batch_sma(prices.data(), n, period, sma.data());
+  batch_stddev(prices.data(), n, period, stddev.data());
+  batch_momentum(prices.data(), n, period, momentum.data());
+  batch_channel(prices.data(), n, period, high.data(), low.data());
+
+  IndicatorProbe probe;
+  PriceHistoryStore store(n);
+  InstrumentId id = store.intern("SYM");
+
+  for (std::size_t i = 0; i < n; ++i) {
+    store.push(id, prices[i]);
+    PriceWindow window = store.window(id);
+
+    EXPECT_NEAR(sma[i], probe.calculate_sma(window, period), 1e-9);
+    EXPECT_NEAR(stddev[i], probe.calculate_stddev(window, period), 1e-9);
+    EXPECT_NEAR(momentum[i], probe.calculate_momentum(window, period), 1e-9);
+
+    if (i + 1 >= period) {
+      PriceWindow tail = window.tail(period);
+      double expected_high = tail[0];
+      double expected_low = tail[0];
+      for (double p : tail) {
+        expected_high = std::max(expected_high, p);
+        expected_low = std::min(expected_low, p);
+      }
+      EXPECT_EQ(high[i], expected_high);
+      EXPECT_EQ(low[i], expected_low);
+    }
+  }
+}
+
+TEST_P(BatchIndicatorsTest, EmaMatchesScalarHelper) {
+  const std::size_t n = 2000;
+  auto prices = random_walk(n, 5);
+
+  std::vector<double> ema(n);
+  batch_ema(prices.data(), n, 12, ema.data());
+
+  IndicatorProbe probe;
+  PriceHistoryStore store(n);
+  InstrumentId id = store.intern("SYM");
+  for (std::size_t i = 0; i < n; ++i) {
+    store.push(id, prices[i]);
+    EXPECT_NEAR(ema[i], probe.calculate_ema(store.window(id), 12), 1e-9);
+  }
+}
+
+TEST_P(BatchIndicatorsTest, SlidingWindowsStayAccurateOverLongSeries) {
+  // Far more outputs than one resync interval, at a price level where
+  // naive sums of squares would cancel
+  const std::size_t n = 200000;
+  const std::size_t period = 50;
+  auto prices = random_walk(n, 21);
+  for (double &p : prices) {
+    p += 10000.0;
+  }
+
+  std::vector<double> sma(n), stddev(n), high(n), low(n);
+  batch_sma(prices.data(), n, period, sma.data());
+  batch_stddev(prices.data(), n, period, stddev.data());
+  batch_channel(prices.data(), n, period, high.data(), low.data());
+
+  IndicatorProbe probe;
+  PriceHistoryStore store(period);
+  InstrumentId id = store.intern("SYM");
+  for (std::size_t i = 0; i < n; ++i) {
+    store.push(id, prices[i]);
+    if (i % 997 != 0 && i + 1 != n) {
+      continue;
+    }
+    PriceWindow window = store.window(id);
+    EXPECT_NEAR(sma[i], probe.calculate_sma(window, period), 1e-9);
+    EXPECT_NEAR(stddev[i], probe.calculate_stddev(window, period), 1e-9);
+    if (i + 1 >= period) {
+      PriceWindow tail = window.tail(period);
+      double expected_high = tail[0];
+      double expected_low = tail[0];
+      for (double p : tail) {
+        expected_high = std::max(expected_high, p);
+        expected_low = std::min(expected_low, p);
+      }
+      EXPECT_EQ(high[i], expected_high);
+      EXPECT_EQ(low[i], expected_low);
+    }
+  }
+}
+
+TEST_P(BatchIndicatorsTest, MeanReversionSignalsMatchStreamingStrategy) {
+  auto prices = random_walk(4000, 9);
+
+  StrategyConfig config;
+  config.name = "MR";
+  config.symbols = {"SYM"};
+  config.set_parameter("lookback_period", 20.0);
+  config.set_parameter("entry_std_devs", 1.5);
+  config.set_parameter("exit_std_devs", 0.25);
+  MeanReversionStrategy strategy(config);
+
+  MeanReversionSignalParams params;
+  params.lookback_period = 20;
+  params.entry_std_devs = 1.5;
+  params.exit_std_devs = 0.25;
+
+  auto streamed = stream_signals(strategy, prices);
+  auto batched = batch_mean_reversion_signals(prices, params);
+  EXPECT_EQ(batched, streamed);
+  EXPECT_GT(std::count(batched.begin(), batched.end(), SignalType::BUY), 0);
+}
+
+TEST_P(BatchIndicatorsTest, MomentumSignalsMatchStreamingStrategy) {
+  auto prices = random_walk(4000, 13);
+
+  // Take-profit / stop-loss depend on fill prices the streaming strategy
+  // only learns through on_fill, so compare the momentum rules alone.
+  StrategyConfig config;
+  config.name = "MOM";
+  config.symbols = {"SYM"};
+  config.set_parameter("lookback_period", 10.0);
+  config.set_parameter("entry_threshold", 1.0);
+  config.set_parameter("exit_threshold", -0.2);
+  config.set_parameter("take_profit", 1e9);
+  config.set_parameter("stop_loss", 1e9);
+  MomentumStrategy strategy(config);
+
+  MomentumSignalParams params;
+  params.lookback_period = 10;
+  params.entry_threshold = 1.0;
+  params.exit_threshold = -0.2;
+  params.take_profit = 1e9;
+  params.stop_loss = 1e9;
+
+  auto streamed = stream_signals(strategy, prices);
+  auto batched = batch_momentum_signals(prices, params);
+  EXPECT_EQ(batched, streamed);
+  EXPECT_GT(std::count(batched.begin(), batched.end(), SignalType::SELL), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(SimdLevels, BatchIndicatorsTest,
+                         ::testing::Values(SimdLevel::SCALAR,
+                                           SimdLevel::AVX2),
+                         [](const auto &info) {
+                           return std::string(
+                               simd_level_to_string(info.param));
+                         });
@@ -0,0 +1,196 @@
+#include "bootstrap.hpp"
+#include "performance_metrics.hpp"
+#include "worker_pool.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// P&L path from `start` with iid normal changes
+std::vector<double> random_walk_pnl(std::size_t changes, double start,
+                                    double mean, double stddev,
+                                    unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> dist(mean, stddev);
+  std::vector<double> pnl(changes + 1, start);
+  for (std::size_t i = 1; i < pnl.size(); ++i) {
+    pnl[i] = pnl[i - 1] + dist(rng);
+  }
+  return pnl;
+}
+
+// AR(1) changes: strong serial correlation that iid resampling hides
+std::vector<double> ar1_pnl(std::size_t changes, double phi, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> noise(0.0, 1000.0);
+  std::vector<double> pnl(changes + 1, 1e6);
+  double previous = 0.0;
+  for (std::size_t i = 1; i < pnl.size(); ++i) {
+    previous = phi * previous + noise(rng);
+    pnl[i] = pnl[i - 1] + 50.0 + previous;
+  }
+  return pnl;
+}
+
+} // namespace
+
+TEST(BootstrapTest, StatsMatchDirectFormulas) {
+  // The 0 makes the following return undefined: 0 for Sharpe, skipped
+  // by Sortino
+  std::vector<double> pnl = {100.0, 110.0, 99.0, 120.0, 0.0, 30.0};
+  auto stats = compute_pnl_stats(pnl.data(), pnl.size());
+
+  std::vector<double> defined = {0.1, -0.1, 21.0 / 99.0, -1.0};
+  std::vector<double> sharpe_returns = defined;
+  sharpe_returns.push_back(0.0);
+
+  auto mean_of = [](const std::vector<double> &values) {
+    double sum = 0.0;
+    for (double v : values) {
+      sum += v;
+    }
+    return sum / static_cast<double>(values.size());
+  };
+  double mean = mean_of(sharpe_returns);
+  double variance = 0.0;
+  for (double r : sharpe_returns) {
+    variance += (r - mean) * (r - mean);
+  }
+  variance /= 5.0;
+  EXPECT_NEAR(stats.sharpe, mean / std::sqrt(variance) * std::sqrt(252.0),
+              1e-9);
+  double downside = std::sqrt((0.01 + 1.0) / 2.0);
+  EXPECT_NEAR(stats.sortino, mean_of(defined) / downside * std::sqrt(252.0),
+              1e-9);
+
+  // Peak 120 down to 0; the 10% dip from 110 is smaller
+  EXPECT_NEAR(stats.max_drawdown, 100.0, 1e-9);
+  EXPECT_NEAR(stats.total_return, -70.0, 1e-9);
+  EXPECT_NEAR(stats.calmar, -0.7, 1e-12);
+}
+
+TEST(BootstrapTest, EstimatesEqualPerformanceMetrics) {
+  // Crosses zero and sits on it, so every convention is exercised
+  auto pnl = random_walk_pnl(400, 500.0, 2.0, 60.0, 3);
+  pnl[200] = 0.0;
+  pnl[201] = 0.0;
+
+  PerformanceMetrics metrics;
+  for (std::size_t i = 0; i < pnl.size(); ++i) {
+    metrics.add_pnl_snapshot(TimePoint(std::chrono::seconds(i)), pnl[i]);
+  }
+  metrics.calculate({});
+
+  BootstrapConfig config;
+  config.resamples = 50;
+  auto report = metrics.bootstrap(config);
+  EXPECT_DOUBLE_EQ(report.sharpe.estimate, metrics.sharpe_ratio);
+  EXPECT_DOUBLE_EQ(report.sortino.estimate, metrics.get_sortino_ratio());
+  EXPECT_DOUBLE_EQ(report.max_drawdown.estimate, metrics.max_drawdown);
+  EXPECT_DOUBLE_EQ(report.total_return.estimate,
+                   metrics.get_return_percentage());
+  EXPECT_DOUBLE_EQ(report.calmar.estimate, metrics.get_calmar_ratio());
+  EXPECT_GT(metrics.max_drawdown, 0.0);
+}
+
+TEST(BootstrapTest, DeterministicAcrossThreadCounts) {
+  auto pnl = random_walk_pnl(1000, 1e6, 50.0, 1000.0, 5);
+  BootstrapConfig config;
+  config.resamples = 500;
+  config.block_length = 10;
+  config.resamples_per_task = 16;
+
+  auto serial = block_bootstrap(pnl, config);
+  WorkerPool pool(4);
+  auto parallel = block_bootstrap(pnl, config, &pool);
+
+  EXPECT_EQ(serial.sharpe.lower, parallel.sharpe.lower);
+  EXPECT_EQ(serial.sharpe.upper, parallel.sharpe.upper);
+  EXPECT_EQ(serial.max_drawdown.std_error, parallel.max_drawdown.std_error);
+  EXPECT_EQ(serial.total_return.mean, parallel.total_return.mean);
+
+  config.seed = 99;
+  auto reseeded = block_bootstrap(pnl, config, &pool);
+  EXPECT_NE(serial.sharpe.lower, reseeded.sharpe.lower);
+}
+
+TEST(BootstrapTest, IntervalsBracketEstimate) {
+  // Changes small against the level, so returns are close to iid
+  auto pnl = random_walk_pnl(2000, 1e6, 100.0, 1000.0, 11);
+  BootstrapConfig config;
+  config.resamples = 1000;
+  config.block_length = 1;
+  auto report = block_bootstrap(pnl, config);
+
+  for (const auto *interval : {&report.sharpe, &report.sortino,
+                               &report.max_drawdown, &report.total_return}) {
+    EXPECT_LT(interval->lower, interval->estimate);
+    EXPECT_GT(interval->upper, interval->estimate);
+    EXPECT_GT(interval->std_error, 0.0);
+  }
+
+  // iid Sharpe standard error ~ sqrt((1 + SR^2 / 2) / n), annualized
+  double period_sharpe = report.sharpe.estimate / std::sqrt(252.0);
+  double expected = std::sqrt((1.0 + period_sharpe * period_sharpe / 2.0) /
+                              2000.0) *
+                    std::sqrt(252.0);
+  EXPECT_NEAR(report.sharpe.std_error, expected, expected * 0.2);
+}
+
+TEST(BootstrapTest, BlocksWidenIntervalsForCorrelatedReturns) {
+  auto pnl = ar1_pnl(4000, 0.8, 17);
+  BootstrapConfig config;
+  config.resamples = 800;
+
+  config.block_length = 1;
+  auto iid = block_bootstrap(pnl, config);
+  config.block_length = 50;
+  auto blocked = block_bootstrap(pnl, config);
+
+  // Positive autocorrelation inflates the true sampling variance of the
+  // mean; only the block bootstrap sees it
+  EXPECT_GT(blocked.sharpe.std_error, iid.sharpe.std_error * 1.5);
+  EXPECT_EQ(blocked.block_length, 50u);
+}
+
+TEST(BootstrapTest, RejectsShortSeriesAndBadConfig) {
+  EXPECT_THROW(block_bootstrap({100.0, 101.0}), std::runtime_error);
+
+  BootstrapConfig config;
+  config.confidence = 1.0;
+  EXPECT_THROW(block_bootstrap({100.0, 101.0, 103.0, 102.0}, config),
+               std::runtime_error);
+
+  // Block longer than the series is clamped
+  config.confidence = 0.9;
+  config.block_length = 100;
+  auto report = block_bootstrap({100.0, 101.0, 103.0, 102.0}, config);
+  EXPECT_EQ(report.block_length, 3u);
+  EXPECT_EQ(report.observations, 3u);
+}
+
+TEST(BootstrapTest, PerformanceMetricsBootstrapsPnl) {
+  PerformanceMetrics metrics;
+  double pnl = 10000.0;
+  std::mt19937 rng(23);
+  std::normal_distribution<double> step(5.0, 100.0);
+  for (int i = 0; i < 500; ++i) {
+    pnl += step(rng);
+    metrics.add_pnl_snapshot(TimePoint(std::chrono::seconds(i)), pnl);
+  }
+
+  BootstrapConfig config;
+  config.resamples = 200;
+  auto report = metrics.bootstrap(config);
+  EXPECT_EQ(report.observations, 499u);
+  EXPECT_NEAR(report.sharpe.estimate, metrics.online.sharpe_ratio(), 1e-6);
+  EXPECT_NEAR(report.sortino.estimate, metrics.get_sortino_ratio(), 1e-6);
+
+  metrics.set_timeseries_mode(TimeseriesMode::NONE);
+  EXPECT_THROW(metrics.bootstrap(config), std::runtime_error);
+}
@@ -0,0 +1,169 @@
+#include "correlated_market_data.hpp"
+#include "order_book.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Sample correlation of columns a and b of a steps x n row-major matrix
+double sample_correlation(const std::vector<double> &draws, std::size_t n,
+                          std::size_t a, std::size_t b) {
+  std::size_t steps = draws.size() / n;
+  double sa = 0.0, sb = 0.0, saa = 0.0, sbb = 0.0, sab = 0.0;
+  for (std::size_t s = 0; s < steps; ++s) {
+    double x = draws[s * n + a];
+    double y = draws[s * n + b];
+    sa += x;
+    sb += y;
+    saa += x * x;
+    sbb += y * y;
+    sab += x * y;
+  }
+  double m = static_cast<double>(steps);
+  double cov = sab / m - (sa / m) * (sb / m);
+  double va = saa / m - (sa / m) * (sa / m);
+  double vb = sbb / m - (sb / m) * (sb / m);
+  return cov / std::sqrt(va * vb);
+}
+
+MultiAssetMarketDataGenerator::Config pair_universe(double rho) {
+  MultiAssetMarketDataGenerator::Config universe;
+  for (const char *name : {"AAA", "BBB"}) {
+    MarketDataGenerator::Config symbol;
+    symbol.symbol = name;
+    universe.symbols.push_back(symbol);
+  }
+  universe.symbols[1].start_price = 20.0;
+  universe.symbols[1].volatility = 0.1;
+  universe.symbols[1].tick_size = 0.05;
+  universe.symbols[1].spread = 0.10;
+  universe.correlation = {1.0, rho, rho, 1.0};
+  universe.seed = 7;
+  return universe;
+}
+
+} // namespace
+
+TEST(CorrelatedMarketDataTest, CholeskyReproducesCorrelation) {
+  std::vector<double> correlation = {1.0, 0.8, 0.3,  //
+                                     0.8, 1.0, -0.2, //
+                                     0.3, -0.2, 1.0};
+  auto shocks = CorrelatedShockGenerator::from_correlation(3, correlation, 11);
+
+  auto implied = shocks.implied_correlation();
+  for (std::size_t i = 0; i < correlation.size(); ++i) {
+    EXPECT_NEAR(implied[i], correlation[i], 1e-12);
+  }
+
+  std::vector<double> draws(200000 * 3);
+  shocks.generate(200000, draws.data());
+  EXPECT_NEAR(sample_correlation(draws, 3, 0, 1), 0.8, 0.01);
+  EXPECT_NEAR(sample_correlation(draws, 3, 0, 2), 0.3, 0.01);
+  EXPECT_NEAR(sample_correlation(draws, 3, 1, 2), -0.2, 0.01);
+}
+
+TEST(CorrelatedMarketDataTest, FactorModelKeepsUnitVariance) {
+  // 200 symbols on a market factor plus one of two sector factors
+  const std::size_t n = 200;
+  std::vector<double> loadings(n * 3, 0.0);
+  for (std::size_t i = 0; i < n; ++i) {
+    loadings[i * 3] = 0.6;
+    loadings[i * 3 + 1 + i % 2] = 0.5;
+  }
+  auto shocks = CorrelatedShockGenerator::from_factors(n, 3, loadings, 5);
+
+  auto implied = shocks.implied_correlation();
+  EXPECT_NEAR(implied[0], 1.0, 1e-12);
+  EXPECT_NEAR(implied[0 * n + 2], 0.61, 1e-12); // Same sector
+  EXPECT_NEAR(implied[0 * n + 1], 0.36, 1e-12); // Market only
+
+  std::vector<double> draws(50000 * n);
+  shocks.generate(50000, draws.data());
+  EXPECT_NEAR(sample_correlation(draws, n, 10, 12), 0.61, 0.02);
+  EXPECT_NEAR(sample_correlation(draws, n, 10, 13), 0.36, 0.02);
+}
+
+TEST(CorrelatedMarketDataTest, RejectsInvalidModels) {
+  EXPECT_THROW(CorrelatedShockGenerator::from_correlation(
+                   2, {1.0, 0.5, 0.4, 1.0}),
+               std::runtime_error); // Asymmetric
+  EXPECT_THROW(CorrelatedShockGenerator::from_correlation(
+                   2, {1.0, 1.2, 1.2, 1.0}),
+               std::runtime_error); // Not positive definite
+  EXPECT_THROW(CorrelatedShockGenerator::from_correlation(2, {1.0}),
+               std::runtime_error);
+  EXPECT_THROW(CorrelatedShockGenerator::from_factors(1, 2, {0.9, 0.9}),
+               std::runtime_error); // Explains more than unit variance
+}
+
+TEST(CorrelatedMarketDataTest, BatchMatchesStepwise) {
+  auto batch = CorrelatedShockGenerator::from_correlation(
+      2, {1.0, 0.5, 0.5, 1.0}, 3);
+  auto stepwise = batch;
+
+  std::vector<double> all(10 * 2);
+  batch.generate(10, all.data());
+  for (std::size_t s = 0; s < 10; ++s) {
+    double one[2];
+    stepwise.next(one);
+    EXPECT_DOUBLE_EQ(one[0], all[s * 2]);
+    EXPECT_DOUBLE_EQ(one[1], all[s * 2 + 1]);
+  }
+}
+
+TEST(CorrelatedMarketDataTest, SymbolsMoveTogetherWithOwnSettings) {
+  MultiAssetMarketDataGenerator generator(pair_universe(0.9));
+  ASSERT_EQ(generator.size(), 2u);
+
+  std::vector<std::size_t> seen(2, 0);
+  generator.register_callback(
+      [&](std::size_t symbol, const MarketDataSnapshot &snapshot) {
+        ++seen[symbol];
+        EXPECT_EQ(snapshot.symbol, symbol == 0 ? "AAA" : "BBB");
+      });
+  int own_callbacks = 0;
+  generator.generator(1).register_callback(
+      [&](const MarketDataSnapshot &) { ++own_callbacks; });
+
+  const std::size_t steps = 5000;
+  auto series = generator.generate_series(steps);
+  ASSERT_EQ(series.size(), steps * 2);
+  EXPECT_EQ(seen[0], steps);
+  EXPECT_EQ(seen[1], steps);
+  EXPECT_EQ(own_callbacks, static_cast<int>(steps));
+
+  // Mid changes carry the shock correlation, scaled per symbol
+  std::vector<double> moves;
+  double var_a = 0.0, var_b = 0.0;
+  for (std::size_t s = 1; s < steps; ++s) {
+    double da = series[s * 2].last_price - series[(s - 1) * 2].last_price;
+    double db =
+        series[s * 2 + 1].last_price - series[(s - 1) * 2 + 1].last_price;
+    moves.push_back(da);
+    moves.push_back(db);
+    var_a += da * da;
+    var_b += db * db;
+  }
+  EXPECT_NEAR(sample_correlation(moves, 2, 0, 1), 0.9, 0.03);
+  EXPECT_NEAR(std::sqrt(var_a / (steps - 1)), 0.5, 0.03);
+  EXPECT_NEAR(std::sqrt(var_b / (steps - 1)), 0.1, 0.01);
+  EXPECT_GE(series.back().spread, 0.05 - 1e-12); // BBB's tick size
+}
+
+TEST(CorrelatedMarketDataTest, StepFeedsEachBook) {
+  MultiAssetMarketDataGenerator generator(pair_universe(0.5));
+  OrderBook a("AAA");
+  OrderBook b("BBB");
+
+  generator.step({&a, &b}, 0.0);
+  EXPECT_GT(a.bids_size(), 0u);
+  EXPECT_GT(b.asks_size(), 0u);
+
+  generator.step({&a, nullptr}, 0.0); // BBB moves without a book
+  const auto &snapshots = generator.next_snapshots();
+  ASSERT_EQ(snapshots.size(), 2u);
+  EXPECT_EQ(snapshots[1].symbol, "BBB");
+}
@@ -0,0 +1,207 @@
+#include "engine_metrics.hpp"
+#include "mass_quote.hpp"
+#include "order_book.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+std::string segment_name(const char *test) {
+  return "/me_test_" + std::string(test) + "_" + std::to_string(getpid());
+}
+
+} // namespace
+
+TEST(EngineMetricsTest, RegistersCountersGaugesAndHistograms) {
+  MetricsRegistry registry;
+  Counter orders = registry.counter("orders");
+  Gauge depth = registry.gauge("depth");
+  Histogram latency = registry.histogram("latency");
+
+  orders.inc();
+  orders.inc(4);
+  depth.set(10);
+  depth.add(-3);
+  latency.record(0);
+  latency.record(700);
+
+  EXPECT_EQ(orders.value(), 5);
+  EXPECT_EQ(depth.value(), 7);
+  EXPECT_EQ(latency.count(), 2u);
+  EXPECT_EQ(registry.size(), 3u);
+
+  // Same name, same metric
+  registry.counter("orders").inc();
+  EXPECT_EQ(orders.value(), 6);
+  EXPECT_EQ(registry.size(), 3u);
+
+  EXPECT_THROW(registry.gauge("orders"), std::runtime_error);
+  EXPECT_THROW(registry.counter(std::string(60, 'x')), std::runtime_error);
+
+  // Unregistered handles are safe no-ops
+  Counter unregistered;
+  unregistered.inc();
+}
+
+TEST(EngineMetricsTest, FullSegmentThrows) {
+  MetricsRegistry::Config config;
+  config.slot_capacity = 2;
+  config.histogram_capacity = 0;
+  MetricsRegistry registry(config);
+  registry.counter("a");
+  EXPECT_THROW(registry.histogram("h"), std::runtime_error);
+  registry.counter("b");
+  EXPECT_THROW(registry.counter("c"), std::runtime_error);
+}
+
+TEST(EngineMetricsTest, ReaderSeesSharedSegment) {
+  MetricsRegistry::Config config;
+  config.shm_name = segment_name("reader");
+  MetricsRegistry registry(config);
+  Counter fills = registry.counter("fills");
+  Histogram latency = registry.histogram("latency");
+
+  MetricsReader reader(config.shm_name);
+  EXPECT_EQ(reader.writer_pid(), static_cast<std::int64_t>(getpid()));
+  EXPECT_EQ(reader.size(), 2u);
+
+  fills.inc(42);
+  for (int i = 0; i < 100; ++i) {
+    latency.record(i < 90 ? 100 : 5000);
+  }
+  // Registered after the reader attached
+  registry.gauge("late").set(-9);
+
+  EXPECT_EQ(reader.value("fills"), 42);
+  EXPECT_EQ(reader.value("late"), -9);
+  EXPECT_FALSE(reader.value("missing").has_value());
+
+  auto samples = reader.sample();
+  ASSERT_EQ(samples.size(), 3u);
+  EXPECT_EQ(samples[1].kind, MetricKind::HISTOGRAM);
+  EXPECT_EQ(samples[1].count, 100u);
+  EXPECT_EQ(samples[1].sum, 90u * 100 + 10u * 5000);
+  EXPECT_EQ(samples[1].quantile_bound(0.5), 127u);
+  EXPECT_EQ(samples[1].quantile_bound(0.99), 8191u);
+
+  EXPECT_THROW(MetricsReader("/me_test_no_such_segment"), std::runtime_error);
+}
+
+TEST(EngineMetricsTest, RestartLeavesAttachedReadersIntact) {
+  MetricsRegistry::Config config;
+  config.shm_name = segment_name("restart");
+  auto first = std::make_unique<MetricsRegistry>(config);
+  first->counter("fills").inc(7);
+  MetricsReader old_reader(config.shm_name);
+
+  // A new writer under the same name gets a fresh segment; the old
+  // mapping stays readable instead of being truncated under the reader
+  MetricsRegistry second(config);
+  second.counter("orders").inc(3);
+  EXPECT_EQ(old_reader.value("fills"), 7);
+  EXPECT_EQ(old_reader.size(), 1u);
+
+  MetricsReader new_reader(config.shm_name);
+  EXPECT_EQ(new_reader.value("orders"), 3);
+  EXPECT_FALSE(new_reader.value("fills").has_value());
+
+  // The old writer going away leaves the new segment published
+  first.reset();
+  EXPECT_EQ(MetricsReader(config.shm_name).value("orders"), 3);
+}
+
+TEST(EngineMetricsTest, ConcurrentIncrementsAreExact) {
+  MetricsRegistry registry;
+  Counter counter = registry.counter("shared");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([counter]() mutable {
+      for (int i = 0; i < 100000; ++i) {
+        counter.inc();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.value(), 400000);
+}
+
+TEST(EngineMetricsTest, OrderBookPublishesActivity) {
+  MetricsRegistry registry;
+  OrderBook book("XYZ");
+  book.attach_metrics(registry);
+
+  book.add_order(Order(1, 100, Side::SELL, 100.0, 50));
+  book.add_order(Order(2, 100, Side::SELL, 101.0, 50));
+  book.add_order(Order(3, 200, Side::BUY, OrderType::MARKET, 60));
+  book.add_order(Order(4, 200, Side::BUY, 99.0, 10));
+  book.cancel_order(4);
+  book.cancel_order(999);
+  book.add_order(Order(5, 200, Side::BUY, 200.0, 500, TimeInForce::FOK));
+  book.add_order(Order(6, 100, Side::BUY, 105.0, 10)); // Self-trade
+
+  auto value = [&](const std::string &name) {
+    return registry.counter("book.XYZ." + name).value();
+  };
+  EXPECT_EQ(value("in.limit"), 5);
+  EXPECT_EQ(value("in.market"), 1);
+  EXPECT_EQ(value("fills"), 2);
+  EXPECT_EQ(value("fill_volume"), 60);
+  EXPECT_EQ(value("out.filled"), 2); // Order 1 and the market order
+  EXPECT_EQ(value("out.cancelled"), 1);
+  EXPECT_EQ(value("out.killed"), 1);
+  EXPECT_EQ(value("rejects"), 1);
+  EXPECT_EQ(value("self_trades"), 1);
+  EXPECT_EQ(registry.gauge("book.XYZ.tracked_orders").value(), 5);
+  EXPECT_EQ(registry.histogram("book.XYZ.add_latency_ns").count(), 6u);
+
+  book.detach_metrics();
+  book.add_order(Order(7, 300, Side::BUY, 90.0, 10));
+  EXPECT_EQ(value("in.limit"), 5);
+}
+
+TEST(EngineMetricsTest, AmendsAndQuotesCountOnce) {
+  MetricsRegistry registry;
+  OrderBook book("XYZ");
+  book.attach_metrics(registry);
+  auto value = [&](const std::string &name) {
+    return registry.counter("book.XYZ." + name).value();
+  };
+
+  book.add_order(Order(1, 100, Side::BUY, 99.0, 10));
+  book.amend_order(1, 98.0, 20); // Cancel and re-add inside
+  EXPECT_EQ(value("in.amend"), 1);
+  EXPECT_EQ(value("in.limit"), 1);
+  EXPECT_EQ(value("out.cancelled"), 0);
+  EXPECT_EQ(registry.histogram("book.XYZ.add_latency_ns").count(), 1u);
+
+  MassQuote quote;
+  quote.account_id = 200;
+  quote.bid_price = 97.0;
+  quote.bid_quantity = 10;
+  quote.ask_price = 103.0;
+  quote.ask_quantity = 10;
+  quote.new_bid_id = 10;
+  quote.new_ask_id = 11;
+  book.mass_quote(quote);
+  EXPECT_EQ(value("in.limit"), 3);
+
+  // Smaller at the same price amends in place; zero pulls the side
+  quote.live_bid_id = 10;
+  quote.live_ask_id = 11;
+  quote.bid_quantity = 5;
+  quote.ask_quantity = 0;
+  quote.new_bid_id = 12;
+  quote.new_ask_id = 13;
+  book.mass_quote(quote);
+  EXPECT_EQ(value("in.amend"), 2);
+  EXPECT_EQ(value("out.cancelled"), 1);
+  EXPECT_EQ(registry.gauge("book.XYZ.tracked_orders").value(), 2);
+}
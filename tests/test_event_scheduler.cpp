@@ -0,0 +1,259 @@
+#include "event_scheduler.hpp"
+#include "market_data_generator.hpp"
+#include "muted_output.hpp"
+#include "trading_simulator.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using std::chrono::milliseconds;
+
+namespace {
+
+// Records when it was called, and asks for a follow-up wakeup once.
+class WakeupStrategy : public Strategy {
+public:
+  explicit WakeupStrategy(const StrategyConfig &config, const SimClock &clock)
+      : Strategy(config), clock_(clock) {}
+
+  void on_market_data(const MarketDataSnapshot &snapshot) override {
+    snapshots.push_back(snapshot.timestamp);
+    if (snapshots.size() == 1) {
+      request_wakeup(milliseconds(5), 42);
+    }
+  }
+  void on_fill(const Fill &fill) override { update_stats(fill); }
+  void generate_signals(std::vector<TradingSignal> &) override {}
+  void on_timer() override { timers.push_back(clock_.now()); }
+  void on_wakeup(std::uint64_t token) override {
+    wakeups.push_back({clock_.now(), token});
+  }
+
+  std::vector<TimePoint> snapshots;
+  std::vector<TimePoint> timers;
+  std::vector<std::pair<TimePoint, std::uint64_t>> wakeups;
+
+private:
+  const SimClock &clock_;
+};
+
+// Holds every tick and keeps the signals it was handed back
+class SignalStrategy : public WakeupStrategy {
+public:
+  using WakeupStrategy::WakeupStrategy;
+
+  void generate_signals(std::vector<TradingSignal> &signals) override {
+    signals.emplace_back(SignalType::HOLD, get_instruments().front());
+  }
+  void signals_to_orders(const std::vector<TradingSignal> &signals,
+                         std::vector<Order> &orders) override {
+    for (const auto &signal : signals) {
+      signal_times.push_back(signal.timestamp);
+    }
+    Strategy::signals_to_orders(signals, orders);
+  }
+
+  std::vector<TimePoint> signal_times;
+};
+
+StrategyConfig make_config(int account_id) {
+  StrategyConfig config;
+  config.name = "Clocked";
+  config.account_id = account_id;
+  config.symbols = {"SIM"};
+  return config;
+}
+
+TimePoint at_ms(long ms) { return TimePoint() + milliseconds(ms); }
+
+} // namespace
+
+TEST(EventSchedulerTest, RunsInTimestampOrderWithFifoTies) {
+  VirtualClock clock;
+  EventScheduler scheduler(clock);
+  std::vector<int> order;
+
+  scheduler.schedule_at(at_ms(30), SimEventType::CUSTOM,
+                        [&] { order.push_back(3); });
+  scheduler.schedule_at(at_ms(10), SimEventType::CUSTOM,
+                        [&] { order.push_back(1); });
+  scheduler.schedule_at(at_ms(10), SimEventType::CUSTOM,
+                        [&] { order.push_back(2); });
+
+  EXPECT_EQ(scheduler.pending(), 3u);
+  EXPECT_EQ(scheduler.run(), 3u);
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(clock.now(), at_ms(30));
+  EXPECT_EQ(scheduler.events_run(SimEventType::CUSTOM), 3u);
+}
+
+TEST(EventSchedulerTest, ClockJumpsAndEventsCanScheduleMore) {
+  VirtualClock clock;
+  EventScheduler scheduler(clock);
+  std::vector<TimePoint> seen;
+
+  std::function<void()> tick = [&] {
+    seen.push_back(clock.now());
+    if (seen.size() < 4) {
+      scheduler.schedule_after(std::chrono::hours(1), SimEventType::TIMER,
+                               tick);
+    }
+  };
+  scheduler.schedule_after(std::chrono::hours(1), SimEventType::TIMER, tick);
+
+  scheduler.run_until(TimePoint() + std::chrono::hours(2) + milliseconds(1));
+  ASSERT_EQ(seen.size(), 2u);
+  EXPECT_EQ(clock.now(), TimePoint() + std::chrono::hours(2) + milliseconds(1));
+
+  scheduler.run();
+  ASSERT_EQ(seen.size(), 4u);
+  EXPECT_EQ(seen.back(), TimePoint() + std::chrono::hours(4));
+  EXPECT_THROW(clock.advance_to(at_ms(0)), std::runtime_error);
+}
+
+TEST(EventSchedulerTest, CancelledEventsNeverRun) {
+  VirtualClock clock;
+  EventScheduler scheduler(clock);
+  int runs = 0;
+
+  auto keep = scheduler.schedule_at(at_ms(1), SimEventType::CUSTOM,
+                                    [&] { runs += 1; });
+  auto drop = scheduler.schedule_at(at_ms(2), SimEventType::CUSTOM,
+                                    [&] { runs += 10; });
+
+  EXPECT_TRUE(scheduler.cancel(drop));
+  EXPECT_FALSE(scheduler.cancel(drop));
+  EXPECT_EQ(scheduler.pending(), 1u);
+
+  scheduler.run();
+  EXPECT_EQ(runs, 1);
+  EXPECT_FALSE(scheduler.cancel(keep)); // Already ran
+  EXPECT_TRUE(scheduler.empty());
+}
+
+TEST(EventSchedulerTest, SimulatorRunsInVirtualTime) {
+  TradingSimulator sim;
+  sim.create_account(1, "Clocked", 100000.0);
+  sim.create_account(2, "Liquidity", 100000.0);
+  sim.set_step_interval(milliseconds(10));
+  sim.set_timer_interval(milliseconds(25));
+
+  auto strategy =
+      std::make_unique<WakeupStrategy>(make_config(1), sim.get_clock());
+  WakeupStrategy *clocked = strategy.get();
+  sim.add_strategy(std::move(strategy));
+
+  // A resting order arrives between the 3rd and 4th steps
+  sim.schedule_order(Order(9001, 2, Side::BUY, 99.0, 10), at_ms(35));
+
+  sim.run_simulation(10);
+
+  EXPECT_EQ(sim.get_clock().now(), at_ms(100));
+  ASSERT_EQ(clocked->snapshots.size(), 10u);
+  EXPECT_EQ(clocked->snapshots.front(), at_ms(10));
+  EXPECT_EQ(clocked->snapshots.back(), at_ms(100));
+
+  ASSERT_EQ(clocked->timers.size(), 4u);
+  EXPECT_EQ(clocked->timers.front(), at_ms(25));
+
+  ASSERT_EQ(clocked->wakeups.size(), 1u);
+  EXPECT_EQ(clocked->wakeups[0].first, at_ms(15));
+  EXPECT_EQ(clocked->wakeups[0].second, 42u);
+
+  EXPECT_EQ(sim.get_order_book().active_bids_count(), 1u);
+}
+
+TEST(EventSchedulerTest, RepeatedRunsKeepOneTimerChain) {
+  TradingSimulator sim;
+  sim.create_account(1, "Clocked", 100000.0);
+  sim.set_step_interval(milliseconds(10));
+  sim.set_timer_interval(milliseconds(25));
+
+  auto strategy =
+      std::make_unique<WakeupStrategy>(make_config(1), sim.get_clock());
+  WakeupStrategy *clocked = strategy.get();
+  sim.add_strategy(std::move(strategy));
+
+  {
+    MutedOutput muted;
+    sim.run_simulation(10);
+    sim.run_simulation(10);
+    sim.run_simulation(10);
+  }
+
+  // One timer every 25ms over 300ms, each at a distinct time
+  ASSERT_EQ(clocked->timers.size(), 12u);
+  for (size_t i = 0; i < clocked->timers.size(); ++i) {
+    EXPECT_LE(clocked->timers[i], at_ms(300));
+    if (i > 0) {
+      EXPECT_LT(clocked->timers[i - 1], clocked->timers[i]);
+    }
+  }
+  EXPECT_EQ(sim.get_scheduler().pending(), 0u);
+}
+
+TEST(EventSchedulerTest, MarketDataGeneratorUsesInjectedClock) {
+  VirtualClock clock(at_ms(500));
+  MarketDataGenerator generator;
+  generator.set_clock(clock);
+
+  EXPECT_EQ(generator.next_snapshot().timestamp, at_ms(500));
+  clock.advance_by(milliseconds(5));
+  EXPECT_EQ(generator.next_snapshot().timestamp, at_ms(505));
+}
+
+TEST(EventSchedulerTest, IdenticalRunsAreReproducible) {
+  auto run_once = [] {
+    TradingSimulator sim;
+    sim.create_account(1, "Clocked", 100000.0);
+    sim.create_account(2, "Liquidity", 100000.0);
+    sim.schedule_order(Order(9001, 2, Side::BUY, 101.0, 10), at_ms(3));
+    sim.schedule_order(Order(9002, 1, Side::SELL, 100.0, 10), at_ms(7));
+
+    auto strategy =
+        std::make_unique<WakeupStrategy>(make_config(1), sim.get_clock());
+    WakeupStrategy *clocked = strategy.get();
+    sim.add_strategy(std::move(strategy));
+    sim.run_simulation(20);
+
+    return std::make_pair(clocked->snapshots, sim.get_order_book().get_account_fills().size());
+  };
+
+  auto first = run_once();
+  auto second = run_once();
+  EXPECT_EQ(first.second, 1u);
+  EXPECT_EQ(first.first, second.first);
+  EXPECT_EQ(first.second, second.second);
+}
+
+TEST(EventSchedulerTest, StrategyAndEventLogUseVirtualTime) {
+  TradingSimulator sim;
+  sim.create_account(1, "Clocked", 100000.0);
+  sim.create_account(2, "Liquidity", 100000.0);
+  sim.get_order_book().enable_logging();
+  sim.schedule_order(Order(9001, 2, Side::BUY, 101.0, 10), at_ms(3));
+  sim.schedule_order(Order(9002, 1, Side::SELL, 100.0, 10), at_ms(7));
+
+  auto strategy =
+      std::make_unique<SignalStrategy>(make_config(1), sim.get_clock());
+  SignalStrategy *clocked = strategy.get();
+  sim.add_strategy(std::move(strategy));
+  {
+    MutedOutput muted;
+    sim.run_simulation(20);
+  }
+
+  ASSERT_FALSE(clocked->signal_times.empty());
+  for (TimePoint t : clocked->signal_times) {
+    EXPECT_LE(t, at_ms(20));
+  }
+  EXPECT_EQ(clocked->get_stats().start_time, TimePoint());
+  EXPECT_EQ(clocked->get_stats().last_update, at_ms(7));
+
+  // Add, add, fill
+  const auto &events = sim.get_order_book().get_events();
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].timestamp, at_ms(3));
+  EXPECT_EQ(events[1].timestamp, at_ms(7));
+  EXPECT_EQ(events[2].timestamp, at_ms(7));
+}
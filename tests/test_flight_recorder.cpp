@@ -0,0 +1,245 @@
+#include "flight_recorder.hpp"
+#include "mass_quote.hpp"
+#include "order_book.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+FlightRecord make_record(int order_id) {
+  FlightRecord entry{};
+  entry.op = FlightOp::ADD;
+  entry.order_id = order_id;
+  entry.quantity = 10;
+  entry.price = 100.0;
+  return entry;
+}
+
+std::string scratch_directory(const char *test) {
+  auto path = std::filesystem::temp_directory_path() /
+              ("flight_" + std::string(test) + "_" + std::to_string(getpid()));
+  std::filesystem::create_directories(path);
+  return path.string();
+}
+
+} // namespace
+
+TEST(FlightRecorderTest, RingKeepsMostRecentRecords) {
+  FlightRecorder::Config config;
+  config.capacity = 5; // Rounded to 8
+  FlightRecorder recorder(config);
+  EXPECT_EQ(recorder.capacity(), 8u);
+
+  for (int i = 0; i < 3; ++i) {
+    recorder.record(make_record(i));
+  }
+  auto records = recorder.records();
+  ASSERT_EQ(records.size(), 3u);
+  EXPECT_EQ(records[0].order_id, 0);
+
+  for (int i = 3; i < 20; ++i) {
+    recorder.record(make_record(i));
+  }
+  records = recorder.records();
+  EXPECT_EQ(recorder.recorded(), 20u);
+  ASSERT_EQ(records.size(), 8u);
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(records[i].order_id, static_cast<int>(12 + i));
+    EXPECT_EQ(records[i].sequence, 12 + i);
+  }
+}
+
+TEST(FlightRecorderTest, DumpRoundTrips) {
+  FlightRecorder::Config config;
+  config.capacity = 4;
+  config.symbol = "ABC";
+  FlightRecorder recorder(config);
+  for (int i = 0; i < 6; ++i) {
+    recorder.record(make_record(i));
+  }
+
+  std::stringstream buffer;
+  recorder.dump(buffer, "test");
+  FlightDump dump = read_flight_dump(buffer);
+  EXPECT_STREQ(dump.header.symbol, "ABC");
+  EXPECT_STREQ(dump.header.reason, "test");
+  EXPECT_EQ(dump.header.recorded, 6u);
+  ASSERT_EQ(dump.records.size(), 4u);
+  EXPECT_EQ(dump.records.front().order_id, 2);
+  EXPECT_EQ(dump.records.back().order_id, 5);
+
+  std::string line = format_flight_record(dump.records.back(),
+                                          dump.header.ns_per_tick, 0);
+  EXPECT_NE(line.find("ADD order 5"), std::string::npos);
+
+  std::stringstream garbage("not a dump at all, definitely not");
+  EXPECT_THROW(read_flight_dump(garbage), std::runtime_error);
+}
+
+TEST(FlightRecorderTest, TriggersDumpToFiles) {
+  std::string directory = scratch_directory("triggers");
+  FlightRecorder::Config config;
+  config.capacity = 4;
+  config.latency_trigger_ns = 1000000; // 1 ms
+  config.dump_directory = directory;
+  config.symbol = "TRG";
+  FlightRecorder recorder(config);
+
+  FlightRecord slow = make_record(1);
+  slow.duration_ticks = UINT32_MAX;
+  recorder.record(slow);
+  ASSERT_EQ(recorder.dump_files().size(), 1u);
+  EXPECT_EQ(read_flight_dump(recorder.dump_files()[0]).header.count, 1u);
+
+  // Cooldown until the ring turns over
+  recorder.record(slow);
+  EXPECT_EQ(recorder.dump_files().size(), 1u);
+
+  FlightRecord crossed = make_record(2);
+  crossed.best_bid = 101.0;
+  crossed.best_ask = 100.0;
+  for (int i = 0; i < 3; ++i) {
+    recorder.record(make_record(3));
+  }
+  recorder.record(crossed);
+  ASSERT_EQ(recorder.dump_files().size(), 2u);
+  EXPECT_STREQ(read_flight_dump(recorder.dump_files()[1]).header.reason,
+               "invariant");
+
+  // Requests are served at the next record, cooldown or not
+  FlightRecorder::request_dump();
+  recorder.record(make_record(4));
+  ASSERT_EQ(recorder.dump_files().size(), 3u);
+  EXPECT_STREQ(read_flight_dump(recorder.dump_files()[2]).header.reason,
+               "signal");
+  recorder.record(make_record(5));
+  EXPECT_EQ(recorder.dump_files().size(), 3u);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(FlightRecorderTest, NoDumpsWithoutDirectory) {
+  FlightRecorder::Config config;
+  config.latency_trigger_ns = 1;
+  FlightRecorder recorder(config);
+
+  FlightRecord slow = make_record(1);
+  slow.duration_ticks = UINT32_MAX;
+  FlightRecorder::request_dump();
+  recorder.record(slow);
+  EXPECT_TRUE(recorder.dump_files().empty());
+  EXPECT_THROW(recorder.dump_to_file(), std::runtime_error);
+}
+
+TEST(FlightRecorderTest, OrderBookRecordsOperations) {
+  OrderBook book("XYZ");
+  ASSERT_NE(book.flight_recorder(), nullptr);
+  EXPECT_EQ(book.flight_recorder()->config().symbol, "XYZ");
+
+  book.add_order(Order(1, 100, Side::SELL, 100.0, 50));
+  book.add_order(Order(2, 200, Side::BUY, 100.0, 20));
+  book.cancel_order(1);
+  book.cancel_order(999);
+
+  auto records = book.flight_recorder()->records();
+  ASSERT_EQ(records.size(), 5u);
+
+  EXPECT_EQ(records[0].op, FlightOp::ADD);
+  EXPECT_EQ(records[0].outcome, FlightOutcome::RESTED);
+  EXPECT_EQ(records[0].best_ask, 100.0);
+
+  EXPECT_EQ(records[1].op, FlightOp::FILL);
+  EXPECT_EQ(records[1].order_id, 2);
+  EXPECT_EQ(records[1].other_id, 1);
+  EXPECT_EQ(records[1].quantity, 20);
+
+  EXPECT_EQ(records[2].op, FlightOp::ADD);
+  EXPECT_EQ(records[2].outcome, FlightOutcome::FILLED);
+  EXPECT_EQ(records[2].other_id, 200);
+  EXPECT_EQ(records[2].leaves, 0);
+
+  EXPECT_EQ(records[3].op, FlightOp::CANCEL);
+  EXPECT_EQ(records[3].outcome, FlightOutcome::CANCELLED);
+  EXPECT_EQ(records[3].quantity, 30);
+
+  EXPECT_EQ(records[4].op, FlightOp::CANCEL);
+  EXPECT_EQ(records[4].outcome, FlightOutcome::REJECTED);
+  EXPECT_EQ(records[4].order_id, 999);
+
+  FlightRecorder::Config config;
+  config.capacity = 16;
+  book.configure_flight_recorder(config);
+  EXPECT_EQ(book.flight_recorder()->recorded(), 0u);
+  EXPECT_EQ(book.flight_recorder()->config().symbol, "XYZ");
+
+  book.disable_flight_recorder();
+  book.add_order(Order(3, 100, Side::BUY, 90.0, 10));
+  EXPECT_EQ(book.flight_recorder(), nullptr);
+}
+
+TEST(FlightRecorderTest, AmendsAndQuotesRecordOnce) {
+  OrderBook book("XYZ");
+  book.add_order(Order(1, 100, Side::BUY, 99.0, 10));
+  book.amend_order(1, 98.0, 20);
+
+  auto records = book.flight_recorder()->records();
+  ASSERT_EQ(records.size(), 2u); // No inner CANCEL / ADD
+  EXPECT_EQ(records[1].op, FlightOp::AMEND);
+  EXPECT_EQ(records[1].price, 98.0);
+  EXPECT_EQ(records[1].leaves, 20);
+
+  MassQuote quote;
+  quote.account_id = 200;
+  quote.bid_price = 97.0;
+  quote.bid_quantity = 10;
+  quote.ask_price = 103.0;
+  quote.ask_quantity = 10;
+  quote.new_bid_id = 10;
+  quote.new_ask_id = 11;
+  book.mass_quote(quote);
+
+  // Bid amended in place, ask pulled
+  quote.live_bid_id = 10;
+  quote.live_ask_id = 11;
+  quote.bid_quantity = 4;
+  quote.ask_quantity = 0;
+  quote.new_bid_id = 12;
+  quote.new_ask_id = 13;
+  book.mass_quote(quote);
+
+  records = book.flight_recorder()->records();
+  ASSERT_EQ(records.size(), 6u);
+  EXPECT_EQ(records[4].op, FlightOp::AMEND);
+  EXPECT_EQ(records[4].order_id, 10);
+  EXPECT_EQ(records[4].other_id, 200);
+  EXPECT_EQ(records[4].leaves, 4);
+  EXPECT_EQ(records[4].outcome, FlightOutcome::RESTED);
+  EXPECT_EQ(records[5].op, FlightOp::CANCEL);
+  EXPECT_EQ(records[5].order_id, 11);
+  EXPECT_EQ(records[5].quantity, 10);
+  EXPECT_EQ(records[5].outcome, FlightOutcome::CANCELLED);
+}
+
+TEST(FlightRecorderTest, RecordsLiveTopOfBook) {
+  OrderBook book("XYZ");
+  book.add_order(Order(1, 100, Side::BUY, 99.0, 10));
+  book.add_order(Order(2, 100, Side::BUY, 98.0, 10));
+  book.add_order(Order(3, 100, Side::SELL, 101.0, 10));
+  book.cancel_order(1); // Its heap copy is still on top until popped
+
+  auto records = book.flight_recorder()->records();
+  ASSERT_EQ(records.back().op, FlightOp::CANCEL);
+  EXPECT_EQ(records.back().best_bid, 98.0);
+  EXPECT_EQ(records.back().best_ask, 101.0);
+
+  book.cancel_order(3);
+  book.cancel_order(2);
+  records = book.flight_recorder()->records();
+  EXPECT_EQ(records.back().best_bid, 0.0);
+  EXPECT_EQ(records.back().best_ask, 0.0);
+}
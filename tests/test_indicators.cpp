@@ -0,0 +1,128 @@
+#include "indicators.hpp"
+#include "price_history.hpp"
+#include "strategy.hpp"
+
+#include <cmath>
+#include <deque>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+// Exposes the scalar Strategy helpers so the incremental engine can be
+// checked against them.
+class IndicatorProbe : public Strategy {
+public:
+  IndicatorProbe() : Strategy(StrategyConfig()) {}
+
+  void on_market_data(const MarketDataSnapshot &) override {}
+  void on_fill(const Fill &) override {}
+  void generate_signals(std::vector<TradingSignal> &) override {}
+
+  using Strategy::calculate_momentum;
+  using Strategy::calculate_sma;
+  using Strategy::calculate_stddev;
+};
+
+std::vector<double> random_walk(std::size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> noise(0.0, 0.25);
+  std::vector<double> prices;
+  double price = 100.0;
+  for (std::size_t i = 0; i < n; ++i) {
+    price = std::max(0.01, price + noise(rng));
+    prices.push_back(price);
+  }
+  return prices;
+}
+
+} // namespace
+
+TEST(IndicatorSetTest, MatchesScalarHelpers) {
+  IndicatorProbe probe;
+  IndicatorSet indicators;
+  indicators.subscribe(IndicatorType::SMA, 20);
+  indicators.subscribe(IndicatorType::MOMENTUM, 10);
+
+  PriceHistoryStore store(1000);
+  InstrumentId id = store.intern("SYM");
+  for (double price : random_walk(5000, 7)) {
+    store.push(id, price);
+    indicators.update(price);
+    PriceWindow history = store.window(id);
+
+    EXPECT_NEAR(indicators.sma(20), probe.calculate_sma(history, 20), 1e-9);
+    EXPECT_NEAR(indicators.stddev(20), probe.calculate_stddev(history, 20),
+                1e-9);
+    EXPECT_NEAR(indicators.momentum(10),
+                probe.calculate_momentum(history, 10), 1e-9);
+  }
+}
+
+TEST(IndicatorSetTest, NotReadyUntilWindowFills) {
+  IndicatorSet indicators;
+  indicators.subscribe(IndicatorType::SMA, 3);
+  indicators.subscribe(IndicatorType::MOMENTUM, 3);
+
+  indicators.update(1.0);
+  indicators.update(2.0);
+  EXPECT_FALSE(indicators.is_ready(IndicatorType::SMA, 3));
+  EXPECT_EQ(indicators.sma(3), 0.0);
+
+  indicators.update(3.0);
+  EXPECT_TRUE(indicators.is_ready(IndicatorType::SMA, 3));
+  EXPECT_DOUBLE_EQ(indicators.sma(3), 2.0);
+  EXPECT_FALSE(indicators.is_ready(IndicatorType::MOMENTUM, 3));
+
+  indicators.update(4.0);
+  EXPECT_DOUBLE_EQ(indicators.momentum(3), 300.0); // 1 -> 4
+}
+
+TEST(IndicatorSetTest, EmaSeedsWithSmaThenRecurses) {
+  IndicatorSet indicators;
+  indicators.subscribe(IndicatorType::EMA, 4);
+
+  for (double p : {1.0, 2.0, 3.0, 4.0}) {
+    indicators.update(p);
+  }
+  EXPECT_DOUBLE_EQ(indicators.ema(4), 2.5);
+
+  indicators.update(10.0);
+  EXPECT_DOUBLE_EQ(indicators.ema(4), 2.5 + (10.0 - 2.5) * 0.4);
+}
+
+TEST(IndicatorSetTest, ChannelTracksRollingHighLow) {
+  IndicatorSet indicators;
+  indicators.subscribe(IndicatorType::CHANNEL, 50);
+
+  std::deque<double> window;
+  for (double price : random_walk(2000, 11)) {
+    window.push_back(price);
+    if (window.size() > 50) {
+      window.pop_front();
+    }
+    indicators.update(price);
+
+    if (window.size() == 50) {
+      EXPECT_EQ(indicators.rolling_high(50),
+                *std::max_element(window.begin(), window.end()));
+      EXPECT_EQ(indicators.rolling_low(50),
+                *std::min_element(window.begin(), window.end()));
+    }
+  }
+}
+
+TEST(IndicatorSetTest, StrategyRebuildsLateSubscriptionsFromHistory) {
+  IndicatorProbe probe;
+  for (double p : {10.0, 11.0, 12.0, 13.0, 14.0}) {
+    probe.add_price("SYM", p);
+  }
+
+  probe.subscribe_indicator(IndicatorType::SMA, 5);
+  const auto &indicators = probe.get_indicators("SYM");
+  EXPECT_TRUE(indicators.is_ready(IndicatorType::SMA, 5));
+  EXPECT_DOUBLE_EQ(indicators.sma(5), 12.0);
+
+  probe.add_price("SYM", 20.0);
+  EXPECT_DOUBLE_EQ(probe.get_indicators("SYM").sma(5), 14.0);
+}
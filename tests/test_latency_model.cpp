@@ -0,0 +1,207 @@
+#include "latency_model.hpp"
+#include "trading_simulator.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+namespace {
+
+TimePoint at_us(long us) { return TimePoint() + microseconds(us); }
+
+// Buys once on its first BBO; records when data and fills reach it
+class LatencyProbe : public Strategy {
+public:
+  LatencyProbe(const StrategyConfig &config, const SimClock &clock)
+      : Strategy(config), clock_(clock) {}
+
+  void on_market_data(const MarketDataSnapshot &snapshot) override {
+    if (snapshot.type != MarketDataType::BBO) {
+      return;
+    }
+    data_seen.push_back({snapshot.timestamp, clock_.now()});
+    if (data_seen.size() == 1) {
+      want_order = true;
+    }
+  }
+  void on_fill(const Fill &fill) override {
+    fills_seen.push_back(clock_.now());
+    update_stats(fill);
+  }
+  void generate_signals(std::vector<TradingSignal> &signals) override {
+    if (!want_order) {
+      return;
+    }
+    want_order = false;
+    TradingSignal signal(SignalType::BUY, 0);
+    signal.target_price = 101.0;
+    signal.suggested_quantity = 10;
+    signals.push_back(signal);
+  }
+
+  // (published at, received at)
+  std::vector<std::pair<TimePoint, TimePoint>> data_seen;
+  std::vector<TimePoint> fills_seen;
+  bool want_order = false;
+
+private:
+  const SimClock &clock_;
+};
+
+StrategyConfig probe_config() {
+  StrategyConfig config;
+  config.name = "Probe";
+  config.account_id = 1;
+  config.symbols = {"SIM"};
+  return config;
+}
+
+// Two-sided resting book from a non-strategy account
+void seed_book(TradingSimulator &sim) {
+  sim.create_account(2, "Liquidity", 1000000.0);
+  sim.schedule_order(Order(9001, 2, Side::BUY, 99.0, 100), TimePoint());
+  sim.schedule_order(Order(9002, 2, Side::SELL, 101.0, 100), TimePoint());
+}
+
+} // namespace
+
+TEST(LatencyModelTest, FixedAndQueueLoad) {
+  FixedLatency fixed(microseconds(50));
+  EXPECT_EQ(fixed.sample(0), microseconds(50));
+  EXPECT_EQ(fixed.sample(1000), microseconds(50));
+
+  QueueLoadLatency loaded(std::make_unique<FixedLatency>(microseconds(50)),
+                          microseconds(2), microseconds(100));
+  EXPECT_EQ(loaded.sample(0), microseconds(50));
+  EXPECT_EQ(loaded.sample(10), microseconds(70));
+  EXPECT_EQ(loaded.sample(1000), microseconds(100)); // Capped
+
+  EXPECT_THROW(FixedLatency(microseconds(-1)), std::runtime_error);
+}
+
+TEST(LatencyModelTest, LogNormalIsSeededAndCentredOnMedian) {
+  LogNormalLatency a(microseconds(100), 0.5, 7);
+  LogNormalLatency b(microseconds(100), 0.5, 7);
+
+  std::vector<Duration> samples;
+  for (int i = 0; i < 2001; ++i) {
+    Duration sample = a.sample(0);
+    EXPECT_EQ(sample, b.sample(0));
+    EXPECT_GT(sample, Duration::zero());
+    samples.push_back(sample);
+  }
+
+  std::nth_element(samples.begin(), samples.begin() + 1000, samples.end());
+  double median_us =
+      std::chrono::duration<double, std::micro>(samples[1000]).count();
+  EXPECT_NEAR(median_us, 100.0, 10.0);
+}
+
+TEST(LatencyModelTest, FactoryReadsStrategyParameters) {
+  StrategyConfig config = probe_config();
+  EXPECT_EQ(make_latency_model(config, LatencyPath::MARKET_DATA), nullptr);
+
+  config.set_parameter("md_latency_us", 25.0);
+  config.set_parameter("fill_latency_us", 40.0);
+  config.set_parameter("fill_latency_per_msg_us", 5.0);
+  config.set_parameter("order_latency_us", 30.0);
+  config.set_parameter("order_latency_sigma", 0.3);
+
+  auto md = make_latency_model(config, LatencyPath::MARKET_DATA);
+  ASSERT_NE(md, nullptr);
+  EXPECT_EQ(md->sample(0), microseconds(25));
+
+  auto fill = make_latency_model(config, LatencyPath::FILL_NOTIFICATION);
+  ASSERT_NE(fill, nullptr);
+  EXPECT_EQ(fill->sample(4), microseconds(60));
+
+  auto order = make_latency_model(config, LatencyPath::ORDER_ENTRY);
+  ASSERT_NE(dynamic_cast<LogNormalLatency *>(order.get()), nullptr);
+}
+
+TEST(LatencyModelTest, DelayQueueIsFifo) {
+  DelayQueue<int> queue;
+  EXPECT_TRUE(queue.push(at_us(30), 1));
+  EXPECT_FALSE(queue.push(at_us(10), 2)); // Cannot overtake message 1
+  EXPECT_FALSE(queue.push(at_us(50), 3));
+
+  std::vector<int> delivered;
+  auto collect = [&](int value) { delivered.push_back(value); };
+
+  EXPECT_EQ(queue.release(at_us(29), collect), 0u);
+  EXPECT_EQ(queue.release(at_us(30), collect), 2u);
+  EXPECT_EQ(queue.next_due(), at_us(50));
+  EXPECT_EQ(queue.release(at_us(100), collect), 1u);
+  EXPECT_EQ(delivered, (std::vector<int>{1, 2, 3}));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(LatencyModelTest, SimulatorDelaysEachPath) {
+  TradingSimulator sim;
+  sim.create_account(1, "Probe", 100000.0);
+  seed_book(sim);
+
+  StrategyConfig config = probe_config();
+  config.set_parameter("md_latency_us", 200.0);
+  config.set_parameter("order_latency_us", 300.0);
+  config.set_parameter("fill_latency_us", 400.0);
+  auto strategy = std::make_unique<LatencyProbe>(config, sim.get_clock());
+  LatencyProbe *probe = strategy.get();
+  sim.add_strategy(std::move(strategy));
+
+  sim.run_simulation(3); // Steps at 1ms, 2ms, 3ms
+
+  // Data published at 1ms arrives 200us later; the order it triggers
+  // reaches the book 300us after that, and the fill report 400us later
+  // The 3ms update is still in flight when the run ends
+  ASSERT_EQ(probe->data_seen.size(), 2u);
+  EXPECT_EQ(sim.in_flight(1, LatencyPath::MARKET_DATA), 1u);
+  EXPECT_EQ(probe->data_seen[0].first, at_us(1000));
+  EXPECT_EQ(probe->data_seen[0].second, at_us(1200));
+
+  ASSERT_EQ(probe->fills_seen.size(), 1u);
+  EXPECT_EQ(probe->fills_seen[0], at_us(1900));
+  EXPECT_EQ(sim.get_scheduler().events_run(SimEventType::FILL_NOTIFICATION),
+            1u);
+}
+
+TEST(LatencyModelTest, ZeroLatencyStrategyTradesInline) {
+  TradingSimulator sim;
+  sim.create_account(1, "Probe", 100000.0);
+  seed_book(sim);
+
+  auto strategy = std::make_unique<LatencyProbe>(probe_config(),
+                                                 sim.get_clock());
+  LatencyProbe *probe = strategy.get();
+  sim.add_strategy(std::move(strategy));
+  sim.run_simulation(2);
+
+  ASSERT_EQ(probe->fills_seen.size(), 1u);
+  EXPECT_EQ(probe->fills_seen[0], at_us(1000));
+}
+
+TEST(LatencyModelTest, ManyMessagesInFlightShareOneEvent) {
+  TradingSimulator sim;
+  sim.create_account(1, "Probe", 100000.0);
+  seed_book(sim);
+
+  auto strategy = std::make_unique<LatencyProbe>(probe_config(),
+                                                 sim.get_clock());
+  LatencyProbe *probe = strategy.get();
+  sim.add_strategy(std::move(strategy));
+
+  // Market data takes longer than the whole run, so every update is still
+  // queued at the end
+  sim.set_latency_model(1, LatencyPath::MARKET_DATA,
+                        std::make_unique<FixedLatency>(milliseconds(500)));
+  sim.set_step_interval(microseconds(10));
+  sim.run_simulation(10000);
+
+  EXPECT_TRUE(probe->data_seen.empty());
+  EXPECT_EQ(sim.in_flight(1, LatencyPath::MARKET_DATA), 10000u);
+  EXPECT_EQ(sim.get_scheduler().pending(), 1u); // Just the head's release
+  EXPECT_THROW(sim.in_flight(7, LatencyPath::MARKET_DATA), std::runtime_error);
+}
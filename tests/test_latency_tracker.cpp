@@ -0,0 +1,134 @@
+#include "latency_tracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+TEST(LatencyTrackerTest, SmallValuesAreExact) {
+  LatencyTracker tracker;
+  for (long long v = 1; v <= 100; ++v) {
+    tracker.record(v);
+  }
+  EXPECT_EQ(tracker.count(), 100u);
+  EXPECT_EQ(tracker.percentile(50), 50);
+  EXPECT_EQ(tracker.percentile(99), 99);
+  EXPECT_EQ(tracker.percentile(100), 100);
+  EXPECT_EQ(tracker.percentile(0), 1);
+  EXPECT_EQ(tracker.min(), 1);
+  EXPECT_EQ(tracker.max(), 100);
+  EXPECT_DOUBLE_EQ(tracker.mean(), 50.5);
+}
+
+TEST(LatencyTrackerTest, BucketsTileTheRange) {
+  LatencyTracker::Config config;
+  config.precision_bits = 4;
+  config.max_value_ns = 1'000'000;
+  LatencyTracker tracker(config);
+
+  long long expected_lower = 0;
+  for (std::size_t i = 0; i < tracker.bucket_count(); ++i) {
+    ASSERT_EQ(tracker.bucket_lower(i), expected_lower);
+    ASSERT_EQ(tracker.bucket_index(tracker.bucket_lower(i)), i);
+    ASSERT_EQ(tracker.bucket_index(tracker.bucket_upper(i)), i);
+    expected_lower = tracker.bucket_upper(i) + 1;
+  }
+  EXPECT_EQ(tracker.bucket_index(config.max_value_ns),
+            tracker.bucket_count() - 1);
+}
+
+TEST(LatencyTrackerTest, PercentilesWithinRelativeError) {
+  LatencyTracker tracker;
+  std::mt19937_64 rng(7);
+  std::lognormal_distribution<double> dist(7.0, 1.0);
+  std::vector<long long> samples;
+  for (int i = 0; i < 100000; ++i) {
+    long long v = static_cast<long long>(dist(rng));
+    samples.push_back(v);
+    tracker.record(v);
+  }
+  std::sort(samples.begin(), samples.end());
+
+  for (double p : {50.0, 90.0, 99.0, 99.9}) {
+    auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * samples.size()));
+    long long exact = samples[rank - 1];
+    long long approx = tracker.percentile(p);
+    EXPECT_GE(approx, exact);
+    EXPECT_LE(approx - exact, exact * tracker.relative_error() + 1) << p;
+  }
+}
+
+TEST(LatencyTrackerTest, MergeMatchesSingleTracker) {
+  LatencyTracker combined;
+  LatencyTracker a;
+  LatencyTracker b;
+  std::mt19937_64 rng(3);
+  std::uniform_int_distribution<long long> dist(100, 50000);
+  for (int i = 0; i < 20000; ++i) {
+    long long v = dist(rng);
+    combined.record(v);
+    (i % 2 ? a : b).record(v);
+  }
+  a.merge(b);
+
+  EXPECT_EQ(a.count(), combined.count());
+  EXPECT_EQ(a.min(), combined.min());
+  EXPECT_EQ(a.max(), combined.max());
+  for (double p : {1.0, 50.0, 99.0, 99.99}) {
+    EXPECT_EQ(a.percentile(p), combined.percentile(p));
+  }
+
+  LatencyTracker::Config coarse;
+  coarse.precision_bits = 3;
+  EXPECT_THROW(a.merge(LatencyTracker(coarse)), std::runtime_error);
+}
+
+TEST(LatencyTrackerTest, IntervalResetAndSaturation) {
+  LatencyTracker::Config config;
+  config.max_value_ns = 10000;
+  LatencyTracker tracker(config);
+  tracker.record(500);
+  tracker.record(-5);
+  tracker.record(1'000'000);
+
+  EXPECT_EQ(tracker.saturated(), 1u);
+  EXPECT_EQ(tracker.min(), 0);
+  EXPECT_EQ(tracker.max(), 10000);
+
+  auto interval = tracker.take_interval();
+  EXPECT_EQ(interval.count(), 3u);
+  EXPECT_EQ(tracker.count(), 0u);
+  EXPECT_EQ(tracker.percentile(50), 0);
+
+  tracker.record(42);
+  EXPECT_EQ(tracker.min(), 42);
+  EXPECT_EQ(tracker.percentile(100), 42);
+}
+
+TEST(LatencyTrackerTest, SerializationRoundTrip) {
+  LatencyTracker tracker;
+  for (long long v = 0; v < 100000; v += 37) {
+    tracker.record(v);
+  }
+  tracker.record_n(123456, 10);
+
+  std::stringstream buffer;
+  tracker.serialize(buffer);
+  // Only non-empty buckets are written
+  EXPECT_LT(buffer.str().size(), tracker.bucket_count() * 16);
+
+  auto restored = LatencyTracker::deserialize(buffer);
+  EXPECT_EQ(restored.count(), tracker.count());
+  EXPECT_EQ(restored.min(), tracker.min());
+  EXPECT_EQ(restored.max(), tracker.max());
+  EXPECT_DOUBLE_EQ(restored.mean(), tracker.mean());
+  for (double p : {10.0, 50.0, 99.0, 100.0}) {
+    EXPECT_EQ(restored.percentile(p), tracker.percentile(p));
+  }
+
+  std::stringstream garbage("not a histogram at all, just some text....");
+  EXPECT_THROW(LatencyTracker::deserialize(garbage), std::runtime_error);
+}
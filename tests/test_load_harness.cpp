@@ -0,0 +1,87 @@
+#include "load_harness.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+void spin_for(std::chrono::microseconds duration) {
+  auto until = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < until) {
+  }
+}
+
+LoadHarnessConfig small_config(LoadTarget target) {
+  LoadHarnessConfig config;
+  config.target = target;
+  config.symbols = 3;
+  config.tape.streams = 4;
+  config.warmup_commands = 200;
+  config.measured_commands = 2000;
+  return config;
+}
+
+} // namespace
+
+TEST(LoadHarnessTest, StallIsChargedToQueuedCommands) {
+  std::vector<TapeCommand> tape(1000);
+  std::size_t index = 0;
+  // 10 us apart; command 500 stalls for 2 ms, so ~200 commands queue
+  // behind it while none of them is slow to service
+  LoadRunResult result =
+      run_open_loop(tape, 100000.0, 100, [&index](const TapeCommand &) {
+        if (index++ == 500) {
+          spin_for(std::chrono::microseconds(2000));
+        }
+      });
+
+  EXPECT_EQ(result.commands, 900u);
+  EXPECT_EQ(result.response.count(), 900u);
+  EXPECT_GE(result.response.max(), 2000000);
+  EXPECT_GE(result.max_lag_ns, 1000000);
+  EXPECT_GE(result.response.percentile(90), 100000);
+  EXPECT_LT(result.service.percentile(90), 100000);
+}
+
+TEST(LoadHarnessTest, RejectsBadRuns) {
+  std::vector<TapeCommand> tape(10);
+  auto sink = [](const TapeCommand &) {};
+  EXPECT_THROW(run_open_loop(tape, 0.0, 0, sink), std::runtime_error);
+  EXPECT_THROW(run_open_loop(tape, 1000.0, 10, sink), std::runtime_error);
+
+  LoadHarnessConfig config;
+  config.measured_commands = 0;
+  EXPECT_THROW(LoadHarness harness(config), std::runtime_error);
+}
+
+TEST(LoadHarnessTest, DrivesEveryTarget) {
+  for (LoadTarget target : {LoadTarget::SINGLE_BOOK, LoadTarget::MULTI_SYMBOL,
+                            LoadTarget::SIMULATOR}) {
+    LoadHarness harness(small_config(target));
+    EXPECT_EQ(harness.tape().size(), 2200u);
+
+    LoadRunResult result = harness.run_at(20000.0);
+    EXPECT_EQ(result.response.count(), 2000u) << to_string(target);
+    EXPECT_TRUE(result.sustained) << to_string(target);
+    EXPECT_GT(result.achieved_rate, 19000.0) << to_string(target);
+    EXPECT_GE(result.response.percentile(50),
+              result.service.percentile(50) / 2);
+    EXPECT_TRUE(std::cout.good()); // Engine output unmuted again
+  }
+}
+
+TEST(LoadHarnessTest, SweepStopsAtSaturation) {
+  LoadHarnessConfig config = small_config(LoadTarget::SINGLE_BOOK);
+  config.offered_rates = {20000.0, 1e10, 40000.0};
+  LoadHarness harness(config);
+
+  auto results = harness.run();
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_TRUE(results[0].sustained);
+  EXPECT_FALSE(results[1].sustained);
+  EXPECT_LT(results[1].achieved_rate, 1e10);
+  EXPECT_EQ(LoadHarness::saturation_knee(results), 20000.0);
+}
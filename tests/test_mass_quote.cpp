@@ -0,0 +1,182 @@
+#include "order_book.hpp"
+#include "strategies.hpp"
+#include "trading_simulator.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+MassQuote make_quote(int account, double bid, int bid_qty, double ask,
+                     int ask_qty, int new_bid_id, int new_ask_id) {
+  MassQuote quote;
+  quote.account_id = account;
+  quote.bid_price = bid;
+  quote.bid_quantity = bid_qty;
+  quote.ask_price = ask;
+  quote.ask_quantity = ask_qty;
+  quote.new_bid_id = new_bid_id;
+  quote.new_ask_id = new_ask_id;
+  return quote;
+}
+
+// Requote on top of a previous result, reusing its live order IDs
+MassQuote requote(const MassQuoteResult &previous, int account, double bid,
+                  int bid_qty, double ask, int ask_qty, int new_bid_id,
+                  int new_ask_id) {
+  MassQuote quote =
+      make_quote(account, bid, bid_qty, ask, ask_qty, new_bid_id, new_ask_id);
+  quote.live_bid_id = previous.bid.order_id;
+  quote.live_ask_id = previous.ask.order_id;
+  return quote;
+}
+
+} // namespace
+
+TEST(MassQuoteTest, PlacesBothSidesOnFirstQuote) {
+  OrderBook book("MQ");
+  auto result = book.mass_quote(make_quote(1, 99.0, 10, 101.0, 10, 1, 2));
+
+  EXPECT_EQ(result.bid.action, QuoteAction::NEW);
+  EXPECT_EQ(result.ask.action, QuoteAction::NEW);
+  EXPECT_EQ(result.bid.order_id, 1);
+  EXPECT_EQ(result.ask.order_id, 2);
+  EXPECT_EQ(result.bid.resting_quantity, 10);
+  EXPECT_DOUBLE_EQ(book.get_best_bid()->price, 99.0);
+  EXPECT_DOUBLE_EQ(book.get_best_ask()->price, 101.0);
+}
+
+TEST(MassQuoteTest, ShrinkAtSamePriceKeepsQueuePriority) {
+  OrderBook book("MQ");
+  auto first = book.mass_quote(make_quote(1, 99.0, 10, 101.0, 10, 1, 2));
+
+  // Another account joins behind us at the same bid
+  book.add_order(Order(50, 2, Side::BUY, 99.0, 10));
+
+  auto second = book.mass_quote(requote(first, 1, 99.0, 4, 101.0, 10, 3, 4));
+  EXPECT_EQ(second.bid.action, QuoteAction::AMENDED);
+  EXPECT_EQ(second.bid.order_id, 1);
+  EXPECT_EQ(second.bid.resting_quantity, 4);
+  EXPECT_EQ(second.ask.action, QuoteAction::UNCHANGED);
+  EXPECT_EQ(second.ask.order_id, 2);
+
+  // An incoming sell hits us first, for the reduced size only
+  book.add_order(Order(60, 3, Side::SELL, 99.0, 6));
+  const auto &fills = book.get_fills();
+  ASSERT_EQ(fills.size(), 2u);
+  EXPECT_EQ(fills[0].buy_order_id, 1);
+  EXPECT_EQ(fills[0].quantity, 4);
+  EXPECT_EQ(fills[1].buy_order_id, 50);
+  EXPECT_EQ(fills[1].quantity, 2);
+}
+
+TEST(MassQuoteTest, FokSeesAmendedQuoteSize) {
+  OrderBook book("MQ");
+  auto first = book.mass_quote(make_quote(1, 99.0, 10, 101.0, 100, 1, 2));
+  book.mass_quote(requote(first, 1, 99.0, 10, 101.0, 10, 3, 4));
+
+  // The ask's queue copy still says 100; only 10 are really there
+  Order fok(60, 2, Side::BUY, 101.0, 50, TimeInForce::FOK);
+  book.add_order(fok);
+  EXPECT_EQ(book.get_order(60)->state, OrderState::CANCELLED);
+  EXPECT_EQ(book.get_order(2)->remaining_qty, 10);
+  EXPECT_TRUE(book.get_fills().empty());
+
+  book.add_order(Order(61, 2, Side::BUY, 101.0, 10, TimeInForce::FOK));
+  EXPECT_EQ(book.get_order(61)->state, OrderState::FILLED);
+}
+
+TEST(MassQuoteTest, PriceChangeOrSizeIncreaseReplaces) {
+  OrderBook book("MQ");
+  auto first = book.mass_quote(make_quote(1, 99.0, 10, 101.0, 10, 1, 2));
+
+  auto second =
+      book.mass_quote(requote(first, 1, 99.5, 10, 101.0, 20, 3, 4));
+  EXPECT_EQ(second.bid.action, QuoteAction::REPLACED);
+  EXPECT_EQ(second.bid.order_id, 3);
+  EXPECT_EQ(second.ask.action, QuoteAction::REPLACED);
+  EXPECT_EQ(second.ask.order_id, 4);
+
+  EXPECT_EQ(book.get_order(1)->state, OrderState::CANCELLED);
+  EXPECT_EQ(book.get_order(2)->state, OrderState::CANCELLED);
+  EXPECT_EQ(book.active_bids_count(), 1u);
+  EXPECT_EQ(book.active_asks_count(), 1u);
+  EXPECT_DOUBLE_EQ(book.get_best_bid()->price, 99.5);
+}
+
+TEST(MassQuoteTest, ZeroQuantityPullsSide) {
+  OrderBook book("MQ");
+  auto first = book.mass_quote(make_quote(1, 99.0, 10, 101.0, 10, 1, 2));
+
+  auto second = book.mass_quote(requote(first, 1, 0.0, 0, 101.0, 10, 3, 4));
+  EXPECT_EQ(second.bid.action, QuoteAction::CANCELLED);
+  EXPECT_EQ(second.bid.order_id, 1);
+  EXPECT_EQ(second.bid.resting_quantity, 0);
+  EXPECT_EQ(second.ask.action, QuoteAction::UNCHANGED);
+  EXPECT_EQ(book.active_bids_count(), 0u);
+}
+
+TEST(MassQuoteTest, RejectsCrossedOrForeignQuotesWithoutSideEffects) {
+  OrderBook book("MQ");
+  auto first = book.mass_quote(make_quote(1, 99.0, 10, 101.0, 10, 1, 2));
+
+  auto crossed = book.mass_quote(requote(first, 1, 101.0, 10, 100.0, 10, 3, 4));
+  EXPECT_EQ(crossed.bid.action, QuoteAction::REJECTED);
+  EXPECT_EQ(crossed.ask.action, QuoteAction::REJECTED);
+
+  // Account 2 may not replace account 1's orders
+  auto foreign = book.mass_quote(requote(first, 2, 98.0, 10, 102.0, 10, 5, 6));
+  EXPECT_EQ(foreign.bid.action, QuoteAction::REJECTED);
+  EXPECT_EQ(foreign.ask.action, QuoteAction::REJECTED);
+
+  EXPECT_EQ(book.get_order(1)->state, OrderState::ACTIVE);
+  EXPECT_EQ(book.get_order(2)->state, OrderState::ACTIVE);
+}
+
+TEST(MassQuoteTest, ReportsImmediateExecution) {
+  OrderBook book("MQ");
+  book.add_order(Order(50, 2, Side::SELL, 100.0, 6));
+
+  auto result = book.mass_quote(make_quote(1, 100.0, 10, 101.0, 10, 1, 2));
+  EXPECT_EQ(result.bid.action, QuoteAction::NEW);
+  EXPECT_EQ(result.bid.filled_quantity, 6);
+  EXPECT_EQ(result.bid.resting_quantity, 4);
+}
+
+TEST(MassQuoteTest, MarketMakerKeepsOneQuotePerSide) {
+  TradingSimulator sim("MQ");
+  sim.create_account(1, "Market Maker", 1000000.0);
+  sim.create_account(2, "Liquidity", 1000000.0);
+
+  StrategyConfig config;
+  config.name = "MM";
+  config.account_id = 1;
+  config.symbols = {"MQ"};
+  config.max_position_size = 10000;
+  config.set_parameter("spread_bps", 20.0);
+  config.set_parameter("quote_size", 50.0);
+
+  auto strategy = std::make_unique<MarketMakerStrategy>(config);
+  MarketMakerStrategy *mm = strategy.get();
+  sim.add_strategy(std::move(strategy));
+  mm->initialize();
+
+  OrderBook &book = sim.get_order_book();
+  book.add_order(Order(9001, 2, Side::BUY, 99.0, 10));
+  book.add_order(Order(9002, 2, Side::SELL, 101.0, 10));
+
+  for (int step = 0; step < 20; ++step) {
+    sim.process_step();
+  }
+
+  // Liquidity orders plus exactly one live bid and ask from the strategy
+  EXPECT_EQ(book.active_bids_count(), 2u);
+  EXPECT_EQ(book.active_asks_count(), 2u);
+
+  const auto *quote = mm->get_active_quote("MQ");
+  ASSERT_NE(quote, nullptr);
+  ASSERT_NE(quote->bid_id, 0);
+  ASSERT_NE(quote->ask_id, 0);
+  EXPECT_EQ(book.get_order(quote->bid_id)->account_id, 1);
+  EXPECT_EQ(book.get_order(quote->bid_id)->remaining_qty, 50);
+  EXPECT_LT(quote->bid_price, quote->ask_price);
+}
@@ -0,0 +1,105 @@
+#include "memory_profile.hpp"
+#include "muted_output.hpp"
+#include "order_book.hpp"
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::size_t elements_named(const std::vector<StructureFootprint> &structures,
+                           const std::string &name) {
+  for (const auto &structure : structures) {
+    if (structure.name == name) {
+      return structure.elements;
+    }
+  }
+  return 0;
+}
+
+MemorySoakConfig small_config() {
+  MemorySoakConfig config;
+  config.operations = 20000;
+  config.sample_every = 5000;
+  config.footprint_orders = 2000;
+  return config;
+}
+
+} // namespace
+
+TEST(MemoryProfileTest, CountsThreadAllocations) {
+  ASSERT_TRUE(alloc_counting_enabled());
+
+  AllocCounts before = thread_alloc_counts();
+  auto value = std::make_unique<std::vector<int>>(1000);
+  AllocCounts delta = thread_alloc_counts() - before;
+  EXPECT_EQ(delta.allocations, 2u);
+  EXPECT_GE(delta.bytes_allocated, 1000 * sizeof(int));
+  EXPECT_GE(delta.live_bytes, static_cast<std::int64_t>(1000 * sizeof(int)));
+
+  before = thread_alloc_counts();
+  value.reset();
+  delta = thread_alloc_counts() - before;
+  EXPECT_EQ(delta.allocations, 0u);
+  EXPECT_EQ(delta.frees, 2u);
+  EXPECT_LT(delta.live_bytes, 0);
+
+  EXPECT_GT(resident_set_bytes(), 0u);
+}
+
+TEST(MemoryProfileTest, FootprintTracksBookStructures) {
+  OrderBook book("MEM");
+  {
+    MutedOutput muted;
+    for (int i = 1; i <= 100; ++i) {
+      book.add_order(Order(i, 1, Side::BUY, 99.0 - i * 0.01, 100));
+    }
+    for (int i = 1; i <= 40; ++i) {
+      book.cancel_order(i);
+    }
+  }
+
+  auto structures = book.memory_footprint();
+  EXPECT_EQ(elements_named(structures, "active_orders_"), 60u);
+  EXPECT_EQ(elements_named(structures, "cancelled_orders_"), 40u);
+  EXPECT_EQ(elements_named(structures, "fills_"), 0u);
+  for (const auto &structure : structures) {
+    if (structure.elements > 0) {
+      EXPECT_GT(structure.bytes, 0u) << structure.name;
+    }
+  }
+}
+
+TEST(MemoryProfileTest, SoakAttributesEveryOperation) {
+  MemorySoakReport report = run_memory_soak(small_config());
+  EXPECT_TRUE(std::cout.good()); // Engine output unmuted again
+  EXPECT_TRUE(report.counting);
+
+  std::uint64_t operations = 0;
+  std::uint64_t steady = 0;
+  for (std::size_t i = 0; i < kTapeOpCount; ++i) {
+    operations += report.all[i].operations;
+    steady += report.steady[i].operations;
+    EXPECT_LE(report.all[i].allocating_operations, report.all[i].operations);
+  }
+  EXPECT_EQ(operations, 20000u);
+  EXPECT_EQ(steady, 18000u);
+
+  ASSERT_EQ(report.growth.size(), 4u);
+  EXPECT_EQ(report.growth.back().operations, 20000u);
+  EXPECT_GT(report.growth.back().rss_bytes, 0u);
+  EXPECT_GT(report.heap_bytes_per_order, 0.0);
+  EXPECT_GT(report.estimated_bytes_per_order, 0.0);
+
+  // Order history is retained for the whole session, so it only grows
+  const char *history[] = {"cancelled_orders_", "event_log_",
+                           "insertion_latencies_ns_"};
+  for (const char *name : history) {
+    EXPECT_GE(elements_named(report.growth[3].structures, name),
+              elements_named(report.growth[0].structures, name))
+        << name;
+  }
+}
@@ -0,0 +1,156 @@
+#include "online_metrics.hpp"
+#include "performance_metrics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+TimePoint at(int seconds) { return TimePoint(std::chrono::seconds(seconds)); }
+
+std::vector<double> random_walk(std::size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> step(5.0, 100.0);
+  std::vector<double> pnl;
+  double value = 10000.0;
+  for (std::size_t i = 0; i < n; ++i) {
+    value += step(rng);
+    pnl.push_back(value);
+  }
+  return pnl;
+}
+
+} // namespace
+
+TEST(OnlineMetricsTest, MatchesTwoPassFormulas) {
+  auto pnl = random_walk(5000, 3);
+  OnlinePnlMetrics online;
+  for (std::size_t i = 0; i < pnl.size(); ++i) {
+    online.add(at(static_cast<int>(i)), pnl[i]);
+  }
+
+  std::vector<double> returns;
+  for (std::size_t i = 1; i < pnl.size(); ++i) {
+    returns.push_back((pnl[i] - pnl[i - 1]) / std::abs(pnl[i - 1]));
+  }
+  double mean = 0.0;
+  for (double r : returns) {
+    mean += r;
+  }
+  mean /= returns.size();
+  double var = 0.0;
+  double downside = 0.0;
+  int negatives = 0;
+  for (double r : returns) {
+    var += (r - mean) * (r - mean);
+    if (r < 0.0) {
+      downside += r * r;
+      ++negatives;
+    }
+  }
+  double stddev = std::sqrt(var / returns.size());
+
+  double peak = pnl[0];
+  double max_dd = 0.0;
+  for (double value : pnl) {
+    peak = std::max(peak, value);
+    max_dd = std::max(max_dd, (peak - value) / peak * 100.0);
+  }
+
+  EXPECT_EQ(online.samples(), pnl.size());
+  EXPECT_EQ(online.return_count(), returns.size());
+  EXPECT_NEAR(online.return_statistics().first, mean, 1e-12);
+  EXPECT_NEAR(online.return_statistics().second, stddev, 1e-12);
+  EXPECT_NEAR(online.sharpe_ratio(), mean / stddev * std::sqrt(252.0), 1e-9);
+  EXPECT_NEAR(online.sortino_ratio(),
+              mean / std::sqrt(downside / negatives) * std::sqrt(252.0), 1e-9);
+  EXPECT_NEAR(online.max_drawdown(), max_dd, 1e-9);
+  EXPECT_DOUBLE_EQ(online.total_return(), pnl.back() - pnl.front());
+}
+
+TEST(OnlineMetricsTest, TracksDrawdownDuration) {
+  OnlinePnlMetrics online;
+  online.add(at(0), 100.0);
+  online.add(at(10), 200.0); // Peak
+  online.add(at(15), 150.0);
+  online.add(at(40), 190.0);
+  online.add(at(50), 250.0); // Recovered after 40s below the peak
+  online.add(at(55), 240.0); // Still in a short drawdown
+
+  EXPECT_EQ(online.longest_drawdown(), std::chrono::seconds(30));
+  EXPECT_DOUBLE_EQ(online.max_drawdown_amount(), 50.0);
+  EXPECT_NEAR(online.max_drawdown(), 25.0, 1e-12);
+  EXPECT_TRUE(online.in_drawdown());
+  EXPECT_DOUBLE_EQ(online.current_drawdown_amount(), 10.0);
+
+  online.reset();
+  EXPECT_EQ(online.samples(), 0u);
+  EXPECT_EQ(online.longest_drawdown(), Clock::duration::zero());
+}
+
+TEST(OnlineMetricsTest, DecimatorIsBoundedAndKeepsExtremes) {
+  MinMaxDecimator decimator(64);
+  auto pnl = random_walk(100000, 9);
+  pnl[54321] = 1e9;   // Spike
+  pnl[77777] = -1e9;  // Trough
+  for (std::size_t i = 0; i < pnl.size(); ++i) {
+    decimator.add(at(static_cast<int>(i)), pnl[i]);
+  }
+
+  auto points = decimator.points();
+  EXPECT_LE(points.size(), decimator.capacity());
+  EXPECT_GE(points.size(), decimator.capacity() / 2);
+  EXPECT_EQ(decimator.samples(), pnl.size());
+  EXPECT_TRUE(std::is_sorted(
+      points.begin(), points.end(),
+      [](const auto &a, const auto &b) { return a.first < b.first; }));
+
+  auto by_value = [](const auto &a, const auto &b) {
+    return a.second < b.second;
+  };
+  auto high = *std::max_element(points.begin(), points.end(), by_value);
+  auto low = *std::min_element(points.begin(), points.end(), by_value);
+  EXPECT_EQ(high.first, at(54321));
+  EXPECT_EQ(low.first, at(77777));
+
+  // Short series are kept whole
+  MinMaxDecimator small(64);
+  for (int i = 0; i < 10; ++i) {
+    small.add(at(i), i);
+  }
+  EXPECT_EQ(small.points().size(), 10u);
+}
+
+TEST(OnlineMetricsTest, PerformanceMetricsModes) {
+  auto pnl = random_walk(20000, 5);
+
+  PerformanceMetrics full;
+  PerformanceMetrics decimated;
+  PerformanceMetrics none;
+  decimated.set_timeseries_mode(TimeseriesMode::DECIMATED, 256);
+  none.set_timeseries_mode(TimeseriesMode::NONE);
+
+  for (std::size_t i = 0; i < pnl.size(); ++i) {
+    for (auto *metrics : {&full, &decimated, &none}) {
+      metrics->add_pnl_snapshot(at(static_cast<int>(i)), pnl[i]);
+    }
+  }
+
+  std::vector<Account> accounts;
+  for (auto *metrics : {&full, &decimated, &none}) {
+    metrics->calculate(accounts);
+    EXPECT_EQ(metrics->snapshot_count(), pnl.size());
+    EXPECT_DOUBLE_EQ(metrics->sharpe_ratio, full.sharpe_ratio);
+    EXPECT_DOUBLE_EQ(metrics->max_drawdown, full.max_drawdown);
+    EXPECT_DOUBLE_EQ(metrics->get_sortino_ratio(), full.get_sortino_ratio());
+  }
+
+  EXPECT_EQ(full.plot_series().size(), pnl.size());
+  EXPECT_LE(decimated.plot_series().size(), 256u);
+  EXPECT_TRUE(decimated.pnl_timeseries.empty());
+  EXPECT_TRUE(none.plot_series().empty());
+}
@@ -0,0 +1,245 @@
+#include "order_book.hpp"
+#include "order_flow_model.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+OrderFlowConfig quiet_flow() {
+  OrderFlowConfig config;
+  config.kind_weights = {0.85, 0.03, 0.04, 0.0, 0.05, 0.03}; // No stops
+  config.volatility_ticks = 0.0;
+  return config;
+}
+
+double seconds_since_start(const OrderFlowConfig &config, TimePoint t) {
+  return std::chrono::duration<double>(t - config.start_time).count();
+}
+
+// Variance-to-mean ratio of NEW counts in fixed windows
+double arrival_fano(const OrderFlowConfig &config,
+                    const std::vector<FlowEvent> &events, double window) {
+  std::vector<double> counts;
+  for (const auto &event : events) {
+    if (event.type != EventType::NEW_ORDER) {
+      continue;
+    }
+    auto b = static_cast<std::size_t>(
+        seconds_since_start(config, event.timestamp) / window);
+    if (b >= counts.size()) {
+      counts.resize(b + 1, 0.0);
+    }
+    counts[b] += 1.0;
+  }
+  counts.pop_back(); // Last window is partial
+
+  double mean = 0.0;
+  for (double c : counts) {
+    mean += c;
+  }
+  mean /= counts.size();
+  double var = 0.0;
+  for (double c : counts) {
+    var += (c - mean) * (c - mean);
+  }
+  var /= counts.size() - 1;
+  return var / mean;
+}
+
+} // namespace
+
+TEST(OrderFlowModelTest, RejectsExplosiveOrInvalidConfig) {
+  OrderFlowConfig config;
+  config.excitation = config.decay;
+  EXPECT_THROW(OrderFlowModel{config}, std::runtime_error);
+
+  config = OrderFlowConfig();
+  config.participants.clear();
+  EXPECT_THROW(OrderFlowModel{config}, std::runtime_error);
+
+  config = OrderFlowConfig();
+  config.kind_weights.pop_back();
+  EXPECT_THROW(OrderFlowModel{config}, std::runtime_error);
+}
+
+TEST(OrderFlowModelTest, SameSeedSameFlow) {
+  OrderFlowConfig config = quiet_flow();
+  auto a = OrderFlowModel(config).generate(5000);
+  auto b = OrderFlowModel(config).generate(5000);
+
+  ASSERT_EQ(a.size(), b.size());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(a[i].timestamp, b[i].timestamp);
+    ASSERT_EQ(a[i].order_id, b[i].order_id);
+    ASSERT_EQ(a[i].type, b[i].type);
+  }
+
+  // Time never runs backwards, cancels included
+  for (std::size_t i = 1; i < a.size(); ++i) {
+    ASSERT_GE(a[i].timestamp, a[i - 1].timestamp);
+  }
+}
+
+TEST(OrderFlowModelTest, SelfExcitationClustersArrivals) {
+  OrderFlowConfig bursty = quiet_flow();
+  bursty.baseline_rate = 100.0;
+  bursty.excitation = 1600.0;
+  bursty.decay = 2000.0; // Branching ratio 0.8
+
+  OrderFlowConfig poisson = bursty;
+  poisson.excitation = 0.0;
+  poisson.baseline_rate = 500.0; // Same mean rate
+
+  OrderFlowModel bursty_model(bursty);
+  OrderFlowModel poisson_model(poisson);
+  auto bursty_events = bursty_model.generate(120000);
+  auto poisson_events = poisson_model.generate(120000);
+
+  // Mean rate is baseline / (1 - n) either way
+  double bursty_rate = bursty_model.arrivals() /
+                       seconds_since_start(bursty, bursty_model.now());
+  EXPECT_NEAR(bursty_rate, 500.0, 75.0);
+
+  // Long windows: Fano -> 1 / (1 - n)^2 = 25 for Hawkes, 1 for Poisson
+  double window = 0.5;
+  EXPECT_GT(arrival_fano(bursty, bursty_events, window), 8.0);
+  EXPECT_NEAR(arrival_fano(poisson, poisson_events, window), 1.0, 0.3);
+}
+
+TEST(OrderFlowModelTest, CancelsFollowParticipants) {
+  OrderFlowConfig config = quiet_flow();
+  config.kind_weights = {1.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  config.participants = {{1, 0.5, 1.0, 0.001}, {2, 0.5, 0.0, 0.001}};
+
+  OrderFlowModel model(config);
+  auto events = model.generate(20000);
+
+  std::size_t news[3] = {};
+  std::size_t cancels[3] = {};
+  for (const auto &event : events) {
+    ASSERT_TRUE(event.account_id == 1 || event.account_id == 2);
+    if (event.type == EventType::NEW_ORDER) {
+      ++news[event.account_id];
+    } else {
+      ++cancels[event.account_id];
+    }
+  }
+
+  EXPECT_EQ(cancels[2], 0u);
+  EXPECT_GE(cancels[1] + model.pending_cancels(), news[1]);
+  EXPECT_NEAR(static_cast<double>(news[1]) / (news[1] + news[2]), 0.5, 0.03);
+  EXPECT_EQ(model.cancels(), cancels[1]);
+}
+
+TEST(OrderFlowModelTest, PlacementConcentratesAtTouch) {
+  OrderFlowConfig config = quiet_flow();
+  config.kind_weights = {1.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  config.placement_exponent = 2.5;
+
+  OrderFlowModel model(config);
+  double bid = (std::lround(config.reference_price / config.tick_size) -
+                config.half_spread_ticks) *
+               config.tick_size;
+  double ask = bid + 2 * config.half_spread_ticks * config.tick_size;
+
+  std::size_t at_touch = 0;
+  std::size_t beyond_ten = 0;
+  std::size_t total = 0;
+  for (const auto &event : model.generate(40000)) {
+    if (event.type != EventType::NEW_ORDER) {
+      continue;
+    }
+    double behind = event.side == Side::BUY ? bid - event.price
+                                            : event.price - ask;
+    long ticks = std::lround(behind / config.tick_size);
+    ASSERT_GE(ticks, 0);
+    ASSERT_LT(ticks, static_cast<long>(config.max_distance_ticks));
+    at_touch += ticks == 0;
+    beyond_ten += ticks >= 10;
+    ++total;
+  }
+
+  // (d + 1)^-2.5 puts most mass on the touch and a thin tail past it
+  EXPECT_GT(static_cast<double>(at_touch) / total, 0.55);
+  EXPECT_LT(static_cast<double>(beyond_ten) / total, 0.05);
+}
+
+TEST(OrderFlowModelTest, DrivesOrderBook) {
+  OrderFlowConfig config;
+  config.kind_weights = {0.80, 0.04, 0.04, 0.0, 0.09, 0.03};
+
+  OrderBook book;
+  OrderFlowModel model(config);
+  model.drive(book, 20000);
+
+  EXPECT_GT(book.get_fills().size(), 0u);
+  auto bid = book.get_best_bid();
+  auto ask = book.get_best_ask();
+  ASSERT_TRUE(bid && ask);
+  EXPECT_LT(bid->price, ask->price);
+  EXPECT_GT(model.cancels(), model.arrivals() / 2);
+}
+
+TEST(OrderFlowModelTest, CalibratesFromEventLog) {
+  OrderFlowConfig truth = quiet_flow();
+  truth.baseline_rate = 150.0;
+  truth.excitation = 1050.0;
+  truth.decay = 1500.0; // Branching ratio 0.7
+  truth.placement_exponent = 2.0;
+  truth.participants = {{11, 0.7, 0.9, 0.010}, {12, 0.3, 0.2, 1.000}};
+
+  // Drive a book and log what was sent, with model timestamps
+  std::string filename = "test_order_flow_log.csv";
+  {
+    std::ofstream file(filename);
+    file << OrderEvent::csv_header() << "\n";
+    OrderBook book;
+    OrderFlowModel model(truth);
+    for (int i = 0; i < 60000; ++i) {
+      model.anchor(book);
+      FlowEvent event = model.next();
+      apply_flow_event(book, event);
+      file << event.to_order_event().to_csv() << "\n";
+    }
+  }
+
+  OrderFlowConfig fitted = calibrate_order_flow(filename);
+  std::filesystem::remove(filename);
+
+  EXPECT_NEAR(fitted.branching_ratio(), truth.branching_ratio(), 0.15);
+  double truth_rate = truth.baseline_rate / (1.0 - truth.branching_ratio());
+  double fitted_rate =
+      fitted.baseline_rate / (1.0 - fitted.branching_ratio());
+  EXPECT_NEAR(fitted_rate, truth_rate, 0.15 * truth_rate);
+  EXPECT_NEAR(fitted.placement_exponent, truth.placement_exponent, 0.25);
+
+  double total = 0.0;
+  for (double w : fitted.kind_weights) {
+    total += w;
+  }
+  EXPECT_NEAR(fitted.kind_weights[0] / total, 0.85 * 0.99, 0.03);
+  EXPECT_NEAR(fitted.kind_weights[3] / total, 0.01, 1e-9); // Base's stops
+
+  ASSERT_EQ(fitted.participants.size(), 2u);
+  for (const auto &participant : fitted.participants) {
+    const FlowParticipant &expected =
+        participant.account_id == 11 ? truth.participants[0]
+                                     : truth.participants[1];
+    EXPECT_NEAR(participant.weight, expected.weight, 0.03);
+    // Orders filled before their cancel fell due are never cancelled
+    EXPECT_LE(participant.cancel_probability,
+              expected.cancel_probability + 0.03);
+    EXPECT_GT(participant.cancel_probability,
+              expected.cancel_probability * 0.5);
+    EXPECT_NEAR(participant.mean_cancel_latency, expected.mean_cancel_latency,
+                0.5 * expected.mean_cancel_latency);
+  }
+
+  EXPECT_THROW(calibrate_order_flow("missing_flow_log.csv"),
+               std::runtime_error);
+}
@@ -0,0 +1,170 @@
+#include "order_book.hpp"
+#include "order_tape.hpp"
+#include "worker_pool.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+OrderTapeConfig small_tape(std::uint64_t commands = 50000) {
+  OrderTapeConfig config;
+  config.commands = commands;
+  config.streams = 16;
+  config.block_size = 512;
+  return config;
+}
+
+bool same_tape(const std::vector<TapeCommand> &a,
+               const std::vector<TapeCommand> &b) {
+  return a.size() == b.size() &&
+         std::memcmp(a.data(), b.data(), a.size() * sizeof(TapeCommand)) == 0;
+}
+
+} // namespace
+
+TEST(OrderTapeTest, PhiloxIsAPureFunctionOfCounterAndKey) {
+  auto a = Philox4x32::generate(7, 0, 42);
+  auto b = Philox4x32::generate(7, 0, 42);
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, Philox4x32::generate(8, 0, 42));
+  EXPECT_NE(a, Philox4x32::generate(7, 0, 43));
+
+  // Jumping straight to a counter matches walking there
+  CounterRng walked(42);
+  for (int i = 0; i < 4 * 7; ++i) {
+    walked.next_u32();
+  }
+  CounterRng jumped(42, 7);
+  EXPECT_EQ(walked.next_u32(), jumped.next_u32());
+}
+
+TEST(OrderTapeTest, OutputIndependentOfThreadCount) {
+  OrderTapeConfig config = small_tape();
+  auto serial = generate_order_tape(config);
+
+  WorkerPool two(2);
+  WorkerPool four(4);
+  EXPECT_TRUE(same_tape(serial, generate_order_tape(config, &two)));
+  EXPECT_TRUE(same_tape(serial, generate_order_tape(config, &four)));
+
+  config.seed += 1;
+  EXPECT_FALSE(same_tape(serial, generate_order_tape(config)));
+}
+
+TEST(OrderTapeTest, ChunkedGenerationMatchesSinglePass) {
+  OrderTapeConfig config = small_tape();
+  auto whole = generate_order_tape(config);
+
+  OrderTapeGenerator generator(config);
+  WorkerPool pool(3);
+  std::vector<TapeCommand> chunked(config.commands);
+  std::size_t written = 0;
+  while (!generator.done()) {
+    written += generator.generate(chunked.data() + written, 777, &pool);
+  }
+
+  EXPECT_EQ(written, config.commands);
+  EXPECT_TRUE(same_tape(whole, chunked));
+}
+
+TEST(OrderTapeTest, CommandMixFollowsConfig) {
+  OrderTapeConfig config = small_tape(200000);
+  auto tape = generate_order_tape(config);
+
+  std::size_t counts[5] = {};
+  for (const auto &command : tape) {
+    ++counts[static_cast<int>(command.op)];
+    if (command.op == TapeOp::NEW_LIMIT || command.op == TapeOp::NEW_IOC ||
+        command.op == TapeOp::AMEND) {
+      ASSERT_GT(command.price_ticks, 0); // Amends move the price too
+    }
+    ASSERT_LT(command.account, config.account_base + config.streams);
+  }
+
+  // Streams own contiguous runs, not interleaved records
+  for (std::size_t i = 0; i < tape.size(); ++i) {
+    std::size_t stream = i / kTapeStreamRun % config.streams;
+    ASSERT_EQ(tape[i].account, config.account_base + stream);
+  }
+
+  double n = static_cast<double>(tape.size());
+  EXPECT_NEAR(counts[static_cast<int>(TapeOp::CANCEL)] / n,
+              config.cancel_ratio, 0.01);
+  EXPECT_NEAR(counts[static_cast<int>(TapeOp::AMEND)] / n,
+              config.amend_ratio, 0.01);
+  EXPECT_NEAR(counts[static_cast<int>(TapeOp::NEW_MARKET)] / n,
+              config.market_ratio, 0.01);
+  EXPECT_NEAR(counts[static_cast<int>(TapeOp::NEW_IOC)] / n,
+              config.ioc_ratio, 0.01);
+}
+
+TEST(OrderTapeTest, NothingToCancelRestsALimit) {
+  OrderTapeConfig config = small_tape(100000);
+  config.live_orders_per_stream = 0; // Never a cancel or amend target
+  auto tape = generate_order_tape(config);
+
+  std::size_t counts[5] = {};
+  for (const auto &command : tape) {
+    ++counts[static_cast<int>(command.op)];
+  }
+  double n = static_cast<double>(tape.size());
+  EXPECT_EQ(counts[static_cast<int>(TapeOp::CANCEL)], 0u);
+  EXPECT_EQ(counts[static_cast<int>(TapeOp::AMEND)], 0u);
+  EXPECT_NEAR(counts[static_cast<int>(TapeOp::NEW_MARKET)] / n,
+              config.market_ratio, 0.01);
+  EXPECT_NEAR(counts[static_cast<int>(TapeOp::NEW_LIMIT)] / n,
+              1.0 - config.market_ratio - config.ioc_ratio, 0.01);
+}
+
+TEST(OrderTapeTest, FileRoundTrip) {
+  std::string filename = "test_order_tape.bin";
+  OrderTapeConfig config = small_tape(10000);
+
+  WorkerPool pool(2);
+  write_order_tape(filename, config, &pool, 1000);
+
+  OrderTapeHeader header{};
+  auto loaded = load_order_tape(filename, &header);
+  EXPECT_EQ(header.count, config.commands);
+  EXPECT_EQ(header.seed, config.seed);
+  EXPECT_EQ(header.record_size, sizeof(TapeCommand));
+  EXPECT_TRUE(same_tape(loaded, generate_order_tape(config)));
+
+  // Reader hands the tape out in pieces
+  OrderTapeReader reader(filename);
+  std::vector<TapeCommand> buffer(3000);
+  std::size_t total = 0;
+  while (std::size_t n = reader.read(buffer.data(), buffer.size())) {
+    EXPECT_EQ(std::memcmp(buffer.data(), loaded.data() + total,
+                          n * sizeof(TapeCommand)),
+              0);
+    total += n;
+  }
+  EXPECT_EQ(total, config.commands);
+
+  std::filesystem::remove(filename);
+  EXPECT_THROW(OrderTapeReader("missing_tape.bin"), std::runtime_error);
+}
+
+TEST(OrderTapeTest, ReplaysIntoOrderBook) {
+  OrderTapeConfig config = small_tape(20000);
+  auto tape = generate_order_tape(config);
+
+  OrderBook book;
+  for (const auto &command : tape) {
+    apply_tape_command(book, command, config.tick_size);
+  }
+
+  EXPECT_GT(book.get_fills().size(), 0u);
+  EXPECT_GT(book.bids_size(), 0u);
+  EXPECT_GT(book.asks_size(), 0u);
+
+  auto bid = book.get_best_bid();
+  auto ask = book.get_best_ask();
+  ASSERT_TRUE(bid && ask);
+  EXPECT_LT(bid->price, ask->price);
+}
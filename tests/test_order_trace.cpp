@@ -0,0 +1,111 @@
+#include "order_book.hpp"
+#include "order_trace.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace {
+
+std::size_t index(TraceStage stage) { return static_cast<std::size_t>(stage); }
+
+} // namespace
+
+TEST(OrderTraceTest, NestedScopesCountExclusiveTime) {
+  OrderPathTracer tracer(1); // Capture every order
+  {
+    OrderTraceScope order(&tracer, 7);
+    TraceScope outer(&tracer, TraceStage::MATCHING);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    {
+      TraceScope inner(&tracer, TraceStage::FEE_CALC);
+      std::this_thread::sleep_for(std::chrono::milliseconds(4));
+    }
+  }
+
+  auto slow = tracer.slow_orders();
+  ASSERT_EQ(slow.size(), 1u);
+  const auto &breakdown = slow[0];
+  EXPECT_EQ(breakdown.order_id, 7);
+  EXPECT_EQ(breakdown.stage_hits[index(TraceStage::MATCHING)], 1u);
+  EXPECT_EQ(breakdown.stage_hits[index(TraceStage::FEE_CALC)], 1u);
+
+  long long matching = breakdown.stage_ns[index(TraceStage::MATCHING)];
+  long long fees = breakdown.stage_ns[index(TraceStage::FEE_CALC)];
+  EXPECT_GE(fees, 3'900'000);
+  EXPECT_GE(matching, 1'900'000);
+  EXPECT_LT(matching, fees); // Inner time not charged to the outer stage
+  EXPECT_GE(breakdown.total_ns, matching + fees);
+
+  EXPECT_EQ(tracer.stage(TraceStage::MATCHING).count(), 1u);
+  EXPECT_EQ(tracer.total().count(), 1u);
+}
+
+TEST(OrderTraceTest, NestedOrdersFoldIntoOuter) {
+  OrderPathTracer tracer;
+  {
+    OrderTraceScope outer(&tracer, 1);
+    { TraceScope stage(&tracer, TraceStage::STOP_HANDLING); }
+    {
+      OrderTraceScope triggered(&tracer, 2);
+      TraceScope stage(&tracer, TraceStage::MATCHING);
+    }
+  }
+  EXPECT_EQ(tracer.total().count(), 1u);
+  EXPECT_EQ(tracer.stage(TraceStage::STOP_HANDLING).count(), 1u);
+  EXPECT_EQ(tracer.stage(TraceStage::MATCHING).count(), 1u);
+
+  // Scopes outside an order are ignored
+  { TraceScope stray(&tracer, TraceStage::EVENT_LOG); }
+  EXPECT_EQ(tracer.stage(TraceStage::EVENT_LOG).count(), 0u);
+}
+
+TEST(OrderTraceTest, SlowPathKeepsNewestWithinCapacity) {
+  OrderPathTracer tracer(1, 3);
+  for (int id = 1; id <= 5; ++id) {
+    OrderTraceScope order(&tracer, id);
+  }
+  EXPECT_EQ(tracer.slow_order_count(), 5u);
+  auto slow = tracer.slow_orders();
+  ASSERT_EQ(slow.size(), 3u);
+  EXPECT_EQ(slow[0].order_id, 3);
+  EXPECT_EQ(slow[2].order_id, 5);
+
+  tracer.set_slow_threshold(0);
+  { OrderTraceScope order(&tracer, 6); }
+  EXPECT_EQ(tracer.slow_order_count(), 5u);
+}
+
+TEST(OrderTraceTest, OrderBookRecordsStagesAcrossThePath) {
+  OrderBook book("TEST");
+  book.set_fee_schedule(0.0001, 0.0002);
+  book.enable_logging();
+  int callbacks = 0;
+  book.get_fill_router().register_fill_callback(
+      [&](const EnhancedFill &) { ++callbacks; });
+
+  OrderPathTracer &tracer = book.enable_tracing(1);
+  book.add_order(Order(1, 100, Side::SELL, 100.0, 50));
+  book.add_order(Order(2, 200, Side::BUY, 100.0, 50));
+  book.add_order(Order(3, 200, Side::BUY, 101.0, 10, TimeInForce::FOK));
+
+  EXPECT_EQ(callbacks, 1);
+  EXPECT_EQ(tracer.total().count(), 3u);
+  EXPECT_EQ(tracer.stage(TraceStage::ORDER_INSERT).count(), 3u);
+  EXPECT_EQ(tracer.stage(TraceStage::MATCHING).count(), 3u);
+  EXPECT_EQ(tracer.stage(TraceStage::EVENT_LOG).count(), 3u);
+  EXPECT_EQ(tracer.stage(TraceStage::FILL_ROUTING).count(), 1u);
+  EXPECT_EQ(tracer.stage(TraceStage::FEE_CALC).count(), 1u);
+  EXPECT_EQ(tracer.stage(TraceStage::CALLBACKS).count(), 1u);
+  EXPECT_EQ(tracer.stage(TraceStage::STOP_HANDLING).count(), 1u);
+  EXPECT_EQ(tracer.stage(TraceStage::VALIDATION).count(), 1u);
+
+  auto slow = tracer.slow_orders();
+  ASSERT_EQ(slow.size(), 3u);
+  EXPECT_EQ(slow[1].order_id, 2);
+  EXPECT_GT(slow[1].stage_hits[index(TraceStage::FILL_ROUTING)], 0u);
+
+  book.disable_tracing();
+  EXPECT_EQ(book.tracer(), nullptr);
+  book.add_order(Order(4, 100, Side::SELL, 105.0, 10));
+}
@@ -0,0 +1,216 @@
+#include "pair_statistics.hpp"
+#include "strategies.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Moments {
+  double mean_x, mean_y, var_x, var_y, cov;
+};
+
+// Population moments of the last `period` samples, computed from scratch
+Moments brute_force(const std::vector<double> &xs, const std::vector<double> &ys,
+                    std::size_t end, std::size_t period) {
+  std::size_t begin = end > period ? end - period : 0;
+  double n = static_cast<double>(end - begin);
+  Moments m{0, 0, 0, 0, 0};
+  for (std::size_t i = begin; i < end; ++i) {
+    m.mean_x += xs[i] / n;
+    m.mean_y += ys[i] / n;
+  }
+  for (std::size_t i = begin; i < end; ++i) {
+    m.var_x += (xs[i] - m.mean_x) * (xs[i] - m.mean_x) / n;
+    m.var_y += (ys[i] - m.mean_y) * (ys[i] - m.mean_y) / n;
+    m.cov += (xs[i] - m.mean_x) * (ys[i] - m.mean_y) / n;
+  }
+  return m;
+}
+
+// y = 5 + beta * x + noise, with x a random walk around 100
+void cointegrated(std::size_t n, double beta, unsigned seed,
+                  std::vector<double> &xs, std::vector<double> &ys) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> step(0.0, 0.5);
+  std::normal_distribution<double> noise(0.0, 0.2);
+  double x = 100.0;
+  for (std::size_t i = 0; i < n; ++i) {
+    x += step(rng);
+    xs.push_back(x);
+    ys.push_back(5.0 + beta * x + noise(rng));
+  }
+}
+
+StrategyConfig pair_config(const std::string &y, const std::string &x) {
+  StrategyConfig config;
+  config.name = "Pairs";
+  config.account_id = 1;
+  config.symbols = {y, x};
+  config.max_position_size = 10000;
+  config.set_parameter("formation_period", 30.0);
+  return config;
+}
+
+MarketDataSnapshot tick(const std::string &symbol, double price,
+                        TimePoint timestamp) {
+  MarketDataSnapshot snapshot;
+  snapshot.symbol = symbol;
+  snapshot.last_price = price;
+  snapshot.timestamp = timestamp;
+  return snapshot;
+}
+
+} // namespace
+
+TEST(PairStatisticsTest, RollingMomentsMatchBruteForce) {
+  std::vector<double> xs, ys;
+  cointegrated(500, 1.5, 7, xs, ys);
+
+  RollingCovariance rolling(25);
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    rolling.update(xs[i], ys[i]);
+    Moments expected = brute_force(xs, ys, i + 1, 25);
+
+    EXPECT_NEAR(rolling.mean_x(), expected.mean_x, 1e-9);
+    EXPECT_NEAR(rolling.mean_y(), expected.mean_y, 1e-9);
+    EXPECT_NEAR(rolling.variance_x(), expected.var_x, 1e-7);
+    EXPECT_NEAR(rolling.variance_y(), expected.var_y, 1e-7);
+    EXPECT_NEAR(rolling.covariance(), expected.cov, 1e-7);
+  }
+  EXPECT_TRUE(rolling.is_ready());
+}
+
+TEST(PairStatisticsTest, HedgeRatiosRecoverTrueBeta) {
+  std::vector<double> xs, ys;
+  cointegrated(2000, 1.5, 11, xs, ys);
+
+  PairStatistics stats(200, 100.0);
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    stats.update(ys[i], xs[i]);
+  }
+
+  EXPECT_NEAR(stats.hedge_ratio(HedgeRatioMethod::ROLLING_OLS), 1.5, 0.05);
+  EXPECT_NEAR(stats.hedge_ratio(HedgeRatioMethod::EXPONENTIAL), 1.5, 0.05);
+  EXPECT_NEAR(stats.residual_stddev(HedgeRatioMethod::ROLLING_OLS), 0.2, 0.05);
+
+  // A 1.0 shock to y is roughly five residual standard deviations
+  double z = stats.zscore(ys.back() + 1.0, xs.back(),
+                          HedgeRatioMethod::ROLLING_OLS);
+  EXPECT_GT(z, 3.0);
+}
+
+TEST(PairStatisticsTest, SharedInstanceSamplesEachUpdateOnce) {
+  PairStatisticsRegistry registry;
+  auto a = registry.acquire("Y", "X", 10, 5.0);
+  auto b = registry.acquire("Y", "X", 10, 5.0);
+  auto c = registry.acquire("X", "Y", 10, 5.0);
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(registry.size(), 2u);
+
+  TimePoint t0 = Clock::now();
+  EXPECT_TRUE(a->on_price(PairLeg::HEDGE, 100.0, t0));
+  EXPECT_TRUE(a->on_price(PairLeg::DEPENDENT, 150.0, t0));
+  EXPECT_EQ(a->rolling().count(), 1u);
+
+  // The same update seen through the second sharer is ignored
+  EXPECT_FALSE(b->on_price(PairLeg::DEPENDENT, 150.0, t0));
+  EXPECT_EQ(a->rolling().count(), 1u);
+
+  // One leg moving alone waits for the other; the latest prices pair up
+  TimePoint t1 = t0 + std::chrono::milliseconds(1);
+  EXPECT_TRUE(b->on_price(PairLeg::DEPENDENT, 151.0, t1));
+  EXPECT_TRUE(b->on_price(PairLeg::DEPENDENT, 152.0,
+                          t1 + std::chrono::milliseconds(1)));
+  EXPECT_EQ(a->rolling().count(), 1u);
+  EXPECT_TRUE(a->on_price(PairLeg::HEDGE, 101.0, t1));
+  EXPECT_EQ(a->rolling().count(), 2u);
+  EXPECT_DOUBLE_EQ(a->last_y(), 152.0);
+  EXPECT_DOUBLE_EQ(a->rolling().mean_y(), 151.0);
+  EXPECT_DOUBLE_EQ(a->rolling().mean_x(), 100.5);
+}
+
+TEST(PairStatisticsTest, StrategyTradesBothLegsOnSpreadDivergence) {
+  std::vector<double> xs, ys;
+  cointegrated(60, 2.0, 3, xs, ys);
+
+  auto registry = std::make_shared<PairStatisticsRegistry>();
+  PairsTradingStrategy strategy(pair_config("YYY", "XXX"), registry);
+  PairsTradingStrategy sharer(pair_config("YYY", "XXX"), registry);
+  strategy.initialize();
+  sharer.initialize();
+  EXPECT_EQ(&strategy.get_pair_statistics(), &sharer.get_pair_statistics());
+
+  TimePoint t = Clock::now();
+  auto feed = [&](double y, double x) {
+    t += std::chrono::milliseconds(1);
+    for (PairsTradingStrategy *s : {&strategy, &sharer}) {
+      s->on_market_data(tick("XXX", x, t));
+      s->on_market_data(tick("YYY", y, t));
+    }
+  };
+
+  std::vector<TradingSignal> signals;
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    feed(ys[i], xs[i]);
+  }
+  // One sample per tick, shared by both strategies
+  EXPECT_EQ(strategy.get_pair_statistics().rolling().count(), 30u);
+  EXPECT_EQ(strategy.get_pair_statistics().exponential().count(), 60u);
+  EXPECT_NEAR(strategy.get_hedge_ratio(), 2.0, 0.2);
+
+  // Blow the spread out: y rich versus x -> sell y, buy ~2x of x
+  feed(ys.back() + 5.0, xs.back());
+  strategy.generate_signals(signals);
+  ASSERT_EQ(signals.size(), 2u);
+  EXPECT_EQ(signals[0].type, SignalType::SELL);
+  EXPECT_EQ(strategy.symbol_of(signals[0].instrument), "YYY");
+  EXPECT_EQ(signals[0].suggested_quantity, 100);
+  EXPECT_EQ(signals[0].reason, SignalReason::PAIR_SPREAD_HIGH);
+  EXPECT_EQ(signals[1].type, SignalType::BUY);
+  EXPECT_EQ(strategy.symbol_of(signals[1].instrument), "XXX");
+  EXPECT_EQ(signals[1].suggested_quantity,
+            std::lround(100 * strategy.get_hedge_ratio()));
+  int hedge_filled = signals[1].suggested_quantity - 10;
+
+  // Nothing has filled yet: the trade is working, not held
+  EXPECT_EQ(strategy.get_spread_target(), -1);
+  EXPECT_EQ(strategy.get_spread_position(), 0);
+  signals.clear();
+  strategy.generate_signals(signals);
+  EXPECT_TRUE(signals.empty()); // No second entry while the first works
+
+  // y fills in full, the hedge only partly
+  strategy.on_execution(Fill(1, 2, 150.0, 100),
+                        FillContext(2, Side::SELL, "YYY", false, 0.0));
+  strategy.on_execution(Fill(7, 8, 75.0, hedge_filled),
+                        FillContext(7, Side::BUY, "XXX", false, 0.0));
+  EXPECT_EQ(strategy.get_spread_position(), -1);
+  EXPECT_EQ(strategy.get_hedge_position(), hedge_filled);
+
+  // Spread snaps back -> close what actually filled
+  for (int i = 0; i < 5; ++i) {
+    feed(ys.back(), xs.back());
+  }
+  signals.clear();
+  strategy.generate_signals(signals);
+  ASSERT_EQ(signals.size(), 2u);
+  EXPECT_EQ(signals[0].type, SignalType::CLOSE_SHORT);
+  EXPECT_EQ(signals[0].suggested_quantity, 100);
+  EXPECT_EQ(signals[1].type, SignalType::CLOSE_LONG);
+  EXPECT_EQ(signals[1].suggested_quantity, hedge_filled);
+  EXPECT_EQ(signals[1].reason, SignalReason::PAIR_SPREAD_REVERTED);
+  EXPECT_EQ(strategy.get_spread_target(), 0);
+  EXPECT_EQ(strategy.get_spread_position(), -1); // Until the closes fill
+
+  strategy.on_execution(Fill(3, 4, 150.0, 100),
+                        FillContext(3, Side::BUY, "YYY", false, 0.0));
+  strategy.on_execution(Fill(5, 6, 75.0, hedge_filled),
+                        FillContext(6, Side::SELL, "XXX", false, 0.0));
+  EXPECT_EQ(strategy.get_spread_position(), 0);
+  EXPECT_EQ(strategy.get_hedge_position(), 0);
+}
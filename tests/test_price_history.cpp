@@ -0,0 +1,94 @@
+#include "price_history.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<double> to_vector(const PriceWindow &window) {
+  std::vector<double> out;
+  for (double p : window.first) {
+    out.push_back(p);
+  }
+  for (double p : window.second) {
+    out.push_back(p);
+  }
+  return out;
+}
+
+} // namespace
+
+TEST(PriceHistoryStoreTest, CapacityRoundsUpToPowerOfTwo) {
+  EXPECT_EQ(PriceHistoryStore(1000).capacity(), 1024u);
+  EXPECT_EQ(PriceHistoryStore(64).capacity(), 64u);
+  EXPECT_EQ(PriceHistoryStore(1).capacity(), 1u);
+}
+
+TEST(PriceHistoryStoreTest, InternsDenseIds) {
+  PriceHistoryStore store(8);
+  InstrumentId a = store.intern("AAA");
+  InstrumentId b = store.intern("BBB");
+
+  EXPECT_EQ(a, 0u);
+  EXPECT_EQ(b, 1u);
+  EXPECT_EQ(store.intern("AAA"), a);
+  EXPECT_EQ(store.symbol(b), "BBB");
+  EXPECT_FALSE(store.find("CCC").has_value());
+}
+
+TEST(PriceHistoryStoreTest, WindowWrapsIntoTwoSpans) {
+  PriceHistoryStore store(8);
+  InstrumentId id = store.intern("SYM");
+
+  for (int i = 1; i <= 5; ++i) {
+    store.push(id, i);
+  }
+  PriceWindow window = store.window(id);
+  EXPECT_EQ(window.second.size, 0u);
+  EXPECT_EQ(to_vector(window), (std::vector<double>{1, 2, 3, 4, 5}));
+
+  for (int i = 6; i <= 11; ++i) {
+    store.push(id, i);
+  }
+  window = store.window(id);
+  EXPECT_EQ(store.size(id), 8u);
+  EXPECT_EQ(window.first.size, 5u); // slots 3..7
+  EXPECT_EQ(window.second.size, 3u); // slots 0..2
+  EXPECT_EQ(to_vector(window),
+            (std::vector<double>{4, 5, 6, 7, 8, 9, 10, 11}));
+  EXPECT_DOUBLE_EQ(store.last(id), 11.0);
+
+  PriceWindow last4 = store.last_n(id, 4);
+  EXPECT_EQ(to_vector(last4), (std::vector<double>{8, 9, 10, 11}));
+  EXPECT_EQ(to_vector(window.tail(2)), (std::vector<double>{10, 11}));
+  EXPECT_EQ(to_vector(window.tail(5)), (std::vector<double>{7, 8, 9, 10, 11}));
+}
+
+TEST(PriceHistoryStoreTest, InstrumentsAreIndependent) {
+  PriceHistoryStore store(4);
+  InstrumentId a = store.intern("AAA");
+  InstrumentId b = store.intern("BBB");
+
+  store.push(a, 1.0);
+  store.push(b, 2.0);
+  store.push(a, 3.0);
+
+  EXPECT_EQ(to_vector(store.window(a)), (std::vector<double>{1.0, 3.0}));
+  EXPECT_EQ(to_vector(store.window(b)), (std::vector<double>{2.0}));
+  EXPECT_DOUBLE_EQ(store.last(b), 2.0);
+}
+
+TEST(PriceHistoryStoreTest, WindowsSurviveInterning) {
+  PriceHistoryStore store(4);
+  InstrumentId a = store.intern("AAA");
+  store.push(a, 1.0);
+  store.push(a, 2.0);
+  PriceWindow window = store.window(a);
+
+  for (int i = 0; i < 100; ++i) {
+    store.intern("SYM" + std::to_string(i));
+  }
+  EXPECT_EQ(window.first.data, store.window(a).first.data);
+  EXPECT_EQ(to_vector(window), (std::vector<double>{1.0, 2.0}));
+}
@@ -1,7 +1,10 @@
 // tests/test_replay_engine.cpp
+#include "event_log.hpp"
 #include "replay_engine.hpp"
 #include "test_helpers.hpp"
+#include "trading_simulator.hpp"
 #include <filesystem>
+#include <fstream>
 
 class ReplayTest : public ::testing::Test {
 protected:
@@ -83,3 +86,142 @@ TEST_F(ReplayTest, ReplayValidation) {
   // Should validate successfully
   EXPECT_NO_THROW(replay->validate_against_original(original_fills));
 }
+
+namespace {
+
+TimePoint at_ms(double ms) {
+  return TimePoint(std::chrono::duration_cast<Duration>(
+      std::chrono::duration<double, std::milli>(ms)));
+}
+
+void write_log(const std::string &filename,
+               const std::vector<OrderEvent> &events) {
+  std::ofstream file(filename);
+  file << OrderEvent::csv_header() << "\n";
+  for (const auto &event : events) {
+    file << event.to_csv() << "\n";
+  }
+}
+
+// Lifts the replayed ask once, on the first tick
+class LiftOnce : public Strategy {
+public:
+  explicit LiftOnce(const StrategyConfig &config) : Strategy(config) {}
+
+  void on_market_data(const MarketDataSnapshot &) override {}
+  void on_fill(const Fill &fill) override {
+    update_stats(fill);
+    fills.push_back(fill);
+  }
+  void generate_signals(std::vector<TradingSignal> &signals) override {
+    if (sent_) {
+      return;
+    }
+    sent_ = true;
+    TradingSignal signal(SignalType::BUY, instrument_id("SIM"));
+    signal.target_price = 101.0;
+    signal.suggested_quantity = 3;
+    signals.push_back(signal);
+  }
+
+  std::vector<Fill> fills;
+
+private:
+  bool sent_ = false;
+};
+
+} // namespace
+
+TEST_F(ReplayTest, EventLogReaderStreamsEvents) {
+  write_log(events_file,
+            {OrderEvent(at_ms(1), 1, Side::SELL, OrderType::LIMIT,
+                        TimeInForce::GTC, 101.0, 10, 0, 7),
+             OrderEvent(at_ms(2), EventType::CANCEL_ORDER, 1, 7)});
+
+  EventLogReader reader(events_file);
+  auto first = reader.next();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(first->type, EventType::NEW_ORDER);
+  EXPECT_EQ(first->account_id, 7);
+  EXPECT_EQ(first->timestamp, at_ms(1));
+
+  auto second = reader.next();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(second->type, EventType::CANCEL_ORDER);
+  EXPECT_FALSE(reader.next().has_value());
+  EXPECT_EQ(reader.events_read(), 2u);
+
+  EXPECT_THROW(EventLogReader("missing_events.csv"), std::runtime_error);
+}
+
+TEST_F(ReplayTest, SimulatorTradesAgainstReplayedFlow) {
+  // Recorded at 1s..1.0055s; replayed from virtual time 0
+  write_log(events_file,
+            {OrderEvent(at_ms(1000), 1, Side::SELL, OrderType::LIMIT,
+                        TimeInForce::GTC, 101.0, 10, 0, 1),
+             OrderEvent(at_ms(1000), 2, Side::BUY, OrderType::LIMIT,
+                        TimeInForce::GTC, 99.0, 10, 0, 2),
+             OrderEvent(at_ms(1002.5), 3, Side::BUY, OrderType::LIMIT,
+                        TimeInForce::GTC, 101.0, 4, 0, 3),
+             OrderEvent(at_ms(1005.5), EventType::CANCEL_ORDER, 1, 1)});
+
+  TradingSimulator sim;
+  sim.create_account(1, "Lifter", 100000.0);
+  StrategyConfig config;
+  config.name = "Lifter";
+  config.account_id = 1; // Same number as a replayed account, on purpose
+  config.symbols = {"SIM"};
+  auto strategy = std::make_unique<LiftOnce>(config);
+  LiftOnce *lifter = strategy.get();
+  sim.add_strategy(std::move(strategy));
+
+  sim.add_replay("SIM", events_file);
+  sim.run_simulation(10);
+
+  EXPECT_EQ(sim.replayed_events("SIM"), 4u);
+
+  // The strategy lifted 3 of the replayed offer at 1ms; the replayed
+  // buyer took 4 more at 2.5ms; the cancel at 5.5ms pulled the rest
+  ASSERT_EQ(lifter->fills.size(), 1u);
+  EXPECT_TRUE(TradingSimulator::is_strategy_order(
+      lifter->fills[0].buy_order_id));
+  EXPECT_EQ(lifter->fills[0].quantity, 3);
+  EXPECT_EQ(sim.background_fills(), 1u);
+  EXPECT_EQ(sim.get_order_book().active_asks_count(), 0u);
+
+  // Strategy P&L stays on its own account; the counterparty is booked
+  // to the replayed seller's shifted account
+  const PositionManager &positions = sim.get_position_manager();
+  EXPECT_EQ(positions.get_account(1).positions.at("SIM").quantity, 3);
+  EXPECT_EQ(positions.get_account(TradingSimulator::REPLAY_ACCOUNT_BASE + 1)
+                .positions.at("SIM")
+                .quantity,
+            -3);
+  EXPECT_FALSE(positions.has_account(TradingSimulator::REPLAY_ACCOUNT_BASE + 3));
+}
+
+TEST_F(ReplayTest, SimulatorRejectsCollidingReplays) {
+  write_log(events_file,
+            {OrderEvent(at_ms(1), 100000, Side::SELL, OrderType::LIMIT,
+                        TimeInForce::GTC, 101.0, 10, 0, 1)});
+
+  // The generator's order IDs start where this log's do
+  TradingSimulator sim("GEN");
+  MarketDataGenerator::Config generator;
+  generator.symbol = "GEN";
+  sim.add_instrument(generator);
+  EXPECT_THROW(sim.add_replay("GEN", events_file), std::runtime_error);
+
+  sim.add_replay("LOG", events_file);
+  generator.symbol = "LOG";
+  EXPECT_THROW(sim.add_instrument(generator), std::runtime_error);
+
+  // Shifting this account by REPLAY_ACCOUNT_BASE would overflow int
+  write_log(events_file,
+            {OrderEvent(at_ms(1), 1, Side::SELL, OrderType::LIMIT,
+                        TimeInForce::GTC, 101.0, 10, 0,
+                        TradingSimulator::REPLAY_ACCOUNT_BASE)});
+  TradingSimulator overflow;
+  overflow.add_replay("SIM", events_file);
+  EXPECT_THROW(overflow.run_simulation(1), std::runtime_error);
+}
@@ -0,0 +1,81 @@
+#include "memory_profile.hpp"
+#include "muted_output.hpp"
+#include "trading_simulator.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace {
+
+constexpr int kRestingOrders = 8;
+constexpr int kWarmupSteps = 100;
+constexpr int kMeasuredSteps = 20000;
+
+// Rests a few bids far below the market, then sends a market buy every
+// tick into an empty ask side, so each of those dies unfilled on arrival.
+class RestThenSweepStrategy : public Strategy {
+public:
+  explicit RestThenSweepStrategy(const StrategyConfig &config)
+      : Strategy(config) {}
+
+  void on_market_data(const MarketDataSnapshot &) override {}
+  void on_fill(const Fill &fill) override { update_stats(fill); }
+
+  void generate_signals(std::vector<TradingSignal> &signals) override {
+    TradingSignal signal(SignalType::BUY, instrument_id("SIM"));
+    signal.target_price = ticks_ < kRestingOrders ? 50.0 - ticks_ : 0.0;
+    signal.suggested_quantity = 1;
+    signals.push_back(signal);
+    ++ticks_;
+  }
+
+private:
+  int ticks_ = 0;
+};
+
+} // namespace
+
+TEST(SimulatorAllocationTest, StrategyPipelineAddsNoAllocations) {
+  ASSERT_TRUE(alloc_counting_enabled());
+  MutedOutput muted;
+
+  TradingSimulator sim("SIM");
+  sim.create_account(1, "Sweeper", 1e9);
+  StrategyConfig config;
+  config.name = "Sweeper";
+  config.account_id = 1;
+  config.symbols = {"SIM"};
+  auto owned = std::make_unique<RestThenSweepStrategy>(config);
+  RestThenSweepStrategy *strategy = owned.get();
+  sim.add_strategy(std::move(owned));
+
+  for (int i = 0; i < kWarmupSteps; ++i) {
+    sim.process_step();
+  }
+  const std::size_t capacity = strategy->pending_orders().capacity();
+  AllocCounts before = thread_alloc_counts();
+  for (int i = 0; i < kMeasuredSteps; ++i) {
+    sim.process_step();
+  }
+  AllocCounts in_simulator = thread_alloc_counts() - before;
+
+  // The same orders straight into a bare book: whatever the book itself
+  // allocates (order records) is the floor the simulator has to match
+  OrderBook book("SIM");
+  int id = 1;
+  for (int i = 0; i < kWarmupSteps; ++i, ++id) {
+    book.add_order(i < kRestingOrders
+                       ? Order(id, 1, Side::BUY, 50.0 - i, 1)
+                       : Order(id, 1, Side::BUY, OrderType::MARKET, 1));
+  }
+  before = thread_alloc_counts();
+  for (int i = 0; i < kMeasuredSteps; ++i, ++id) {
+    book.add_order(Order(id, 1, Side::BUY, OrderType::MARKET, 1));
+  }
+  AllocCounts in_book = thread_alloc_counts() - before;
+
+  EXPECT_EQ(in_simulator.allocations, in_book.allocations);
+  EXPECT_EQ(strategy->pending_orders().size(),
+            static_cast<std::size_t>(kRestingOrders));
+  EXPECT_EQ(strategy->pending_orders().capacity(), capacity);
+}
@@ -0,0 +1,173 @@
+#include "subscription_registry.hpp"
+#include "trading_simulator.hpp"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Records every market data update it receives.
+class ListenerStrategy : public Strategy {
+public:
+  explicit ListenerStrategy(const StrategyConfig &config) : Strategy(config) {}
+
+  void on_market_data(const MarketDataSnapshot &snapshot) override {
+    updates.push_back(snapshot);
+  }
+  void on_fill(const Fill &fill) override { update_stats(fill); }
+  void generate_signals(std::vector<TradingSignal> &) override {}
+
+  using Strategy::subscribe_market_data;
+  using Strategy::unsubscribe_market_data;
+
+  size_t count(MarketDataType type) const {
+    size_t n = 0;
+    for (const auto &update : updates) {
+      n += update.type == type ? 1 : 0;
+    }
+    return n;
+  }
+
+  std::vector<MarketDataSnapshot> updates;
+};
+
+StrategyConfig make_config(int account_id, const std::string &symbol) {
+  StrategyConfig config;
+  config.name = "Listener " + std::to_string(account_id);
+  config.account_id = account_id;
+  config.symbols = {symbol};
+  return config;
+}
+
+MarketDataSnapshot bbo(const std::string &symbol, double price) {
+  MarketDataSnapshot snapshot;
+  snapshot.symbol = symbol;
+  snapshot.last_price = price;
+  return snapshot;
+}
+
+} // namespace
+
+TEST(SubscriptionRegistryTest, DefaultsToBboForConfiguredSymbols) {
+  ListenerStrategy strategy(make_config(1, "AAA"));
+
+  const auto &subs = strategy.get_market_data_subscriptions();
+  ASSERT_EQ(subs.size(), 1u);
+  EXPECT_EQ(subs[0].symbol, "AAA");
+  EXPECT_EQ(subs[0].type, MarketDataType::BBO);
+  EXPECT_EQ(subs[0].conflation, 1u);
+
+  strategy.subscribe_market_data("AAA", MarketDataType::BBO, 4);
+  strategy.subscribe_market_data("AAA", MarketDataType::TRADES);
+  ASSERT_EQ(subs.size(), 2u);
+  EXPECT_EQ(subs[0].conflation, 4u);
+
+  strategy.unsubscribe_market_data("AAA", MarketDataType::BBO);
+  ASSERT_EQ(subs.size(), 1u);
+  EXPECT_EQ(subs[0].type, MarketDataType::TRADES);
+
+  // Nothing publishes depth, so a subscription would silently starve
+  EXPECT_THROW(strategy.subscribe_market_data("AAA", MarketDataType::DEPTH),
+               std::runtime_error);
+  EXPECT_EQ(subs.size(), 1u);
+}
+
+TEST(SubscriptionRegistryTest, PublishesOnlyToMatchingInstrumentAndType) {
+  ListenerStrategy a(make_config(1, "AAA"));
+  ListenerStrategy b(make_config(2, "BBB"));
+  b.subscribe_market_data("AAA", MarketDataType::TRADES);
+
+  SubscriptionRegistry registry;
+  registry.add_strategy(&a);
+  registry.add_strategy(&b);
+
+  InstrumentId aaa = *registry.find("AAA");
+  InstrumentId bbb = *registry.find("BBB");
+  EXPECT_EQ(registry.subscriber_count(aaa, MarketDataType::BBO), 1u);
+  EXPECT_EQ(registry.subscriber_count(aaa, MarketDataType::TRADES), 1u);
+  EXPECT_EQ(registry.subscriber_count(bbb, MarketDataType::BBO), 1u);
+  EXPECT_FALSE(registry.has_subscribers(bbb, MarketDataType::BARS));
+
+  registry.publish(aaa, bbo("AAA", 10.0));
+  registry.publish(bbb, bbo("BBB", 20.0));
+
+  MarketDataSnapshot trade = bbo("AAA", 10.5);
+  trade.type = MarketDataType::TRADES;
+  registry.publish(aaa, trade);
+
+  ASSERT_EQ(a.updates.size(), 1u);
+  EXPECT_EQ(a.updates[0].symbol, "AAA");
+  ASSERT_EQ(b.updates.size(), 2u);
+  EXPECT_EQ(b.updates[0].symbol, "BBB");
+  EXPECT_EQ(b.updates[1].type, MarketDataType::TRADES);
+
+  registry.remove_strategy(&b);
+  EXPECT_EQ(registry.subscriber_count(aaa, MarketDataType::TRADES), 0u);
+}
+
+TEST(SubscriptionRegistryTest, ConflationDeliversEveryNthUpdate) {
+  ListenerStrategy fast(make_config(1, "AAA"));
+  ListenerStrategy slow(make_config(2, "AAA"));
+  slow.subscribe_market_data("AAA", MarketDataType::BBO, 3);
+
+  SubscriptionRegistry registry;
+  registry.add_strategy(&fast);
+  registry.add_strategy(&slow);
+  InstrumentId aaa = *registry.find("AAA");
+
+  for (int i = 1; i <= 7; ++i) {
+    registry.publish(aaa, bbo("AAA", i));
+  }
+
+  EXPECT_EQ(fast.updates.size(), 7u);
+  ASSERT_EQ(slow.updates.size(), 2u);
+  EXPECT_DOUBLE_EQ(slow.updates[0].last_price, 3.0);
+  EXPECT_DOUBLE_EQ(slow.updates[1].last_price, 6.0);
+}
+
+TEST(SubscriptionRegistryTest, SimulatorFansOutBboTradesAndBars) {
+  TradingSimulator sim("AAA");
+  sim.create_account(1, "Listener", 100000.0);
+  sim.create_account(2, "Other symbol", 100000.0);
+  sim.create_account(3, "Liquidity", 100000.0);
+  sim.set_bar_interval(2);
+
+  auto listener = std::make_unique<ListenerStrategy>(make_config(1, "AAA"));
+  listener->subscribe_market_data("AAA", MarketDataType::TRADES);
+  listener->subscribe_market_data("AAA", MarketDataType::BARS);
+  ListenerStrategy *on_book = listener.get();
+  auto other = std::make_unique<ListenerStrategy>(make_config(2, "ZZZ"));
+  ListenerStrategy *off_book = other.get();
+  sim.add_strategy(std::move(listener));
+  sim.add_strategy(std::move(other));
+
+  OrderBook &book = sim.get_order_book();
+  book.add_order(Order(9001, 3, Side::SELL, 101.0, 10));
+  book.add_order(Order(9002, 3, Side::BUY, 99.0, 10));
+
+  sim.process_step();
+  book.add_order(Order(9003, 2, Side::BUY, 101.0, 4));
+  sim.process_step();
+
+  // ZZZ is hosted on its own (empty) book; nothing from AAA reaches it
+  ASSERT_EQ(off_book->updates.size(), 2u);
+  for (const auto &update : off_book->updates) {
+    EXPECT_EQ(update.symbol, "ZZZ");
+    EXPECT_DOUBLE_EQ(update.last_price, 0.0);
+  }
+  EXPECT_EQ(on_book->count(MarketDataType::BBO), 2u);
+  ASSERT_EQ(on_book->count(MarketDataType::TRADES), 1u);
+  ASSERT_EQ(on_book->count(MarketDataType::BARS), 1u);
+
+  const MarketDataSnapshot &trade = on_book->updates[2];
+  EXPECT_EQ(trade.type, MarketDataType::TRADES);
+  EXPECT_DOUBLE_EQ(trade.last_price, 101.0);
+  EXPECT_DOUBLE_EQ(trade.last_size, 4.0);
+
+  const MarketDataSnapshot &bar = on_book->updates.back();
+  EXPECT_EQ(bar.type, MarketDataType::BARS);
+  EXPECT_DOUBLE_EQ(bar.open_price, 100.0);
+  EXPECT_DOUBLE_EQ(bar.high_price, 101.0);
+  EXPECT_DOUBLE_EQ(bar.last_size, 4.0);
+}
@@ -0,0 +1,345 @@
+#include "muted_output.hpp"
+#include "trading_simulator.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Sends one limit order on the first tick and records every fill callback.
+class RecordingStrategy : public Strategy {
+public:
+  RecordingStrategy(const StrategyConfig &config, Side side, double price,
+                    int quantity)
+      : Strategy(config), side_(side), price_(price), quantity_(quantity) {}
+
+  void on_market_data(const MarketDataSnapshot &) override {}
+
+  void on_fill(const Fill &fill) override {
+    update_stats(fill);
+    fills.push_back(fill);
+  }
+
+  void on_execution(const Fill &fill, const FillContext &context) override {
+    contexts.push_back(context);
+    Strategy::on_execution(fill, context);
+  }
+
+  void generate_signals(std::vector<TradingSignal> &signals) override {
+    if (sent_ && !repeat) {
+      return;
+    }
+    sent_ = true;
+    TradingSignal signal(side_ == Side::BUY ? SignalType::BUY
+                                            : SignalType::SELL,
+                         instrument_id(symbol));
+    signal.target_price = price_;
+    signal.suggested_quantity = quantity_;
+    signals.push_back(signal);
+  }
+
+  std::vector<Fill> fills;
+  std::vector<FillContext> contexts;
+  bool repeat = false; // Send the order every tick, not just the first
+  std::string symbol = "SIM";
+
+private:
+  Side side_;
+  double price_;
+  int quantity_;
+  bool sent_ = false;
+};
+
+StrategyConfig make_config(int account_id) {
+  StrategyConfig config;
+  config.name = "Recorder " + std::to_string(account_id);
+  config.account_id = account_id;
+  config.symbols = {"SIM"};
+  return config;
+}
+
+// Quotes a symbol the simulator does not host, recording any outcome
+class StrayQuoter : public Strategy {
+public:
+  explicit StrayQuoter(const StrategyConfig &config) : Strategy(config) {}
+
+  void on_market_data(const MarketDataSnapshot &) override {}
+  void on_fill(const Fill &fill) override { update_stats(fill); }
+  void generate_signals(std::vector<TradingSignal> &) override {}
+
+  void generate_quotes(std::vector<MassQuote> &quotes) override {
+    MassQuote quote;
+    quote.instrument = instrument_id("ZZZ");
+    quote.bid_price = 99.0;
+    quote.bid_quantity = 10;
+    quote.ask_price = 101.0;
+    quote.ask_quantity = 10;
+    quotes.push_back(quote);
+  }
+  void on_quote_result(const MassQuote &,
+                       const MassQuoteResult &result) override {
+    results.push_back(result);
+  }
+
+  std::vector<MassQuoteResult> results;
+};
+
+} // namespace
+
+TEST(TradingSimulatorTest, DeliversEachFillOnceWithContext) {
+  TradingSimulator sim;
+  sim.setup();
+  sim.create_account(1, "Buyer", 100000.0);
+  sim.create_account(2, "Liquidity", 100000.0);
+
+  // Resting liquidity from a non-strategy account
+  sim.get_order_book().add_order(Order(9001, 2, Side::SELL, 100.0, 50));
+
+  auto strategy =
+      std::make_unique<RecordingStrategy>(make_config(1), Side::BUY, 101.0, 50);
+  RecordingStrategy *recorder = strategy.get();
+  sim.add_strategy(std::move(strategy));
+  recorder->initialize();
+
+  sim.process_step();
+  sim.process_step();
+
+  ASSERT_EQ(recorder->fills.size(), 1u);
+  ASSERT_EQ(recorder->contexts.size(), 1u);
+
+  const FillContext &context = recorder->contexts.front();
+  EXPECT_EQ(context.side, Side::BUY);
+  EXPECT_EQ(context.symbol, "SIM");
+  EXPECT_FALSE(context.is_maker);
+  EXPECT_EQ(context.order_id, recorder->fills.front().buy_order_id);
+  EXPECT_EQ(recorder->get_stats().orders_filled, 1);
+}
+
+TEST(TradingSimulatorTest, RoutesBothSidesToTheirOwners) {
+  TradingSimulator sim;
+  sim.create_account(1, "Seller", 100000.0);
+  sim.create_account(2, "Buyer", 100000.0);
+
+  auto seller =
+      std::make_unique<RecordingStrategy>(make_config(1), Side::SELL, 100.0, 30);
+  auto buyer =
+      std::make_unique<RecordingStrategy>(make_config(2), Side::BUY, 100.0, 30);
+  RecordingStrategy *seller_ptr = seller.get();
+  RecordingStrategy *buyer_ptr = buyer.get();
+  sim.add_strategy(std::move(seller));
+  sim.add_strategy(std::move(buyer));
+  seller_ptr->initialize();
+  buyer_ptr->initialize();
+
+  sim.process_step();
+
+  ASSERT_EQ(seller_ptr->contexts.size(), 1u);
+  ASSERT_EQ(buyer_ptr->contexts.size(), 1u);
+  EXPECT_EQ(seller_ptr->contexts.front().side, Side::SELL);
+  EXPECT_TRUE(seller_ptr->contexts.front().is_maker);
+  EXPECT_EQ(buyer_ptr->contexts.front().side, Side::BUY);
+  EXPECT_FALSE(buyer_ptr->contexts.front().is_maker);
+}
+
+TEST(TradingSimulatorTest, RejectsSecondStrategyOnSameAccount) {
+  TradingSimulator sim;
+  sim.create_account(1, "Shared", 100000.0);
+
+  sim.add_strategy(
+      std::make_unique<RecordingStrategy>(make_config(1), Side::BUY, 1.0, 1));
+  EXPECT_THROW(sim.add_strategy(std::make_unique<RecordingStrategy>(
+                   make_config(1), Side::BUY, 1.0, 1)),
+               std::runtime_error);
+}
+
+TEST(TradingSimulatorTest, EmitOrdersReusesCallerBuffer) {
+  RecordingStrategy strategy(make_config(1), Side::BUY, 100.0, 10);
+  strategy.repeat = true;
+  strategy.initialize();
+
+  std::vector<Order> buffer;
+  buffer.reserve(16);
+  const Order *storage = buffer.data();
+
+  for (int tick = 0; tick < 100; ++tick) {
+    buffer.clear();
+    strategy.emit_orders(buffer);
+
+    ASSERT_EQ(buffer.size(), 1u);
+    EXPECT_EQ(buffer.data(), storage);
+    EXPECT_EQ(buffer[0].side, Side::BUY);
+    EXPECT_DOUBLE_EQ(buffer[0].price, 100.0);
+
+    strategy.remove_order(buffer[0].id);
+  }
+
+  EXPECT_FALSE(strategy.has_pending_orders("SIM"));
+  EXPECT_EQ(strategy.get_stats().orders_submitted, 100);
+}
+
+TEST(TradingSimulatorTest, FinishedOrdersLeavePendingTracking) {
+  TradingSimulator sim("SIM");
+  sim.create_account(1, "Resting", 100000.0);
+  auto owned =
+      std::make_unique<RecordingStrategy>(make_config(1), Side::BUY, 90.0, 5);
+  RecordingStrategy *strategy = owned.get();
+  sim.add_strategy(std::move(owned));
+
+  MutedOutput muted;
+  sim.run_simulation(2);
+  ASSERT_EQ(strategy->pending_orders().size(), 1u); // Resting, still live
+
+  // Cancelled behind the strategy's back; the end of the next run notices
+  sim.get_order_book("SIM").cancel_order(strategy->pending_orders()[0].id);
+  sim.run_simulation(2);
+  EXPECT_FALSE(strategy->has_pending_orders("SIM"));
+}
+
+TEST(TradingSimulatorTest, OrdersRouteToTheirSymbolsBook) {
+  TradingSimulator sim("AAA");
+  sim.create_account(1, "Two legs", 100000.0);
+  sim.create_account(2, "Liquidity", 100000.0);
+
+  StrategyConfig config = make_config(1);
+  config.symbols = {"AAA", "BBB"};
+  auto strategy =
+      std::make_unique<RecordingStrategy>(config, Side::BUY, 50.0, 5);
+  strategy->symbol = "BBB";
+  RecordingStrategy *recorder = strategy.get();
+  sim.add_strategy(std::move(strategy));
+
+  // Both of the strategy's symbols are hosted
+  ASSERT_EQ(sim.instrument_count(), 2u);
+  sim.get_order_book("BBB").add_order(Order(9001, 2, Side::SELL, 50.0, 5));
+
+  sim.process_step();
+
+  ASSERT_EQ(recorder->fills.size(), 1u);
+  EXPECT_EQ(recorder->contexts[0].symbol, "BBB");
+  EXPECT_EQ(sim.get_order_book("AAA").get_fills().size(), 0u);
+  EXPECT_EQ(sim.get_order_book("BBB").get_fills().size(), 1u);
+  EXPECT_EQ(sim.unrouted_orders(), 0u);
+  EXPECT_THROW(sim.get_order_book("CCC"), std::runtime_error);
+}
+
+TEST(TradingSimulatorTest, QuotesForUnhostedSymbolsAreDropped) {
+  TradingSimulator sim;
+  sim.create_account(1, "Stray", 100000.0);
+  auto owned = std::make_unique<StrayQuoter>(make_config(1));
+  StrayQuoter *quoter = owned.get();
+  sim.add_strategy(std::move(owned));
+
+  sim.process_step();
+
+  EXPECT_TRUE(quoter->results.empty());
+  EXPECT_EQ(sim.unrouted_orders(), 1u);
+
+  // Through the latency link the quote reaches enter_order() later
+  sim.set_latency_model(1, LatencyPath::ORDER_ENTRY,
+                        std::make_unique<FixedLatency>(
+                            std::chrono::milliseconds(1)));
+  {
+    MutedOutput muted;
+    sim.run_simulation(3);
+  }
+  EXPECT_TRUE(quoter->results.empty());
+  EXPECT_EQ(sim.unrouted_orders(),
+            4u - sim.in_flight(1, LatencyPath::ORDER_ENTRY));
+  EXPECT_GT(sim.unrouted_orders(), 1u);
+  EXPECT_EQ(sim.get_order_book().active_bids_count(), 0u);
+}
+
+TEST(TradingSimulatorTest, ParallelVenuesMatchSerialRun) {
+  auto run = [](size_t threads) {
+    TradingSimulator sim("S0");
+    for (int i = 0; i < 16; ++i) {
+      MarketDataGenerator::Config generator;
+      generator.symbol = "S" + std::to_string(i);
+      generator.seed = 100 + i;
+      sim.add_instrument(generator, 0.5);
+    }
+    sim.set_worker_threads(threads);
+    for (int step = 0; step < 200; ++step) {
+      sim.process_step();
+    }
+
+    std::vector<size_t> fills;
+    for (int i = 0; i < 16; ++i) {
+      fills.push_back(
+          sim.get_order_book("S" + std::to_string(i)).get_fills().size());
+    }
+    return fills;
+  };
+
+  std::vector<size_t> serial = run(1);
+  EXPECT_GT(serial[0], 0u);
+  EXPECT_NE(serial[0], serial[1]); // Independent flow per instrument
+  EXPECT_EQ(run(4), serial);
+}
+
+TEST(TradingSimulatorTest, RejectsBadInstrumentsWithoutSideEffects) {
+  TradingSimulator sim("AAA");
+  MarketDataGenerator::Config generator;
+  generator.symbol = "BBB";
+  sim.add_instrument(generator);
+  EXPECT_THROW(sim.add_instrument(generator), std::runtime_error);
+
+  // Bad member late in the universe: nothing is hosted or attached
+  MultiAssetMarketDataGenerator::Config universe;
+  for (const char *symbol : {"AAA", "CCC", "DDD"}) {
+    MarketDataGenerator::Config member;
+    member.symbol = symbol;
+    universe.symbols.push_back(member);
+  }
+  universe.symbols[2].max_size = 0.0;
+  EXPECT_THROW(sim.add_universe(universe), std::runtime_error);
+
+  universe.symbols[2] = universe.symbols[1]; // Listed twice
+  EXPECT_THROW(sim.add_universe(universe), std::runtime_error);
+
+  universe.symbols[2].symbol = "BBB"; // Already generated
+  EXPECT_THROW(sim.add_universe(universe), std::runtime_error);
+  EXPECT_EQ(sim.instrument_count(), 2u);
+
+  universe.symbols[2].symbol = "DDD";
+  EXPECT_EQ(sim.add_universe(universe).size(), 3u);
+  EXPECT_EQ(sim.instrument_count(), 4u);
+}
+
+TEST(TradingSimulatorTest, CorrelatedUniverseDrivesVenues) {
+  auto run = [](size_t threads) {
+    MultiAssetMarketDataGenerator::Config universe;
+    const size_t n = 8;
+    for (size_t i = 0; i < n; ++i) {
+      MarketDataGenerator::Config symbol;
+      symbol.symbol = "U" + std::to_string(i);
+      symbol.seed = 300 + static_cast<int>(i);
+      universe.symbols.push_back(symbol);
+    }
+    universe.factors = 1;
+    universe.loadings.assign(n, 0.9);
+
+    TradingSimulator sim("U0");
+    auto ids = sim.add_universe(universe, 0.5);
+    EXPECT_EQ(ids.size(), n);
+    EXPECT_EQ(sim.instrument_count(), n); // U0 reuses the primary venue
+    EXPECT_THROW(sim.add_universe(universe), std::runtime_error);
+
+    sim.set_worker_threads(threads);
+    for (int step = 0; step < 200; ++step) {
+      sim.process_step();
+    }
+
+    std::vector<size_t> fills;
+    for (size_t i = 0; i < n; ++i) {
+      fills.push_back(
+          sim.get_order_book("U" + std::to_string(i)).get_fills().size());
+    }
+    return fills;
+  };
+
+  std::vector<size_t> serial = run(1);
+  EXPECT_GT(serial[0], 0u);
+  EXPECT_EQ(run(4), serial);
+}
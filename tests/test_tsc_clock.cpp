@@ -0,0 +1,67 @@
+#include "timer.hpp"
+#include "tsc_clock.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(TscClockTest, CalibratedRateIsSane) {
+  double rate = TscClock::ns_per_tick();
+  if (TscClock::uses_tsc()) {
+    // Any TSC between 100 MHz and 10 GHz
+    EXPECT_GT(rate, 0.1);
+    EXPECT_LT(rate, 10.0);
+  } else {
+    EXPECT_DOUBLE_EQ(rate, 1.0);
+  }
+}
+
+TEST(TscClockTest, CalibratedBeforeMain) {
+  // The calibration spin already ran, so this is only a guard check
+  auto before = std::chrono::steady_clock::now();
+  TscClock::init();
+  auto elapsed = std::chrono::steady_clock::now() - before;
+  EXPECT_LT(elapsed, std::chrono::milliseconds(1));
+}
+
+TEST(TscClockTest, TracksSteadyClock) {
+  auto steady_start = std::chrono::steady_clock::now();
+  std::uint64_t start = TscClock::start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  std::uint64_t stop = TscClock::stop();
+  auto steady_elapsed = std::chrono::duration<double, std::nano>(
+                            std::chrono::steady_clock::now() - steady_start)
+                            .count();
+
+  double elapsed = TscClock::to_nanoseconds(stop - start);
+  EXPECT_GT(elapsed, 19e6);
+  EXPECT_LE(elapsed, steady_elapsed * 1.02);
+}
+
+TEST(TscClockTest, RecalibrationKeepsRate) {
+  double before = TscClock::ns_per_tick();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  TscClock::recalibrate();
+  double after = TscClock::ns_per_tick();
+  EXPECT_NEAR(after, before, before * 0.01);
+}
+
+TEST(TscClockTest, ReadsAreMonotonic) {
+  std::uint64_t previous = TscClock::now();
+  for (int i = 0; i < 100000; ++i) {
+    std::uint64_t current = TscClock::now();
+    ASSERT_GE(current, previous);
+    previous = current;
+  }
+}
+
+TEST(TscClockTest, TimerUsesCalibratedTicks) {
+  Timer timer;
+  timer.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  timer.stop();
+
+  EXPECT_GE(timer.elapsed_nanoseconds(), 4'900'000);
+  EXPECT_LT(timer.elapsed_milliseconds(), 500.0);
+  EXPECT_EQ(timer.elapsed_microseconds(), timer.elapsed_nanoseconds() / 1000);
+}
@@ -0,0 +1,41 @@
+#include "worker_pool.hpp"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+TEST(WorkerPoolTest, RunsEveryIndexExactlyOnce) {
+  WorkerPool pool(4);
+  EXPECT_EQ(pool.size(), 4u);
+
+  std::vector<int> hits(1000, 0);
+  for (int round = 0; round < 50; ++round) {
+    pool.parallel_for(hits.size(), [&](size_t i) { ++hits[i]; });
+  }
+
+  for (int count : hits) {
+    EXPECT_EQ(count, 50);
+  }
+}
+
+TEST(WorkerPoolTest, SingleThreadRunsInline) {
+  WorkerPool pool(1);
+  std::vector<size_t> order;
+  pool.parallel_for(5, [&](size_t i) { order.push_back(i); });
+  EXPECT_EQ(order, (std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(WorkerPoolTest, RethrowsTaskErrorsAndStaysUsable) {
+  WorkerPool pool(3);
+  EXPECT_THROW(pool.parallel_for(100,
+                                 [](size_t i) {
+                                   if (i == 42) {
+                                     throw std::runtime_error("boom");
+                                   }
+                                 }),
+               std::runtime_error);
+
+  std::atomic<size_t> sum{0};
+  pool.parallel_for(10, [&](size_t i) { sum += i; });
+  EXPECT_EQ(sum.load(), 45u);
+}